@@ -132,49 +132,37 @@ int main()
     std::normal_distribution<> pos_perturb_dist(0.0, 0.05);
     std::normal_distribution<> vel_perturb_dist(0.0, 0.005);
 
-    for (int mc_run = 0; mc_run < num_mc_runs; ++mc_run)
+    // Optimization horizon info
+    int horizon = 200;                  // Optimization horizon length
+    double time_horizon = 200.0;        // Time horizon for optimization [s]
+    double dt = time_horizon / horizon; // Time step for optimization
+    int state_dim = 6;
+    int control_dim = 3;
+
+    // HCW parameters
+    double mean_motion = 0.001107;
+    double mass = 100.0;
+    double nominal_radius = 50.0;
+
+    // Initial state (nominal)
+    Eigen::VectorXd nominal_initial_state(state_dim);
+    nominal_initial_state << nominal_radius, 0.0, 0.0, 0.0, -2.0 * mean_motion * nominal_radius, 0.0;
+
+    // Final (reference/goal) state
+    Eigen::VectorXd goal_state(state_dim);
+    goal_state.setZero(); // Goal is the origin
+
+    // Input constraints
+    double u_max = 1.0;      // for each dimension
+
+    // Cost weighting for SumOfTwoNormObjective
+    double weight_running_control = 1.0;   // Example value
+    double weight_terminal_state = 1000.0; // Example value
+
+    // Problem template shared by all runs. The batch solver calls this once
+    // per worker thread, not once per run.
+    auto make_problem = [&]()
     {
-        std::cout << "\n--- Monte Carlo Run: " << mc_run + 1 << "/" << num_mc_runs << " ---" << std::endl;
-
-        // Optimization horizon info
-        int horizon = 200;                  // Optimization horizon length
-        double time_horizon = 200.0;        // Time horizon for optimization [s]
-        double dt = time_horizon / horizon; // Time step for optimization
-        int state_dim = 6;
-        int control_dim = 3;
-
-        // HCW parameters
-        double mean_motion = 0.001107;
-        double mass = 100.0;
-        double nominal_radius = 50.0;
-
-        // Initial state (nominal)
-        Eigen::VectorXd nominal_initial_state(state_dim);
-        nominal_initial_state << nominal_radius, 0.0, 0.0, 0.0, -2.0 * mean_motion * nominal_radius, 0.0;
-
-        // Perturb initial state
-        Eigen::VectorXd initial_state = nominal_initial_state;
-        initial_state(0) += nominal_radius * pos_perturb_dist(gen);                     // Perturb x
-        initial_state(1) += nominal_radius * pos_perturb_dist(gen);                     // Perturb y
-        initial_state(2) += nominal_radius * pos_perturb_dist(gen);                     // Perturb z
-        initial_state(3) += std::abs(nominal_initial_state(4)) * vel_perturb_dist(gen); // Perturb vx (use initial vy magnitude for scaling)
-        initial_state(4) += std::abs(nominal_initial_state(4)) * vel_perturb_dist(gen); // Perturb vy
-        initial_state(5) += std::abs(nominal_initial_state(4)) * vel_perturb_dist(gen); // Perturb vz
-
-        // Final (reference/goal) state
-        Eigen::VectorXd goal_state(state_dim);
-        goal_state.setZero(); // Goal is the origin
-
-        // Input constraints
-        double u_max = 1.0;      // for each dimension
-        double u_min = -1.0;     // for each dimension
-        double u_min_norm = 0.0; // Minimum thrust magnitude
-        double u_max_norm = 1.0; // Maximum thrust magnitude, consistent with previous u_max
-
-        // Cost weighting for SumOfTwoNormObjective
-        double weight_running_control = 1.0;   // Example value
-        double weight_terminal_state = 1000.0; // Example value
-
         // Create the HCW system for optimization
         std::unique_ptr<cddp::DynamicalSystem> hcw_system =
             std::make_unique<HCW>(dt, mean_motion, mass, "euler");
@@ -186,7 +174,7 @@ int main()
             weight_terminal_state,
             dt);
 
-        // Setup IPDDP solver options
+        // Setup MSIPDDP solver options
         cddp::CDDPOptions options;
         options.max_iterations = 1000;
         options.line_search.max_iterations = 21;
@@ -194,7 +182,7 @@ int main()
         options.verbose = false;
         options.debug = false;
         options.print_solver_header = false;
-        options.enable_parallel = false;
+        options.enable_parallel = false; // Runs are solved in parallel instead
         options.num_threads = 1;
         // Regularization type is now implicit in new API
         options.regularization.initial_value = 1e-5;
@@ -203,46 +191,58 @@ int main()
         options.msipddp.segment_length = horizon / 10;
         options.msipddp.rollout_type = "nonlinear";
 
-        // Initial trajectory.
-        std::vector<Eigen::VectorXd> X(horizon + 1, Eigen::VectorXd::Zero(state_dim));
-        std::vector<Eigen::VectorXd> U(horizon, Eigen::VectorXd::Zero(control_dim));
-        X[0] = initial_state;
-        for (int i = 0; i < horizon; ++i)
-        {
-            X[i + 1] = initial_state;
-        }
-
         // Create CDDP solver.
-        cddp::CDDP cddp_solver(
-            initial_state,
+        auto problem = std::make_unique<cddp::CDDP>(
+            nominal_initial_state,
             goal_state,
             horizon,
             dt,
             std::move(hcw_system),
             std::move(objective),
             options);
-        cddp_solver.setInitialTrajectory(X, U);
 
         // Add Control Constraint
         Eigen::VectorXd u_upper = Eigen::VectorXd::Constant(3, u_max);
-        cddp_solver.addPathConstraint("ControlConstraint",
-                                  std::make_unique<cddp::ControlConstraint>(u_upper));
+        problem->addPathConstraint("ControlConstraint",
+                                   std::make_unique<cddp::ControlConstraint>(u_upper));
+        return problem;
+    };
 
-        // Solve the Trajectory Optimization Problem
-        cddp::CDDPSolution solution = cddp_solver.solve("MSIPDDP");
+    // One perturbed instance per Monte Carlo run
+    std::vector<cddp::BatchProblem> runs(num_mc_runs);
+    for (int mc_run = 0; mc_run < num_mc_runs; ++mc_run)
+    {
+        // Perturb initial state
+        Eigen::VectorXd initial_state = nominal_initial_state;
+        initial_state(0) += nominal_radius * pos_perturb_dist(gen);                     // Perturb x
+        initial_state(1) += nominal_radius * pos_perturb_dist(gen);                     // Perturb y
+        initial_state(2) += nominal_radius * pos_perturb_dist(gen);                     // Perturb z
+        initial_state(3) += std::abs(nominal_initial_state(4)) * vel_perturb_dist(gen); // Perturb vx (use initial vy magnitude for scaling)
+        initial_state(4) += std::abs(nominal_initial_state(4)) * vel_perturb_dist(gen); // Perturb vy
+        initial_state(5) += std::abs(nominal_initial_state(4)) * vel_perturb_dist(gen); // Perturb vz
+
+        // Initial trajectory: hold the initial state
+        runs[mc_run].initial_state = initial_state;
+        runs[mc_run].initial_state_trajectory = cddp::Trajectory(horizon + 1, initial_state);
+        runs[mc_run].initial_control_trajectory = cddp::Trajectory(control_dim, horizon);
+    }
+
+    // Solve all runs in parallel; results come back in run order
+    cddp::BatchSolver batch(make_problem, "MSIPDDP");
+    std::vector<cddp::SolveResult> results = batch.solve(runs);
+
+    for (int mc_run = 0; mc_run < num_mc_runs; ++mc_run)
+    {
+        const cddp::SolveResult &solution = results[mc_run];
 
-        auto state_trajectory = std::any_cast<std::vector<Eigen::VectorXd>>(solution.at("state_trajectory"));
-        auto control_trajectory = std::any_cast<std::vector<Eigen::VectorXd>>(solution.at("control_trajectory"));
-        bool converged = std::any_cast<bool>(solution.at("converged"));
-        
-        if (!state_trajectory.empty() && !control_trajectory.empty() && converged)
+        if (!solution.state_trajectory.empty() && !solution.control_trajectory.empty() && solution.converged())
         {
             std::cout << "Run " << mc_run + 1 << " converged." << std::endl;
             successful_runs++;
             if (first_successful_X_solution.empty())
             {
-                first_successful_X_solution = state_trajectory;
-                first_successful_U_solution = control_trajectory;
+                first_successful_X_solution = solution.state_trajectory.toVector();
+                first_successful_U_solution = solution.control_trajectory.toVector();
             }
         }
         else
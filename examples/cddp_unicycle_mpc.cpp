@@ -115,9 +115,31 @@ int main()
     state_history.push_back(current_state);
     time_history.push_back(0.0);
 
+    // Build the MPC problem once; the controller keeps it (and the solver
+    // workspaces) alive across ticks.
+    std::vector<Eigen::VectorXd> initial_ref_traj(
+        reference_trajectory.begin(),
+        reference_trajectory.begin() + std::min<int>(mpc_horizon + 1, reference_trajectory.size()));
+    initial_ref_traj.resize(mpc_horizon + 1, reference_trajectory.back());
+    auto objective = std::make_unique<cddp::QuadraticObjective>(
+        Q, R, Qf, initial_ref_traj.back(), initial_ref_traj, mpc_timestep);
+    auto system = std::make_unique<cddp::Unicycle>(mpc_timestep, integration_type);
+    auto problem = std::make_unique<cddp::CDDP>(
+        current_state, initial_ref_traj.back(), mpc_horizon, mpc_timestep,
+        std::move(system), std::move(objective), options_ipddp);
+
+    problem->addPathConstraint("ControlConstraint",
+        std::make_unique<cddp::ControlConstraint>(control_upper_bound, control_lower_bound));
+    problem->addPathConstraint("BallConstraint",
+        std::make_unique<cddp::BallConstraint>(obstacles[0](2), obstacles[0].head(2)));
+
     // Initial trajectory guess for the first MPC solve
     std::vector<Eigen::VectorXd> X_guess(mpc_horizon + 1, current_state);
     std::vector<Eigen::VectorXd> U_guess(mpc_horizon, Eigen::VectorXd::Zero(control_dim));
+    problem->setInitialTrajectory(X_guess, U_guess);
+
+    cddp::MPCController mpc(std::move(problem), "IPDDP");
+    auto *ball_constraint = mpc.getProblem().getConstraint<cddp::BallConstraint>("BallConstraint");
 
     // --------------------------
     // 2. MPC Loop
@@ -136,17 +158,9 @@ int main()
             int idx = std::min(ref_start_idx + i, (int)reference_trajectory.size() - 1);
             mpc_ref_traj.push_back(reference_trajectory[idx]);
         }
-        Eigen::VectorXd mpc_goal_state = mpc_ref_traj.back();
-
-        // Create objective for this MPC step
-        auto objective = std::make_unique<cddp::QuadraticObjective>(Q, R, Qf, mpc_goal_state, mpc_ref_traj, mpc_timestep);
+        mpc.setReferenceStates(mpc_ref_traj);
 
-        // Create CDDP solver instance for this MPC step
-        auto system = std::make_unique<cddp::Unicycle>(mpc_timestep, integration_type);
-        cddp::CDDP cddp_solver(current_state, mpc_goal_state, mpc_horizon, mpc_timestep,
-                               std::move(system), std::move(objective), options_ipddp);
-        
-        // Find closest obstacle and add constraint
+        // Move the obstacle constraint to the closest obstacle
         Eigen::Vector2d current_pos = current_state.head(2);
         double min_dist = std::numeric_limits<double>::max();
         Eigen::Vector3d closest_obstacle;
@@ -159,28 +173,20 @@ int main()
                 closest_obstacle = obs;
             }
         }
-        
-        cddp_solver.addPathConstraint("ControlConstraint",
-            std::make_unique<cddp::ControlConstraint>(control_upper_bound, control_lower_bound));
-        cddp_solver.addPathConstraint("BallConstraint",
-            std::make_unique<cddp::BallConstraint>(closest_obstacle(2), closest_obstacle.head(2)));
+        ball_constraint->setCenter(closest_obstacle.head(2));
+        ball_constraint->setRadius(closest_obstacle(2));
 
-        // Set initial trajectory (warm start)
-        cddp_solver.setInitialTrajectory(X_guess, U_guess);
-
-        // Solve the OCP
-        cddp::CDDPSolution solution = cddp_solver.solve("IPDDP");
+        // Solve the OCP from the shifted previous solution
+        const cddp::SolveResult &solution = mpc.step(current_state, current_time);
 
         // Extract and apply the first control
-        auto status = std::any_cast<std::string>(solution.at("status_message"));
-        if (status != "OptimalSolutionFound" && status != "AcceptableSolutionFound")
+        if (!solution.converged())
         {
-            std::cerr << "Warning: Solver did not converge at step " << k << ". Status: " << status << std::endl;
+            std::cerr << "Warning: Solver did not converge at step " << k << ". Status: " << solution.status_message << std::endl;
             // Handle non-convergence, e.g., by applying zero control or previous control
         }
 
-        auto U_sol = std::any_cast<std::vector<Eigen::VectorXd>>(solution.at("control_trajectory"));
-        Eigen::VectorXd control_to_apply = U_sol[0];
+        Eigen::VectorXd control_to_apply = mpc.getControl();
         
         // Propagate system dynamics
         current_state = dyn_system_template->getDiscreteDynamics(current_state, control_to_apply, 0.0);
@@ -191,17 +197,6 @@ int main()
         current_time += sim_dt;
         time_history.push_back(current_time);
 
-        // Warm start for the next iteration: shift the solution
-        auto X_sol = std::any_cast<std::vector<Eigen::VectorXd>>(solution.at("state_trajectory"));
-        for(int i = 0; i < mpc_horizon -1; ++i)
-        {
-            X_guess[i] = X_sol[i+1];
-            U_guess[i] = U_sol[i+1];
-        }
-        X_guess[mpc_horizon -1] = X_sol[mpc_horizon];
-        X_guess[mpc_horizon] = X_sol[mpc_horizon]; // Extrapolate or use goal
-        U_guess[mpc_horizon -1] = U_sol[mpc_horizon-1]; // Hold last control
-
         std::cout << "MPC Step: " << k+1 << "/" << sim_steps <<", Time: " << current_time << "s, X: [" << current_state.transpose() << "], U: [" << control_to_apply.transpose() << "]" << std::endl;
     }
     std::cout << "Simulation finished." << std::endl;
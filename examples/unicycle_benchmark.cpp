@@ -324,6 +324,55 @@ int main() {
         y_msipddp.push_back(state(1));
     }   
 
+    // --------------------------------------------------------
+    // 4b. CLDDP: dynamic-size vs. fixed-size (box constraint only)
+    // --------------------------------------------------------
+    std::cout << "Solving with CLDDP (dynamic vs. fixed-size)..." << std::endl;
+
+    cddp::CDDPOptions options_clddp;
+    options_clddp.max_iterations = 200;
+    options_clddp.verbose = false;
+    options_clddp.print_solver_header = false;
+    options_clddp.enable_parallel = false;
+    options_clddp.num_threads = 1;
+    options_clddp.tolerance = 1e-4;
+    options_clddp.acceptable_tolerance = 1e-5;
+    options_clddp.regularization.initial_value = 1e-4;
+
+    auto makeClddpProblem = [&]() {
+        auto problem = std::make_unique<cddp::CDDP>(
+            initial_state, goal_state, horizon, timestep,
+            std::make_unique<cddp::Unicycle>(timestep, integration_type),
+            std::make_unique<cddp::QuadraticObjective>(Q, R, Qf, goal_state, empty_ref, timestep),
+            options_clddp);
+        problem->setInitialTrajectory(X_init, U_init);
+        problem->addPathConstraint("ControlBoxConstraint",
+            std::make_unique<cddp::ControlBoxConstraint>(control_lower_bound, control_upper_bound));
+        return problem;
+    };
+
+    const std::string fixed_clddp_name =
+        cddp::FixedSizeCLDDPSolver<state_dim, control_dim>::registerSolver();
+
+    auto solver_clddp = makeClddpProblem();
+    auto start_time_clddp = std::chrono::high_resolution_clock::now();
+    cddp::CDDPSolution sol_clddp = solver_clddp->solve(cddp::SolverType::CLDDP);
+    auto end_time_clddp = std::chrono::high_resolution_clock::now();
+    auto solve_time_clddp = std::chrono::duration_cast<std::chrono::microseconds>(end_time_clddp - start_time_clddp).count();
+    double cost_clddp = std::any_cast<double>(sol_clddp.at("final_objective"));
+
+    auto solver_clddp_fixed = makeClddpProblem();
+    auto start_time_clddp_fixed = std::chrono::high_resolution_clock::now();
+    cddp::CDDPSolution sol_clddp_fixed = solver_clddp_fixed->solve(fixed_clddp_name);
+    auto end_time_clddp_fixed = std::chrono::high_resolution_clock::now();
+    auto solve_time_clddp_fixed = std::chrono::duration_cast<std::chrono::microseconds>(end_time_clddp_fixed - start_time_clddp_fixed).count();
+    double cost_clddp_fixed = std::any_cast<double>(sol_clddp_fixed.at("final_objective"));
+
+    std::cout << "CLDDP Optimal Cost: " << cost_clddp
+              << " (" << solve_time_clddp << " us)" << std::endl;
+    std::cout << "Fixed-size CLDDP Optimal Cost: " << cost_clddp_fixed
+              << " (" << solve_time_clddp_fixed << " us)" << std::endl;
+
     // --------------------------------------------------------
     // 5. Baseline #5 & #6: IPOPT and SNOPT (using CasADi)
     // --------------------------------------------------------
@@ -1166,6 +1215,11 @@ int main() {
               << " | " << std::setw(13) << solve_time_snopt_numeric << "\n";
     std::cout << "ACADOS    | " << std::setw(10) << cost_acados 
               << " | " << std::setw(13) << solve_time_acados_numeric << "\n";
+    std::cout << "----------|------------|---------------\n";
+    std::cout << "CLDDP     | " << std::setw(10) << cost_clddp
+              << " | " << std::setw(13) << solve_time_clddp / 1000000.0 << "\n";
+    std::cout << "CLDDP<3,2>| " << std::setw(10) << cost_clddp_fixed
+              << " | " << std::setw(13) << solve_time_clddp_fixed / 1000000.0 << "\n";
     std::cout << "========================================\n\n";
 
     return 0;
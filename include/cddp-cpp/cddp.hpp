@@ -23,17 +23,26 @@
 
 // #include "cddp-cpp/sdqp.hpp"
 #include "cddp_core/dynamical_system.hpp"
+#include "cddp_core/integrator.hpp"
+#include "cddp_core/templated_dynamical_system.hpp"
 #include "cddp_core/objective.hpp"
 #include "cddp_core/constraint.hpp"
 #include "cddp_core/barrier.hpp"
 #include "cddp_core/options.hpp"
 #include "cddp_core/cddp_core.hpp"
 #include "cddp_core/clddp_solver.hpp"
+#include "cddp_core/fixed_size_clddp_solver.hpp"
 #include "cddp_core/asddp_solver.hpp"
 #include "cddp_core/logddp_solver.hpp"
 #include "cddp_core/ipddp_solver.hpp"
 #include "cddp_core/msipddp_solver.hpp"
 #include "cddp_core/alddp_solver.hpp"
+#include "cddp_core/thread_pool.hpp"
+#include "cddp_core/cancellation.hpp"
+#include "cddp_core/trajectory.hpp"
+#include "cddp_core/solve_result.hpp"
+#include "cddp_core/mpc_controller.hpp"
+#include "cddp_core/batch_solver.hpp"
 #include "cddp_core/helper.hpp"
 #include "cddp_core/boxqp.hpp"
 #include "cddp_core/qp_solver.hpp"
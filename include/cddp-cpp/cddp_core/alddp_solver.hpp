@@ -45,13 +45,15 @@ public:
    */
   void initialize(CDDP &context) override;
 
+  using ISolverAlgorithm::solve;
+
   /**
-   * @brief Execute the ALDDP algorithm and return the solution.
+   * @brief Execute the ALDDP algorithm, writing into @p result.
    * @param context Reference to the CDDP instance containing problem data and
    * options.
-   * @return CDDPSolution containing the results.
+   * @param result Typed solution, overwritten in place.
    */
-  CDDPSolution solve(CDDP &context) override;
+  void solve(CDDP &context, SolveResult &result) override;
 
   /**
    * @brief Get the name of the solver algorithm.
@@ -67,18 +69,29 @@ private:
   // Dynamics storage
   std::vector<Eigen::VectorXd> F_; ///< Dynamics evaluations
 
-  // ALDDP-specific variables (constraint name -> time trajectory)
-  std::map<std::string, std::vector<Eigen::VectorXd>>
-      Y_; ///< Dual variables (Lagrange multipliers)
+  // Derivatives along the nominal trajectory, stacked per knot in the order
+  // of CDDP::getPathConstraintBlocks()
+  std::vector<Eigen::MatrixXd> A_;   ///< A = I + dt*F_x
+  std::vector<Eigen::MatrixXd> B_;   ///< B = dt*F_u
+  std::vector<Eigen::VectorXd> G_;   ///< Path constraint values g - ub
+  std::vector<Eigen::MatrixXd> G_x_; ///< Path constraint state Jacobians
+  std::vector<Eigen::MatrixXd> G_u_; ///< Path constraint control Jacobians
+  /// True while the derivatives above belong to the current X_/U_; cleared
+  /// whenever the nominal trajectory changes
+  bool derivatives_valid_ = false;
+
+  // ALDDP-specific variables, stacked over CDDP::getPathConstraintBlocks()
+  std::vector<Eigen::VectorXd>
+      Y_; ///< Dual variables (Lagrange multipliers), one stacked vector per knot
   std::vector<Eigen::VectorXd>
       Lambda_; ///< Lagrange multipliers for defect constraints
 
   // Penalty parameters (simplified for ALDDP)
   double
       rho_defect_; ///< Defect constraint penalty parameter (scalar, constant)
-  std::map<std::string, double>
-      rho_path_; ///< Path constraint penalty parameters (constraint name ->
-                 ///< scalar)
+  std::vector<double>
+      rho_path_; ///< Path constraint penalty parameters (one scalar per
+                 ///< constraint block)
 
   double cost_;                 ///< Current total cost
   double constraint_violation_; ///< Current constraint violation measure
@@ -93,6 +106,13 @@ private:
    */
   void evaluateTrajectory(CDDP &context);
 
+  /**
+   * @brief Evaluate dynamics and path constraint derivatives along the
+   * nominal trajectory.
+   * @param context Reference to the CDDP context.
+   */
+  void precomputeDerivatives(CDDP &context);
+
   /**
    * @brief Perform the backward pass (Riccati recursion with augmented
    * Lagrangian terms).
@@ -134,7 +154,7 @@ private:
    * @brief Print a summary of the final solution.
    * @param solution The solution to print.
    */
-  void printSolutionSummary(const CDDPSolution &solution) const;
+  void printSolutionSummary(const SolveResult &result) const;
 };
 
 } // namespace cddp
@@ -21,6 +21,8 @@
 #include "cddp_core/constraint.hpp"
 #include "osqp++.h"
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <memory>
 #include <vector>
 
 namespace cddp {
@@ -49,13 +51,15 @@ public:
    */
   void initialize(CDDP &context) override;
 
+  using ISolverAlgorithm::solve;
+
   /**
-   * @brief Execute the ASDDP algorithm and return the solution.
+   * @brief Execute the ASDDP algorithm, writing into @p result.
    * @param context Reference to the CDDP instance containing problem data and
    * options.
-   * @return CDDPSolution containing the results.
+   * @param result Typed solution, overwritten in place.
    */
-  CDDPSolution solve(CDDP &context) override;
+  void solve(CDDP &context, SolveResult &result) override;
 
   /**
    * @brief Get the name of the solver algorithm.
@@ -73,6 +77,56 @@ private:
   std::vector<Eigen::MatrixXd> Q_UU_; ///< Control Hessian matrices
   std::vector<Eigen::MatrixXd> Q_UX_; ///< Control-state cross-derivatives
   std::vector<Eigen::VectorXd> Q_U_;  ///< Control gradients
+  std::vector<Eigen::MatrixXd> F_u_;  ///< Discrete control Jacobians (dF/du)
+
+  // Forward-pass QPs. One OSQP solver per knot stays initialized across
+  // line-search steps and iterations; later solves only update the matrix
+  // values, the gradient and the bounds, and OSQP warm starts from the
+  // knot's previous primal/dual solution. P (upper triangle) and A are kept
+  // fully dense in sparse storage so their sparsity pattern never changes.
+  using SparseMatrix = Eigen::SparseMatrix<double, Eigen::ColMajor, osqp::c_int>;
+
+  /// QP data of one knot, sized in initialize()
+  struct KnotQP {
+    std::unique_ptr<osqp::OsqpSolver> solver;
+    SparseMatrix P;          ///< QP Hessian, upper triangle
+    SparseMatrix A;          ///< QP constraint matrix
+    Eigen::MatrixXd A_dense; ///< [I; dg/dx * F_u], rows of A
+    Eigen::VectorXd q;       ///< QP gradient
+    Eigen::VectorXd lb;      ///< Lower bounds
+    Eigen::VectorXd ub;      ///< Upper bounds
+  };
+
+  /// Per-knot QPs and scratch of one line-search step. The parallel line
+  /// search runs one step per alpha at once, so each alpha gets its own lane.
+  struct ForwardPassLane {
+    std::vector<KnotQP> knots;
+    Eigen::VectorXd delta_x; ///< x_t - xbar_t
+    Eigen::VectorXd x_next;  ///< Predicted next state
+    Eigen::VectorXd g;       ///< Linearized constraint values, stacked
+    Eigen::MatrixXd g_x;     ///< Their state Jacobians, stacked
+    Eigen::MatrixXd g_u;     ///< Their control Jacobians (unused by the QP)
+  };
+  std::vector<ForwardPassLane> lanes_;
+
+  /// A non-box path constraint linearized in the forward-pass QPs
+  struct QPConstraintRows {
+    const Constraint *constraint = nullptr; ///< Owned by the CDDP instance
+    int row = 0;           ///< First row in g and below the control rows in A
+    int dim = 0;           ///< Rows of evaluate()
+    Eigen::VectorXd upper; ///< getUpperBound(), read in initialize()
+  };
+  std::vector<QPConstraintRows> qp_constraints_;
+  int qp_constraint_rows_ = 0; ///< Sum of the dims in qp_constraints_
+  Eigen::VectorXd control_lower_; ///< Control box, read in initialize()
+  Eigen::VectorXd control_upper_;
+
+  /**
+   * @brief Size the forward-pass lanes and the QP layout for @p context.
+   *
+   * Knot solvers survive when their QP dimensions are unchanged.
+   */
+  void initializeForwardPassWorkspace(CDDP &context);
 
   /**
    * @brief Perform backward pass (Riccati recursion) with active set method.
@@ -93,9 +147,11 @@ private:
    * @brief Perform single forward pass with given step size using OSQP.
    * @param context Reference to the CDDP context.
    * @param alpha Step size for the forward pass.
+   * @param lane_index Index into lanes_ of the workspace to use.
    * @return Forward pass result.
    */
-  ForwardPassResult forwardPass(CDDP &context, double alpha);
+  ForwardPassResult forwardPass(CDDP &context, double alpha,
+                                size_t lane_index = 0);
 
   /**
    * @brief Compute the current cost given the trajectories.
@@ -120,7 +176,7 @@ private:
    * @brief Print solution summary.
    * @param solution The solution to print.
    */
-  void printSolutionSummary(const CDDPSolution &solution) const;
+  void printSolutionSummary(const SolveResult &result) const;
 };
 
 } // namespace cddp
@@ -0,0 +1,120 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef CDDP_BATCH_SOLVER_HPP
+#define CDDP_BATCH_SOLVER_HPP
+
+#include "cddp_core/cddp_core.hpp"
+#include "cddp_core/solve_result.hpp"
+#include "cddp_core/thread_pool.hpp"
+#include "cddp_core/trajectory.hpp"
+#include <Eigen/Dense>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cddp {
+
+/**
+ * @brief One instance of a batch: what differs from the problem template.
+ */
+struct BatchProblem {
+  Eigen::VectorXd initial_state;
+  /// Terminal reference; left unchanged if empty.
+  Eigen::VectorXd reference_state;
+  /// Reference states for knots 0..N; left unchanged if empty.
+  std::vector<Eigen::VectorXd> reference_states;
+  /// Optional initial guess; the template's initial trajectory if empty.
+  Trajectory initial_state_trajectory;
+  Trajectory initial_control_trajectory;
+};
+
+/**
+ * @brief Solves many independent instances of one problem in parallel.
+ *
+ * The problem template (dynamics, objective, constraints and options) is
+ * built by a factory once per worker, not once per instance. Each worker
+ * keeps its CDDP instance and solves the instances it picks up in turn, so
+ * models and trajectory buffers are reused across the batch.
+ *
+ * Every instance starts from the template's initial trajectory (or its own
+ * initial guess) with a freshly initialized solver, so results do not depend
+ * on how instances are scheduled across workers. Results are returned in
+ * the order of the input.
+ *
+ * Instances already run concurrently, so the template should normally keep
+ * options.enable_parallel off.
+ */
+class BatchSolver {
+public:
+  using ProblemFactory = std::function<std::unique_ptr<CDDP>()>;
+
+  /**
+   * @brief Construct a batch solver.
+   * @param factory Builds a fully configured problem; called once per worker.
+   * @param solver_type Solver used for every instance (e.g. "IPDDP").
+   * @param num_threads Number of workers; hardware concurrency if <= 0.
+   */
+  explicit BatchSolver(ProblemFactory factory,
+                       const std::string &solver_type = "IPDDP",
+                       int num_threads = 0);
+
+  /**
+   * @brief Solve all @p problems and return their results in order.
+   * @throws The first exception raised while solving an instance.
+   */
+  std::vector<SolveResult> solve(const std::vector<BatchProblem> &problems);
+
+  /**
+   * @brief Solve all @p problems into @p results, reusing its storage.
+   *
+   * @p results is resized to problems.size(); entry i receives the result of
+   * problems[i].
+   */
+  void solve(const std::vector<BatchProblem> &problems,
+             std::vector<SolveResult> &results);
+
+  /// Number of workers (and of problem instances built by the factory).
+  int getNumWorkers() const { return pool_.size(); }
+
+  const std::string &getSolverType() const { return solver_type_; }
+
+private:
+  struct Worker {
+    std::unique_ptr<CDDP> problem;
+    // Template values restored for instances that do not override them
+    Trajectory initial_state_trajectory;
+    Trajectory initial_control_trajectory;
+    Eigen::VectorXd reference_state;
+    std::vector<Eigen::VectorXd> reference_states;
+    bool reference_state_overridden = false;
+    bool reference_states_overridden = false;
+  };
+
+  void createWorkers(int count);
+  void solveOne(Worker &worker, const BatchProblem &problem,
+                SolveResult &result);
+
+  ProblemFactory factory_;
+  std::string solver_type_;
+  ThreadPool pool_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+} // namespace cddp
+
+#endif // CDDP_BATCH_SOLVER_HPP
@@ -18,7 +18,9 @@
 #define CDDP_BOXQP_HPP
 
 #include <Eigen/Dense>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace cddp {
 /**
@@ -67,6 +69,53 @@ struct BoxQPResult {
   int factorizations;                 ///< Number of matrix factorizations
 };
 
+/**
+ * @brief Reusable storage for BoxQPSolver::solve, holding the result of the
+ * last solve and the scratch vectors of the iteration.
+ *
+ * Sized once for a problem dimension; solving into the same workspace again
+ * does not allocate. A workspace also remembers which variables ended on a
+ * bound, and the next solve starts from that active set. Callers that solve
+ * a sequence of similar QPs (one per knot in DDP) keep one workspace per
+ * problem in the sequence.
+ */
+struct BoxQPWorkspace {
+  BoxQPWorkspace() = default;
+  explicit BoxQPWorkspace(int n) { resize(n); }
+
+  /// Allocate for dimension @p n; a no-op if already sized, otherwise the
+  /// stored active set is discarded.
+  void resize(int n);
+
+  // Result of the last solve
+  Eigen::VectorXd x;     ///< Solution vector
+  BoxQPStatus status = BoxQPStatus::MAX_ITER_EXCEEDED; ///< Result status
+  Eigen::VectorXi free;  ///< 1 for free variables, 0 for clamped ones
+  /// Factor of H with the rows and columns of clamped variables replaced by
+  /// those of the identity. Solving with a right-hand side that is zero in
+  /// the clamped rows gives the free-subspace solution, zero elsewhere.
+  Eigen::LDLT<Eigen::MatrixXd> Hfree;
+  double final_value = 0.0;     ///< Final objective value
+  double final_grad_norm = 0.0; ///< Final gradient norm
+  int iterations = 0;           ///< Number of iterations taken
+  int factorizations = 0;       ///< Number of matrix factorizations
+
+  /// -1 / +1 for variables that ended on their lower / upper bound, 0
+  /// otherwise; only meaningful when has_active_set is true
+  Eigen::VectorXi active_set;
+  bool has_active_set = false;
+
+  // Scratch
+  Eigen::VectorXd grad;         ///< Gradient g + Hx
+  Eigen::VectorXd grad_clamped; ///< g + H x restricted to clamped columns
+  Eigen::VectorXd search;       ///< Search direction
+  Eigen::VectorXd x_trial;      ///< Line search candidate
+  Eigen::VectorXd Hx;           ///< Product H x of the last evaluated point
+  Eigen::VectorXi clamped;      ///< 1 for clamped variables
+  Eigen::VectorXi old_clamped;  ///< Clamped set of the previous iteration
+  Eigen::MatrixXd H_free;       ///< Matrix factored into Hfree
+};
+
 /**
  * @brief Box-constrained Quadratic Programming solver
  *
@@ -95,6 +144,27 @@ public:
                     const Eigen::VectorXd &lower, const Eigen::VectorXd &upper,
                     const Eigen::VectorXd &x0 = Eigen::VectorXd());
 
+  /**
+   * @brief Solve a box-constrained QP problem into a reusable workspace
+   *
+   * Same iteration as solve() above, without allocating once @p ws has been
+   * sized for the problem. Variables that ended on a bound in the previous
+   * solve with @p ws are moved back onto that bound before the first
+   * iteration, so an unchanged active set is found by the first
+   * factorization.
+   *
+   * @param H Quadratic term (must be positive definite)
+   * @param g Linear term
+   * @param lower Lower bounds
+   * @param upper Upper bounds
+   * @param x0 Initial guess (empty for the midpoint of the bounds)
+   * @param ws Workspace receiving the solution, status and factorization
+   * @return Result status, also stored in ws.status
+   */
+  BoxQPStatus solve(const Eigen::MatrixXd &H, const Eigen::VectorXd &g,
+                    const Eigen::VectorXd &lower, const Eigen::VectorXd &upper,
+                    const Eigen::VectorXd &x0, BoxQPWorkspace &ws);
+
   /**
    * @brief Get the current solver options
    * @return const reference to current options
@@ -111,56 +181,280 @@ private:
   BoxQPOptions options_; ///< Solver configuration options
 
   /**
-   * @brief Initialize the state vector x
+   * @brief Initialize ws.x from x0 (or the bounds) and the active set of
+   * the previous solve
    * @param x0 Initial guess (if provided)
    * @param lower Lower bounds
    * @param upper Upper bounds
-   * @param n Problem dimension
-   * @return Initialized and bound-feasible x vector
+   * @param ws Workspace, sized for the problem
    */
-  Eigen::VectorXd initializeX(const Eigen::VectorXd &x0,
-                              const Eigen::VectorXd &lower,
-                              const Eigen::VectorXd &upper, int n);
+  void initializeX(const Eigen::VectorXd &x0, const Eigen::VectorXd &lower,
+                   const Eigen::VectorXd &upper, BoxQPWorkspace &ws) const;
 
   /**
-   * @brief Perform line search with Armijo condition
-   * @param x Current point
-   * @param search Search direction
-   * @param gradient Current gradient
-   * @param value Current objective value
+   * @brief Projected line search along ws.search with Armijo condition
    * @param H Quadratic term
    * @param g Linear term
    * @param lower Lower bounds
    * @param upper Upper bounds
-   * @return std::pair<bool, std::pair<double, Eigen::VectorXd>> Success flag,
-   * step size, and new point
+   * @param value Objective value at ws.x
+   * @param sdotg Directional derivative along ws.search
+   * @param ws Workspace; the accepted point is left in ws.x_trial
+   * @param step Accepted step size
+   * @param value_new Objective value at the accepted point
+   * @return True if a step satisfying the Armijo condition was found
    */
-  std::pair<bool, std::pair<double, Eigen::VectorXd>>
-  lineSearch(const Eigen::VectorXd &x, const Eigen::VectorXd &search,
-             const Eigen::VectorXd &gradient, double value,
-             const Eigen::MatrixXd &H, const Eigen::VectorXd &g,
-             const Eigen::VectorXd &lower, const Eigen::VectorXd &upper);
+  bool lineSearch(const Eigen::MatrixXd &H, const Eigen::VectorXd &g,
+                  const Eigen::VectorXd &lower, const Eigen::VectorXd &upper,
+                  double value, double sdotg, BoxQPWorkspace &ws, double &step,
+                  double &value_new) const;
 
   /**
    * @brief Evaluate the objective function value
    * @param x Point to evaluate
    * @param H Quadratic term
    * @param g Linear term
+   * @param Hx Receives H * x
    * @return Objective value
    */
   double evaluateObjective(const Eigen::VectorXd &x, const Eigen::MatrixXd &H,
-                           const Eigen::VectorXd &g) const;
+                           const Eigen::VectorXd &g,
+                           Eigen::VectorXd &Hx) const;
+};
+
+/// Largest control dimension for which solvers with compile-time sizes use
+/// BoxQPSolverFixed instead of the dynamic-size BoxQPSolver.
+constexpr int kMaxFixedBoxQPDim = 6;
+
+/**
+ * @brief BoxQPSolver for a compile-time dimension M
+ *
+ * Runs the same projected-Newton iteration as BoxQPSolver (same options,
+ * statuses and active-set warm start) on fixed-size types. The free-subspace
+ * Hessian is factored by a Cholesky with compile-time loop bounds, the free
+ * and clamped sets are masks applied by multiplication, and the projection
+ * is a coefficient-wise min/max, so nothing allocates and the small loops
+ * unroll. Meant for M up to kMaxFixedBoxQPDim.
+ *
+ * @tparam M Problem dimension.
+ */
+template <int M> class BoxQPSolverFixed {
+public:
+  static_assert(M > 0, "BoxQPSolverFixed needs a positive dimension");
+
+  using Vector = Eigen::Matrix<double, M, 1>;
+  using Matrix = Eigen::Matrix<double, M, M>;
+  using IndexVector = Eigen::Matrix<int, M, 1>;
+
+  /// Result of a solve and the warm start for the next one, as in
+  /// BoxQPWorkspace.
+  struct Workspace {
+    Vector x = Vector::Zero(); ///< Solution vector
+    BoxQPStatus status = BoxQPStatus::MAX_ITER_EXCEEDED; ///< Result status
+    IndexVector free = IndexVector::Ones(); ///< 1 for free variables
+    /// Lower Cholesky factor of H with the rows and columns of clamped
+    /// variables replaced by those of the identity; see solveFree()
+    Matrix L = Matrix::Identity();
+    double final_value = 0.0;     ///< Final objective value
+    double final_grad_norm = 0.0; ///< Final gradient norm
+    int iterations = 0;           ///< Number of iterations taken
+    int factorizations = 0;       ///< Number of matrix factorizations
+
+    /// -1 / +1 for variables that ended on their lower / upper bound
+    IndexVector active_set = IndexVector::Zero();
+    bool has_active_set = false;
+
+    /**
+     * @brief Solve the free-subspace system in place: B <- H_free^{-1} B
+     *
+     * Rows of @p B belonging to clamped variables must be zero on entry and
+     * stay zero.
+     */
+    template <typename Derived>
+    void solveFree(Eigen::MatrixBase<Derived> &B) const {
+      for (int c = 0; c < B.cols(); ++c) {
+        for (int i = 0; i < M; ++i) {
+          double s = B(i, c);
+          for (int k = 0; k < i; ++k)
+            s -= L(i, k) * B(k, c);
+          B(i, c) = s / L(i, i);
+        }
+        for (int i = M - 1; i >= 0; --i) {
+          double s = B(i, c);
+          for (int k = i + 1; k < M; ++k)
+            s -= L(k, i) * B(k, c);
+          B(i, c) = s / L(i, i);
+        }
+      }
+    }
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  explicit BoxQPSolverFixed(const BoxQPOptions &options = BoxQPOptions())
+      : options_(options) {}
+
+  const BoxQPOptions &getOptions() const { return options_; }
+  void setOptions(const BoxQPOptions &options) { options_ = options; }
 
   /**
-   * @brief Project a point onto the box constraints
-   * @param x Point to project
+   * @brief Solve min 0.5 x'Hx + g'x s.t. lower <= x <= upper into @p ws
+   *
+   * @param H Quadratic term (must be positive definite)
+   * @param g Linear term
    * @param lower Lower bounds
    * @param upper Upper bounds
-   * @return Projected point
+   * @param x0 Initial guess, projected onto the bounds
+   * @param ws Result, also the active-set warm start of the next solve
+   * @return Result status, also stored in ws.status
+   */
+  BoxQPStatus solve(const Matrix &H, const Vector &g, const Vector &lower,
+                    const Vector &upper, const Vector &x0,
+                    Workspace &ws) const {
+    using Array = Eigen::Array<double, M, 1>;
+
+    ws.status = BoxQPStatus::MAX_ITER_EXCEEDED;
+    ws.iterations = 0;
+    ws.factorizations = 0;
+    ws.final_grad_norm = 0.0;
+
+    // Initial point, with the previous active set put back on its bounds
+    Vector x = x0.cwiseMax(lower).cwiseMin(upper);
+    if (ws.has_active_set) {
+      const auto on_lower =
+          (ws.active_set.array() < 0) && lower.array().isFinite();
+      const auto on_upper =
+          (ws.active_set.array() > 0) && upper.array().isFinite();
+      x = on_lower.select(lower, x);
+      x = on_upper.select(upper, x);
+    }
+
+    Vector Hx = H * x;
+    double value = 0.5 * x.dot(Hx) + g.dot(x);
+    double old_value = std::numeric_limits<double>::infinity();
+
+    // 1 for free, 0 for clamped variables
+    Array free_mask = Array::Ones();
+    Vector grad, rhs, search, x_trial;
+
+    for (int iter = 0; iter < options_.max_iterations; ++iter) {
+      ws.iterations = iter + 1;
+
+      if (iter > 0 &&
+          std::abs(old_value - value) <
+              options_.min_relative_improvement * std::abs(old_value)) {
+        ws.status = BoxQPStatus::SUCCESS;
+        break;
+      }
+      old_value = value;
+
+      grad = g + Hx;
+
+      // Update clamped set
+      const Array old_mask = free_mask;
+      const auto clamped =
+          ((x.array() == lower.array()) && (grad.array() > 0.0)) ||
+          ((x.array() == upper.array()) && (grad.array() < 0.0));
+      free_mask = clamped.select(Array::Zero(), Array::Ones());
+      ws.free = free_mask.template cast<int>().matrix();
+
+      if (free_mask.sum() == 0.0) {
+        ws.status = BoxQPStatus::ALL_CLAMPED;
+        break;
+      }
+
+      // Factorize if clamped set changed
+      if (iter == 0 || (old_mask != free_mask).any()) {
+        Matrix H_free = H.cwiseProduct(free_mask.matrix() *
+                                       free_mask.matrix().transpose());
+        H_free.diagonal() += (1.0 - free_mask).matrix();
+        if (!factorize(H_free, ws.L)) {
+          ws.status = BoxQPStatus::HESSIAN_NOT_PD;
+          break;
+        }
+        ws.factorizations++;
+      }
+
+      const double grad_norm = (grad.array() * free_mask).matrix().norm();
+      ws.final_grad_norm = grad_norm;
+      if (grad_norm < options_.min_gradient_norm) {
+        ws.status = BoxQPStatus::SUCCESS;
+        break;
+      }
+
+      // Newton step on the free variables with the clamped ones held fixed
+      rhs = -(g + H * (x.array() * (1.0 - free_mask)).matrix());
+      rhs.array() *= free_mask;
+      ws.solveFree(rhs);
+      search = ((rhs - x).array() * free_mask).matrix();
+
+      const double sdotg = search.dot(grad);
+      if (sdotg >= 0) {
+        ws.status = BoxQPStatus::NO_DESCENT;
+        break;
+      }
+
+      // Projected Armijo line search
+      double step = 1.0;
+      bool accepted = false;
+      while (step > options_.min_step_size) {
+        x_trial = (x + step * search).cwiseMax(lower).cwiseMin(upper);
+        const Vector Hx_trial = H * x_trial;
+        const double value_new = 0.5 * x_trial.dot(Hx_trial) + g.dot(x_trial);
+        if ((value_new - value) <= options_.armijo_constant * step * sdotg) {
+          x = x_trial;
+          Hx = Hx_trial;
+          value = value_new;
+          accepted = true;
+          break;
+        }
+        step *= options_.step_decrease_factor;
+      }
+      if (!accepted) {
+        ws.status = BoxQPStatus::MAX_LS_EXCEEDED;
+        break;
+      }
+    }
+
+    ws.x = x;
+    ws.final_value = value;
+    ws.active_set =
+        (x.array() == lower.array())
+            .select(IndexVector::Constant(-1).array(),
+                    (x.array() == upper.array())
+                        .select(IndexVector::Ones().array(),
+                                IndexVector::Zero().array()))
+            .matrix();
+    ws.has_active_set = true;
+    return ws.status;
+  }
+
+  /**
+   * @brief Cholesky factorization A = L L' with compile-time loop bounds
+   * @return False if A is not (numerically) positive definite
    */
-  Eigen::VectorXd projectOntoBox(const Eigen::VectorXd &x,
-                                 const Eigen::VectorXd &lower,
-                                 const Eigen::VectorXd &upper) const;
+  static bool factorize(const Matrix &A, Matrix &L) {
+    L.setZero();
+    for (int j = 0; j < M; ++j) {
+      double d = A(j, j);
+      for (int k = 0; k < j; ++k)
+        d -= L(j, k) * L(j, k);
+      if (!(d > 0.0)) // also rejects NaN
+        return false;
+      const double l_jj = std::sqrt(d);
+      L(j, j) = l_jj;
+      for (int i = j + 1; i < M; ++i) {
+        double s = A(i, j);
+        for (int k = 0; k < j; ++k)
+          s -= L(i, k) * L(j, k);
+        L(i, j) = s / l_jj;
+      }
+    }
+    return true;
+  }
+
+private:
+  BoxQPOptions options_;
 };
 
 } // namespace cddp
@@ -0,0 +1,52 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef CDDP_CANCELLATION_HPP
+#define CDDP_CANCELLATION_HPP
+
+#include <atomic>
+#include <memory>
+
+namespace cddp {
+
+/**
+ * @brief Shared flag used to stop a running solve from another thread.
+ *
+ * Copies refer to the same flag: the caller keeps one copy and hands another
+ * to CDDP::solveAsync() (or CDDP::setCancellationToken()). Solvers poll the
+ * flag between iterations, per knot in the backward pass and between line
+ * search trials, and return the last accepted iterate with the status
+ * "Cancelled".
+ */
+class CancellationToken {
+public:
+  CancellationToken() : cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+  /// Request cancellation; safe to call from any thread.
+  void cancel() const { cancelled_->store(true, std::memory_order_relaxed); }
+
+  /// True once cancel() has been called on any copy.
+  bool isCancelled() const {
+    return cancelled_->load(std::memory_order_relaxed);
+  }
+
+private:
+  std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+} // namespace cddp
+
+#endif // CDDP_CANCELLATION_HPP
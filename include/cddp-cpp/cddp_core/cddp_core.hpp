@@ -17,6 +17,7 @@
 #define CDDP_CDDP_CORE_HPP
 
 #include <Eigen/Dense>
+#include <algorithm> // For std::rotate
 #include <any> // For std::any
 #include <future>
 #include <iomanip>  // For std::setw
@@ -25,6 +26,7 @@
 #include <memory>   // For std::unique_ptr
 #include <optional> // For std::optional
 #include <regex>
+#include <stdexcept>
 #include <string> // For std::string
 #include <thread>
 #include <vector>
@@ -32,10 +34,14 @@
 
 #include "cddp_core/barrier.hpp"
 #include "cddp_core/boxqp.hpp"
+#include "cddp_core/cancellation.hpp"
 #include "cddp_core/constraint.hpp"
 #include "cddp_core/dynamical_system.hpp"
 #include "cddp_core/objective.hpp"
 #include "cddp_core/options.hpp"
+#include "cddp_core/solve_result.hpp"
+#include "cddp_core/thread_pool.hpp"
+#include "cddp_core/trajectory.hpp"
 
 namespace cddp {
 
@@ -60,6 +66,9 @@ enum class SolverType {
  * `std::out_of_range`. Handle `std::bad_any_cast` for type mismatches. Optional
  * keys are present only if computed by the specific solver.
  *
+ * SolveResult holds the same data with typed members and can be reused
+ * across solves; see CDDP::solve(const std::string &, SolveResult &).
+ *
  * --- General Information ---
  * - "solver_name":                   std::string (Name of the solver used,
  * e.g., "IPDDP")
@@ -70,7 +79,10 @@ enum class SolverType {
  * "MaxCpuTimeReached" - Exceeded maximum CPU time limit •
  * "RegularizationLimitReached_Converged" - Reached regularization limit but
  * solution acceptable • "RegularizationLimitReached_NotConverged" - Reached
- * regularization limit, solution not acceptable
+ * regularization limit, solution not acceptable • "Cancelled" - Stopped
+ * through a CancellationToken • "RealTimeIterationCompleted" - One real-time
+ * iteration (CDDP::feedback()) completed • "ForwardPassFailed_NotConverged" -
+ * The real-time iteration rollout diverged; the nominal trajectory is kept
  * - "iterations_completed":          int (Number of iterations)
  * - "solve_time_ms":                 double (Total solver time in milliseconds)
  * - "final_objective":               double (Final objective cost J(x,u))
@@ -123,10 +135,29 @@ enum class SolverType {
  */
 using CDDPSolution = std::map<std::string, std::any>;
 
+/**
+ * @brief Convert a typed result into the string-keyed solution map.
+ *
+ * Optional metrics and history series are added only if the solver set them.
+ * The rvalue overload moves the time points and feedback gains instead of
+ * copying them.
+ */
+CDDPSolution toSolution(const SolveResult &result);
+CDDPSolution toSolution(SolveResult &&result);
+
+/**
+ * @brief Fill a typed result from a solution map, e.g. one produced by an
+ * external solver that only implements the map-based interface.
+ *
+ * Keys that are missing or hold an unexpected type are left at their
+ * defaults; keys unknown to SolveResult are ignored.
+ */
+void fromSolution(const CDDPSolution &solution, SolveResult &result);
+
 struct ForwardPassResult {
   // Core trajectories always computed in a forward pass
-  std::vector<Eigen::VectorXd> state_trajectory;
-  std::vector<Eigen::VectorXd> control_trajectory;
+  Trajectory state_trajectory;
+  Trajectory control_trajectory;
 
   // Cost and merit function values
   double cost = 0.0;
@@ -145,12 +176,11 @@ struct ForwardPassResult {
   // pass
   std::optional<std::vector<Eigen::VectorXd>> dynamics_trajectory;
   std::optional<std::vector<Eigen::VectorXd>> costate_trajectory;
-  std::optional<std::map<std::string, std::vector<Eigen::VectorXd>>>
-      dual_trajectory;
-  std::optional<std::map<std::string, std::vector<Eigen::VectorXd>>>
-      slack_trajectory;
-  std::optional<std::map<std::string, std::vector<Eigen::VectorXd>>>
-      constraint_eval_trajectory;
+  // Path-constraint quantities, one stacked vector per knot laid out as in
+  // CDDP::getPathConstraintBlocks()
+  std::optional<std::vector<Eigen::VectorXd>> dual_trajectory;
+  std::optional<std::vector<Eigen::VectorXd>> slack_trajectory;
+  std::optional<std::vector<Eigen::VectorXd>> constraint_eval_trajectory;
   std::optional<std::map<std::string, Eigen::VectorXd>>
       terminal_constraint_dual;
   std::optional<std::map<std::string, Eigen::VectorXd>>
@@ -214,17 +244,114 @@ public:
 
   /**
    * @brief Execute the solver algorithm and return the solution.
+   *
+   * Implementations override this overload, the typed one below, or both.
+   * The default converts the typed result with toSolution().
    * @param context Reference to the CDDP instance containing problem data and
    * options.
    * @return CDDPSolution containing the results.
    */
-  virtual CDDPSolution solve(CDDP &context) = 0;
+  virtual CDDPSolution solve(CDDP &context) {
+    SolveResult result;
+    solve(context, result);
+    return toSolution(std::move(result));
+  }
+
+  /**
+   * @brief Execute the solver algorithm, writing into @p result.
+   *
+   * @p result may hold the result of a previous solve; implementations
+   * overwrite it in place so that its buffers are reused. The default
+   * forwards to the map-based overload and converts with fromSolution().
+   * @param context Reference to the CDDP instance containing problem data and
+   * options.
+   * @param result Typed solution, overwritten.
+   */
+  virtual void solve(CDDP &context, SolveResult &result) {
+    fromSolution(solve(context), result);
+  }
 
   /**
    * @brief Get the name of the solver algorithm.
    * @return String identifier for this solver type.
    */
   virtual std::string getSolverName() const = 0;
+
+  /**
+   * @brief Shift the solver's internal per-knot state forward in time.
+   *
+   * Called by CDDP::shiftTrajectory() in receding-horizon loops so that
+   * gains, duals and slacks line up with the shifted nominal trajectory on
+   * the next warm-started solve. The default implementation does nothing.
+   * @param context Reference to the CDDP instance.
+   * @param steps Number of knots to shift by.
+   */
+  virtual void shift(CDDP &context, int steps) {}
+
+  /**
+   * @brief Real-time iteration, preparation phase.
+   *
+   * Performs the part of one iteration that does not depend on the next
+   * measured state: linearizes around the current (typically shifted)
+   * nominal trajectory and runs the backward pass. Called by CDDP::prepare().
+   * The default implementation throws std::runtime_error.
+   * @param context Reference to the CDDP instance.
+   */
+  virtual void prepare(CDDP &context) {
+    throw std::runtime_error(getSolverName() +
+                             " does not support real-time iteration");
+  }
+
+  /**
+   * @brief Real-time iteration, feedback phase.
+   *
+   * Rolls out the control law computed by prepare() from
+   * context.getInitialState() with a single forward pass and updates the
+   * nominal trajectory. Called by CDDP::feedback(). The default
+   * implementation throws std::runtime_error.
+   * @param context Reference to the CDDP instance.
+   * @param result Typed solution, overwritten.
+   */
+  virtual void feedback(CDDP &context, SolveResult &result) {
+    throw std::runtime_error(getSolverName() +
+                             " does not support real-time iteration");
+  }
+};
+
+/**
+ * @brief Shift a per-knot buffer forward by @p steps knots in place.
+ *
+ * Elements are rotated towards the front and the vacated tail is filled with
+ * copies of the last valid entry. No storage is (re)allocated when the
+ * element sizes are unchanged.
+ */
+template <typename T, typename Alloc>
+void shiftTrajectory(std::vector<T, Alloc> &trajectory, int steps) {
+  const int n = static_cast<int>(trajectory.size());
+  if (n == 0 || steps <= 0) {
+    return;
+  }
+  const int s = std::min(steps, n - 1);
+  std::rotate(trajectory.begin(), trajectory.begin() + s, trajectory.end());
+  for (int i = n - s; i < n; ++i) {
+    trajectory[i] = trajectory[n - s - 1];
+  }
+}
+
+/**
+ * @brief Location of one constraint inside a stacked constraint vector.
+ *
+ * Solvers that keep duals, slacks or constraint values for all constraints of
+ * a knot in one vector use these blocks instead of walking the string-keyed
+ * constraint set.
+ */
+struct ConstraintBlock {
+  std::string name;                 ///< Name the constraint was added under
+  Constraint *constraint = nullptr; ///< Non-owning; owned by the CDDP instance
+  int offset = 0;                   ///< First row in the stacked vector
+  int dim = 0;                      ///< Number of rows (dual dimension)
+  int value_dim = 0;                ///< Rows of evaluate(); dim / 2 for box
+                                    ///< constraints, which use both bounds
 };
 
 class CDDP {
@@ -253,6 +380,16 @@ public:
   int getControlDim() const;
   int getTotalDualDim() const;
   const CDDPOptions &getOptions() const { return options_; }
+
+  /**
+   * @brief Worker pool shared by all solver strategies for parallel work.
+   *
+   * Created on first use with options.num_threads workers and kept for the
+   * lifetime of this CDDP instance; it is rebuilt only if num_threads
+   * changes.
+   * @return Reference to the thread pool.
+   */
+  ThreadPool &getThreadPool();
   const std::map<std::string, std::unique_ptr<Constraint>> &
   getConstraintSet() const {
     return path_constraint_set_;
@@ -262,6 +399,55 @@ public:
     return terminal_constraint_set_;
   }
 
+  /**
+   * @brief Index-based table of the path constraints.
+   *
+   * Blocks follow the iteration order of getConstraintSet() and are stacked
+   * without gaps: block i occupies rows [offset, offset + dim) of a vector of
+   * size getPathDualDim(). Rebuilt whenever the constraint set changes and
+   * when the problem is initialized.
+   */
+  const std::vector<ConstraintBlock> &getPathConstraintBlocks() const {
+    return path_constraint_blocks_;
+  }
+  /// Total dual dimension of all path constraints.
+  int getPathDualDim() const { return path_dual_dim_; }
+
+  /**
+   * @brief Evaluate all path constraints into one stacked vector.
+   *
+   * Block i of @p g is set to evaluate(x, u) - getUpperBound() of the i-th
+   * path constraint, so feasibility is g <= 0. Box constraints, whose dual
+   * dimension counts both bounds, get [lb - g; g - ub] in the layout of
+   * ControlConstraint. Bounds are those read when the blocks were last
+   * compiled, i.e. at the start of the current solve.
+   * @param g Output of size getPathDualDim() (resized if necessary).
+   */
+  void evaluatePathConstraints(const Eigen::VectorXd &state,
+                               const Eigen::VectorXd &control,
+                               Eigen::VectorXd &g) const;
+
+  /**
+   * @brief Jacobians of @p block's rows of evaluatePathConstraints().
+   * @param g_x Output (block.dim x state_dim), e.g. a middleRows() view.
+   * @param g_u Output (block.dim x control_dim).
+   */
+  void evaluatePathConstraintJacobians(const ConstraintBlock &block,
+                                       const Eigen::VectorXd &state,
+                                       const Eigen::VectorXd &control,
+                                       Eigen::Ref<Eigen::MatrixXd> g_x,
+                                       Eigen::Ref<Eigen::MatrixXd> g_u) const;
+
+  /**
+   * @brief Index-based table of the terminal constraints.
+   * @see getPathConstraintBlocks()
+   */
+  const std::vector<ConstraintBlock> &getTerminalConstraintBlocks() const {
+    return terminal_constraint_blocks_;
+  }
+  /// Total dual dimension of all terminal constraints.
+  int getTerminalDualDim() const { return terminal_dual_dim_; }
+
   // Setters for problem definition
   void setDynamicalSystem(std::unique_ptr<DynamicalSystem> system);
   void setInitialState(const Eigen::VectorXd &initial_state);
@@ -273,6 +459,7 @@ public:
   void setObjective(std::unique_ptr<Objective> objective);
   void setInitialTrajectory(const std::vector<Eigen::VectorXd> &X,
                             const std::vector<Eigen::VectorXd> &U);
+  void setInitialTrajectory(const Trajectory &X, const Trajectory &U);
   void addPathConstraint(std::string constraint_name,
                          std::unique_ptr<Constraint> constraint);
   void addTerminalConstraint(std::string constraint_name,
@@ -314,6 +501,152 @@ public:
    */
   CDDPSolution solve(const std::string &solver_type);
 
+  /**
+   * @brief Solves the optimal control problem into a typed result.
+   *
+   * Unlike the map-returning overloads, @p result is overwritten in place:
+   * passing the same SolveResult on every call (e.g. once per MPC tick)
+   * reuses its trajectory and gain storage.
+   * @param solver_type Enum identifying the solver algorithm to use.
+   * @param result Typed solution, overwritten.
+   */
+  void solve(SolverType solver_type, SolveResult &result);
+
+  /**
+   * @brief Solves the optimal control problem into a typed result.
+   * @param solver_type A string identifying the solver algorithm to use.
+   * @param result Typed solution, overwritten.
+   */
+  void solve(const std::string &solver_type, SolveResult &result);
+
+  /**
+   * @brief Shift the nominal trajectory and solver state forward in time.
+   *
+   * Intended for receding-horizon (MPC) use: X_ and U_ are advanced by
+   * @p steps knots, the last control is held and the tail states are
+   * propagated through the dynamics. The active solver, if any, shifts its
+   * own per-knot state. Existing buffers are reused.
+   * @param steps Number of knots to shift by.
+   */
+  void shiftTrajectory(int steps = 1);
+
+  /**
+   * @brief Drop the warm-start state so the next solve starts cold.
+   *
+   * The problem is re-initialized and a new solver is created on the next
+   * solve() or prepare(), even with options.warm_start set. A pending
+   * prepare() is discarded. X_ and U_ are kept as the initial guess.
+   */
+  void resetWarmStart();
+
+  // --- Real-Time Iteration ---
+  /**
+   * @brief Preparation phase of a real-time iteration (RTI).
+   *
+   * One RTI performs a single backward pass and a single forward pass, split
+   * so that the expensive part runs before the next measurement is known:
+   *
+   * @code
+   *   problem.shiftTrajectory();          // previous solution, advanced
+   *   problem.prepare(SolverType::IPDDP); // derivatives + backward pass
+   *   // ... wait for the measurement ...
+   *   problem.feedback(x_measured, result); // one forward pass
+   * @endcode
+   *
+   * The solver is selected (and initialized) as in solve(); with
+   * options.warm_start set it is kept across calls together with its gains,
+   * duals and slacks. Only solvers that implement ISolverAlgorithm::prepare()
+   * (currently CLDDP and IPDDP) support RTI.
+   * @param solver_type Solver to prepare.
+   * @throws std::runtime_error If the solver is unknown or does not support
+   * real-time iteration.
+   */
+  void prepare(SolverType solver_type);
+
+  /**
+   * @brief Preparation phase of a real-time iteration (string version).
+   * @param solver_type A string identifying the solver algorithm to use.
+   */
+  void prepare(const std::string &solver_type);
+
+  /**
+   * @brief Feedback phase of a real-time iteration.
+   *
+   * Sets the initial state to @p initial_state and rolls out the control law
+   * computed by the last prepare(), so the deviation from the linearization
+   * point is corrected by the feedback gains. The nominal trajectory is
+   * replaced by the rollout, ready to be shifted for the next iteration. A
+   * rollout with a non-finite cost, state or control is rejected and the
+   * nominal trajectory kept.
+   * @param initial_state Measured state.
+   * @param result Typed solution, overwritten in place.
+   * @throws std::runtime_error If prepare() has not been called since the
+   * last feedback() or solve().
+   */
+  void feedback(const Eigen::VectorXd &initial_state, SolveResult &result);
+
+  // --- Asynchronous Solve and Monitoring ---
+  /**
+   * @brief Per-iteration callback.
+   *
+   * Receives the context itself, so the current iterate (X_, U_, cost_,
+   * inf_pr_, ...) is read in place without copies. It runs on the solving
+   * thread after every accepted step and must not modify the problem.
+   */
+  using IterationCallback =
+      std::function<void(const CDDP &context, int iteration)>;
+
+  /**
+   * @brief Set (or clear, with an empty function) the iteration callback.
+   */
+  void setIterationCallback(IterationCallback callback);
+
+  /**
+   * @brief Set the token polled by synchronous solves.
+   *
+   * Cancelling @p token from another thread stops the running solve, which
+   * returns the last accepted iterate with the status "Cancelled".
+   */
+  void setCancellationToken(const CancellationToken &token);
+
+  /// True if the token of the running solve has been cancelled.
+  bool isCancellationRequested() const {
+    return cancellation_token_.isCancelled();
+  }
+
+  /// Invoke the iteration callback, if any; called by the solvers after
+  /// each accepted step.
+  void notifyIteration(int iteration) const {
+    if (iteration_callback_) {
+      iteration_callback_(*this, iteration);
+    }
+  }
+
+  /**
+   * @brief Solve on a separate thread.
+   *
+   * @p token is polled by the solver for the duration of this solve; keep a
+   * copy and call cancel() on it to stop early, e.g. when the problem has
+   * become stale. The problem must not be accessed or modified until the
+   * future is ready (the iteration callback runs on the solving thread).
+   * As with std::async, destroying the future waits for the solve.
+   * @param solver_type Enum identifying the solver algorithm to use.
+   * @param token Cancellation token for this solve.
+   * @return Future holding the typed solution.
+   */
+  std::future<SolveResult>
+  solveAsync(SolverType solver_type,
+             CancellationToken token = CancellationToken());
+
+  /**
+   * @brief Solve on a separate thread (string version).
+   * @param solver_type A string identifying the solver algorithm to use.
+   * @param token Cancellation token for this solve.
+   */
+  std::future<SolveResult>
+  solveAsync(const std::string &solver_type,
+             CancellationToken token = CancellationToken());
+
   // --- External Solver Registration ---
   /**
    * @brief Register an external solver factory function
@@ -338,8 +671,8 @@ public:
 
   // --- Public members for strategy access (or provide getters/setters) ---
   // These are the core iterative variables shared across solver strategies.
-  std::vector<Eigen::VectorXd> X_; ///< State trajectory (nominal)
-  std::vector<Eigen::VectorXd> U_; ///< Control trajectory (nominal)
+  Trajectory X_; ///< State trajectory (nominal), contiguous knots
+  Trajectory U_; ///< Control trajectory (nominal), contiguous knots
   double cost_;                    ///< Current total cost
   double merit_function_;          ///< Merit function value
   double inf_pr_; ///< Current primal infeasibility (constraint violation norm)
@@ -450,13 +783,35 @@ private:
 
   int total_dual_dim_ = 0;
 
+  // Flattened constraint tables (see getPathConstraintBlocks())
+  std::vector<ConstraintBlock> path_constraint_blocks_;
+  std::vector<ConstraintBlock> terminal_constraint_blocks_;
+  Eigen::VectorXd path_upper_bound_; // Stacked upper bounds of the path blocks
+  int path_dual_dim_ = 0;
+  int terminal_dual_dim_ = 0;
+
   // Strategy pattern for different solver algorithms
   std::unique_ptr<ISolverAlgorithm> solver_;
+  std::string solver_type_; ///< Name the current solver_ was created with
+  bool rti_prepared_ = false; ///< prepare() ran since the last feedback/solve
+
+  IterationCallback iteration_callback_;
+  CancellationToken cancellation_token_;
+
+  // Persistent worker pool for parallel line search / derivative evaluation
+  std::unique_ptr<ThreadPool> thread_pool_;
 
   // Static registry for external solvers
   static std::map<std::string, std::function<std::unique_ptr<ISolverAlgorithm>()>> external_solver_registry_;
 
   void initializeProblemIfNecessary();
+  void compileConstraintTables();
+
+  /**
+   * @brief Select (or keep) the solver for @p solver_type and initialize it.
+   * @return False, with @p unknown filled in, if no such solver exists.
+   */
+  bool prepareSolver(const std::string &solver_type, SolveResult &unknown);
 };
 
 } // namespace cddp
@@ -45,13 +45,15 @@ public:
    */
   void initialize(CDDP &context) override;
 
+  using ISolverAlgorithm::solve;
+
   /**
-   * @brief Execute the CLDDP algorithm and return the solution.
+   * @brief Execute the CLDDP algorithm, writing into @p result.
    * @param context Reference to the CDDP instance containing problem data and
    * options.
-   * @return CDDPSolution containing the results.
+   * @param result Typed solution, overwritten in place.
    */
-  CDDPSolution solve(CDDP &context) override;
+  void solve(CDDP &context, SolveResult &result) override;
 
   /**
    * @brief Get the name of the solver algorithm.
@@ -59,14 +61,82 @@ public:
    */
   std::string getSolverName() const override;
 
+  /**
+   * @brief Shift the control gains forward for a receding-horizon re-solve.
+   * @param context Reference to the CDDP context.
+   * @param steps Number of knots to shift by.
+   */
+  void shift(CDDP &context, int steps) override;
+
+  /**
+   * @brief Real-time iteration: backward pass around the nominal trajectory.
+   * @param context Reference to the CDDP context.
+   */
+  void prepare(CDDP &context) override;
+
+  /**
+   * @brief Real-time iteration: full-step forward pass from the new initial
+   * state.
+   * @param context Reference to the CDDP context.
+   * @param result Typed solution, overwritten in place.
+   */
+  void feedback(CDDP &context, SolveResult &result) override;
+
 private:
   // Control law parameters
   std::vector<Eigen::VectorXd> k_u_; ///< Feedforward control gains
   std::vector<Eigen::MatrixXd> K_u_; ///< Feedback control gains
   Eigen::Vector2d dV_;               ///< Expected value function change
+  bool prepared_ = false; ///< Last prepare() produced a valid control law
 
   // Constraint solver
   BoxQPSolver boxqp_solver_; ///< Box QP solver for control constraints
+  std::vector<BoxQPWorkspace>
+      boxqp_workspaces_; ///< Per-knot QP workspaces, warm-started each pass
+  ControlBoxConstraint *control_box_constraint_ =
+      nullptr; ///< Looked up once per solve
+
+  // Backward pass workspace, sized on the first iteration and reused
+  struct Workspace {
+    Eigen::VectorXd x;        ///< State knot passed to callbacks
+    Eigen::VectorXd u;        ///< Control knot passed to callbacks
+    Eigen::MatrixXd A;        ///< A = I + dt*F_x
+    Eigen::MatrixXd B;        ///< B = dt*F_u
+    Eigen::VectorXd l_x;      ///< Running cost state gradient
+    Eigen::VectorXd l_u;      ///< Running cost control gradient
+    Eigen::MatrixXd l_xx;     ///< Running cost state Hessian
+    Eigen::MatrixXd l_uu;     ///< Running cost control Hessian
+    Eigen::MatrixXd l_ux;     ///< Running cost cross Hessian
+    Eigen::VectorXd Q_x;      ///< Q-function state gradient
+    Eigen::VectorXd Q_u;      ///< Q-function control gradient
+    Eigen::MatrixXd Q_xx;     ///< Q-function state Hessian
+    Eigen::MatrixXd Q_ux;     ///< Q-function cross Hessian
+    Eigen::MatrixXd Q_uu;     ///< Q-function control Hessian
+    Eigen::MatrixXd Q_uu_reg; ///< Regularized Q_uu
+    Eigen::VectorXd Q_uu_k;   ///< Q_uu * k
+    Eigen::MatrixXd Q_uu_K;   ///< Q_uu * K
+    Eigen::MatrixXd V_xx_A;   ///< V_xx * A
+    Eigen::MatrixXd V_xx_B;   ///< V_xx * B
+    Eigen::VectorXd V_x;      ///< Value function gradient
+    Eigen::MatrixXd V_xx;     ///< Value function Hessian
+    Eigen::MatrixXd V_xx_T;   ///< Transpose scratch for symmetrization
+    Eigen::VectorXd lb;       ///< Lower bound on the control step
+    Eigen::VectorXd ub;       ///< Upper bound on the control step
+    Eigen::MatrixXd Q_ux_free; ///< -Q_ux with clamped rows zeroed
+    Eigen::LLT<Eigen::MatrixXd> llt; ///< Factorization of Q_uu_reg
+  } workspace_;
+
+  // Per-rollout scratch; each concurrent rollout needs its own
+  struct ForwardPassWorkspace {
+    Eigen::VectorXd x;       ///< State knot passed to callbacks
+    Eigen::VectorXd u;       ///< Control knot passed to callbacks
+    Eigen::VectorXd delta_x; ///< Deviation from the nominal state
+  };
+
+  // Line search buffers, swapped rather than copied between trials
+  ForwardPassResult trial_result_;
+  ForwardPassResult best_result_;
+  ForwardPassWorkspace forward_workspace_;
 
   /**
    * @brief Perform backward pass (Riccati recursion).
@@ -78,17 +148,23 @@ private:
   /**
    * @brief Perform forward pass with line search.
    * @param context Reference to the CDDP context.
-   * @return Best forward pass result.
+   * @return Best forward pass result, owned by the solver and valid until
+   * the next call.
    */
-  ForwardPassResult performForwardPass(CDDP &context);
+  ForwardPassResult &performForwardPass(CDDP &context);
 
   /**
    * @brief Perform single forward pass with given step size.
+   *
+   * Trajectories in @p result are overwritten in place, so no allocation
+   * happens once they have the right size.
    * @param context Reference to the CDDP context.
    * @param alpha Step size for the forward pass.
-   * @return Forward pass result.
+   * @param result Output forward pass result.
+   * @param ws Scratch vectors for this rollout.
    */
-  ForwardPassResult forwardPass(CDDP &context, double alpha);
+  void forwardPass(CDDP &context, double alpha, ForwardPassResult &result,
+                   ForwardPassWorkspace &ws);
 
   /**
    * @brief Compute the current cost given the trajectories.
@@ -106,7 +182,7 @@ private:
    * @brief Print solution summary.
    * @param solution The solution to print.
    */
-  void printSolutionSummary(const CDDPSolution &solution) const;
+  void printSolutionSummary(const SolveResult &result) const;
 };
 
 } // namespace cddp
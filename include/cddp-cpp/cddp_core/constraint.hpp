@@ -68,6 +68,31 @@ namespace cddp
               getControlJacobian(state, control)};
     }
 
+    // In-place variants of evaluate(), getUpperBound() and getJacobians().
+    // Outputs must already have the sizes the returning versions produce.
+    // The defaults forward to those; the built-in constraints override them
+    // so solvers can fill their per-knot buffers without temporaries.
+    virtual void evalInto(const Eigen::VectorXd &state,
+                          const Eigen::VectorXd &control,
+                          Eigen::Ref<Eigen::VectorXd> g) const
+    {
+      g = evaluate(state, control);
+    }
+
+    virtual void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const
+    {
+      upper = getUpperBound();
+    }
+
+    virtual void evalJacobiansInto(const Eigen::VectorXd &state,
+                                   const Eigen::VectorXd &control,
+                                   Eigen::Ref<Eigen::MatrixXd> g_x,
+                                   Eigen::Ref<Eigen::MatrixXd> g_u) const
+    {
+      g_x = getStateJacobian(state, control);
+      g_u = getControlJacobian(state, control);
+    }
+
     // Compute how far the constraint is violated
     virtual double computeViolation(const Eigen::VectorXd &state,
                                     const Eigen::VectorXd &control) const = 0;
@@ -162,6 +187,27 @@ namespace cddp
       return Eigen::MatrixXd::Identity(control.size(), control.size());
     }
 
+    void evalInto(const Eigen::VectorXd & /*state*/,
+                  const Eigen::VectorXd &control,
+                  Eigen::Ref<Eigen::VectorXd> g) const override
+    {
+      g = control;
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper = upper_bound_;
+    }
+
+    void evalJacobiansInto(const Eigen::VectorXd & /*state*/,
+                           const Eigen::VectorXd & /*control*/,
+                           Eigen::Ref<Eigen::MatrixXd> g_x,
+                           Eigen::Ref<Eigen::MatrixXd> g_u) const override
+    {
+      g_x.setZero();
+      g_u.setIdentity();
+    }
+
     Eigen::VectorXd clamp(const Eigen::VectorXd &control) const
     {
       return control.cwiseMax(lower_bound_).cwiseMin(upper_bound_);
@@ -243,6 +289,27 @@ namespace cddp
       return Eigen::MatrixXd::Zero(state.size(), control.size());
     }
 
+    void evalInto(const Eigen::VectorXd &state,
+                  const Eigen::VectorXd & /*control*/,
+                  Eigen::Ref<Eigen::VectorXd> g) const override
+    {
+      g = state;
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper = upper_bound_;
+    }
+
+    void evalJacobiansInto(const Eigen::VectorXd & /*state*/,
+                           const Eigen::VectorXd & /*control*/,
+                           Eigen::Ref<Eigen::MatrixXd> g_x,
+                           Eigen::Ref<Eigen::MatrixXd> g_u) const override
+    {
+      g_x.setIdentity();
+      g_u.setZero();
+    }
+
     Eigen::VectorXd clamp(const Eigen::VectorXd &state) const
     {
       return state.cwiseMax(lower_bound_).cwiseMin(upper_bound_);
@@ -325,6 +392,27 @@ namespace cddp
       return Eigen::MatrixXd::Zero(A_.rows(), control.size());
     }
 
+    void evalInto(const Eigen::VectorXd &state,
+                  const Eigen::VectorXd & /*control*/,
+                  Eigen::Ref<Eigen::VectorXd> g) const override
+    {
+      g.noalias() = A_ * state;
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper = b_;
+    }
+
+    void evalJacobiansInto(const Eigen::VectorXd & /*state*/,
+                           const Eigen::VectorXd & /*control*/,
+                           Eigen::Ref<Eigen::MatrixXd> g_x,
+                           Eigen::Ref<Eigen::MatrixXd> g_u) const override
+    {
+      g_x = A_;
+      g_u.setZero();
+    }
+
     double computeViolation(const Eigen::VectorXd &state,
                             const Eigen::VectorXd &control) const override
     {
@@ -440,6 +528,31 @@ namespace cddp
       return jac;
     }
 
+    void evalInto(const Eigen::VectorXd & /*state*/,
+                  const Eigen::VectorXd &control,
+                  Eigen::Ref<Eigen::VectorXd> g) const override
+    {
+      g.head(control.size()) = -scale_factor_ * control;
+      g.tail(control.size()) = scale_factor_ * control;
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper = upper_bound_;
+    }
+
+    // Like getControlJacobian(), the control block is not scaled.
+    void evalJacobiansInto(const Eigen::VectorXd & /*state*/,
+                           const Eigen::VectorXd &control,
+                           Eigen::Ref<Eigen::MatrixXd> g_x,
+                           Eigen::Ref<Eigen::MatrixXd> g_u) const override
+    {
+      const int m = control.size();
+      g_x.setZero();
+      g_u.topRows(m) = -Eigen::MatrixXd::Identity(m, m);
+      g_u.bottomRows(m).setIdentity();
+    }
+
     double computeViolation(const Eigen::VectorXd &state,
                             const Eigen::VectorXd &control) const override
     {
@@ -555,6 +668,30 @@ namespace cddp
       return Eigen::MatrixXd::Zero(2 * state.size(), control.size());
     }
 
+    void evalInto(const Eigen::VectorXd &state,
+                  const Eigen::VectorXd & /*control*/,
+                  Eigen::Ref<Eigen::VectorXd> g) const override
+    {
+      g.head(state.size()) = -scale_factor_ * state;
+      g.tail(state.size()) = scale_factor_ * state;
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper = upper_bound_;
+    }
+
+    void evalJacobiansInto(const Eigen::VectorXd &state,
+                           const Eigen::VectorXd & /*control*/,
+                           Eigen::Ref<Eigen::MatrixXd> g_x,
+                           Eigen::Ref<Eigen::MatrixXd> g_u) const override
+    {
+      const int n = state.size();
+      g_x.topRows(n) = -scale_factor_ * Eigen::MatrixXd::Identity(n, n);
+      g_x.bottomRows(n) = scale_factor_ * Eigen::MatrixXd::Identity(n, n);
+      g_u.setZero();
+    }
+
     double computeViolation(const Eigen::VectorXd &state,
                             const Eigen::VectorXd &control) const override
     {
@@ -675,9 +812,43 @@ namespace cddp
       return Eigen::MatrixXd::Zero(1, control.size());
     }
 
+    void evalInto(const Eigen::VectorXd &state,
+                  const Eigen::VectorXd & /*control*/,
+                  Eigen::Ref<Eigen::VectorXd> g) const override
+    {
+      g(0) = -scale_factor_ * (state.head(dim_) - center_).squaredNorm();
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper(0) = -radius_ * radius_ * scale_factor_;
+    }
+
+    void evalJacobiansInto(const Eigen::VectorXd &state,
+                           const Eigen::VectorXd & /*control*/,
+                           Eigen::Ref<Eigen::MatrixXd> g_x,
+                           Eigen::Ref<Eigen::MatrixXd> g_u) const override
+    {
+      g_x.setZero();
+      g_x.leftCols(dim_) =
+          -2.0 * scale_factor_ * (state.head(dim_) - center_).transpose();
+      g_u.setZero();
+    }
+
     Eigen::VectorXd getCenter() const { return center_; }
     double getRadius() const { return radius_; }
 
+    // Allow moving obstacles to be updated in place between solves
+    void setCenter(const Eigen::VectorXd &center)
+    {
+      if (center.size() != dim_)
+      {
+        throw std::invalid_argument("BallConstraint: center dimension mismatch");
+      }
+      center_ = center;
+    }
+    void setRadius(double radius) { radius_ = radius; }
+
     // Hessians for BallConstraint
     std::vector<Eigen::MatrixXd>
     getStateHessian(const Eigen::VectorXd &state,
@@ -757,7 +928,16 @@ namespace cddp
 
     Eigen::VectorXd
     evaluate(const Eigen::VectorXd &state,
-             const Eigen::VectorXd & /* control */) const override
+             const Eigen::VectorXd &control) const override
+    {
+      Eigen::VectorXd g(1);
+      evalInto(state, control, g);
+      return g;
+    }
+
+    void evalInto(const Eigen::VectorXd &state,
+                  const Eigen::VectorXd & /* control */,
+                  Eigen::Ref<Eigen::VectorXd> g) const override
     {
       if (state.size() < 3)
       {
@@ -787,9 +967,7 @@ namespace cddp
         signed_distance = std::max(dx, dy); // Both are non-positive.
       }
 
-      Eigen::VectorXd g(1);
       g(0) = -scale_factor_ * signed_distance;
-      return g;
     }
 
     Eigen::VectorXd getLowerBound() const override
@@ -805,7 +983,31 @@ namespace cddp
 
     Eigen::MatrixXd
     getStateJacobian(const Eigen::VectorXd &state,
-                     const Eigen::VectorXd & /* control */) const override
+                     const Eigen::VectorXd &control) const override
+    {
+      Eigen::MatrixXd J(1, state.size());
+      Eigen::MatrixXd J_u(1, control.size());
+      evalJacobiansInto(state, control, J, J_u);
+      return J;
+    }
+
+    // The constraint does not depend on the control input.
+    Eigen::MatrixXd
+    getControlJacobian(const Eigen::VectorXd & /* state */,
+                       const Eigen::VectorXd &control) const override
+    {
+      return Eigen::MatrixXd::Zero(1, control.size());
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper.setZero();
+    }
+
+    void evalJacobiansInto(const Eigen::VectorXd &state,
+                           const Eigen::VectorXd & /* control */,
+                           Eigen::Ref<Eigen::MatrixXd> J,
+                           Eigen::Ref<Eigen::MatrixXd> J_u) const override
     {
       if (state.size() < 3)
       {
@@ -873,17 +1075,9 @@ namespace cddp
       }
       // Construct the Jacobian: place derivative for the first three state
       // elements.
-      Eigen::MatrixXd J = Eigen::MatrixXd::Zero(1, state.size());
+      J.setZero();
       J.block(0, 0, 1, 3) = -scale_factor_ * d_signed_distance_dp.transpose();
-      return J;
-    }
-
-    // The constraint does not depend on the control input.
-    Eigen::MatrixXd
-    getControlJacobian(const Eigen::VectorXd & /* state */,
-                       const Eigen::VectorXd &control) const override
-    {
-      return Eigen::MatrixXd::Zero(1, control.size());
+      J_u.setZero();
     }
 
     double computeViolation(const Eigen::VectorXd &state,
@@ -987,7 +1181,16 @@ namespace cddp
     // Evaluate g(x) = cos(theta_fov) * sqrt(||p_s - p_o||^2 + epsilon) - (p_s -
     // p_o) . axis
     Eigen::VectorXd evaluate(const Eigen::VectorXd &state,
-                             const Eigen::VectorXd & /*control*/) const override
+                             const Eigen::VectorXd &control) const override
+    {
+      Eigen::VectorXd result(1);
+      evalInto(state, control, result);
+      return result;
+    }
+
+    void evalInto(const Eigen::VectorXd &state,
+                  const Eigen::VectorXd & /*control*/,
+                  Eigen::Ref<Eigen::VectorXd> result) const override
     {
       if (state.size() < 3)
       {
@@ -1003,9 +1206,7 @@ namespace cddp
       double dot_prod = v.dot(axis_); // (p_s - p_o) . axis
       double g_val = reg_norm * cos_fov_ - dot_prod;
 
-      Eigen::VectorXd result(1);
       result(0) = g_val;
-      return result;
     }
 
     Eigen::VectorXd getLowerBound() const override
@@ -1021,10 +1222,34 @@ namespace cddp
       return Eigen::VectorXd::Zero(1);
     }
 
-    // Calculate Jacobian dg/dx = dg/dp_s * dp_s/dx
     Eigen::MatrixXd
     getStateJacobian(const Eigen::VectorXd &state,
-                     const Eigen::VectorXd & /*control*/) const override
+                     const Eigen::VectorXd &control) const override
+    {
+      Eigen::MatrixXd jacobian(1, state.size());
+      Eigen::MatrixXd jacobian_u(1, control.size());
+      evalJacobiansInto(state, control, jacobian, jacobian_u);
+      return jacobian;
+    }
+
+    // The constraint does not depend on the control input.
+    Eigen::MatrixXd
+    getControlJacobian(const Eigen::VectorXd & /* state */,
+                       const Eigen::VectorXd &control) const override
+    {
+      return Eigen::MatrixXd::Zero(1, control.size());
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper.setZero();
+    }
+
+    // Calculate Jacobian dg/dx = dg/dp_s * dp_s/dx
+    void evalJacobiansInto(const Eigen::VectorXd &state,
+                           const Eigen::VectorXd & /*control*/,
+                           Eigen::Ref<Eigen::MatrixXd> jacobian,
+                           Eigen::Ref<Eigen::MatrixXd> jacobian_u) const override
     {
       if (state.size() < 3)
       {
@@ -1040,9 +1265,6 @@ namespace cddp
 
       // Jacobian dg/dx = dg/dp_s * dp_s/dx
       // Assuming p_s = state.head(3), then dp_s/dx = [I_3x3, 0]
-      Eigen::MatrixXd dp_s_dx = Eigen::MatrixXd::Zero(3, state.size());
-      dp_s_dx.leftCols(3) = Eigen::Matrix3d::Identity();
-
       // Calculate dg/dp_s:
       // g = cos(fov) * sqrt(||p_s - p_o||^2 + epsilon) - (p_s - p_o) . axis
       // dg/dp_s = cos(fov) * d/dp_s sqrt(||p_s - p_o||^2 + epsilon) - d/dp_s (p_s
@@ -1059,16 +1281,9 @@ namespace cddp
       }
 
       // Chain rule: dg/dx = dg/dp_s * dp_s/dx
-      Eigen::MatrixXd jacobian = dg_dps * dp_s_dx;
-      return jacobian;
-    }
-
-    // The constraint does not depend on the control input.
-    Eigen::MatrixXd
-    getControlJacobian(const Eigen::VectorXd & /* state */,
-                       const Eigen::VectorXd &control) const override
-    {
-      return Eigen::MatrixXd::Zero(1, control.size());
+      jacobian.setZero();
+      jacobian.leftCols<3>() = dg_dps;
+      jacobian_u.setZero();
     }
 
     double computeViolation(const Eigen::VectorXd &state,
@@ -1204,6 +1419,38 @@ namespace cddp
       return jac;
     }
 
+    void evalInto(const Eigen::VectorXd & /*state*/,
+                  const Eigen::VectorXd &control,
+                  Eigen::Ref<Eigen::VectorXd> g) const override
+    {
+      double u_norm = control.norm();
+      g(0) = min_thrust_norm_ - u_norm;
+      g(1) = u_norm - max_thrust_norm_;
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper.setZero();
+    }
+
+    void evalJacobiansInto(const Eigen::VectorXd & /*state*/,
+                           const Eigen::VectorXd &control,
+                           Eigen::Ref<Eigen::MatrixXd> g_x,
+                           Eigen::Ref<Eigen::MatrixXd> g_u) const override
+    {
+      g_x.setZero();
+      double u_reg_norm = std::sqrt(control.squaredNorm() + epsilon_);
+      if (u_reg_norm < epsilon_)
+      {
+        g_u.setZero();
+      }
+      else
+      {
+        g_u.row(0) = -control.transpose() / u_reg_norm;
+        g_u.row(1) = control.transpose() / u_reg_norm;
+      }
+    }
+
     double computeViolation(const Eigen::VectorXd &state,
                             const Eigen::VectorXd &control) const override
     {
@@ -1338,6 +1585,35 @@ namespace cddp
       return jac;
     }
 
+    void evalInto(const Eigen::VectorXd & /*state*/,
+                  const Eigen::VectorXd &control,
+                  Eigen::Ref<Eigen::VectorXd> g) const override
+    {
+      g(0) = control.norm() - max_thrust_norm_;
+    }
+
+    void evalUpperBoundInto(Eigen::Ref<Eigen::VectorXd> upper) const override
+    {
+      upper.setZero();
+    }
+
+    void evalJacobiansInto(const Eigen::VectorXd & /*state*/,
+                           const Eigen::VectorXd &control,
+                           Eigen::Ref<Eigen::MatrixXd> g_x,
+                           Eigen::Ref<Eigen::MatrixXd> g_u) const override
+    {
+      g_x.setZero();
+      double u_reg_norm = std::sqrt(control.squaredNorm() + epsilon_);
+      if (u_reg_norm > std::numeric_limits<double>::min())
+      {
+        g_u.row(0) = control.transpose() / u_reg_norm;
+      }
+      else
+      {
+        g_u.setZero();
+      }
+    }
+
     double computeViolation(const Eigen::VectorXd &state,
                             const Eigen::VectorXd &control) const override
     {
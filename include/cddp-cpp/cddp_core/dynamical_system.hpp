@@ -17,9 +17,12 @@
 #define CDDP_DYNAMICAL_SYSTEM_HPP
 
 #include "cddp_core/helper.hpp"
+#include "cddp_core/integrator.hpp"
 #include <Eigen/Dense>
 #include <autodiff/forward/dual.hpp> // Include autodiff (defines dual, dual2nd)
 #include <autodiff/forward/dual/eigen.hpp> // Include autodiff Eigen support
+#include <memory>
+#include <tuple>
 #include <vector>
 
 namespace cddp {
@@ -36,7 +39,8 @@ public:
   DynamicalSystem(int state_dim, int control_dim, double timestep,
                   std::string integration_type)
       : state_dim_(state_dim), control_dim_(control_dim), timestep_(timestep),
-        integration_type_(integration_type) {}
+        integration_type_(integration_type),
+        integrator_(makeIntegrator(integration_type)) {}
 
   virtual ~DynamicalSystem() {} // Virtual destructor
 
@@ -61,7 +65,8 @@ public:
   }
 
   // Discrete dynamics function: x_{t+1} = f(x_t, u_t)
-  // Uses integration based on getContinuousDynamics
+  // One step of the integrator selected at construction applied to
+  // getContinuousDynamics
   virtual Eigen::VectorXd getDiscreteDynamics(const Eigen::VectorXd &state,
                                               const Eigen::VectorXd &control,
                                               double time) const;
@@ -86,6 +91,104 @@ public:
             getControlJacobian(state, control, time)};
   }
 
+  // Jacobians of the discrete dynamics x_{t+1} = F(x_t, u_t) returned by
+  // getDiscreteDynamics: dF/dx (state_dim x state_dim), dF/du (state_dim x
+  // control_dim). The default differentiates the integrator step
+  // (Integrator::stepJacobians) using getJacobians() at its stage points, so
+  // the linearization matches the rollout; for euler it reduces to
+  // I + dt * df/dx, dt * df/du. Models that implement getDiscreteDynamics
+  // directly instead of integrating must override this.
+  virtual std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+  getDiscreteJacobians(const Eigen::VectorXd &state,
+                       const Eigen::VectorXd &control, double time) const;
+
+  // --- In-place evaluation ---
+  // The functions below write into caller-provided storage of the documented
+  // shape instead of returning new objects, so solver loops can reuse their
+  // workspace from one iteration to the next. Outputs must not alias the
+  // inputs. The defaults forward to the returning functions above; built-in
+  // models implement them directly.
+
+  // f(x, u) into state_dot (state_dim)
+  virtual void
+  evalContinuousDynamicsInto(const Eigen::VectorXd &state,
+                             const Eigen::VectorXd &control, double time,
+                             Eigen::Ref<Eigen::VectorXd> state_dot) const {
+    state_dot = getContinuousDynamics(state, control, time);
+  }
+
+  // F(x, u) into next_state (state_dim)
+  virtual void
+  evalDiscreteDynamicsInto(const Eigen::VectorXd &state,
+                           const Eigen::VectorXd &control, double time,
+                           Eigen::Ref<Eigen::VectorXd> next_state) const {
+    next_state = getDiscreteDynamics(state, control, time);
+  }
+
+  // df/dx into A (state_dim x state_dim), df/du into B (state_dim x
+  // control_dim)
+  virtual void evalJacobiansInto(const Eigen::VectorXd &state,
+                                 const Eigen::VectorXd &control, double time,
+                                 Eigen::Ref<Eigen::MatrixXd> A,
+                                 Eigen::Ref<Eigen::MatrixXd> B) const {
+    const auto [Fx, Fu] = getJacobians(state, control, time);
+    A = Fx;
+    B = Fu;
+  }
+
+  // dF/dx into A, dF/du into B, shaped as in evalJacobiansInto
+  virtual void
+  evalDiscreteJacobiansInto(const Eigen::VectorXd &state,
+                            const Eigen::VectorXd &control, double time,
+                            Eigen::Ref<Eigen::MatrixXd> A,
+                            Eigen::Ref<Eigen::MatrixXd> B) const {
+    const auto [Fx, Fu] = getDiscreteJacobians(state, control, time);
+    A = Fx;
+    B = Fu;
+  }
+
+  // --- Batched evaluation ---
+  // The functions below evaluate N knots at once. Knot j is column j of
+  // states (state_dim x N) and controls (control_dim x N) at times(j), and
+  // results are written into caller-provided blocks of the documented shape,
+  // which must not alias the inputs. The defaults loop over the per-knot
+  // functions; models override them with kernels that process all knots
+  // together.
+
+  // State derivatives f(x_j, u_j) into state_dots (state_dim x N)
+  virtual void
+  getContinuousDynamicsBatch(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                             const Eigen::Ref<const Eigen::MatrixXd> &controls,
+                             const Eigen::Ref<const Eigen::VectorXd> &times,
+                             Eigen::Ref<Eigen::MatrixXd> state_dots) const;
+
+  // Next states F(x_j, u_j) into next_states (state_dim x N)
+  virtual void
+  getDiscreteDynamicsBatch(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                           const Eigen::Ref<const Eigen::MatrixXd> &controls,
+                           const Eigen::Ref<const Eigen::VectorXd> &times,
+                           Eigen::Ref<Eigen::MatrixXd> next_states) const;
+
+  // Continuous Jacobians side by side: df/dx of knot j is
+  // state_jacobians.middleCols(j * state_dim, state_dim) of a
+  // (state_dim x N * state_dim) block, df/du is
+  // control_jacobians.middleCols(j * control_dim, control_dim) of a
+  // (state_dim x N * control_dim) block.
+  virtual void
+  getJacobiansBatch(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                    const Eigen::Ref<const Eigen::MatrixXd> &controls,
+                    const Eigen::Ref<const Eigen::VectorXd> &times,
+                    Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+                    Eigen::Ref<Eigen::MatrixXd> control_jacobians) const;
+
+  // Discrete Jacobians dF/dx, dF/du in the layout of getJacobiansBatch
+  virtual void
+  getDiscreteJacobiansBatch(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                            const Eigen::Ref<const Eigen::MatrixXd> &controls,
+                            const Eigen::Ref<const Eigen::VectorXd> &times,
+                            Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+                            Eigen::Ref<Eigen::MatrixXd> control_jacobians) const;
+
   // Hessian of dynamics w.r.t state: d^2f/dx^2
   // Tensor (state_dim x state_dim x state_dim), vector<MatrixXd> (size
   // state_dim)
@@ -119,31 +222,81 @@ public:
             getCrossHessian(state, control, time)};
   }
 
+  // All three Hessian tensors from autodiff in one pass: the full Hessian of
+  // each output w.r.t. [x, u] is computed once and split into blocks, where
+  // calling getStateHessian, getControlHessian and getCrossHessian computes
+  // it three times. getHessians() keeps dispatching to the per-block
+  // functions so that analytic overrides are honoured; models whose Hessians
+  // all come from autodiff should return this from getHessians() instead.
+  std::tuple<std::vector<Eigen::MatrixXd>, std::vector<Eigen::MatrixXd>,
+             std::vector<Eigen::MatrixXd>>
+  getHessiansAutodiff(const Eigen::VectorXd &state,
+                      const Eigen::VectorXd &control, double time) const;
+
+  // Hessian tensors contracted with a weight vector lambda (state_dim), which
+  // is all the DDP backward pass needs:
+  //   sum_i lambda_i d^2f_i/dx^2  (state_dim x state_dim)
+  //   sum_i lambda_i d^2f_i/du^2  (control_dim x control_dim)
+  //   sum_i lambda_i d^2f_i/dudx  (control_dim x state_dim)
+  // The default contracts the tensors returned by getHessians().
+  virtual std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+  getHessianContraction(const Eigen::VectorXd &state,
+                        const Eigen::VectorXd &control,
+                        const Eigen::VectorXd &lambda, double time) const;
+
+  // Contraction from autodiff as the Hessian of the scalar lambda^T f w.r.t.
+  // [x, u]: one hessian() evaluation instead of one per output. Models whose
+  // Hessians all come from autodiff should return this from
+  // getHessianContraction().
+  std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+  getHessianContractionAutodiff(const Eigen::VectorXd &state,
+                                const Eigen::VectorXd &control,
+                                const Eigen::VectorXd &lambda,
+                                double time) const;
+
   // Accessor methods
   int getStateDim() const { return state_dim_; }
   int getControlDim() const { return control_dim_; }
   double getTimestep() const { return timestep_; }
   std::string getIntegrationType() const { return integration_type_; }
+  // nullptr if the integration type given at construction is unknown
+  const Integrator *getIntegrator() const { return integrator_.get(); }
+
+  // Replace the integrator, e.g. with an RK45Integrator using custom
+  // tolerances; getIntegrationType() then reports its name.
+  void setIntegrator(std::shared_ptr<const Integrator> integrator) {
+    integration_type_ = integrator ? integrator->getName() : std::string();
+    integrator_ = std::move(integrator);
+  }
 
 protected:
+  // evalDiscreteDynamicsInto and evalDiscreteJacobiansInto through
+  // Integrator::stepInto and Integrator::stepJacobiansInto, which evaluate the
+  // stages with evalContinuousDynamicsInto and evalJacobiansInto. Models that
+  // integrate their continuous dynamics forward the discrete in-place
+  // functions here.
+  void integrateInto(const Eigen::VectorXd &state,
+                     const Eigen::VectorXd &control, double time,
+                     Eigen::Ref<Eigen::VectorXd> next_state) const;
+  void integrateJacobiansInto(const Eigen::VectorXd &state,
+                              const Eigen::VectorXd &control, double time,
+                              Eigen::Ref<Eigen::MatrixXd> A,
+                              Eigen::Ref<Eigen::MatrixXd> B) const;
+
+  // getDiscreteDynamicsBatch through Integrator::stepBatch, which evaluates
+  // every stage with getContinuousDynamicsBatch. Models with a batched
+  // continuous kernel forward their getDiscreteDynamicsBatch here.
+  void integrateBatch(const Eigen::Ref<const Eigen::MatrixXd> &states,
+                      const Eigen::Ref<const Eigen::MatrixXd> &controls,
+                      const Eigen::Ref<const Eigen::VectorXd> &times,
+                      Eigen::Ref<Eigen::MatrixXd> next_states) const;
+
   int state_dim_;
   int control_dim_;
   double timestep_;
-  std::string integration_type_; // Integration type: Euler, Heun, RK3, RK4
-
-  // Integration step functions
-  Eigen::VectorXd euler_step(const Eigen::VectorXd &state,
-                             const Eigen::VectorXd &control, double dt,
-                             double time) const;
-  Eigen::VectorXd heun_step(const Eigen::VectorXd &state,
-                            const Eigen::VectorXd &control, double dt,
-                            double time) const;
-  Eigen::VectorXd rk3_step(const Eigen::VectorXd &state,
-                           const Eigen::VectorXd &control, double dt,
-                           double time) const;
-  Eigen::VectorXd rk4_step(const Eigen::VectorXd &state,
-                           const Eigen::VectorXd &control, double dt,
-                           double time) const;
+  std::string integration_type_; // Integration type: euler, heun, rk3, rk4,
+                                 // rk45, implicit_midpoint
+  std::shared_ptr<const Integrator> integrator_;
 };
 } // namespace cddp
 #endif // CDDP_DYNAMICAL_SYSTEM_HPP
\ No newline at end of file
@@ -0,0 +1,535 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef CDDP_FIXED_SIZE_CLDDP_SOLVER_HPP
+#define CDDP_FIXED_SIZE_CLDDP_SOLVER_HPP
+
+#include "cddp_core/boxqp.hpp"
+#include "cddp_core/cddp_core.hpp"
+#include "cddp_core/constraint.hpp"
+#include <Eigen/Dense>
+#include <Eigen/StdVector>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cddp {
+
+/**
+ * @brief CLDDP solver specialized for compile-time state/control dimensions.
+ *
+ * Implements the same algorithm as CLDDPSolver (Riccati backward pass,
+ * optional BoxQP for a "ControlBoxConstraint", Armijo line search) but keeps
+ * every per-knot quantity in fixed-size Eigen types: the nominal and trial
+ * trajectories, the gains, the Q-function blocks and the Q_uu factorization.
+ * These live on the stack or in contiguous per-knot arrays allocated once in
+ * initialize(), and all matrix products are unrolled at compile time.
+ *
+ * Dynamics and objective evaluations still go through the dynamic-size
+ * DynamicalSystem / Objective interfaces; their results are converted at the
+ * boundary.
+ *
+ * For Nu <= kMaxFixedBoxQPDim the control-box QP is solved by
+ * BoxQPSolverFixed<Nu>, warm-started from each knot's previous active set.
+ *
+ * @tparam Nx State dimension.
+ * @tparam Nu Control dimension.
+ */
+template <int Nx, int Nu>
+class FixedSizeCLDDPSolver : public ISolverAlgorithm {
+public:
+  using StateVector = Eigen::Matrix<double, Nx, 1>;
+  using ControlVector = Eigen::Matrix<double, Nu, 1>;
+  using StateMatrix = Eigen::Matrix<double, Nx, Nx>;
+  using InputMatrix = Eigen::Matrix<double, Nx, Nu>;
+  using GainMatrix = Eigen::Matrix<double, Nu, Nx>;
+  using ControlMatrix = Eigen::Matrix<double, Nu, Nu>;
+
+  template <typename T>
+  using AlignedVector = std::vector<T, Eigen::aligned_allocator<T>>;
+
+  FixedSizeCLDDPSolver() : boxqp_solver_(BoxQPOptions()) {}
+
+  /**
+   * @brief Name under which this specialization registers itself.
+   * @return e.g. "FixedSizeCLDDP<3,2>".
+   */
+  static std::string name() {
+    return "FixedSizeCLDDP<" + std::to_string(Nx) + "," + std::to_string(Nu) +
+           ">";
+  }
+
+  /**
+   * @brief Register this specialization with CDDP's external solver registry.
+   * @return Solver name to pass to CDDP::solve().
+   */
+  static std::string registerSolver() {
+    const std::string solver_name = name();
+    if (!CDDP::isSolverRegistered(solver_name)) {
+      CDDP::registerSolver(solver_name, []() {
+        return std::make_unique<FixedSizeCLDDPSolver<Nx, Nu>>();
+      });
+    }
+    return solver_name;
+  }
+
+  void initialize(CDDP &context) override {
+    const CDDPOptions &options = context.getOptions();
+    const int horizon = context.getHorizon();
+
+    if (context.getStateDim() != Nx || context.getControlDim() != Nu) {
+      throw std::invalid_argument(
+          name() + ": problem dimensions (" +
+          std::to_string(context.getStateDim()) + ", " +
+          std::to_string(context.getControlDim()) +
+          ") do not match the compiled dimensions");
+    }
+
+    // Keep existing gains on a valid warm start
+    const bool valid_warm_start =
+        options.warm_start && k_u_.size() == static_cast<size_t>(horizon);
+
+    if (!valid_warm_start) {
+      k_u_.assign(horizon, ControlVector::Zero());
+      K_u_.assign(horizon, GainMatrix::Zero());
+    }
+
+    if constexpr (Nu <= kMaxFixedBoxQPDim) {
+      // Active sets only carry over together with the gains
+      if (!valid_warm_start)
+        boxqp_workspaces_.clear();
+      boxqp_workspaces_.resize(horizon);
+    }
+
+    X_.resize(horizon + 1);
+    U_.resize(horizon);
+    X_new_.resize(horizon + 1);
+    U_new_.resize(horizon);
+    A_.resize(horizon);
+    B_.resize(horizon);
+
+    if (context.X_.size() == static_cast<size_t>(horizon + 1) &&
+        context.U_.size() == static_cast<size_t>(horizon)) {
+      loadTrajectory(context);
+    } else {
+      X_.assign(horizon + 1, context.getInitialState());
+      U_.assign(horizon, ControlVector::Zero());
+      storeTrajectory(context, X_, U_);
+    }
+    X_[0] = context.getInitialState();
+
+    dV_.setZero();
+    boxqp_solver_.setOptions(options.box_qp);
+    fixed_boxqp_solver_.setOptions(options.box_qp);
+    computeCost(context);
+  }
+
+  using ISolverAlgorithm::solve;
+
+  void solve(CDDP &context, SolveResult &result) override {
+    const CDDPOptions &options = context.getOptions();
+
+    if (options.print_solver_header) {
+      context.printSolverInfo();
+    }
+    if (options.print_solver_options) {
+      context.printOptions(options);
+    }
+
+    result.beginSolve(getSolverName(), options.return_iteration_info,
+                      static_cast<size_t>(options.max_iterations + 1));
+    SolveHistory *history = result.history ? &*result.history : nullptr;
+    if (history) {
+      history->objective.push_back(context.cost_);
+    }
+
+    if (options.verbose) {
+      printIteration(0, context.cost_, context.inf_du_,
+                     context.regularization_, context.alpha_pr_);
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    int iter = 0;
+    std::string termination_reason = "MaxIterationsReached";
+
+    while (iter < options.max_iterations) {
+      ++iter;
+
+      if (options.max_cpu_time > 0) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - start_time);
+        if (elapsed.count() > options.max_cpu_time * 1000) {
+          termination_reason = "MaxCpuTimeReached";
+          break;
+        }
+      }
+
+      if (context.isCancellationRequested()) {
+        termination_reason = "Cancelled";
+        break;
+      }
+
+      // 1. Backward pass
+      bool backward_pass_success = false;
+      while (!backward_pass_success) {
+        backward_pass_success = backwardPass(context);
+        if (!backward_pass_success) {
+          if (context.isCancellationRequested()) {
+            termination_reason = "Cancelled";
+            break;
+          }
+          context.increaseRegularization();
+          if (context.isRegularizationLimitReached()) {
+            termination_reason = "RegularizationLimit_NotConverged";
+            break;
+          }
+        }
+      }
+      if (!backward_pass_success)
+        break;
+
+      if (context.inf_du_ < options.tolerance) {
+        termination_reason = "OptimalSolutionFound";
+        break;
+      }
+
+      // 2. Forward pass (line search over context.alphas_)
+      bool accepted = false;
+      double best_cost = std::numeric_limits<double>::infinity();
+      for (double alpha : context.alphas_) {
+        if (context.isCancellationRequested()) {
+          break;
+        }
+        double cost = 0.0;
+        if (forwardPass(context, alpha, cost)) {
+          accepted = true;
+          best_cost = cost;
+          context.alpha_pr_ = alpha;
+          break;
+        }
+      }
+
+      if (accepted) {
+        std::swap(X_, X_new_);
+        std::swap(U_, U_new_);
+        const double dJ = context.cost_ - best_cost;
+        context.cost_ = best_cost;
+        context.merit_function_ = best_cost;
+
+        if (history) {
+          history->objective.push_back(context.cost_);
+        }
+
+        context.decreaseRegularization();
+
+        if (dJ < options.acceptable_tolerance) {
+          termination_reason = "AcceptableSolutionFound";
+          break;
+        }
+      } else {
+        if (context.isCancellationRequested()) {
+          termination_reason = "Cancelled";
+          break;
+        }
+        context.increaseRegularization();
+        if (context.isRegularizationLimitReached()) {
+          termination_reason = "RegularizationLimitReached_NotConverged";
+          break;
+        }
+      }
+
+      if (options.verbose) {
+        printIteration(iter, context.cost_, context.inf_du_,
+                       context.regularization_, context.alpha_pr_);
+      }
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - start_time);
+
+    storeTrajectory(context, X_, U_);
+
+    result.status_message = termination_reason;
+    result.iterations_completed = iter;
+    result.solve_time_ms = static_cast<double>(duration.count());
+    result.final_objective = context.cost_;
+    result.final_step_length = context.alpha_pr_;
+
+    result.setTimePoints(context.getHorizon(), context.getTimestep());
+    result.state_trajectory = context.X_;
+    result.control_trajectory = context.U_;
+    result.setFeedbackGains(K_u_);
+    result.final_regularization = context.regularization_;
+  }
+
+  std::string getSolverName() const override { return name(); }
+
+  void shift(CDDP &context, int steps) override {
+    cddp::shiftTrajectory(k_u_, steps);
+    cddp::shiftTrajectory(K_u_, steps);
+  }
+
+private:
+  // Nominal and trial trajectories
+  AlignedVector<StateVector> X_, X_new_;
+  AlignedVector<ControlVector> U_, U_new_;
+
+  // Control law
+  AlignedVector<ControlVector> k_u_;
+  AlignedVector<GainMatrix> K_u_;
+  Eigen::Vector2d dV_;
+
+  // Discrete-time linearization along the nominal trajectory
+  AlignedVector<StateMatrix> A_;
+  AlignedVector<InputMatrix> B_;
+
+  // Box-constrained QP on the controls: the unrolled fixed-size solver with
+  // one warm-started workspace per knot for small Nu, the generic one above
+  BoxQPSolver boxqp_solver_;
+  BoxQPSolverFixed<Nu> fixed_boxqp_solver_;
+  AlignedVector<typename BoxQPSolverFixed<Nu>::Workspace> boxqp_workspaces_;
+
+  // Solves the BoxQP of knot t into k and the free-subspace feedback gain K.
+  bool solveBoxQP(int t, const ControlMatrix &Q_uu, const ControlVector &Q_u,
+                  const GainMatrix &Q_ux, const ControlVector &lb,
+                  const ControlVector &ub, ControlVector &k, GainMatrix &K) {
+    if constexpr (Nu <= kMaxFixedBoxQPDim) {
+      auto &ws = boxqp_workspaces_[t];
+      const BoxQPStatus status =
+          fixed_boxqp_solver_.solve(Q_uu, Q_u, lb, ub, k_u_[t], ws);
+      if (status == BoxQPStatus::HESSIAN_NOT_PD ||
+          status == BoxQPStatus::NO_DESCENT) {
+        return false;
+      }
+
+      k = ws.x;
+      K.noalias() = -(ws.free.template cast<double>().asDiagonal() * Q_ux);
+      ws.solveFree(K);
+      return true;
+    } else {
+      BoxQPResult qp_result = boxqp_solver_.solve(
+          Q_uu, Q_u, Eigen::VectorXd(lb), Eigen::VectorXd(ub), k_u_[t]);
+      if (qp_result.status == BoxQPStatus::HESSIAN_NOT_PD ||
+          qp_result.status == BoxQPStatus::NO_DESCENT) {
+        return false;
+      }
+
+      k = qp_result.x;
+      K.setZero();
+      if (qp_result.free.sum() > 0) {
+        int num_free = qp_result.free.sum();
+        Eigen::MatrixXd Q_ux_free(num_free, Nx);
+        for (int i = 0, j = 0; i < Nu; ++i) {
+          if (qp_result.free(i))
+            Q_ux_free.row(j++) = Q_ux.row(i);
+        }
+        Eigen::MatrixXd K_free = -qp_result.Hfree.solve(Q_ux_free);
+        for (int i = 0, j = 0; i < Nu; ++i) {
+          if (qp_result.free(i))
+            K.row(i) = K_free.row(j++);
+        }
+      }
+      return true;
+    }
+  }
+
+  void loadTrajectory(const CDDP &context) {
+    for (size_t t = 0; t < X_.size(); ++t)
+      X_[t] = context.X_[t];
+    for (size_t t = 0; t < U_.size(); ++t)
+      U_[t] = context.U_[t];
+  }
+
+  static void storeTrajectory(CDDP &context,
+                              const AlignedVector<StateVector> &X,
+                              const AlignedVector<ControlVector> &U) {
+    context.X_.resize(Nx, X.size());
+    context.U_.resize(Nu, U.size());
+    for (size_t t = 0; t < X.size(); ++t)
+      context.X_[t] = X[t];
+    for (size_t t = 0; t < U.size(); ++t)
+      context.U_[t] = U[t];
+  }
+
+  void computeCost(CDDP &context) {
+    const auto &objective = context.getObjective();
+    double cost = 0.0;
+    for (size_t t = 0; t < U_.size(); ++t) {
+      cost += objective.running_cost(X_[t], U_[t], static_cast<int>(t));
+    }
+    cost += objective.terminal_cost(X_.back());
+    context.cost_ = cost;
+    context.merit_function_ = cost;
+  }
+
+  bool backwardPass(CDDP &context) {
+    const CDDPOptions &options = context.getOptions();
+    const int horizon = context.getHorizon();
+    const double timestep = context.getTimestep();
+    const auto &system = context.getSystem();
+    const auto &objective = context.getObjective();
+    auto control_box_constraint =
+        context.getConstraint<ControlBoxConstraint>("ControlBoxConstraint");
+
+    StateVector V_x = objective.getFinalCostGradient(X_.back());
+    StateMatrix V_xx = objective.getFinalCostHessian(X_.back());
+
+    StateVector Q_x;
+    ControlVector Q_u;
+    StateMatrix Q_xx;
+    GainMatrix Q_ux;
+    ControlMatrix Q_uu, Q_uu_reg;
+    ControlVector k;
+    GainMatrix K;
+    Eigen::LLT<ControlMatrix> llt;
+
+    dV_.setZero();
+    double norm_Vx = V_x.template lpNorm<1>();
+    double Qu_error = 0.0;
+
+    for (int t = horizon - 1; t >= 0; --t) {
+      if (context.isCancellationRequested()) {
+        return false;
+      }
+
+      const StateVector &x = X_[t];
+      const ControlVector &u = U_[t];
+
+      // Discrete Jacobians, exact for the system's integrator
+      StateMatrix &A = A_[t];
+      InputMatrix &B = B_[t];
+      std::tie(A, B) = system.getDiscreteJacobians(x, u, t * timestep);
+
+      const auto [l_x, l_u] = objective.getRunningCostGradients(x, u, t);
+      const auto [l_xx, l_uu, l_ux] =
+          objective.getRunningCostHessians(x, u, t);
+
+      Q_x.noalias() = l_x + A.transpose() * V_x;
+      Q_u.noalias() = l_u + B.transpose() * V_x;
+      Q_xx.noalias() = l_xx + A.transpose() * V_xx * A;
+      Q_ux.noalias() = l_ux + B.transpose() * V_xx * A;
+      Q_uu.noalias() = l_uu + B.transpose() * V_xx * B;
+
+      Q_uu_reg = Q_uu;
+      Q_uu_reg.diagonal().array() += context.regularization_;
+
+      // Cholesky doubles as the positive-definiteness check
+      llt.compute(Q_uu_reg);
+      if (llt.info() != Eigen::Success) {
+        if (options.debug) {
+          std::cerr << name() << ": Q_uu is not positive definite at time "
+                    << t << std::endl;
+        }
+        return false;
+      }
+
+      if (control_box_constraint == nullptr) {
+        k.noalias() = -llt.solve(Q_u);
+        K.noalias() = -llt.solve(Q_ux);
+      } else {
+        const ControlVector lb = control_box_constraint->getLowerBound() - u;
+        const ControlVector ub = control_box_constraint->getUpperBound() - u;
+        if (!solveBoxQP(t, Q_uu_reg, Q_u, Q_ux, lb, ub, k, K)) {
+          if (options.debug) {
+            std::cerr << name() << ": BoxQP failed at time step " << t
+                      << std::endl;
+          }
+          return false;
+        }
+      }
+
+      k_u_[t] = k;
+      K_u_[t] = K;
+
+      dV_(0) += Q_u.dot(k);
+      dV_(1) += 0.5 * k.dot(Q_uu * k);
+
+      V_x.noalias() = Q_x + K.transpose() * Q_uu * k +
+                      Q_ux.transpose() * k + K.transpose() * Q_u;
+      V_xx.noalias() = Q_xx + K.transpose() * Q_uu * K +
+                       Q_ux.transpose() * K + K.transpose() * Q_ux;
+      V_xx = 0.5 * (V_xx + V_xx.transpose()).eval();
+
+      norm_Vx += V_x.template lpNorm<1>();
+      Qu_error = std::max(Qu_error, Q_u.template lpNorm<Eigen::Infinity>());
+    }
+
+    double scaling_factor = options.termination_scaling_max_factor;
+    scaling_factor =
+        std::max(scaling_factor, norm_Vx / (horizon * Nx)) / scaling_factor;
+    context.inf_du_ = Qu_error / scaling_factor;
+    return true;
+  }
+
+  bool forwardPass(CDDP &context, double alpha, double &cost) {
+    const CDDPOptions &options = context.getOptions();
+    const int horizon = context.getHorizon();
+    const double timestep = context.getTimestep();
+    const auto &system = context.getSystem();
+    const auto &objective = context.getObjective();
+    auto control_box_constraint =
+        context.getConstraint<ControlBoxConstraint>("ControlBoxConstraint");
+
+    X_new_[0] = context.getInitialState();
+    cost = 0.0;
+    for (int t = 0; t < horizon; ++t) {
+      U_new_[t].noalias() =
+          U_[t] + alpha * k_u_[t] + K_u_[t] * (X_new_[t] - X_[t]);
+      if (control_box_constraint != nullptr) {
+        U_new_[t] = control_box_constraint->clamp(U_new_[t]);
+      }
+      cost += objective.running_cost(X_new_[t], U_new_[t], t);
+      X_new_[t + 1] =
+          system.getDiscreteDynamics(X_new_[t], U_new_[t], t * timestep);
+    }
+    cost += objective.terminal_cost(X_new_.back());
+
+    if (!std::isfinite(cost))
+      return false;
+
+    const double dJ = context.cost_ - cost;
+    const double expected = -alpha * (dV_(0) + 0.5 * alpha * dV_(1));
+    const double reduction_ratio =
+        expected > 0.0 ? dJ / expected : std::copysign(1.0, dJ);
+    return reduction_ratio > options.filter.armijo_constant;
+  }
+
+  void printIteration(int iter, double cost, double inf_du,
+                      double regularization, double alpha) const {
+    if (iter == 0) {
+      std::cout << std::setw(4) << "iter" << " " << std::setw(12)
+                << "objective" << " " << std::setw(10) << "inf_du" << " "
+                << std::setw(8) << "lg(rg)" << " " << std::setw(8) << "alpha"
+                << std::endl;
+    }
+    std::cout << std::setw(4) << iter << " " << std::setw(12)
+              << std::scientific << std::setprecision(4) << cost << " "
+              << std::setw(10) << std::scientific << std::setprecision(2)
+              << inf_du << " " << std::setw(8) << std::fixed
+              << std::setprecision(1) << std::log10(regularization) << " "
+              << std::setw(8) << std::fixed << std::setprecision(4) << alpha
+              << std::endl;
+  }
+};
+
+} // namespace cddp
+
+#endif // CDDP_FIXED_SIZE_CLDDP_SOLVER_HPP
@@ -0,0 +1,289 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef CDDP_INTEGRATOR_HPP
+#define CDDP_INTEGRATOR_HPP
+
+#include <Eigen/Dense>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+
+namespace cddp {
+
+class DynamicalSystem;
+
+/**
+ * @brief Integration schemes available through makeIntegrator().
+ */
+enum class IntegrationType {
+  Euler,           ///< "euler": explicit Euler
+  Heun,            ///< "heun": explicit trapezoidal rule
+  RK3,             ///< "rk3": Kutta's third-order method
+  RK4,             ///< "rk4": classical fourth-order Runge-Kutta
+  RK45,            ///< "rk45": adaptive Dormand-Prince 5(4) substeps
+  ImplicitMidpoint ///< "implicit_midpoint": A-stable, solved with Newton
+};
+
+/**
+ * @brief One step of the discrete dynamics x_{t+1} = F(x_t, u_t), built from
+ * the continuous dynamics of a DynamicalSystem.
+ *
+ * DynamicalSystem selects its integrator once at construction and calls it
+ * from getDiscreteDynamics() and getDiscreteJacobians(). Integrators are
+ * stateless and shared between copies of a system; the schemes below keep
+ * their stage vectors in per-thread buffers, so concurrent rollouts do not
+ * allocate scratch on every step.
+ */
+class Integrator {
+public:
+  virtual ~Integrator() = default;
+
+  virtual IntegrationType getType() const = 0;
+
+  /// Name accepted by makeIntegrator(), e.g. "rk4".
+  virtual std::string getName() const = 0;
+
+  /// State after integrating @p system over [time, time + dt].
+  virtual Eigen::VectorXd step(const DynamicalSystem &system,
+                               const Eigen::VectorXd &state,
+                               const Eigen::VectorXd &control, double dt,
+                               double time) const = 0;
+
+  /**
+   * @brief Exact Jacobians of step() w.r.t. state and control.
+   *
+   * Obtained by differentiating the scheme itself (the variational
+   * equations through its stages), using the continuous Jacobians of
+   * @p system at the stage points.
+   */
+  virtual std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+  stepJacobians(const DynamicalSystem &system, const Eigen::VectorXd &state,
+                const Eigen::VectorXd &control, double dt,
+                double time) const = 0;
+
+  /**
+   * @brief step() written into @p next_state (state_dim).
+   *
+   * The default forwards to step(); schemes that implement it directly
+   * evaluate their stages with DynamicalSystem::evalContinuousDynamicsInto
+   * into per-thread buffers, so no vector is allocated once the buffers have
+   * grown to the system's size.
+   */
+  virtual void stepInto(const DynamicalSystem &system,
+                        const Eigen::VectorXd &state,
+                        const Eigen::VectorXd &control, double dt, double time,
+                        Eigen::Ref<Eigen::VectorXd> next_state) const;
+
+  /**
+   * @brief stepJacobians() written into @p A (state_dim x state_dim) and
+   * @p B (state_dim x control_dim).
+   *
+   * The default forwards to stepJacobians(); schemes that implement it
+   * directly use DynamicalSystem::evalJacobiansInto at the stage points.
+   */
+  virtual void stepJacobiansInto(const DynamicalSystem &system,
+                                 const Eigen::VectorXd &state,
+                                 const Eigen::VectorXd &control, double dt,
+                                 double time, Eigen::Ref<Eigen::MatrixXd> A,
+                                 Eigen::Ref<Eigen::MatrixXd> B) const;
+
+  /**
+   * @brief step() for N knots packed as columns of @p states and
+   * @p controls, started at times(j), into @p next_states.
+   *
+   * The default steps every column on its own; schemes that can evaluate all
+   * knots together use DynamicalSystem::getContinuousDynamicsBatch.
+   */
+  virtual void stepBatch(const DynamicalSystem &system,
+                         const Eigen::Ref<const Eigen::MatrixXd> &states,
+                         const Eigen::Ref<const Eigen::MatrixXd> &controls,
+                         double dt,
+                         const Eigen::Ref<const Eigen::VectorXd> &times,
+                         Eigen::Ref<Eigen::MatrixXd> next_states) const;
+};
+
+/**
+ * @brief Fixed-step explicit Runge-Kutta scheme (euler, heun, rk3 or rk4).
+ */
+class ExplicitRungeKuttaIntegrator : public Integrator {
+public:
+  /// @throws std::invalid_argument if @p type is not an explicit fixed-step
+  /// scheme.
+  explicit ExplicitRungeKuttaIntegrator(IntegrationType type);
+
+  IntegrationType getType() const override { return type_; }
+  std::string getName() const override;
+
+  Eigen::VectorXd step(const DynamicalSystem &system,
+                       const Eigen::VectorXd &state,
+                       const Eigen::VectorXd &control, double dt,
+                       double time) const override;
+
+  std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+  stepJacobians(const DynamicalSystem &system, const Eigen::VectorXd &state,
+                const Eigen::VectorXd &control, double dt,
+                double time) const override;
+
+  void stepInto(const DynamicalSystem &system, const Eigen::VectorXd &state,
+                const Eigen::VectorXd &control, double dt, double time,
+                Eigen::Ref<Eigen::VectorXd> next_state) const override;
+
+  void stepJacobiansInto(const DynamicalSystem &system,
+                         const Eigen::VectorXd &state,
+                         const Eigen::VectorXd &control, double dt,
+                         double time, Eigen::Ref<Eigen::MatrixXd> A,
+                         Eigen::Ref<Eigen::MatrixXd> B) const override;
+
+  void stepBatch(const DynamicalSystem &system,
+                 const Eigen::Ref<const Eigen::MatrixXd> &states,
+                 const Eigen::Ref<const Eigen::MatrixXd> &controls, double dt,
+                 const Eigen::Ref<const Eigen::VectorXd> &times,
+                 Eigen::Ref<Eigen::MatrixXd> next_states) const override;
+
+private:
+  IntegrationType type_;
+};
+
+/**
+ * @brief Dormand-Prince 5(4) with error control inside each timestep.
+ *
+ * The interval [time, time + dt] is covered by as many substeps as the
+ * tolerances require, so a coarse dt stays accurate where the dynamics are
+ * fast. stepJacobians() chains the sensitivities of the accepted substeps.
+ * Once max_substeps is reached, the remaining interval is accepted as one
+ * substep without error control; getSubstepLimitCount() counts how often.
+ */
+class RK45Integrator : public Integrator {
+public:
+  /**
+   * @param abs_tolerance Absolute error tolerance per substep.
+   * @param rel_tolerance Relative error tolerance per substep.
+   * @param max_substeps Substeps (accepted or rejected) per timestep after
+   *        which the remaining interval is accepted in one substep, without
+   *        error control.
+   */
+  explicit RK45Integrator(double abs_tolerance = 1e-8,
+                          double rel_tolerance = 1e-6, int max_substeps = 200);
+
+  IntegrationType getType() const override { return IntegrationType::RK45; }
+  std::string getName() const override { return "rk45"; }
+
+  Eigen::VectorXd step(const DynamicalSystem &system,
+                       const Eigen::VectorXd &state,
+                       const Eigen::VectorXd &control, double dt,
+                       double time) const override;
+
+  std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+  stepJacobians(const DynamicalSystem &system, const Eigen::VectorXd &state,
+                const Eigen::VectorXd &control, double dt,
+                double time) const override;
+
+  void stepInto(const DynamicalSystem &system, const Eigen::VectorXd &state,
+                const Eigen::VectorXd &control, double dt, double time,
+                Eigen::Ref<Eigen::VectorXd> next_state) const override;
+
+  void stepJacobiansInto(const DynamicalSystem &system,
+                         const Eigen::VectorXd &state,
+                         const Eigen::VectorXd &control, double dt,
+                         double time, Eigen::Ref<Eigen::MatrixXd> A,
+                         Eigen::Ref<Eigen::MatrixXd> B) const override;
+
+  /// Timesteps, across all threads, that hit max_substeps and finished
+  /// without error control. A growing count means the tolerances are too
+  /// tight for the model or dt is too coarse.
+  std::size_t getSubstepLimitCount() const {
+    return substep_limit_count_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Shared by all step functions; the final state is written into
+  // next_state when it is non-null, A and B are only accumulated when both
+  // are non-null.
+  void integrate(const DynamicalSystem &system, const Eigen::VectorXd &state,
+                 const Eigen::VectorXd &control, double dt, double time,
+                 Eigen::Ref<Eigen::VectorXd> *next_state,
+                 Eigen::Ref<Eigen::MatrixXd> *A,
+                 Eigen::Ref<Eigen::MatrixXd> *B) const;
+
+  double abs_tolerance_;
+  double rel_tolerance_;
+  int max_substeps_;
+  mutable std::atomic<std::size_t> substep_limit_count_{0};
+};
+
+/**
+ * @brief Implicit midpoint rule x+ = x + dt f((x + x+) / 2, u, t + dt / 2).
+ *
+ * A-stable and symplectic, so stiff or orbital models can run at timesteps
+ * where explicit schemes diverge. The stage equation is solved by Newton's
+ * method with the continuous state Jacobian of the system.
+ */
+class ImplicitMidpointIntegrator : public Integrator {
+public:
+  /**
+   * @param tolerance Newton stops once the stage residual's max-norm is
+   *        below tolerance * (1 + |k|).
+   * @param max_iterations Newton iterations per step.
+   */
+  explicit ImplicitMidpointIntegrator(double tolerance = 1e-10,
+                                      int max_iterations = 20);
+
+  IntegrationType getType() const override {
+    return IntegrationType::ImplicitMidpoint;
+  }
+  std::string getName() const override { return "implicit_midpoint"; }
+
+  Eigen::VectorXd step(const DynamicalSystem &system,
+                       const Eigen::VectorXd &state,
+                       const Eigen::VectorXd &control, double dt,
+                       double time) const override;
+
+  std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+  stepJacobians(const DynamicalSystem &system, const Eigen::VectorXd &state,
+                const Eigen::VectorXd &control, double dt,
+                double time) const override;
+
+  /// Steps, across all threads, whose Newton iteration stopped at
+  /// max_iterations without converging; the last iterate is used.
+  std::size_t getNewtonFailureCount() const {
+    return newton_failure_count_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Solves k = f(x + dt/2 k, u, t + dt/2) for the stage derivative k.
+  Eigen::VectorXd solveStage(const DynamicalSystem &system,
+                             const Eigen::VectorXd &state,
+                             const Eigen::VectorXd &control, double dt,
+                             double time) const;
+
+  double tolerance_;
+  int max_iterations_;
+  mutable std::atomic<std::size_t> newton_failure_count_{0};
+};
+
+/// Integrator for @p type with default settings.
+std::shared_ptr<const Integrator> makeIntegrator(IntegrationType type);
+
+/// Integrator named @p name ("euler", "heun", "rk3", "rk4", "rk45",
+/// "implicit_midpoint"); nullptr for unknown names.
+std::shared_ptr<const Integrator> makeIntegrator(const std::string &name);
+
+} // namespace cddp
+
+#endif // CDDP_INTEGRATOR_HPP
@@ -19,7 +19,6 @@
 
 #include "cddp_core/cddp_core.hpp"
 #include <Eigen/Dense>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -46,12 +45,14 @@ namespace cddp
          */
         void initialize(CDDP &context) override;
 
+        using ISolverAlgorithm::solve;
+
         /**
          * @brief Execute IPDDP algorithm.
          * @param context CDDP instance with problem data and options.
-         * @return Solution containing trajectories and statistics.
+         * @param result Trajectories and statistics, overwritten in place.
          */
-        CDDPSolution solve(CDDP &context) override;
+        void solve(CDDP &context, SolveResult &result) override;
 
         /**
          * @brief Get solver name.
@@ -59,49 +60,65 @@ namespace cddp
          */
         std::string getSolverName() const override;
 
+        /**
+         * @brief Shift gains, duals and slacks forward for a receding-horizon re-solve.
+         * @param context CDDP instance with problem data and options.
+         * @param steps Number of knots to shift by.
+         */
+        void shift(CDDP &context, int steps) override;
+
+        /**
+         * @brief Real-time iteration: derivatives and backward pass around the
+         * nominal trajectory.
+         * @param context CDDP instance with problem data and options.
+         */
+        void prepare(CDDP &context) override;
+
+        /**
+         * @brief Real-time iteration: one forward pass from the new initial state.
+         * @param context CDDP instance with problem data and options.
+         * @param result Trajectories and statistics, overwritten in place.
+         */
+        void feedback(CDDP &context, SolveResult &result) override;
+
     private:
         // Dynamics derivatives
-        std::vector<Eigen::MatrixXd> F_x_;               ///< State jacobians
-        std::vector<Eigen::MatrixXd> F_u_;               ///< Control jacobians
-        std::vector<std::vector<Eigen::MatrixXd>> F_xx_; ///< State hessians
-        std::vector<std::vector<Eigen::MatrixXd>> F_uu_; ///< Control hessians
-        std::vector<std::vector<Eigen::MatrixXd>> F_ux_; ///< Mixed hessians
-
-        // Constraint derivatives
-        std::map<std::string, std::vector<Eigen::MatrixXd>> G_x_; ///< State gradients
-        std::map<std::string, std::vector<Eigen::MatrixXd>> G_u_; ///< Control gradients
-        std::map<std::string, std::vector<Eigen::MatrixXd>>
-            G_xx_; ///< Constraint state hessians
-        std::map<std::string, std::vector<Eigen::MatrixXd>>
-            G_uu_; ///< Constraint control hessians
-        std::map<std::string, std::vector<Eigen::MatrixXd>>
-            G_ux_; ///< Constraint mixed hessians
+        std::vector<Eigen::MatrixXd> F_x_;               ///< Discrete state jacobians dF/dx
+        std::vector<Eigen::MatrixXd> F_u_;               ///< Discrete control jacobians dF/du
+
+        // Constraint derivatives, stacked per knot in the order of
+        // CDDP::getPathConstraintBlocks()
+        std::vector<Eigen::MatrixXd> G_x_; ///< State gradients
+        std::vector<Eigen::MatrixXd> G_u_; ///< Control gradients
+
+        /// True while the derivatives above belong to the current X_/U_;
+        /// cleared whenever the nominal trajectory changes
+        bool derivatives_valid_ = false;
 
         // Control law
         std::vector<Eigen::VectorXd> k_u_; ///< Feedforward gains
         std::vector<Eigen::MatrixXd> K_u_; ///< Feedback gains
         Eigen::Vector2d dV_;               ///< Expected value change
 
-        // Interior point variables
-        std::map<std::string, std::vector<Eigen::VectorXd>> G_; ///< Constraint values
-        std::map<std::string, std::vector<Eigen::VectorXd>> Y_; ///< Dual variables
-        std::map<std::string, std::vector<Eigen::VectorXd>> S_; ///< Slack variables
+        // Interior point variables (stacked per knot)
+        std::vector<Eigen::VectorXd> G_; ///< Constraint values
+        std::vector<Eigen::VectorXd> Y_; ///< Dual variables
+        std::vector<Eigen::VectorXd> S_; ///< Slack variables
 
-        // Interior point gains
-        std::map<std::string, std::vector<Eigen::VectorXd>> k_y_; ///< Dual feedforward
-        std::map<std::string, std::vector<Eigen::MatrixXd>> K_y_; ///< Dual feedback
-        std::map<std::string, std::vector<Eigen::VectorXd>> k_s_; ///< Slack feedforward
-        std::map<std::string, std::vector<Eigen::MatrixXd>> K_s_; ///< Slack feedback
+        // Interior point gains (stacked per knot)
+        std::vector<Eigen::VectorXd> k_y_; ///< Dual feedforward
+        std::vector<Eigen::MatrixXd> K_y_; ///< Dual feedback
+        std::vector<Eigen::VectorXd> k_s_; ///< Slack feedforward
+        std::vector<Eigen::MatrixXd> K_s_; ///< Slack feedback
 
         // Barrier method parameters
         double mu_;                       ///< Barrier parameter
         std::vector<FilterPoint> filter_; ///< Filter for line search
+        bool prepared_ = false;           ///< Last prepare() produced a valid control law
 
         // Pre-allocated workspace for performance optimization
         struct Workspace {
             // Backward pass workspace
-            std::vector<Eigen::MatrixXd> A_matrices;     ///< A = I + dt*F_x
-            std::vector<Eigen::MatrixXd> B_matrices;     ///< B = dt*F_u
             std::vector<Eigen::MatrixXd> Q_xx_matrices;  ///< Q_xx workspace
             std::vector<Eigen::MatrixXd> Q_ux_matrices;  ///< Q_ux workspace
             std::vector<Eigen::MatrixXd> Q_uu_matrices;  ///< Q_uu workspace
@@ -112,14 +129,36 @@ namespace cddp
             std::vector<Eigen::LDLT<Eigen::MatrixXd>> ldlt_solvers; ///< Cached LDLT factorizations
             std::vector<bool> ldlt_valid;                            ///< Validity flags for LDLT cache
             
+            // Per-knot scratch shared by both backward recursions
+            Eigen::VectorXd x;               ///< State knot passed to callbacks
+            Eigen::VectorXd u;               ///< Control knot passed to callbacks
+            Eigen::VectorXd V_x;             ///< Value function gradient
+            Eigen::MatrixXd V_xx;            ///< Value function Hessian
+            Eigen::VectorXd l_x;             ///< Running cost state gradient
+            Eigen::VectorXd l_u;             ///< Running cost control gradient
+            Eigen::MatrixXd l_xx;            ///< Running cost state Hessian
+            Eigen::MatrixXd l_uu;            ///< Running cost control Hessian
+            Eigen::MatrixXd l_ux;            ///< Running cost cross Hessian
+            Eigen::MatrixXd V_xx_A;          ///< V_xx * A
+            Eigen::MatrixXd V_xx_B;          ///< V_xx * B
+            Eigen::VectorXd Q_uu_k;          ///< Q_uu * k_u
+            Eigen::MatrixXd Q_uu_K;          ///< Q_uu * K_u
+            Eigen::MatrixXd Q_uu_reg;        ///< Regularized, constrained Q_uu
+            Eigen::MatrixXd V_xx_T;          ///< Transpose scratch for symmetrizing V_xx
+            Eigen::MatrixXd Q_uu_T;          ///< Transpose scratch for symmetrizing Q_uu
+            Eigen::LDLT<Eigen::MatrixXd> ldlt; ///< Constrained Q_uu factorization
+
             // Constraint workspace
-            Eigen::VectorXd y_combined;      ///< Combined dual variables
-            Eigen::VectorXd s_combined;      ///< Combined slack variables
-            Eigen::VectorXd g_combined;      ///< Combined constraint values
-            Eigen::MatrixXd Q_yu_combined;   ///< Combined Q_yu matrix
-            Eigen::MatrixXd Q_yx_combined;   ///< Combined Q_yx matrix
-            Eigen::MatrixXd YSinv;           ///< Y * S^{-1} matrix
+            Eigen::VectorXd YSinv;           ///< Diagonal of Y * S^{-1}
+            Eigen::MatrixXd YSinv_Q_yx;      ///< Y * S^{-1} * Q_yx
+            Eigen::MatrixXd YSinv_Q_yu;      ///< Y * S^{-1} * Q_yu
+            Eigen::VectorXd primal_residual; ///< g + s
+            Eigen::VectorXd complementary_residual; ///< y .* s - mu
+            Eigen::VectorXd rhat;            ///< Barrier-corrected residual
+            Eigen::VectorXd S_inv_rhat;      ///< S^{-1} * rhat
+            Eigen::VectorXd Q_yu_k;          ///< Q_yu * k_u
             Eigen::MatrixXd bigRHS;          ///< RHS matrix for solving
+            Eigen::MatrixXd kK;              ///< Stacked [k_u, K_u] solution
             
             // Forward pass workspace
             std::vector<Eigen::VectorXd> delta_x_vectors; ///< State deviation vectors
@@ -127,6 +166,19 @@ namespace cddp
             bool initialized = false;
         } workspace_;
 
+        // Per-rollout scratch; each concurrent rollout needs its own
+        struct ForwardPassWorkspace {
+            Eigen::VectorXd x;                    ///< State knot passed to callbacks
+            Eigen::VectorXd u;                    ///< Control knot passed to callbacks
+            Eigen::VectorXd delta_x;              ///< Deviation from the nominal state
+            std::vector<Eigen::VectorXd> Y_trial; ///< Duals for the current dual step
+        };
+
+        // Line search buffers, swapped rather than copied between trials
+        ForwardPassResult trial_result_;
+        ForwardPassResult best_result_;
+        ForwardPassWorkspace forward_workspace_;
+
         /**
          * @brief Precompute dynamics derivatives in parallel.
          */
@@ -175,16 +227,22 @@ namespace cddp
 
         /**
          * @brief Perform forward pass with line search.
-         * @return Best result.
+         * @return Best result, owned by the solver and valid until the next call.
          */
-        ForwardPassResult performForwardPass(CDDP &context);
+        ForwardPassResult &performForwardPass(CDDP &context);
 
         /**
          * @brief Single forward pass with given step size.
+         *
+         * Trajectories in @p result are overwritten in place.
          * @param alpha Step size.
-         * @return Forward pass result.
+         * @param result Output forward pass result.
+         * @param ws Scratch vectors for this rollout.
+         * @param use_filter If false, every step that keeps slacks and duals
+         * positive is accepted (real-time iteration).
          */
-        ForwardPassResult forwardPass(CDDP &context, double alpha);
+        void forwardPass(CDDP &context, double alpha, ForwardPassResult &result,
+                         ForwardPassWorkspace &ws, bool use_filter = true);
 
         /**
          * @brief Update barrier parameter.
@@ -192,20 +250,10 @@ namespace cddp
         void updateBarrierParameters(CDDP &context, bool forward_pass_success);
 
         /**
-         * @brief Get total dual dimension.
-         */
-        int getTotalDualDim(const CDDP &context) const;
-
-        /**
-         * @brief Update iteration history if tracking enabled.
+         * @brief Append the current iterate's metrics to @p history.
          */
-        void updateIterationHistory(
-            const CDDPOptions &options, const CDDP &context,
-            std::vector<double> &history_objective, std::vector<double> &history_merit_function,
-            std::vector<double> &history_step_length_primal, std::vector<double> &history_step_length_dual,
-            std::vector<double> &history_dual_infeasibility, std::vector<double> &history_primal_infeasibility,
-            std::vector<double> &history_complementary_infeasibility, std::vector<double> &history_barrier_mu,
-            double alpha_du) const;
+        void updateIterationHistory(const CDDP &context, SolveHistory &history,
+                                    double alpha_du) const;
 
         /**
          * @brief Check convergence criteria.
@@ -243,7 +291,7 @@ namespace cddp
         /**
          * @brief Print solution summary.
          */
-        void printSolutionSummary(const CDDPSolution &solution) const;
+        void printSolutionSummary(const SolveResult &result) const;
         
     };
 
@@ -45,13 +45,15 @@ public:
    */
   void initialize(CDDP &context) override;
 
+  using ISolverAlgorithm::solve;
+
   /**
-   * @brief Execute the LogDDP algorithm and return the solution.
+   * @brief Execute the LogDDP algorithm, writing into @p result.
    * @param context Reference to the CDDP instance containing problem data and
    * options.
-   * @return CDDPSolution containing the results.
+   * @param result Typed solution, overwritten in place.
    */
-  CDDPSolution solve(CDDP &context) override;
+  void solve(CDDP &context, SolveResult &result) override;
 
   /**
    * @brief Get the name of the solver algorithm.
@@ -61,12 +63,13 @@ public:
 
 private:
   // Dynamics storage
-  std::vector<Eigen::VectorXd> F_;                 ///< Dynamics evaluations
-  std::vector<Eigen::MatrixXd> F_x_;               ///< State jacobians (Fx)
-  std::vector<Eigen::MatrixXd> F_u_;               ///< Control jacobians (Fu)
-  std::vector<std::vector<Eigen::MatrixXd>> F_xx_; ///< State hessians (Fxx)
-  std::vector<std::vector<Eigen::MatrixXd>> F_uu_; ///< Control hessians (Fuu)
-  std::vector<std::vector<Eigen::MatrixXd>> F_ux_; ///< Mixed hessians (Fux)
+  Trajectory F_;                                   ///< Dynamics evaluations, contiguous knots
+  std::vector<Eigen::MatrixXd> F_x_;               ///< Discrete state jacobians (dF/dx)
+  std::vector<Eigen::MatrixXd> F_u_;               ///< Discrete control jacobians (dF/du)
+
+  /// True while the derivatives above belong to the current X_/U_; cleared
+  /// whenever the nominal trajectory changes
+  bool derivatives_valid_ = false;
 
   // Control law parameters
   std::vector<Eigen::VectorXd> k_u_; ///< Feedforward control gains
@@ -88,8 +91,8 @@ private:
   int ms_segment_length_; ///< Multi-shooting segment length
 
   /**
-   * @brief Pre-compute dynamics jacobians and hessians for all time steps in
-   * parallel.
+   * @brief Pre-compute dynamics jacobians for all time steps in parallel.
+   * Second-order dynamics terms are contracted in the backward pass instead.
    * @param context Reference to the CDDP context.
    */
   void precomputeDynamicsDerivatives(CDDP &context);
@@ -161,7 +164,7 @@ private:
    * @brief Print solution summary.
    * @param solution The solution to print.
    */
-  void printSolutionSummary(const CDDPSolution &solution) const;
+  void printSolutionSummary(const SolveResult &result) const;
 };
 
 } // namespace cddp
@@ -0,0 +1,124 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef CDDP_MPC_CONTROLLER_HPP
+#define CDDP_MPC_CONTROLLER_HPP
+
+#include "cddp_core/cddp_core.hpp"
+#include <Eigen/Dense>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cddp {
+
+/**
+ * @brief Receding-horizon controller built on a persistent CDDP problem.
+ *
+ * The controller owns a single CDDP instance (and, through it, a single
+ * solver instance) for its whole lifetime. On every call to step() the
+ * previous state, control, dual and slack trajectories are shifted forward
+ * in place and the problem is re-solved from the measured state, so no
+ * problem setup or solver workspace allocation is repeated between ticks.
+ * Each tick's solution is written into the same SolveResult, whose
+ * trajectory and gain buffers are reused as well.
+ */
+class MPCController {
+public:
+  /**
+   * @brief Construct a controller around a fully configured problem.
+   * @param problem CDDP problem with dynamics, objective and constraints set.
+   * @param solver_type Solver used for every tick (e.g. "IPDDP").
+   */
+  explicit MPCController(std::unique_ptr<CDDP> problem,
+                         const std::string &solver_type = "IPDDP");
+
+  /**
+   * @brief Run one control tick.
+   *
+   * Shifts the previous solution by the number of knots elapsed since the
+   * last tick, resets the initial state to @p current_state and re-solves.
+   * All solves after the first one are warm started.
+   * @param current_state Measured state at @p time.
+   * @param time Current time [s].
+   * @return Solution of this tick's solve, valid until the next call to
+   * step() or reset().
+   */
+  const SolveResult &step(const Eigen::VectorXd &current_state, double time);
+
+  /**
+   * @brief Preparation phase of a real-time iteration tick.
+   *
+   * Shifts the previous solution like step() and runs the part of a single
+   * solver iteration that does not need the measurement (see
+   * CDDP::prepare()). Call it while waiting for the state at @p time, then
+   * call feedback() once it arrives. Supported by CLDDP and IPDDP.
+   * @param time Time of the upcoming measurement [s].
+   */
+  void prepare(double time);
+
+  /**
+   * @brief Feedback phase of a real-time iteration tick.
+   * @param current_state Measured state at the time passed to prepare().
+   * @return Solution of this tick, valid until the next call to step(),
+   * feedback() or reset().
+   */
+  const SolveResult &feedback(const Eigen::VectorXd &current_state);
+
+  /**
+   * @brief Update the reference trajectory tracked over the next horizon.
+   *
+   * Keeps the terminal reference of the context and the objective consistent.
+   * @param reference_states Reference states for knots 0..N.
+   */
+  void setReferenceStates(const std::vector<Eigen::VectorXd> &reference_states);
+
+  /**
+   * @brief First control of the most recent solution.
+   */
+  Eigen::VectorXd getControl() const;
+
+  /**
+   * @brief Solution returned by the most recent call to step().
+   */
+  const SolveResult &getLastSolution() const { return last_solution_; }
+
+  /**
+   * @brief Access the underlying problem, e.g. to update constraint parameters.
+   */
+  CDDP &getProblem() { return *problem_; }
+  const CDDP &getProblem() const { return *problem_; }
+
+  /**
+   * @brief Forget the previous solution; the next step() starts cold.
+   */
+  void reset();
+
+private:
+  void advanceTo(double time);
+  void finishTick();
+
+  std::unique_ptr<CDDP> problem_;
+  std::string solver_type_;
+  bool user_warm_start_;    ///< warm_start option as configured by the user
+  bool has_solution_ = false;
+  double last_time_ = 0.0;
+  SolveResult last_solution_;
+};
+
+} // namespace cddp
+
+#endif // CDDP_MPC_CONTROLLER_HPP
@@ -19,7 +19,6 @@
 
 #include "cddp_core/cddp_core.hpp"
 #include <Eigen/Dense>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -46,12 +45,14 @@ namespace cddp
          */
         void initialize(CDDP &context) override;
 
+        using ISolverAlgorithm::solve;
+
         /**
          * @brief Execute MSIPDDP algorithm.
          * @param context CDDP instance with problem data and options.
-         * @return Solution containing trajectories and statistics.
+         * @param result Trajectories and statistics, overwritten in place.
          */
-        CDDPSolution solve(CDDP &context) override;
+        void solve(CDDP &context, SolveResult &result) override;
 
         /**
          * @brief Get solver name.
@@ -59,23 +60,31 @@ namespace cddp
          */
         std::string getSolverName() const override;
 
+        /**
+         * @brief Shift gains, duals and slacks forward for a receding-horizon re-solve.
+         * @param context CDDP instance with problem data and options.
+         * @param steps Number of knots to shift by.
+         */
+        void shift(CDDP &context, int steps) override;
+
     private:
         // Dynamics storage
-        std::vector<Eigen::VectorXd> F_;   ///< Dynamics evaluations
-        std::vector<Eigen::MatrixXd> F_x_;               ///< State jacobians
-        std::vector<Eigen::MatrixXd> F_u_;               ///< Control jacobians
-        std::vector<std::vector<Eigen::MatrixXd>> F_xx_; ///< State hessians
-        std::vector<std::vector<Eigen::MatrixXd>> F_uu_; ///< Control hessians
-        std::vector<std::vector<Eigen::MatrixXd>> F_ux_; ///< Mixed hessians
-
-        // Constraint derivatives
-        std::map<std::string, std::vector<Eigen::MatrixXd>> G_x_; ///< State gradients
-        std::map<std::string, std::vector<Eigen::MatrixXd>> G_u_; ///< Control gradients
-        std::map<std::string, std::vector<std::vector<Eigen::MatrixXd>>>
+        Trajectory F_;                     ///< Dynamics evaluations, contiguous knots
+        std::vector<Eigen::MatrixXd> F_x_;               ///< Discrete state jacobians dF/dx
+        std::vector<Eigen::MatrixXd> F_u_;               ///< Discrete control jacobians dF/du
+
+        // Constraint derivatives, stacked over CDDP::getPathConstraintBlocks()
+        std::vector<Eigen::MatrixXd> G_x_; ///< State gradients (time x [dual_dim x state_dim])
+        std::vector<Eigen::MatrixXd> G_u_; ///< Control gradients (time x [dual_dim x control_dim])
+
+        /// True while the derivatives above belong to the current X_/U_;
+        /// cleared whenever the nominal trajectory changes
+        bool derivatives_valid_ = false;
+        std::vector<std::vector<Eigen::MatrixXd>>
             G_xx_; ///< Constraint state hessians (time x dual_dim)
-        std::map<std::string, std::vector<std::vector<Eigen::MatrixXd>>>
+        std::vector<std::vector<Eigen::MatrixXd>>
             G_uu_; ///< Constraint control hessians (time x dual_dim)
-        std::map<std::string, std::vector<std::vector<Eigen::MatrixXd>>>
+        std::vector<std::vector<Eigen::MatrixXd>>
             G_ux_; ///< Constraint mixed hessians (time x dual_dim)
 
         // Control law
@@ -83,16 +92,16 @@ namespace cddp
         std::vector<Eigen::MatrixXd> K_u_; ///< Feedback gains
         Eigen::Vector2d dV_;               ///< Expected value change
 
-        // Interior point variables
-        std::map<std::string, std::vector<Eigen::VectorXd>> G_; ///< Constraint values
-        std::map<std::string, std::vector<Eigen::VectorXd>> Y_; ///< Dual variables
-        std::map<std::string, std::vector<Eigen::VectorXd>> S_; ///< Slack variables
+        // Interior point variables (one stacked vector per knot)
+        std::vector<Eigen::VectorXd> G_; ///< Constraint values
+        std::vector<Eigen::VectorXd> Y_; ///< Dual variables
+        std::vector<Eigen::VectorXd> S_; ///< Slack variables
 
         // Interior point gains
-        std::map<std::string, std::vector<Eigen::VectorXd>> k_y_; ///< Dual feedforward
-        std::map<std::string, std::vector<Eigen::MatrixXd>> K_y_; ///< Dual feedback
-        std::map<std::string, std::vector<Eigen::VectorXd>> k_s_; ///< Slack feedforward
-        std::map<std::string, std::vector<Eigen::MatrixXd>> K_s_; ///< Slack feedback
+        std::vector<Eigen::VectorXd> k_y_; ///< Dual feedforward
+        std::vector<Eigen::MatrixXd> K_y_; ///< Dual feedback
+        std::vector<Eigen::VectorXd> k_s_; ///< Slack feedforward
+        std::vector<Eigen::MatrixXd> K_s_; ///< Slack feedback
 
         // MSIPDDP-specific costate variables and gains
         std::vector<Eigen::VectorXd>
@@ -112,8 +121,6 @@ namespace cddp
         // Pre-allocated workspace for performance optimization
         struct Workspace {
             // Backward pass workspace
-            std::vector<Eigen::MatrixXd> A_matrices;     ///< A = I + dt*F_x
-            std::vector<Eigen::MatrixXd> B_matrices;     ///< B = dt*F_u
             std::vector<Eigen::MatrixXd> Q_xx_matrices;  ///< Q_xx workspace
             std::vector<Eigen::MatrixXd> Q_ux_matrices;  ///< Q_ux workspace
             std::vector<Eigen::MatrixXd> Q_uu_matrices;  ///< Q_uu workspace
@@ -125,12 +132,9 @@ namespace cddp
             std::vector<bool> ldlt_valid;                            ///< Validity flags for LDLT cache
             
             // Constraint workspace
-            Eigen::VectorXd y_combined;      ///< Combined dual variables
-            Eigen::VectorXd s_combined;      ///< Combined slack variables
-            Eigen::VectorXd g_combined;      ///< Combined constraint values
-            Eigen::MatrixXd Q_yu_combined;   ///< Combined Q_yu matrix
-            Eigen::MatrixXd Q_yx_combined;   ///< Combined Q_yx matrix
-            Eigen::MatrixXd YSinv;           ///< Y * S^{-1} matrix
+            Eigen::VectorXd YSinv;           ///< Diagonal of Y * S^{-1}
+            Eigen::MatrixXd YSinv_Q_yx;      ///< Y * S^{-1} * Q_yx
+            Eigen::MatrixXd YSinv_Q_yu;      ///< Y * S^{-1} * Q_yu
             Eigen::MatrixXd bigRHS;          ///< RHS matrix for solving
             
             // Forward pass workspace
@@ -234,20 +238,10 @@ namespace cddp
         void updateBarrierParameters(CDDP &context, bool forward_pass_success);
 
         /**
-         * @brief Get total dual dimension.
-         */
-        int getTotalDualDim(const CDDP &context) const;
-
-        /**
-         * @brief Update iteration history if tracking enabled.
+         * @brief Append the current iterate's metrics to @p history.
          */
-        void updateIterationHistory(
-            const CDDPOptions &options, const CDDP &context,
-            std::vector<double> &history_objective, std::vector<double> &history_merit_function,
-            std::vector<double> &history_step_length_primal, std::vector<double> &history_step_length_dual,
-            std::vector<double> &history_dual_infeasibility, std::vector<double> &history_primal_infeasibility,
-            std::vector<double> &history_complementary_infeasibility, std::vector<double> &history_barrier_mu,
-            double alpha_du) const;
+        void updateIterationHistory(const CDDP &context, SolveHistory &history,
+                                    double alpha_du) const;
 
         /**
          * @brief Check convergence criteria.
@@ -285,7 +279,7 @@ namespace cddp
         /**
          * @brief Print solution summary.
          */
-        void printSolutionSummary(const CDDPSolution &solution) const;
+        void printSolutionSummary(const SolveResult &result) const;
     };
 
 } // namespace cddp
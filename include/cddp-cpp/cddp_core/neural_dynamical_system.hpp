@@ -104,6 +104,19 @@ public:
                                        const Eigen::VectorXd& control,
                                        double time) const override;
 
+    /**
+     * @brief Jacobians of getDiscreteDynamics, which always steps with Euler
+     *
+     * @param state Current state (Eigen vector)
+     * @param control Current control (Eigen vector)
+     * @param time Current time
+     * @return Tuple of discrete Jacobians (dF/dx, dF/du)
+     */
+    std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+    getDiscreteJacobians(const Eigen::VectorXd& state,
+                         const Eigen::VectorXd& control,
+                         double time) const override;
+
     /**
      * @brief Hessian of the dynamics w.r.t. state
      *
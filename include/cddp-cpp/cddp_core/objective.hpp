@@ -98,6 +98,53 @@ public:
   virtual Eigen::MatrixXd
   getFinalCostHessian(const Eigen::VectorXd &final_state) const = 0;
 
+  // --- In-place evaluation ---
+  // Derivatives written into caller-provided storage so that solver loops can
+  // reuse their workspace: l_x (state_dim), l_u (control_dim), l_xx
+  // (state_dim x state_dim), l_uu (control_dim x control_dim) and l_ux
+  // (control_dim x state_dim). The defaults forward to the returning
+  // functions above.
+
+  // dl/dx, dl/du
+  virtual void
+  evalRunningCostGradientsInto(const Eigen::VectorXd &state,
+                               const Eigen::VectorXd &control, int index,
+                               Eigen::Ref<Eigen::VectorXd> l_x,
+                               Eigen::Ref<Eigen::VectorXd> l_u) const {
+    const auto [grad_x, grad_u] =
+        getRunningCostGradients(state, control, index);
+    l_x = grad_x;
+    l_u = grad_u;
+  }
+
+  // d^2l/dx^2, d^2l/du^2, d^2l/dudx
+  virtual void
+  evalRunningCostHessiansInto(const Eigen::VectorXd &state,
+                              const Eigen::VectorXd &control, int index,
+                              Eigen::Ref<Eigen::MatrixXd> l_xx,
+                              Eigen::Ref<Eigen::MatrixXd> l_uu,
+                              Eigen::Ref<Eigen::MatrixXd> l_ux) const {
+    const auto [hess_xx, hess_uu, hess_ux] =
+        getRunningCostHessians(state, control, index);
+    l_xx = hess_xx;
+    l_uu = hess_uu;
+    l_ux = hess_ux;
+  }
+
+  // dlf/dx
+  virtual void
+  evalFinalCostGradientInto(const Eigen::VectorXd &final_state,
+                            Eigen::Ref<Eigen::VectorXd> lf_x) const {
+    lf_x = getFinalCostGradient(final_state);
+  }
+
+  // d^2lf/dx^2
+  virtual void
+  evalFinalCostHessianInto(const Eigen::VectorXd &final_state,
+                           Eigen::Ref<Eigen::MatrixXd> lf_xx) const {
+    lf_xx = getFinalCostHessian(final_state);
+  }
+
   // Accessors
   virtual Eigen::VectorXd getReferenceState() const { return reference_state_; }
 
@@ -171,6 +218,22 @@ public:
   Eigen::MatrixXd
   getFinalCostHessian(const Eigen::VectorXd &final_state) const override;
 
+  // In-place derivatives; the gradients are matrix-vector products against
+  // the weights, so no error vector is formed
+  void evalRunningCostGradientsInto(const Eigen::VectorXd &state,
+                                    const Eigen::VectorXd &control, int index,
+                                    Eigen::Ref<Eigen::VectorXd> l_x,
+                                    Eigen::Ref<Eigen::VectorXd> l_u) const override;
+  void evalRunningCostHessiansInto(const Eigen::VectorXd &state,
+                                   const Eigen::VectorXd &control, int index,
+                                   Eigen::Ref<Eigen::MatrixXd> l_xx,
+                                   Eigen::Ref<Eigen::MatrixXd> l_uu,
+                                   Eigen::Ref<Eigen::MatrixXd> l_ux) const override;
+  void evalFinalCostGradientInto(const Eigen::VectorXd &final_state,
+                                 Eigen::Ref<Eigen::VectorXd> lf_x) const override;
+  void evalFinalCostHessianInto(const Eigen::VectorXd &final_state,
+                                Eigen::Ref<Eigen::MatrixXd> lf_xx) const override;
+
   // Accessors
   const Eigen::MatrixXd &getQ() const { return Q_; }
   const Eigen::MatrixXd &getR() const { return R_; }
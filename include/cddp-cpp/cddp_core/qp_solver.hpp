@@ -62,6 +62,11 @@ struct QPResult {
  * Solves problems of the form:
  * minimize    1/2 x'Qx + c'x
  * subject to  Ax <= b
+ *
+ * The problem is mapped to a minimum-norm problem through the Cholesky
+ * factor of Q and solved by Seidel's randomized incremental algorithm,
+ * which is fast for few variables. All workspace is allocated in
+ * setDimensions().
  */
 class QPSolver {
 public:
@@ -99,10 +104,39 @@ public:
 
   /**
    * @brief Solve the QP problem
+   *
+   * With options.warm_start, the constraints active at the previous
+   * solution are processed first.
+   *
    * @return QPResult containing solution and status
    */
   QPResult solve();
 
+  /**
+   * @brief Solve the QP given by the arguments without copying it
+   *
+   * Sizes must match setDimensions().
+   *
+   * @param Q Quadratic cost matrix (must be positive definite)
+   * @param c Linear cost vector
+   * @param A Constraint matrix
+   * @param b Constraint vector
+   * @param x Solution (num_vars)
+   * @param basis Constraint indices, -1 for unused entries (num_vars). With
+   *        options.warm_start they are processed first; on return they are
+   *        the constraints active at the solution.
+   * @return Solution status
+   */
+  QPStatus solve(const Eigen::Ref<const Eigen::MatrixXd> &Q,
+                 const Eigen::Ref<const Eigen::VectorXd> &c,
+                 const Eigen::Ref<const Eigen::MatrixXd> &A,
+                 const Eigen::Ref<const Eigen::VectorXd> &b,
+                 Eigen::Ref<Eigen::VectorXd> x,
+                 Eigen::Ref<Eigen::VectorXi> basis);
+
+  /// Constraints violated along the way in the last solve
+  int getIterations() const { return iterations_; }
+
 private:
   QPSolverOptions options_;
   int num_vars_;
@@ -112,25 +146,46 @@ private:
   Eigen::VectorXd c_; // Linear cost vector
   Eigen::MatrixXd A_; // Constraint matrix
   Eigen::VectorXd b_; // Constraint vector
+  Eigen::VectorXi basis_; // Active constraints of the last solve()
 
   // Work matrices/vectors
-  Eigen::MatrixXd halves_;
-  std::vector<Eigen::VectorXd> work_vectors_;
-  std::vector<int> work_indices_;
+  Eigen::LLT<Eigen::MatrixXd> llt_;
+  Eigen::MatrixXd As_;    // A U^{-1} for Q = U'U
+  Eigen::VectorXd v_;     // Q^{-1} c
+  Eigen::VectorXd bs_;    // A v + b
+  Eigen::VectorXi order_; // Constraint held by each column of the halves
+
+  // Minimum-norm problem in d variables: column j of halves is the
+  // halfspace [a; b] : a'y + b <= 0, normalized so that |a| = 1 at d =
+  // num_vars_
+  struct MinNormLevel {
+    Eigen::MatrixXd halves; // (d + 1) x num_constraints
+    Eigen::VectorXd x;      // Solution
+    Eigen::VectorXd reflx;  // Householder vector
+    Eigen::VectorXd lifted; // Sub-solution mapped back to d variables
+  };
+  std::vector<MinNormLevel> levels_; // Indexed by d
+  Eigen::VectorXi next_, prev_;      // Constraint processing order
+  Eigen::VectorXi marked_;
+  int iterations_ = 0;
 
   /**
    * @brief Solve minimum norm problem (internal)
-   * @param x Solution vector
-   * @return QPStatus solution status
+   *
+   * Processes the first m constraints of the list in next_, recursing into
+   * dimension d - 1 on the plane of each violated constraint.
+   *
+   * @param d Number of variables
+   * @param m End of the constraint list
+   * @return QPStatus solution status; the solution is levels_[d].x
    */
-  QPStatus solveMinNorm(Eigen::VectorXd &x);
+  QPStatus solveMinNorm(int d, int m);
 
   /**
-   * @brief Generate random permutation (internal)
-   * @param n Size of permutation
-   * @param perm Output permutation vector
+   * @brief Shuffle order_ from position begin on (internal)
+   * @param begin First position to shuffle
    */
-  void generateRandomPermutation(int n, Eigen::VectorXi &perm);
+  void generateRandomPermutation(int begin);
 
   /**
    * @brief Move element to front of linked list (internal)
@@ -145,6 +200,71 @@ private:
   std::mt19937 rng_;
 };
 
+class ThreadPool;
+
+/**
+ * @brief Solves many QPs of the same size stored side by side
+ *
+ * Problem k of a batch of N with n variables uses Q.middleCols(k * n, n),
+ * c.col(k), A.middleCols(k * n, n) and b.col(k), and its solution goes to
+ * X.col(k). Each problem remembers its active constraints, which seed the
+ * next solve of a batch of the same size when options.warm_start is set
+ * (e.g. per-knot QPs across successive iterations).
+ */
+class BatchQPSolver {
+public:
+  explicit BatchQPSolver(const QPSolverOptions &options = QPSolverOptions());
+
+  /**
+   * @brief Set the dimensions shared by all problems
+   * @param num_vars Number of variables
+   * @param num_constraints Number of constraints
+   */
+  void setDimensions(int num_vars, int num_constraints);
+
+  /**
+   * @brief Solve every problem of the batch
+   *
+   * @param Q Quadratic cost matrices, num_vars x (N * num_vars)
+   * @param c Linear cost vectors, num_vars x N
+   * @param A Constraint matrices, num_constraints x (N * num_vars)
+   * @param b Constraint vectors, num_constraints x N
+   * @param X Solutions, num_vars x N
+   * @param status Status of each problem, resized to N
+   * @param pool If given, contiguous chunks of the batch are solved on its
+   *        workers
+   */
+  void solve(const Eigen::Ref<const Eigen::MatrixXd> &Q,
+             const Eigen::Ref<const Eigen::MatrixXd> &c,
+             const Eigen::Ref<const Eigen::MatrixXd> &A,
+             const Eigen::Ref<const Eigen::MatrixXd> &b,
+             Eigen::Ref<Eigen::MatrixXd> X, std::vector<QPStatus> &status,
+             ThreadPool *pool = nullptr);
+
+  /// Active constraints of each problem after the last solve, one column
+  /// per problem, -1 for unused entries
+  const Eigen::MatrixXi &getBases() const { return bases_; }
+
+  /// Forget the stored active sets
+  void resetWarmStart() { bases_.setConstant(-1); }
+
+private:
+  QPSolverOptions options_;
+  int num_vars_ = 0;
+  int num_constraints_ = 0;
+
+  std::vector<std::unique_ptr<QPSolver>> solvers_; // One per task
+  Eigen::MatrixXi bases_;
+
+  void solveRange(QPSolver &solver, int begin, int end,
+                  const Eigen::Ref<const Eigen::MatrixXd> &Q,
+                  const Eigen::Ref<const Eigen::MatrixXd> &c,
+                  const Eigen::Ref<const Eigen::MatrixXd> &A,
+                  const Eigen::Ref<const Eigen::MatrixXd> &b,
+                  Eigen::Ref<Eigen::MatrixXd> X,
+                  std::vector<QPStatus> &status);
+};
+
 } // namespace cddp
 
 #endif // CDDP_QP_SOLVER_HPP
\ No newline at end of file
@@ -0,0 +1,176 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef CDDP_SOLVE_RESULT_HPP
+#define CDDP_SOLVE_RESULT_HPP
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cddp_core/trajectory.hpp"
+
+namespace cddp {
+
+/**
+ * @brief Per-iteration solver history, indexed by iteration number.
+ *
+ * Each solver records only the series it tracks; the others stay empty.
+ */
+struct SolveHistory {
+  std::vector<double> objective;
+  std::vector<double> merit_function;
+  std::vector<double> lagrangian;           ///< Augmented Lagrangian (ALDDP)
+  std::vector<double> step_length_primal;
+  std::vector<double> step_length_dual;
+  std::vector<double> primal_infeasibility;
+  std::vector<double> dual_infeasibility;
+  std::vector<double> complementary_infeasibility;
+  std::vector<double> barrier_mu;
+  std::vector<double> penalty_parameter;    ///< Penalty parameter (ALDDP)
+  std::vector<double> regularization;       ///< Control regularization
+
+  /// Empty every series, keeping its capacity.
+  void clear() {
+    for (std::vector<double> *series : seriesList()) {
+      series->clear();
+    }
+  }
+
+  /// Reserve @p capacity entries in every series.
+  void reserve(std::size_t capacity) {
+    for (std::vector<double> *series : seriesList()) {
+      series->reserve(capacity);
+    }
+  }
+
+private:
+  std::array<std::vector<double> *, 11> seriesList() {
+    return {&objective,           &merit_function,
+            &lagrangian,          &step_length_primal,
+            &step_length_dual,    &primal_infeasibility,
+            &dual_infeasibility,  &complementary_infeasibility,
+            &barrier_mu,          &penalty_parameter,
+            &regularization};
+  }
+};
+
+/**
+ * @brief Strongly typed result of a CDDP solve.
+ *
+ * Trajectories are stored contiguously and read in place, so a caller never
+ * has to any_cast and copy them out. A SolveResult passed back into
+ * CDDP::solve() is overwritten in place: once its buffers have the right
+ * shape, re-solving the same problem (e.g. on every MPC tick) copies the
+ * solution into existing storage instead of allocating a new one.
+ *
+ * The string-keyed CDDPSolution map is still available through
+ * toSolution().
+ */
+struct SolveResult {
+  // --- General information ---
+  std::string solver_name;
+  /// Termination status, e.g. "OptimalSolutionFound", "MaxIterationsReached".
+  std::string status_message;
+  int iterations_completed = 0;
+  double solve_time_ms = 0.0;
+  double final_objective = 0.0;
+  double final_step_length = 1.0;
+
+  // --- Primary solution trajectories ---
+  std::vector<double> time_points;     ///< t_0..t_N
+  Trajectory state_trajectory;         ///< X_0..X_N
+  Trajectory control_trajectory;       ///< U_0..U_{N-1}
+  std::vector<Eigen::MatrixXd> control_feedback_gains_K; ///< K_0..K_{N-1}
+
+  // --- Final metrics, set only by solvers that compute them ---
+  std::optional<double> final_regularization;
+  std::optional<double> final_primal_infeasibility;
+  std::optional<double> final_dual_infeasibility;
+  std::optional<double> final_complementary_infeasibility;
+  std::optional<double> final_barrier_parameter_mu;
+  std::optional<double> final_penalty_parameter;
+  std::optional<double> final_lagrangian;
+
+  /// Iteration history; present only if options.return_iteration_info is set.
+  std::optional<SolveHistory> history;
+
+  /// True if the solver terminated with an optimal or acceptable solution.
+  bool converged() const {
+    return status_message == "OptimalSolutionFound" ||
+           status_message == "AcceptableSolutionFound";
+  }
+
+  /**
+   * @brief Prepare for a new solve by @p name.
+   *
+   * Resets the status and final metrics. Trajectory, gain and history
+   * buffers keep their storage so they can be overwritten in place.
+   * @param name Solver name.
+   * @param record_history Whether history should be recorded.
+   * @param history_capacity Entries to reserve per history series.
+   */
+  void beginSolve(const std::string &name, bool record_history,
+                  std::size_t history_capacity = 0) {
+    solver_name = name;
+    status_message = "Running";
+    iterations_completed = 0;
+    solve_time_ms = 0.0;
+    final_objective = 0.0;
+    final_step_length = 1.0;
+    final_regularization.reset();
+    final_primal_infeasibility.reset();
+    final_dual_infeasibility.reset();
+    final_complementary_infeasibility.reset();
+    final_barrier_parameter_mu.reset();
+    final_penalty_parameter.reset();
+    final_lagrangian.reset();
+    if (!record_history) {
+      history.reset();
+    } else if (history) {
+      history->clear();
+      history->reserve(history_capacity);
+    } else {
+      history.emplace();
+      history->reserve(history_capacity);
+    }
+  }
+
+  /// Fill time_points with t_k = k * timestep for k = 0..horizon.
+  void setTimePoints(int horizon, double timestep) {
+    time_points.resize(static_cast<std::size_t>(horizon) + 1);
+    for (int t = 0; t <= horizon; ++t) {
+      time_points[t] = t * timestep;
+    }
+  }
+
+  /// Copy feedback gains into control_feedback_gains_K, reusing storage.
+  template <typename GainContainer>
+  void setFeedbackGains(const GainContainer &gains) {
+    control_feedback_gains_K.resize(gains.size());
+    std::size_t t = 0;
+    for (const auto &gain : gains) {
+      control_feedback_gains_K[t++] = gain;
+    }
+  }
+};
+
+} // namespace cddp
+
+#endif // CDDP_SOLVE_RESULT_HPP
@@ -0,0 +1,140 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef CDDP_TEMPLATED_DYNAMICAL_SYSTEM_HPP
+#define CDDP_TEMPLATED_DYNAMICAL_SYSTEM_HPP
+
+#include "cddp_core/dynamical_system.hpp"
+
+namespace cddp {
+
+/**
+ * @brief Base for models whose continuous dynamics are written once for any
+ * scalar type.
+ *
+ * The derived model implements
+ * @code
+ * template <typename Scalar>
+ * Eigen::Matrix<Scalar, Eigen::Dynamic, 1>
+ * dynamics(const Eigen::Matrix<Scalar, Eigen::Dynamic, 1> &state,
+ *          const Eigen::Matrix<Scalar, Eigen::Dynamic, 1> &control,
+ *          double time) const;
+ * @endcode
+ * and this class instantiates it with:
+ * - double for getContinuousDynamics() and evalContinuousDynamicsInto() (and
+ *   thus the integrators),
+ * - first-order autodiff::dual for the Jacobians, evaluated in one pass over
+ *   [x, u],
+ * - autodiff::dual2nd only for getContinuousDynamicsAutodiff() and the
+ *   Hessians.
+ *
+ * Writing the dynamics once keeps the double and autodiff paths from
+ * drifting apart, and first-order duals are much cheaper than dual2nd on the
+ * Jacobian path that every solver iteration runs.
+ *
+ * A model that defines dynamics() in its .cpp must explicitly instantiate it
+ * for double, autodiff::dual and autodiff::dual2nd.
+ */
+template <typename Derived>
+class TemplatedDynamicalSystem : public DynamicalSystem {
+public:
+  using DynamicalSystem::DynamicalSystem;
+
+  Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd &state,
+                                        const Eigen::VectorXd &control,
+                                        double time) const override {
+    return derived().template dynamics<double>(state, control, time);
+  }
+
+  void
+  evalContinuousDynamicsInto(const Eigen::VectorXd &state,
+                             const Eigen::VectorXd &control, double time,
+                             Eigen::Ref<Eigen::VectorXd> state_dot) const override {
+    state_dot = derived().template dynamics<double>(state, control, time);
+  }
+
+  VectorXdual2nd getContinuousDynamicsAutodiff(const VectorXdual2nd &state,
+                                               const VectorXdual2nd &control,
+                                               double time) const override {
+    return derived().template dynamics<autodiff::dual2nd>(state, control,
+                                                          time);
+  }
+
+  Eigen::MatrixXd getStateJacobian(const Eigen::VectorXd &state,
+                                   const Eigen::VectorXd &control,
+                                   double time) const override {
+    return std::get<0>(getJacobians(state, control, time));
+  }
+
+  Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd &state,
+                                     const Eigen::VectorXd &control,
+                                     double time) const override {
+    return std::get<1>(getJacobians(state, control, time));
+  }
+
+  std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+  getJacobians(const Eigen::VectorXd &state, const Eigen::VectorXd &control,
+               double time) const override {
+    Eigen::MatrixXd A(state_dim_, state_dim_);
+    Eigen::MatrixXd B(state_dim_, control_dim_);
+    evalJacobiansInto(state, control, time, A, B);
+    return {A, B};
+  }
+
+  void evalJacobiansInto(const Eigen::VectorXd &state,
+                         const Eigen::VectorXd &control, double time,
+                         Eigen::Ref<Eigen::MatrixXd> A,
+                         Eigen::Ref<Eigen::MatrixXd> B) const override {
+    const int n = state_dim_;
+    const int m = control_dim_;
+
+    // One first-order sweep over z = [x, u] gives [df/dx, df/du]
+    VectorXdual z(n + m);
+    z.head(n) = state.cast<autodiff::dual>();
+    z.tail(m) = control.cast<autodiff::dual>();
+    auto f = [&](const VectorXdual &z_ad) -> VectorXdual {
+      VectorXdual x_ad = z_ad.head(n);
+      VectorXdual u_ad = z_ad.tail(m);
+      return derived().template dynamics<autodiff::dual>(x_ad, u_ad, time);
+    };
+    const Eigen::MatrixXd J =
+        autodiff::jacobian(f, autodiff::wrt(z), autodiff::at(z));
+    A = J.leftCols(n);
+    B = J.rightCols(m);
+  }
+
+  std::tuple<std::vector<Eigen::MatrixXd>, std::vector<Eigen::MatrixXd>,
+             std::vector<Eigen::MatrixXd>>
+  getHessians(const Eigen::VectorXd &state, const Eigen::VectorXd &control,
+              double time) const override {
+    return getHessiansAutodiff(state, control, time);
+  }
+
+  std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+  getHessianContraction(const Eigen::VectorXd &state,
+                        const Eigen::VectorXd &control,
+                        const Eigen::VectorXd &lambda,
+                        double time) const override {
+    return getHessianContractionAutodiff(state, control, lambda, time);
+  }
+
+protected:
+  const Derived &derived() const { return static_cast<const Derived &>(*this); }
+};
+
+} // namespace cddp
+
+#endif // CDDP_TEMPLATED_DYNAMICAL_SYSTEM_HPP
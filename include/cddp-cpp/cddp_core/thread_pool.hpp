@@ -0,0 +1,96 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef CDDP_THREAD_POOL_HPP
+#define CDDP_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cddp {
+
+/**
+ * @brief Persistent work-stealing thread pool.
+ *
+ * Each worker owns a task deque. Tasks submitted from a worker go to that
+ * worker's own deque; tasks submitted from other threads are distributed
+ * round-robin. Idle workers steal from the front of other workers' deques.
+ * Workers are created once and live as long as the pool.
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Create a pool with the given number of worker threads.
+   * @param num_threads Number of workers (at least one is created).
+   */
+  explicit ThreadPool(int num_threads);
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Number of worker threads.
+   */
+  int size() const { return static_cast<int>(workers_.size()); }
+
+  /**
+   * @brief Submit a callable for execution.
+   * @param f Callable taking no arguments.
+   * @return Future holding the callable's result (or exception).
+   */
+  template <typename F>
+  auto submit(F &&f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    auto task =
+        std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+    std::future<R> result = task->get_future();
+    enqueue([task]() { (*task)(); });
+    return result;
+  }
+
+private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void enqueue(std::function<void()> task);
+  bool popTask(int index, std::function<void()> &task);
+  void workerLoop(int index);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<int> pending_{0};
+  std::atomic<unsigned> next_queue_{0};
+  bool stop_ = false;
+};
+
+} // namespace cddp
+
+#endif // CDDP_THREAD_POOL_HPP
@@ -0,0 +1,203 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef CDDP_TRAJECTORY_HPP
+#define CDDP_TRAJECTORY_HPP
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cddp {
+
+/**
+ * @brief Sequence of equally sized knot vectors stored contiguously.
+ *
+ * Knots are the columns of a single column-major (dim x length) matrix, so a
+ * whole trajectory is one allocation and walking it is a linear scan.
+ * Indexing returns a column view into that storage rather than a copy.
+ *
+ * The container mirrors the parts of the std::vector<Eigen::VectorXd>
+ * interface used throughout the solvers (size, operator[], front, back,
+ * resize, ...) and converts to and from std::vector<Eigen::VectorXd> for
+ * user-facing APIs.
+ */
+class Trajectory {
+public:
+  using ColumnView = Eigen::MatrixXd::ColXpr;
+  using ConstColumnView = Eigen::MatrixXd::ConstColXpr;
+
+  Trajectory() = default;
+
+  /**
+   * @brief Create a trajectory of @p length zero knots of dimension @p dim.
+   */
+  Trajectory(int dim, std::size_t length)
+      : data_(Eigen::MatrixXd::Zero(dim, static_cast<Eigen::Index>(length))) {}
+
+  /**
+   * @brief Create a trajectory of @p length copies of @p value.
+   */
+  Trajectory(std::size_t length, const Eigen::VectorXd &value)
+      : data_(value.replicate(1, static_cast<Eigen::Index>(length))) {}
+
+  /**
+   * @brief Pack a vector of knots into contiguous storage.
+   * @throws std::invalid_argument if the knots differ in size.
+   */
+  Trajectory(const std::vector<Eigen::VectorXd> &knots) { assign(knots); }
+
+  /**
+   * @brief Unpack into a vector of knots (one allocation per knot).
+   */
+  operator std::vector<Eigen::VectorXd>() const { return toVector(); }
+
+  std::vector<Eigen::VectorXd> toVector() const {
+    std::vector<Eigen::VectorXd> knots;
+    knots.reserve(size());
+    for (Eigen::Index k = 0; k < data_.cols(); ++k) {
+      knots.emplace_back(data_.col(k));
+    }
+    return knots;
+  }
+
+  void assign(const std::vector<Eigen::VectorXd> &knots) {
+    const Eigen::Index dim = knots.empty() ? 0 : knots.front().size();
+    data_.resize(dim, static_cast<Eigen::Index>(knots.size()));
+    for (std::size_t k = 0; k < knots.size(); ++k) {
+      if (knots[k].size() != dim) {
+        throw std::invalid_argument(
+            "Trajectory: knot " + std::to_string(k) + " has size " +
+            std::to_string(knots[k].size()) + ", expected " +
+            std::to_string(dim));
+      }
+      data_.col(static_cast<Eigen::Index>(k)) = knots[k];
+    }
+  }
+
+  void assign(std::size_t length, const Eigen::VectorXd &value) {
+    resize(static_cast<int>(value.size()), length);
+    data_.colwise() = value;
+  }
+
+  /// Number of knots.
+  std::size_t size() const { return static_cast<std::size_t>(data_.cols()); }
+  bool empty() const { return data_.cols() == 0; }
+  /// Dimension of every knot.
+  int dim() const { return static_cast<int>(data_.rows()); }
+
+  ColumnView operator[](std::size_t k) {
+    return data_.col(static_cast<Eigen::Index>(k));
+  }
+  ConstColumnView operator[](std::size_t k) const {
+    return data_.col(static_cast<Eigen::Index>(k));
+  }
+
+  ColumnView at(std::size_t k) {
+    checkIndex(k);
+    return (*this)[k];
+  }
+  ConstColumnView at(std::size_t k) const {
+    checkIndex(k);
+    return (*this)[k];
+  }
+
+  ColumnView front() { return (*this)[0]; }
+  ConstColumnView front() const { return (*this)[0]; }
+  ColumnView back() { return (*this)[size() - 1]; }
+  ConstColumnView back() const { return (*this)[size() - 1]; }
+
+  /**
+   * @brief Resize to @p length knots of dimension @p dim.
+   *
+   * Storage is kept when the shape is unchanged. When only the length
+   * changes, existing knots are preserved and new knots are zero.
+   */
+  void resize(int dim, std::size_t length) {
+    const Eigen::Index cols = static_cast<Eigen::Index>(length);
+    if (data_.rows() == dim && data_.cols() == cols) {
+      return;
+    }
+    if (data_.rows() == dim) {
+      const Eigen::Index old_cols = data_.cols();
+      data_.conservativeResize(Eigen::NoChange, cols);
+      if (cols > old_cols) {
+        data_.rightCols(cols - old_cols).setZero();
+      }
+    } else {
+      data_ = Eigen::MatrixXd::Zero(dim, cols);
+    }
+  }
+
+  /// Resize keeping the current knot dimension.
+  void resize(std::size_t length) { resize(dim(), length); }
+
+  void clear() { data_.resize(dim(), 0); }
+
+  void setZero() { data_.setZero(); }
+
+  /**
+   * @brief Advance by @p steps knots in place.
+   *
+   * Knots are moved towards the front and the vacated tail is filled with the
+   * last valid knot. No storage is reallocated.
+   */
+  void shift(int steps) {
+    const Eigen::Index n = data_.cols();
+    if (n == 0 || steps <= 0) {
+      return;
+    }
+    const Eigen::Index s = std::min<Eigen::Index>(steps, n - 1);
+    double *begin = data_.data();
+    std::copy(begin + s * data_.rows(), begin + n * data_.rows(), begin);
+    for (Eigen::Index k = n - s; k < n; ++k) {
+      data_.col(k) = data_.col(n - s - 1);
+    }
+  }
+
+  void swap(Trajectory &other) noexcept { data_.swap(other.data_); }
+
+  /// Underlying (dim x length) storage.
+  Eigen::MatrixXd &matrix() { return data_; }
+  const Eigen::MatrixXd &matrix() const { return data_; }
+
+private:
+  void checkIndex(std::size_t k) const {
+    if (k >= size()) {
+      throw std::out_of_range("Trajectory: index " + std::to_string(k) +
+                              " out of range (size " + std::to_string(size()) +
+                              ")");
+    }
+  }
+
+  Eigen::MatrixXd data_;
+};
+
+inline void swap(Trajectory &a, Trajectory &b) noexcept { a.swap(b); }
+
+/**
+ * @brief Shift a trajectory forward by @p steps knots in place.
+ */
+inline void shiftTrajectory(Trajectory &trajectory, int steps) {
+  trajectory.shift(steps);
+}
+
+} // namespace cddp
+
+#endif // CDDP_TRAJECTORY_HPP
@@ -17,7 +17,7 @@
 #ifndef CDDP_ACROBOT_HPP
 #define CDDP_ACROBOT_HPP
 
-#include "cddp_core/dynamical_system.hpp"
+#include "cddp_core/templated_dynamical_system.hpp"
 
 namespace cddp {
 
@@ -28,9 +28,11 @@ namespace cddp {
  * State vector: [theta1, theta2, theta1_dot, theta2_dot]
  * Control vector: [torque] (applied to second joint only)
  * 
- * This implementation follows the Julia RobotZoo.jl Acrobot model.
+ * This implementation follows the Julia RobotZoo.jl Acrobot model. The
+ * dynamics are written once in dynamics<Scalar>(); derivatives come from
+ * TemplatedDynamicalSystem.
  */
-class Acrobot : public DynamicalSystem {
+class Acrobot : public TemplatedDynamicalSystem<Acrobot> {
 public:
     /**
      * @brief Constructor for the acrobot model
@@ -50,14 +52,17 @@ public:
             std::string integration_type = "euler");
 
     /**
-     * @brief Computes the continuous-time dynamics of the acrobot
+     * @brief Continuous-time dynamics of the acrobot for any scalar type
      * @param state Current state vector
      * @param control Current control input
      * @param time Current time (unused in this model)
      * @return State derivative vector
      */
-    Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd& state, 
-                                         const Eigen::VectorXd& control, double time) const override;
+    template <typename Scalar>
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 1>
+    dynamics(const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& state,
+             const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& control,
+             double time) const;
 
     /**
      * @brief Computes the discrete-time dynamics using the specified integration method
@@ -72,39 +77,20 @@ public:
     }
 
     /**
-     * @brief Computes the Jacobian of the dynamics with respect to the state
-     * Uses base class autodiff implementation
+     * @brief In-place getDiscreteDynamics and getDiscreteJacobians through the
+     * integrator
      */
-    Eigen::MatrixXd getStateJacobian(const Eigen::VectorXd& state, 
-                                    const Eigen::VectorXd& control, double time) const override {
-        return DynamicalSystem::getStateJacobian(state, control, time);
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override {
+        integrateInto(state, control, time, next_state);
     }
 
-    /**
-     * @brief Computes the Jacobian of the dynamics with respect to the control input
-     * Uses base class autodiff implementation
-     */
-    Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd& state, 
-                                      const Eigen::VectorXd& control, double time) const override {
-        return DynamicalSystem::getControlJacobian(state, control, time);
-    }
-
-    /**
-     * @brief Computes the Hessian of the dynamics with respect to the state
-     * Uses base class autodiff implementation
-     */
-    std::vector<Eigen::MatrixXd> getStateHessian(const Eigen::VectorXd& state, 
-                                                const Eigen::VectorXd& control, double time) const override {
-        return DynamicalSystem::getStateHessian(state, control, time);
-    }
-
-    /**
-     * @brief Computes the Hessian of the dynamics with respect to the control
-     * Uses base class autodiff implementation
-     */
-    std::vector<Eigen::MatrixXd> getControlHessian(const Eigen::VectorXd& state, 
-                                                  const Eigen::VectorXd& control, double time) const override {
-        return DynamicalSystem::getControlHessian(state, control, time);
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override {
+        integrateJacobiansInto(state, control, time, A, B);
     }
 
     // Getters
@@ -121,12 +107,6 @@ public:
     double getGravity() const { return gravity_; }
     double getFriction() const { return friction_; }
 
-    /**
-     * @brief Autodiff implementation for automatic differentiation
-     */
-    VectorXdual2nd getContinuousDynamicsAutodiff(
-        const VectorXdual2nd& state, const VectorXdual2nd& control, double time) const override;
-
 private:
     // Acrobot parameters
     double l1_;   // length of link 1 [m]
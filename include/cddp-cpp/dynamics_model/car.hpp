@@ -77,6 +77,22 @@ public:
     Eigen::VectorXd getDiscreteDynamics(const Eigen::VectorXd& state, 
                                        const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief getDiscreteDynamics written into next_state (STATE_DIM)
+     */
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override;
+
+    /**
+     * @brief Discrete dynamics of N knots packed as columns, with the
+     * rolling-distance geometry evaluated as array operations over the batch
+     */
+    void getDiscreteDynamicsBatch(const Eigen::Ref<const Eigen::MatrixXd>& states,
+                                  const Eigen::Ref<const Eigen::MatrixXd>& controls,
+                                  const Eigen::Ref<const Eigen::VectorXd>& times,
+                                  Eigen::Ref<Eigen::MatrixXd> next_states) const override;
+
     /**
      * @brief Computes the Jacobian of the dynamics with respect to the state
      * @param state Current state vector
@@ -97,6 +113,35 @@ public:
     Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd& state, 
                                       const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Computes both Jacobians from a single autodiff pass over [x, u]
+     * @param state Current state vector
+     * @param control Current control input
+     * @param time Current time
+     * @return Tuple of state and control Jacobians (df/dx, df/du)
+     */
+    std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> getJacobians(const Eigen::VectorXd& state,
+                                                              const Eigen::VectorXd& control, double time) const override;
+
+    /**
+     * @brief Computes the Jacobians of getDiscreteDynamics directly
+     * @param state Current state vector
+     * @param control Current control input
+     * @param time Current time
+     * @return Tuple of discrete state and control Jacobians (dF/dx, dF/du)
+     */
+    std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> getDiscreteJacobians(const Eigen::VectorXd& state,
+                                                                      const Eigen::VectorXd& control, double time) const override;
+
+    /**
+     * @brief getDiscreteJacobians written into A (STATE_DIM x STATE_DIM) and
+     * B (STATE_DIM x CONTROL_DIM)
+     */
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override;
+
     /**
      * @brief Computes the Hessian of the dynamics with respect to the state
      * @param state Current state vector
@@ -17,7 +17,7 @@
 #ifndef CDDP_CARTPOLE_HPP
 #define CDDP_CARTPOLE_HPP
 
-#include "cddp_core/dynamical_system.hpp"
+#include "cddp_core/templated_dynamical_system.hpp"
 
 namespace cddp {
 
@@ -33,8 +33,11 @@ namespace cddp {
  * - theta_dot: Pole angular velocity
  * Control: [force]
  * - force: Force applied to cart
+ *
+ * The dynamics are written once in dynamics<Scalar>(); derivatives come from
+ * TemplatedDynamicalSystem.
  */
-class CartPole : public DynamicalSystem {
+class CartPole : public TemplatedDynamicalSystem<CartPole> {
 public:
     /**
      * @brief Constructs a CartPole system with configurable parameters
@@ -55,24 +58,17 @@ public:
              double damping = 0.0);
 
     /**
-     * @brief Computes continuous-time system dynamics
+     * @brief Continuous-time system dynamics for any scalar type
      * @param state Current state vector
      * @param control Current control input
      * @param time Current time
      * @return State derivative vector
      */
-    Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd& state, 
-                                         const Eigen::VectorXd& control, double time) const override;
-
-    /**
-     * @brief Computes continuous-time system dynamics using autodiff
-     * @param state Current state vector
-     * @param control Current control input
-     * @param time Current time
-     * @return State derivative vector
-     */
-    VectorXdual2nd getContinuousDynamicsAutodiff(const VectorXdual2nd& state, 
-                                                const VectorXdual2nd& control, double time) const override;
+    template <typename Scalar>
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 1>
+    dynamics(const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& state,
+             const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& control,
+             double time) const;
 
     /**
      * @brief Computes discrete-time system dynamics
@@ -87,44 +83,21 @@ public:
     }
 
     /**
-     * @brief Computes state Jacobian matrix (∂f/∂x)
-     * @param state Current state vector
-     * @param control Current control input
-     * @param time Current time
-     * @return State Jacobian matrix
+     * @brief In-place getDiscreteDynamics and getDiscreteJacobians through the
+     * integrator
      */
-    Eigen::MatrixXd getStateJacobian(const Eigen::VectorXd& state, 
-                                    const Eigen::VectorXd& control, double time) const override;
-
-    /**
-     * @brief Computes control Jacobian matrix (∂f/∂u)
-     * @param state Current state vector
-     * @param control Current control input
-     * @param time Current time
-     * @return Control Jacobian matrix
-     */
-    Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd& state, 
-                                      const Eigen::VectorXd& control, double time) const override;
-
-    /**
-     * @brief Computes state Hessian tensor (∂²f/∂x²)
-     * @param state Current state vector
-     * @param control Current control input
-     * @param time Current time
-     * @return Vector of state Hessian matrices, one per state dimension
-     */
-    std::vector<Eigen::MatrixXd> getStateHessian(const Eigen::VectorXd& state, 
-                                   const Eigen::VectorXd& control, double time) const override;
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override {
+        integrateInto(state, control, time, next_state);
+    }
 
-    /**
-     * @brief Computes control Hessian tensor (∂²f/∂u²)
-     * @param state Current state vector
-     * @param control Current control input
-     * @param time Current time
-     * @return Vector of control Hessian matrices, one per state dimension
-     */
-    std::vector<Eigen::MatrixXd> getControlHessian(const Eigen::VectorXd& state, 
-                                     const Eigen::VectorXd& control, double time) const override;
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override {
+        integrateJacobiansInto(state, control, time, A, B);
+    }
 
     // Getters
     double getCartMass() const { return cart_mass_; }
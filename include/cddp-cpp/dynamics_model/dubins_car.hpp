@@ -54,6 +54,13 @@ public:
     Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd& state,
                                           const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Writes the continuous-time dynamics into state_dot (STATE_DIM)
+     */
+    void evalContinuousDynamicsInto(const Eigen::VectorXd& state,
+                                    const Eigen::VectorXd& control, double time,
+                                    Eigen::Ref<Eigen::VectorXd> state_dot) const override;
+
     /**
      * @brief Discrete dynamics via the base class method (e.g., Euler or RK)
      */
@@ -63,6 +70,23 @@ public:
         return DynamicalSystem::getDiscreteDynamics(state, control, time);
     }
 
+    /**
+     * @brief In-place getDiscreteDynamics and getDiscreteJacobians through the
+     * integrator
+     */
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override {
+        integrateInto(state, control, time, next_state);
+    }
+
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override {
+        integrateJacobiansInto(state, control, time, A, B);
+    }
+
     /**
      * @brief Jacobian of the dynamics wrt. the state
      *
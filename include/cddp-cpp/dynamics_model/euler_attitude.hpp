@@ -65,6 +65,13 @@ namespace cddp
           Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd &state,
                                                 const Eigen::VectorXd &control, double time) const override;
 
+          /**
+           * Writes the continuous-time dynamics into state_dot (STATE_DIM)
+           */
+          void evalContinuousDynamicsInto(const Eigen::VectorXd &state,
+                                          const Eigen::VectorXd &control, double time,
+                                          Eigen::Ref<Eigen::VectorXd> state_dot) const override;
+
           /**
            * Computes the discrete-time dynamics using the specified integration method
            * @param state Current state vector
@@ -78,6 +85,25 @@ namespace cddp
                return DynamicalSystem::getDiscreteDynamics(state, control, time);
           }
 
+          /**
+           * In-place getDiscreteDynamics and getDiscreteJacobians through the
+           * integrator
+           */
+          void evalDiscreteDynamicsInto(const Eigen::VectorXd &state,
+                                        const Eigen::VectorXd &control, double time,
+                                        Eigen::Ref<Eigen::VectorXd> next_state) const override
+          {
+               integrateInto(state, control, time, next_state);
+          }
+
+          void evalDiscreteJacobiansInto(const Eigen::VectorXd &state,
+                                         const Eigen::VectorXd &control, double time,
+                                         Eigen::Ref<Eigen::MatrixXd> A,
+                                         Eigen::Ref<Eigen::MatrixXd> B) const override
+          {
+               integrateJacobiansInto(state, control, time, A, B);
+          }
+
           /**
            * Computes the Jacobian of the dynamics with respect to the state using Autodiff.
            * @param state Current state vector
@@ -74,6 +74,21 @@ public:
     Eigen::VectorXd getDiscreteDynamics(const Eigen::VectorXd& state, 
                                        const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Writes A x + B u into next_state without temporaries
+     */
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override;
+
+    /**
+     * @brief Discrete dynamics of N knots packed as columns: A X + B U
+     */
+    void getDiscreteDynamicsBatch(const Eigen::Ref<const Eigen::MatrixXd>& states,
+                                  const Eigen::Ref<const Eigen::MatrixXd>& controls,
+                                  const Eigen::Ref<const Eigen::VectorXd>& times,
+                                  Eigen::Ref<Eigen::MatrixXd> next_states) const override;
+
     /**
      * @brief Computes the Jacobian w.r.t state (A matrix)
      */
@@ -86,6 +101,31 @@ public:
     Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd& state, 
                                       const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Discrete Jacobians, which are the A and B matrices themselves
+     */
+    std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> getDiscreteJacobians(const Eigen::VectorXd& state,
+                                      const Eigen::VectorXd& control, double time) const override {
+        return {A_, B_};
+    }
+
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override {
+        A = A_;
+        B = B_;
+    }
+
+    /**
+     * @brief Discrete Jacobians of N knots, A and B repeated for every knot
+     */
+    void getDiscreteJacobiansBatch(const Eigen::Ref<const Eigen::MatrixXd>& states,
+                           const Eigen::Ref<const Eigen::MatrixXd>& controls,
+                           const Eigen::Ref<const Eigen::VectorXd>& times,
+                           Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+                           Eigen::Ref<Eigen::MatrixXd> control_jacobians) const override;
+
     /**
      * @brief Computes state Hessian (zero for linear system)
      * @return Vector of state Hessian matrices, one per state dimension
@@ -61,6 +61,13 @@ namespace cddp
         Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd &state,
                                               const Eigen::VectorXd &control, double time) const override;
 
+        /**
+         * Writes the continuous-time dynamics into state_dot (STATE_DIM)
+         */
+        void evalContinuousDynamicsInto(const Eigen::VectorXd &state,
+                                        const Eigen::VectorXd &control, double time,
+                                        Eigen::Ref<Eigen::VectorXd> state_dot) const override;
+
         /**
          * Computes the discrete-time dynamics using the specified integration method
          * @param state Current state vector
@@ -74,6 +81,25 @@ namespace cddp
             return DynamicalSystem::getDiscreteDynamics(state, control, time);
         }
 
+        /**
+         * In-place getDiscreteDynamics and getDiscreteJacobians through the
+         * integrator
+         */
+        void evalDiscreteDynamicsInto(const Eigen::VectorXd &state,
+                                      const Eigen::VectorXd &control, double time,
+                                      Eigen::Ref<Eigen::VectorXd> next_state) const override
+        {
+            integrateInto(state, control, time, next_state);
+        }
+
+        void evalDiscreteJacobiansInto(const Eigen::VectorXd &state,
+                                       const Eigen::VectorXd &control, double time,
+                                       Eigen::Ref<Eigen::MatrixXd> A,
+                                       Eigen::Ref<Eigen::MatrixXd> B) const override
+        {
+            integrateJacobiansInto(state, control, time, A, B);
+        }
+
         /**
          * Computes the Jacobian of the dynamics with respect to the state
          * @param state Current state vector
@@ -124,6 +150,34 @@ namespace cddp
         std::vector<Eigen::MatrixXd> getCrossHessian(const Eigen::VectorXd &state,
                                                      const Eigen::VectorXd &control, double time) const override;
 
+        /**
+         * Computes the state, control and cross Hessians together, evaluating
+         * the autodiff Hessian of each output once
+         * @param state Current state vector
+         * @param control Current control input
+         * @param time Current time
+         * @return Tuple of state, control and cross Hessian tensors
+         */
+        std::tuple<std::vector<Eigen::MatrixXd>, std::vector<Eigen::MatrixXd>,
+                   std::vector<Eigen::MatrixXd>>
+        getHessians(const Eigen::VectorXd &state,
+                    const Eigen::VectorXd &control, double time) const override;
+
+        /**
+         * Computes the Hessians contracted with @p lambda as one autodiff
+         * Hessian of lambda^T f
+         * @param state Current state vector
+         * @param control Current control input
+         * @param lambda Contraction weights, one per state dimension
+         * @param time Current time
+         * @return Tuple of contracted state, control and cross Hessians
+         */
+        std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+        getHessianContraction(const Eigen::VectorXd &state,
+                              const Eigen::VectorXd &control,
+                              const Eigen::VectorXd &lambda,
+                              double time) const override;
+
         /**
          * Computes the continuous-time dynamics of the MRP attitude model using autodiff
          * @param state Current state vector
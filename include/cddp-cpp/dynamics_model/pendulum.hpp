@@ -52,6 +52,13 @@ public:
     Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd& state, 
                                          const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Writes the continuous-time dynamics into state_dot (STATE_DIM)
+     */
+    void evalContinuousDynamicsInto(const Eigen::VectorXd& state,
+                                    const Eigen::VectorXd& control, double time,
+                                    Eigen::Ref<Eigen::VectorXd> state_dot) const override;
+
     /**
      * @brief Computes the discrete-time dynamics using the specified integration method
      * @param state Current state vector
@@ -63,6 +70,23 @@ public:
         return DynamicalSystem::getDiscreteDynamics(state, control, time);
     }
 
+    /**
+     * @brief In-place getDiscreteDynamics and getDiscreteJacobians through the
+     * integrator
+     */
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override {
+        integrateInto(state, control, time, next_state);
+    }
+
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override {
+        integrateJacobiansInto(state, control, time, A, B);
+    }
+
     /**
      * @brief Computes the Jacobian of the dynamics with respect to the state
      * @param state Current state vector
@@ -81,6 +105,15 @@ public:
     Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd& state, 
                                       const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Writes both analytic Jacobians into A (STATE_DIM x STATE_DIM) and
+     * B (STATE_DIM x CONTROL_DIM)
+     */
+    void evalJacobiansInto(const Eigen::VectorXd& state,
+                           const Eigen::VectorXd& control, double time,
+                           Eigen::Ref<Eigen::MatrixXd> A,
+                           Eigen::Ref<Eigen::MatrixXd> B) const override;
+
     /**
      * @brief Computes the Hessian of the dynamics with respect to the state
      * @param state Current state vector
@@ -46,6 +46,13 @@ public:
     Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd& state, 
                                          const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * Writes the continuous-time dynamics into state_dot (STATE_DIM)
+     */
+    void evalContinuousDynamicsInto(const Eigen::VectorXd& state,
+                                    const Eigen::VectorXd& control, double time,
+                                    Eigen::Ref<Eigen::VectorXd> state_dot) const override;
+
     /**
      * Computes the discrete-time dynamics using the specified integration method
      * @param state Current state vector
@@ -58,6 +65,23 @@ public:
         return DynamicalSystem::getDiscreteDynamics(state, control, time);
     }
 
+    /**
+     * In-place getDiscreteDynamics and getDiscreteJacobians through the
+     * integrator
+     */
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override {
+        integrateInto(state, control, time, next_state);
+    }
+
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override {
+        integrateJacobiansInto(state, control, time, A, B);
+    }
+
     /**
      * Computes the Jacobian of the dynamics with respect to the state
      * @param state Current state vector
@@ -108,6 +132,34 @@ public:
     std::vector<Eigen::MatrixXd> getCrossHessian(const Eigen::VectorXd& state, 
                                      const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * Computes the state, control and cross Hessians together, evaluating the
+     * autodiff Hessian of each output once
+     * @param state Current state vector
+     * @param control Current control input
+     * @param time Current time
+     * @return Tuple of state, control and cross Hessian tensors
+     */
+    std::tuple<std::vector<Eigen::MatrixXd>, std::vector<Eigen::MatrixXd>,
+               std::vector<Eigen::MatrixXd>>
+    getHessians(const Eigen::VectorXd& state,
+                const Eigen::VectorXd& control, double time) const override;
+
+    /**
+     * Computes the Hessians contracted with @p lambda (sum_i lambda_i * f_i'')
+     * as one autodiff Hessian of lambda^T f
+     * @param state Current state vector
+     * @param control Current control input
+     * @param lambda Contraction weights, one per state dimension
+     * @param time Current time
+     * @return Tuple of contracted state, control and cross Hessians
+     */
+    std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+    getHessianContraction(const Eigen::VectorXd& state,
+                          const Eigen::VectorXd& control,
+                          const Eigen::VectorXd& lambda,
+                          double time) const override;
+
     /**
      * Computes the continuous-time dynamics of the quadrotor model using autodiff
      * @param state Current state vector
@@ -47,6 +47,13 @@ public:
     Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd& state, 
                                          const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * Writes the continuous-time dynamics into state_dot (STATE_DIM)
+     */
+    void evalContinuousDynamicsInto(const Eigen::VectorXd& state,
+                                    const Eigen::VectorXd& control, double time,
+                                    Eigen::Ref<Eigen::VectorXd> state_dot) const override;
+
     /**
      * Computes the discrete-time dynamics using the specified integration method
      * @param state Current state vector
@@ -59,6 +66,51 @@ public:
         return DynamicalSystem::getDiscreteDynamics(state, control, time);
     }
 
+    /**
+     * In-place getDiscreteDynamics and getDiscreteJacobians through the
+     * integrator
+     */
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override {
+        integrateInto(state, control, time, next_state);
+    }
+
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override {
+        integrateJacobiansInto(state, control, time, A, B);
+    }
+
+    /**
+     * Continuous dynamics of N knots packed as columns, as two matrix
+     * products with the constant HCW system matrices
+     */
+    void getContinuousDynamicsBatch(const Eigen::Ref<const Eigen::MatrixXd>& states,
+                                    const Eigen::Ref<const Eigen::MatrixXd>& controls,
+                                    const Eigen::Ref<const Eigen::VectorXd>& times,
+                                    Eigen::Ref<Eigen::MatrixXd> state_dots) const override;
+
+    /**
+     * Discrete dynamics of N knots, integrating all of them together
+     */
+    void getDiscreteDynamicsBatch(const Eigen::Ref<const Eigen::MatrixXd>& states,
+                                  const Eigen::Ref<const Eigen::MatrixXd>& controls,
+                                  const Eigen::Ref<const Eigen::VectorXd>& times,
+                                  Eigen::Ref<Eigen::MatrixXd> next_states) const override {
+        integrateBatch(states, controls, times, next_states);
+    }
+
+    /**
+     * Continuous Jacobians of N knots, which are the same for every knot
+     */
+    void getJacobiansBatch(const Eigen::Ref<const Eigen::MatrixXd>& states,
+                           const Eigen::Ref<const Eigen::MatrixXd>& controls,
+                           const Eigen::Ref<const Eigen::VectorXd>& times,
+                           Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+                           Eigen::Ref<Eigen::MatrixXd> control_jacobians) const override;
+
     /**
      * Computes the Jacobian of the dynamics with respect to the state
      * @param state Current state vector
@@ -79,6 +131,15 @@ public:
     Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd& state, 
                                       const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Writes both analytic Jacobians into A (STATE_DIM x STATE_DIM) and
+     * B (STATE_DIM x CONTROL_DIM)
+     */
+    void evalJacobiansInto(const Eigen::VectorXd& state,
+                           const Eigen::VectorXd& control, double time,
+                           Eigen::Ref<Eigen::MatrixXd> A,
+                           Eigen::Ref<Eigen::MatrixXd> B) const override;
+
     /**
      * Computes the Hessian of the dynamics with respect to the state
      * @param state Current state vector
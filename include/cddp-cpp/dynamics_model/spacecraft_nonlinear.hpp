@@ -49,7 +49,7 @@ public:
     /**
      * @brief Constructor
      * @param timestep Integration timestep
-     * @param integration_type Integration method
+     * @param integration_type Integration method (e.g. "rk4", "rk45", "implicit_midpoint")
      * @param mass Spacecraft mass [kg]
      * @param r_scale Position scaling factor
      * @param v_scale Velocity scaling factor
@@ -94,6 +94,30 @@ public:
         const Eigen::VectorXd& state,
         const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Writes the continuous-time dynamics into state_dot (STATE_DIM)
+     */
+    void evalContinuousDynamicsInto(const Eigen::VectorXd& state,
+                                    const Eigen::VectorXd& control, double time,
+                                    Eigen::Ref<Eigen::VectorXd> state_dot) const override;
+
+    /**
+     * @brief In-place getDiscreteDynamics and getDiscreteJacobians through the
+     * integrator
+     */
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override {
+        integrateInto(state, control, time, next_state);
+    }
+
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override {
+        integrateJacobiansInto(state, control, time, A, B);
+    }
+
     /**
      * @brief Compute state Jacobian matrix
      * @param state Current state vector
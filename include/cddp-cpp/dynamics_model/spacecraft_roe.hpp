@@ -87,6 +87,30 @@ namespace cddp
             const Eigen::VectorXd &state,
             const Eigen::VectorXd &control, double time) const override;
 
+        /**
+         * @brief Writes the continuous-time dynamics into xdot (STATE_DIM)
+         */
+        void evalContinuousDynamicsInto(const Eigen::VectorXd &state,
+                                        const Eigen::VectorXd &control, double time,
+                                        Eigen::Ref<Eigen::VectorXd> xdot) const override;
+
+        /**
+         * @brief In-place getDiscreteDynamics and getDiscreteJacobians through the
+         * integrator
+         */
+        void evalDiscreteDynamicsInto(const Eigen::VectorXd &state,
+                                      const Eigen::VectorXd &control, double time,
+                                      Eigen::Ref<Eigen::VectorXd> next_state) const override {
+            integrateInto(state, control, time, next_state);
+        }
+
+        void evalDiscreteJacobiansInto(const Eigen::VectorXd &state,
+                                       const Eigen::VectorXd &control, double time,
+                                       Eigen::Ref<Eigen::MatrixXd> A,
+                                       Eigen::Ref<Eigen::MatrixXd> B) const override {
+            integrateJacobiansInto(state, control, time, A, B);
+        }
+
         /**
          * @brief Compute continuous-time dynamics in ROE coordinates using autodiff
          * @param state   Current ROE state vector
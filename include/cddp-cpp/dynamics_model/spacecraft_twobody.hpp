@@ -24,8 +24,11 @@ public:
    * @param timestep Discretization time step [s]
    * @param mu Gravitational parameter of the central body [m^3/s^2]
    * @param mass Spacecraft mass [kg]
+   * @param integration_type Integration method; "implicit_midpoint" or
+   *        "rk45" allow much coarser timesteps than explicit Euler
    */
-  SpacecraftTwobody(double timestep, double mu, double mass);
+  SpacecraftTwobody(double timestep, double mu, double mass,
+                    std::string integration_type = "euler");
 
   /**
    * @brief Computes the continuous-time dynamics
@@ -38,6 +41,13 @@ public:
   Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd &state,
                                          const Eigen::VectorXd &control, double time) const override;
 
+  /**
+   * @brief Writes the continuous-time dynamics into state_dot (STATE_DIM)
+   */
+  void evalContinuousDynamicsInto(const Eigen::VectorXd &state,
+                                  const Eigen::VectorXd &control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> state_dot) const override;
+
   /**
    * @brief Computes the discrete-time dynamics
    *
@@ -51,6 +61,23 @@ public:
     return DynamicalSystem::getDiscreteDynamics(state, control, time);
   }
 
+  /**
+   * @brief In-place getDiscreteDynamics and getDiscreteJacobians through the
+   * integrator
+   */
+  void evalDiscreteDynamicsInto(const Eigen::VectorXd &state,
+                                const Eigen::VectorXd &control, double time,
+                                Eigen::Ref<Eigen::VectorXd> next_state) const override {
+    integrateInto(state, control, time, next_state);
+  }
+
+  void evalDiscreteJacobiansInto(const Eigen::VectorXd &state,
+                                 const Eigen::VectorXd &control, double time,
+                                 Eigen::Ref<Eigen::MatrixXd> A,
+                                 Eigen::Ref<Eigen::MatrixXd> B) const override {
+    integrateJacobiansInto(state, control, time, A, B);
+  }
+
   /**
    * @brief Computes the state Jacobian matrix (∂f/∂x)
    *
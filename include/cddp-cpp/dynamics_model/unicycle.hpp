@@ -51,6 +51,13 @@ public:
     Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd& state, 
                                          const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Writes the continuous-time dynamics into state_dot (STATE_DIM)
+     */
+    void evalContinuousDynamicsInto(const Eigen::VectorXd& state,
+                                    const Eigen::VectorXd& control, double time,
+                                    Eigen::Ref<Eigen::VectorXd> state_dot) const override;
+
     /**
      * @brief Computes the discrete-time dynamics using the specified integration method
      * @param state Current state vector
@@ -63,6 +70,52 @@ public:
         return DynamicalSystem::getDiscreteDynamics(state, control, time);
     }
 
+    /**
+     * @brief In-place getDiscreteDynamics and getDiscreteJacobians through the
+     * integrator
+     */
+    void evalDiscreteDynamicsInto(const Eigen::VectorXd& state,
+                                  const Eigen::VectorXd& control, double time,
+                                  Eigen::Ref<Eigen::VectorXd> next_state) const override {
+        integrateInto(state, control, time, next_state);
+    }
+
+    void evalDiscreteJacobiansInto(const Eigen::VectorXd& state,
+                                   const Eigen::VectorXd& control, double time,
+                                   Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const override {
+        integrateJacobiansInto(state, control, time, A, B);
+    }
+
+    /**
+     * @brief Continuous dynamics of N knots packed as columns, evaluated with
+     * vectorized sin/cos over the whole batch
+     */
+    void getContinuousDynamicsBatch(const Eigen::Ref<const Eigen::MatrixXd>& states,
+                                    const Eigen::Ref<const Eigen::MatrixXd>& controls,
+                                    const Eigen::Ref<const Eigen::VectorXd>& times,
+                                    Eigen::Ref<Eigen::MatrixXd> state_dots) const override;
+
+    /**
+     * @brief Discrete dynamics of N knots, integrating all of them together
+     */
+    void getDiscreteDynamicsBatch(const Eigen::Ref<const Eigen::MatrixXd>& states,
+                                  const Eigen::Ref<const Eigen::MatrixXd>& controls,
+                                  const Eigen::Ref<const Eigen::VectorXd>& times,
+                                  Eigen::Ref<Eigen::MatrixXd> next_states) const override {
+        integrateBatch(states, controls, times, next_states);
+    }
+
+    /**
+     * @brief Continuous Jacobians of N knots in the layout of
+     * DynamicalSystem::getJacobiansBatch
+     */
+    void getJacobiansBatch(const Eigen::Ref<const Eigen::MatrixXd>& states,
+                           const Eigen::Ref<const Eigen::MatrixXd>& controls,
+                           const Eigen::Ref<const Eigen::VectorXd>& times,
+                           Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+                           Eigen::Ref<Eigen::MatrixXd> control_jacobians) const override;
+
     /**
      * @brief Computes the Jacobian of the dynamics with respect to the state
      * @param state Current state vector
@@ -83,6 +136,15 @@ public:
     Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd& state, 
                                       const Eigen::VectorXd& control, double time) const override;
 
+    /**
+     * @brief Writes both analytic Jacobians into A (STATE_DIM x STATE_DIM) and
+     * B (STATE_DIM x CONTROL_DIM)
+     */
+    void evalJacobiansInto(const Eigen::VectorXd& state,
+                           const Eigen::VectorXd& control, double time,
+                           Eigen::Ref<Eigen::MatrixXd> A,
+                           Eigen::Ref<Eigen::MatrixXd> B) const override;
+
     /**
      * @brief Computes the Hessian of the dynamics with respect to the state
      * @param state Current state vector
@@ -22,8 +22,8 @@
 #include <vector>
 #include <map>
 #include <string>
-#include <casadi/casadi.hpp>
 
+#include "osqp++.h"
 #include "cddp_core/dynamical_system.hpp"
 #include "cddp_core/objective.hpp"
 #include "cddp_core/constraint.hpp"
@@ -52,6 +52,11 @@ struct SCPOptions {
     int ipopt_max_iter = 1000;
     int ipopt_print_level = 5;
     double ipopt_tol = 1e-6;
+
+    // OSQP options for the convex subproblems
+    int osqp_max_iter = 10000;           // Maximum ADMM iterations per subproblem
+    double osqp_eps_abs = 1e-6;          // Absolute tolerance
+    double osqp_eps_rel = 1e-6;          // Relative tolerance
 };
 
 /**
@@ -71,6 +76,12 @@ struct SCPResult {
 
 /**
  * @brief Sequential Convex Programming solver
+ *
+ * Every iteration solves a QP in w = [x_0, ..., x_N, u_0, ..., u_{N-1}]
+ * with the dynamics linearized about the previous iterate and a trust region
+ * around it. The QP keeps one block-banded sparsity pattern for the horizon,
+ * so a single OSQP instance is set up once and later iterations only update
+ * the linearization and bounds in place, reusing its symbolic factorization.
  */
 class SCPSolver {
 public:
@@ -151,13 +162,36 @@ private:
     std::vector<Eigen::VectorXd> X_;
     std::vector<Eigen::VectorXd> U_;
 
+    // Subproblem data
+    using SparseMatrix = Eigen::SparseMatrix<double, Eigen::ColMajor, osqp::c_int>;
+    std::unique_ptr<osqp::OsqpSolver> qp_solver_;
+    SparseMatrix qp_P_;             // Cost Hessian (upper triangle)
+    SparseMatrix qp_A_;             // [initial state; dynamics; trust region]
+    Eigen::VectorXd qp_q_;          // Cost gradient
+    Eigen::VectorXd qp_lower_, qp_upper_;
+
+    // Linearization about the previous iterate, knots side by side in the
+    // layout of DynamicalSystem::getDiscreteJacobiansBatch
+    Eigen::MatrixXd X_bar_, U_bar_; // state_dim x N, control_dim x N
+    Eigen::VectorXd times_;
+    Eigen::MatrixXd F_nom_;         // state_dim x N
+    Eigen::MatrixXd A_;             // state_dim x (N * state_dim)
+    Eigen::MatrixXd B_;             // state_dim x (N * control_dim)
+
     // Helper routines.
     void initializeSCP();
     void computeLinearizedDynamics(const std::vector<Eigen::VectorXd>& X,
-                                   const std::vector<Eigen::VectorXd>& U,
-                                   std::vector<Eigen::MatrixXd>& A,
-                                   std::vector<Eigen::MatrixXd>& B) const;
-                                   
+                                   const std::vector<Eigen::VectorXd>& U);
+
+    // Sets up the sparsity pattern and the constant cost of the subproblem.
+    void setupQP(int state_dim, int control_dim);
+
+    // Writes the linearization and the trust region of radius Delta about
+    // (X, U) into the constraint matrix and bounds.
+    void updateQP(const std::vector<Eigen::VectorXd>& X,
+                  const std::vector<Eigen::VectorXd>& U,
+                  double Delta);
+
     bool satisfies_trust_region_constraints(const std::vector<Eigen::VectorXd>& X,
                                               const std::vector<Eigen::VectorXd>& X_prev,
                                               double Delta) {
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -29,6 +30,7 @@ AlddpSolver::AlddpSolver()
       optimality_gap_(0.0) {}
 
 void AlddpSolver::initialize(CDDP &context) {
+  derivatives_valid_ = false;
   const CDDPOptions &options = context.getOptions();
   const int state_dim = context.getStateDim();
   const int control_dim = context.getControlDim();
@@ -54,25 +56,17 @@ void AlddpSolver::initialize(CDDP &context) {
 
     // Check dual variables validity for warm start
     if (valid_warm_start) {
-      const auto &constraint_set = context.getConstraintSet();
-      for (const auto &constraint_pair : constraint_set) {
-        const std::string &constraint_name = constraint_pair.first;
-        int dual_dim = constraint_pair.second->getDualDim();
-
-        if (Y_.find(constraint_name) == Y_.end() ||
-            Y_[constraint_name].size() != static_cast<size_t>(horizon)) {
-          valid_warm_start = false;
-          break;
-        }
-
+      const int total_dual_dim = context.getPathDualDim();
+      if (Y_.size() != static_cast<size_t>(horizon) ||
+          rho_path_.size() != context.getPathConstraintBlocks().size()) {
+        valid_warm_start = false;
+      } else {
         for (int t = 0; t < horizon; ++t) {
-          if (Y_[constraint_name][t].size() != dual_dim) {
+          if (Y_[t].size() != total_dual_dim) {
             valid_warm_start = false;
             break;
           }
         }
-        if (!valid_warm_start)
-          break;
       }
     }
 
@@ -112,26 +106,13 @@ void AlddpSolver::initialize(CDDP &context) {
         state_dim, options.altro.defect_dual_init_scale);
   }
 
-  // Initialize dual variables for constraints
-  Y_.clear();
-  const auto &constraint_set = context.getConstraintSet();
-
-  for (const auto &constraint_pair : constraint_set) {
-    const std::string &constraint_name = constraint_pair.first;
-    const auto &constraint = constraint_pair.second;
-    int dual_dim = constraint->getDualDim();
+  // Initialize dual variables to small positive values (stacked per knot)
+  Y_.assign(horizon, Eigen::VectorXd::Constant(context.getPathDualDim(),
+                                               options.altro.dual_var_init_scale));
 
-    Y_[constraint_name].resize(horizon, Eigen::VectorXd::Zero(dual_dim));
-
-    // Initialize dual variables to small positive values
-    for (int t = 0; t < horizon; ++t) {
-      Y_[constraint_name][t] = Eigen::VectorXd::Constant(
-          dual_dim, options.altro.dual_var_init_scale);
-    }
-
-    // Initialize path constraint penalty parameter (scalar for ALDDP)
-    rho_path_[constraint_name] = options.altro.penalty_scaling;
-  }
+  // Initialize path constraint penalty parameters (scalar per constraint)
+  rho_path_.assign(context.getPathConstraintBlocks().size(),
+                   options.altro.penalty_scaling);
 
   // Initialize defect constraint penalty parameter (scalar for ALDDP)
   rho_defect_ = options.altro.defect_penalty_scaling;
@@ -148,7 +129,7 @@ void AlddpSolver::initialize(CDDP &context) {
 
 std::string AlddpSolver::getSolverName() const { return "ALDDP"; }
 
-CDDPSolution AlddpSolver::solve(CDDP &context) {
+void AlddpSolver::solve(CDDP &context, SolveResult &result) {
   const CDDPOptions &options = context.getOptions();
 
   // Print solver header if requested
@@ -161,41 +142,22 @@ CDDPSolution AlddpSolver::solve(CDDP &context) {
     context.printOptions(options);
   }
 
-  // Prepare solution map
-  CDDPSolution solution;
-  solution["solver_name"] = getSolverName();
-  solution["status_message"] = std::string("Running");
-  solution["iterations_completed"] = 0;
-  solution["solve_time_ms"] = 0.0;
-
-  // Initialize history vectors only if requested
-  std::vector<double> history_objective;
-  std::vector<double> history_lagrangian;
-  std::vector<double> history_step_length_primal;
-  std::vector<double> history_dual_infeasibility;
-  std::vector<double> history_primal_infeasibility;
-  std::vector<double> history_penalty_parameter;
+  // History is recorded only if requested
+  result.beginSolve(getSolverName(), options.return_iteration_info,
+                    static_cast<size_t>(options.max_iterations + 1));
+  SolveHistory *history = result.history ? &*result.history : nullptr;
 
   // Initial trajectory evaluation
   evaluateTrajectory(context);
 
-  if (options.return_iteration_info) {
-    const size_t expected_size =
-        static_cast<size_t>(options.max_iterations + 1);
-    history_objective.reserve(expected_size);
-    history_lagrangian.reserve(expected_size);
-    history_step_length_primal.reserve(expected_size);
-    history_dual_infeasibility.reserve(expected_size);
-    history_primal_infeasibility.reserve(expected_size);
-    history_penalty_parameter.reserve(expected_size);
-
+  if (history) {
     // Initial iteration values
-    history_objective.push_back(cost_);
-    history_lagrangian.push_back(lagrangian_value_);
-    history_step_length_primal.push_back(1.0);
-    history_dual_infeasibility.push_back(optimality_gap_);
-    history_primal_infeasibility.push_back(constraint_violation_);
-    history_penalty_parameter.push_back(options.altro.penalty_scaling);
+    history->objective.push_back(cost_);
+    history->lagrangian.push_back(lagrangian_value_);
+    history->step_length_primal.push_back(1.0);
+    history->dual_infeasibility.push_back(optimality_gap_);
+    history->primal_infeasibility.push_back(constraint_violation_);
+    history->penalty_parameter.push_back(options.altro.penalty_scaling);
   }
 
   // Start timer
@@ -229,12 +191,21 @@ CDDPSolution AlddpSolver::solve(CDDP &context) {
       }
     }
 
+    if (context.isCancellationRequested()) {
+      termination_reason = "Cancelled";
+      break;
+    }
+
     // 1. Backward pass
     bool backward_pass_success = false;
     while (!backward_pass_success) {
       backward_pass_success = backwardPass(context);
 
       if (!backward_pass_success) {
+        if (context.isCancellationRequested()) {
+          termination_reason = "Cancelled";
+          break;
+        }
         context.increaseRegularization();
         if (context.isRegularizationLimitReached()) {
           termination_reason = "RegularizationLimitReached_NotConverged";
@@ -265,8 +236,9 @@ CDDPSolution AlddpSolver::solve(CDDP &context) {
                   << std::endl;
       }
 
-      context.X_ = best_result.state_trajectory;
-      context.U_ = best_result.control_trajectory;
+      context.X_.swap(best_result.state_trajectory);
+      context.U_.swap(best_result.control_trajectory);
+      derivatives_valid_ = false;
       if (best_result.dynamics_trajectory) {
         F_ = *best_result.dynamics_trajectory;
       }
@@ -279,14 +251,15 @@ CDDPSolution AlddpSolver::solve(CDDP &context) {
       constraint_violation_ = best_result.constraint_violation;
 
       // Store history only if requested
-      if (options.return_iteration_info) {
-        history_objective.push_back(cost_);
-        history_lagrangian.push_back(lagrangian_value_);
-        history_step_length_primal.push_back(context.alpha_pr_);
-        history_dual_infeasibility.push_back(optimality_gap_);
-        history_primal_infeasibility.push_back(constraint_violation_);
-        history_penalty_parameter.push_back(options.altro.penalty_scaling);
+      if (history) {
+        history->objective.push_back(cost_);
+        history->lagrangian.push_back(lagrangian_value_);
+        history->step_length_primal.push_back(context.alpha_pr_);
+        history->dual_infeasibility.push_back(optimality_gap_);
+        history->primal_infeasibility.push_back(constraint_violation_);
+        history->penalty_parameter.push_back(options.altro.penalty_scaling);
       }
+      context.notifyIteration(iter);
 
       context.decreaseRegularization();
 
@@ -310,6 +283,10 @@ CDDPSolution AlddpSolver::solve(CDDP &context) {
         break;
       }
     } else {
+      if (context.isCancellationRequested()) {
+        termination_reason = "Cancelled";
+        break;
+      }
       context.increaseRegularization();
 
       if (context.isRegularizationLimitReached()) {
@@ -340,48 +317,30 @@ CDDPSolution AlddpSolver::solve(CDDP &context) {
       end_time - start_time);
 
   // Populate final solution
-  solution["status_message"] = termination_reason;
-  solution["iterations_completed"] = iter;
-  solution["solve_time_ms"] = static_cast<double>(duration.count());
-  solution["final_objective"] = cost_;
-  solution["final_step_length"] = context.alpha_pr_;
+  result.status_message = termination_reason;
+  result.iterations_completed = iter;
+  result.solve_time_ms = static_cast<double>(duration.count());
+  result.final_objective = cost_;
+  result.final_step_length = context.alpha_pr_;
 
   // Add trajectories
-  std::vector<double> time_points;
-  time_points.reserve(static_cast<size_t>(context.getHorizon() + 1));
-  for (int t = 0; t <= context.getHorizon(); ++t) {
-    time_points.push_back(t * context.getTimestep());
-  }
-  solution["time_points"] = time_points;
-  solution["state_trajectory"] = context.X_;
-  solution["control_trajectory"] = context.U_;
-
-  // Add iteration history if requested
-  if (options.return_iteration_info) {
-    solution["history_objective"] = history_objective;
-    solution["history_lagrangian"] = history_lagrangian;
-    solution["history_step_length_primal"] = history_step_length_primal;
-    solution["history_dual_infeasibility"] = history_dual_infeasibility;
-    solution["history_primal_infeasibility"] = history_primal_infeasibility;
-    solution["history_penalty_parameter"] = history_penalty_parameter;
-  }
+  result.setTimePoints(context.getHorizon(), context.getTimestep());
+  result.state_trajectory = context.X_;
+  result.control_trajectory = context.U_;
 
   // Add control gains
-  solution["control_feedback_gains_K"] = K_u_;
+  result.setFeedbackGains(K_u_);
 
   // Final metrics
-  solution["final_regularization"] = context.regularization_;
-  solution["final_penalty_parameter"] = options.altro.penalty_scaling;
-  solution["final_primal_infeasibility"] = constraint_violation_;
-  solution["final_dual_infeasibility"] = optimality_gap_;
-  solution["final_lagrangian"] = lagrangian_value_;
+  result.final_regularization = context.regularization_;
+  result.final_penalty_parameter = options.altro.penalty_scaling;
+  result.final_primal_infeasibility = constraint_violation_;
+  result.final_dual_infeasibility = optimality_gap_;
+  result.final_lagrangian = lagrangian_value_;
 
   if (options.verbose) {
-    printSolutionSummary(solution);
+    printSolutionSummary(result);
   }
-
-
-  return solution;
 }
 
 void AlddpSolver::evaluateTrajectory(CDDP &context) {
@@ -389,7 +348,6 @@ void AlddpSolver::evaluateTrajectory(CDDP &context) {
   const auto &U = context.U_;
   const auto &objective = context.getObjective();
   const auto &system = context.getSystem();
-  const auto &constraint_set = context.getConstraintSet();
   const int horizon = context.getHorizon();
   const double timestep = context.getTimestep();
   const double penalty_scaling = context.getOptions().altro.penalty_scaling;
@@ -427,16 +385,16 @@ void AlddpSolver::evaluateTrajectory(CDDP &context) {
   }
 
   // Add path constraint terms
-  for (const auto &constraint_pair : constraint_set) {
-    const std::string &constraint_name = constraint_pair.first;
-    const auto &constraint = constraint_pair.second;
+  const auto &blocks = context.getPathConstraintBlocks();
+  Eigen::VectorXd g_stacked;
+  for (int t = 0; t < horizon && !blocks.empty(); ++t) {
+    // Evaluate all constraints at this knot
+    context.evaluatePathConstraints(X[t], U[t], g_stacked);
 
-    for (int t = 0; t < horizon; ++t) {
-      // Evaluate constraint
-      Eigen::VectorXd g =
-          constraint->evaluate(X[t], U[t]) - constraint->getUpperBound();
-      const Eigen::VectorXd &y = Y_[constraint_name][t];
-      const double rho_path = rho_path_[constraint_name];
+    for (size_t b = 0; b < blocks.size(); ++b) {
+      const auto g = g_stacked.segment(blocks[b].offset, blocks[b].dim);
+      const auto y = Y_[t].segment(blocks[b].offset, blocks[b].dim);
+      const double rho_path = rho_path_[b];
 
       // Update constraint violation
       constraint_violation_ += std::max(0.0, g.maxCoeff());
@@ -463,18 +421,51 @@ void AlddpSolver::evaluateTrajectory(CDDP &context) {
   lagrangian_value_ = cost_ + penalty_cost;
 }
 
+void AlddpSolver::precomputeDerivatives(CDDP &context) {
+  const auto &X = context.X_;
+  const auto &U = context.U_;
+  const auto &system = context.getSystem();
+  const auto &blocks = context.getPathConstraintBlocks();
+  const int horizon = context.getHorizon();
+  const int state_dim = context.getStateDim();
+  const int control_dim = context.getControlDim();
+  const int total_dual_dim = context.getPathDualDim();
+  const double timestep = context.getTimestep();
+
+  A_.resize(horizon);
+  B_.resize(horizon);
+  G_.resize(horizon);
+  G_x_.resize(horizon);
+  G_u_.resize(horizon);
+
+  for (int t = 0; t < horizon; ++t) {
+    const Eigen::VectorXd &x = X[t];
+    const Eigen::VectorXd &u = U[t];
+
+    A_[t].resize(state_dim, state_dim);
+    B_[t].resize(state_dim, control_dim);
+    system.evalDiscreteJacobiansInto(x, u, t * timestep, A_[t], B_[t]);
+
+    context.evaluatePathConstraints(x, u, G_[t]);
+    G_x_[t].resize(total_dual_dim, state_dim);
+    G_u_[t].resize(total_dual_dim, control_dim);
+    for (const auto &block : blocks) {
+      context.evaluatePathConstraintJacobians(
+          block, x, u, G_x_[t].middleRows(block.offset, block.dim),
+          G_u_[t].middleRows(block.offset, block.dim));
+    }
+  }
+}
+
 bool AlddpSolver::backwardPass(CDDP &context) {
   const auto &options = context.getOptions();
 
   const auto &X = context.X_;
   const auto &U = context.U_;
   const auto &objective = context.getObjective();
-  const auto &system = context.getSystem();
-  const auto &constraint_set = context.getConstraintSet();
   const int horizon = context.getHorizon();
   const int state_dim = context.getStateDim();
   const int control_dim = context.getControlDim();
-  const double timestep = context.getTimestep();
   const double penalty_scaling = context.getOptions().altro.penalty_scaling;
   const double defect_penalty_scaling =
       context.getOptions().altro.defect_penalty_scaling;
@@ -482,6 +473,13 @@ bool AlddpSolver::backwardPass(CDDP &context) {
 
   double Qu_err = 0.0;
 
+  // Derivatives depend only on X_/U_, which regularization retries leave
+  // unchanged
+  if (!derivatives_valid_) {
+    precomputeDerivatives(context);
+    derivatives_valid_ = true;
+  }
+
   // Terminal cost derivatives
   Eigen::VectorXd V_x = objective.getFinalCostGradient(X.back());
   Eigen::MatrixXd V_xx = objective.getFinalCostHessian(X.back());
@@ -489,17 +487,19 @@ bool AlddpSolver::backwardPass(CDDP &context) {
 
   // Backward recursion
   for (int t = horizon - 1; t >= 0; --t) {
+    if (context.isCancellationRequested()) {
+      return false;
+    }
+
     const Eigen::VectorXd &x = X[t];
     const Eigen::VectorXd &u = U[t];
     const Eigen::VectorXd &f = F_[t];
     const Eigen::VectorXd &d = f - context.X_[t + 1]; // Defect
     const Eigen::VectorXd &lambda = Lambda_[t];
 
-    // Get dynamics derivatives
-    const auto [Fx, Fu] = system.getJacobians(x, u, t * timestep);
-    Eigen::MatrixXd A =
-        Eigen::MatrixXd::Identity(state_dim, state_dim) + timestep * Fx;
-    Eigen::MatrixXd B = timestep * Fu;
+    // Dynamics derivatives
+    const Eigen::MatrixXd &A = A_[t];
+    const Eigen::MatrixXd &B = B_[t];
 
     // Cost derivatives at (x_t, u_t)
     auto [l_x, l_u] = objective.getRunningCostGradients(x, u, t);
@@ -518,17 +518,15 @@ bool AlddpSolver::backwardPass(CDDP &context) {
         l_uu + B.transpose() * V_xx * B + rho_defect_ * B.transpose() * B;
 
     // Add path constraint terms to Q-function
-    for (const auto &constraint_pair : constraint_set) {
-      const std::string &constraint_name = constraint_pair.first;
-      const auto &constraint = constraint_pair.second;
-      const Eigen::VectorXd &y = Y_[constraint_name][t];
-      const double rho_path = rho_path_[constraint_name];
-
-      // Evaluate constraint and its derivatives
-      Eigen::VectorXd g =
-          constraint->evaluate(x, u) - constraint->getUpperBound();
-      Eigen::MatrixXd g_x = constraint->getStateJacobian(x, u);
-      Eigen::MatrixXd g_u = constraint->getControlJacobian(x, u);
+    const auto &blocks = context.getPathConstraintBlocks();
+    for (size_t b = 0; b < blocks.size(); ++b) {
+      const auto y = Y_[t].segment(blocks[b].offset, blocks[b].dim);
+      const double rho_path = rho_path_[b];
+
+      // Constraint value and derivatives
+      const auto g = G_[t].segment(blocks[b].offset, blocks[b].dim);
+      const auto g_x = G_x_[t].middleRows(blocks[b].offset, blocks[b].dim);
+      const auto g_u = G_u_[t].middleRows(blocks[b].offset, blocks[b].dim);
 
       for (int i = 0; i < g.size(); ++i) {
         const double constraint_tolerance =
@@ -615,17 +613,55 @@ ForwardPassResult AlddpSolver::performForwardPass(CDDP &context) {
   best_result.success = false;
   best_result.merit_function = std::numeric_limits<double>::infinity();
 
-  // Try different step sizes from the context
-  for (double alpha : context.alphas_) {
-    ForwardPassResult result = forwardPass(context, alpha);
+  if (!options.enable_parallel) {
+    // Try different step sizes from the context
+    for (double alpha : context.alphas_) {
+      ForwardPassResult result = forwardPass(context, alpha);
+
+      if (result.success &&
+          result.merit_function < best_result.merit_function) {
+        best_result = result;
+      }
+
+      // Early termination if we found a good step
+      if (result.success && result.merit_function < lagrangian_value_) {
+        break;
+      }
+    }
+  } else {
+    // Evaluate all step sizes concurrently on the shared pool
+    std::vector<std::future<ForwardPassResult>> futures;
+    futures.reserve(context.alphas_.size());
+
+    for (double alpha : context.alphas_) {
+      futures.push_back(context.getThreadPool().submit(
+          [this, &context, alpha]() { return forwardPass(context, alpha); }));
+    }
 
-    if (result.success && result.merit_function < best_result.merit_function) {
-      best_result = result;
+    std::vector<ForwardPassResult> results(futures.size());
+    for (size_t i = 0; i < futures.size(); ++i) {
+      try {
+        if (futures[i].valid()) {
+          results[i] = futures[i].get();
+        }
+      } catch (const std::exception &e) {
+        if (options.verbose) {
+          std::cerr << "ALDDP: Forward pass thread failed: " << e.what()
+                    << std::endl;
+        }
+      }
     }
 
-    // Early termination if we found a good step
-    if (result.success && result.merit_function < lagrangian_value_) {
-      break;
+    // Accept in alpha order with the sequential rule, so both paths take
+    // the same step
+    for (const auto &result : results) {
+      if (result.success &&
+          result.merit_function < best_result.merit_function) {
+        best_result = result;
+      }
+      if (result.success && result.merit_function < lagrangian_value_) {
+        break;
+      }
     }
   }
 
@@ -640,19 +676,21 @@ ForwardPassResult AlddpSolver::forwardPass(CDDP &context, double alpha) {
   result.alpha_pr = alpha;
   result.cost = std::numeric_limits<double>::infinity();
   result.merit_function = std::numeric_limits<double>::infinity();
+  if (context.isCancellationRequested()) {
+    return result;
+  }
 
   const auto &X = context.X_;
   const auto &U = context.U_;
   const auto &system = context.getSystem();
   const auto &objective = context.getObjective();
-  const auto &constraint_set = context.getConstraintSet();
   const int horizon = context.getHorizon();
   const int state_dim = context.getStateDim();
   const double timestep = context.getTimestep();
 
   // Initialize new trajectories
-  std::vector<Eigen::VectorXd> X_new = X;
-  std::vector<Eigen::VectorXd> U_new = U;
+  Trajectory X_new = X;
+  Trajectory U_new = U;
   std::vector<Eigen::VectorXd> F_new(horizon);
 
   // Set initial state
@@ -727,15 +765,15 @@ ForwardPassResult AlddpSolver::forwardPass(CDDP &context, double alpha) {
   }
 
   // 3. Add path constraint Lagrangian terms
-  for (const auto &constraint_pair : constraint_set) {
-    const std::string &constraint_name = constraint_pair.first;
-    const auto &constraint = constraint_pair.second;
+  const auto &blocks = context.getPathConstraintBlocks();
+  Eigen::VectorXd g_stacked;
+  for (int t = 0; t < horizon && !blocks.empty(); ++t) {
+    context.evaluatePathConstraints(X_new[t], U_new[t], g_stacked);
 
-    for (int t = 0; t < horizon; ++t) {
-      Eigen::VectorXd g = constraint->evaluate(X_new[t], U_new[t]) -
-                          constraint->getUpperBound();
-      const Eigen::VectorXd &y = Y_[constraint_name][t];
-      const double rho_path = rho_path_[constraint_name];
+    for (size_t b = 0; b < blocks.size(); ++b) {
+      const auto g = g_stacked.segment(blocks[b].offset, blocks[b].dim);
+      const auto y = Y_[t].segment(blocks[b].offset, blocks[b].dim);
+      const double rho_path = rho_path_[b];
 
       constraint_violation_new += std::max(0.0, g.maxCoeff());
 
@@ -766,8 +804,8 @@ ForwardPassResult AlddpSolver::forwardPass(CDDP &context, double alpha) {
   if (merit_function_new < lagrangian_value_ ||
       constraint_violation_new < constraint_violation_) {
     result.success = true;
-    result.state_trajectory = X_new;
-    result.control_trajectory = U_new;
+    result.state_trajectory = std::move(X_new);
+    result.control_trajectory = std::move(U_new);
     result.dynamics_trajectory = F_new;
     result.cost = cost_new;
     result.merit_function = merit_function_new;
@@ -793,7 +831,6 @@ void AlddpSolver::updateAugmentedLagrangian(CDDP &context) {
   const auto &options = context.getOptions();
   const auto &X = context.X_;
   const auto &U = context.U_;
-  const auto &constraint_set = context.getConstraintSet();
   const int horizon = context.getHorizon();
 
   double max_defect_violation = 0.0;
@@ -812,15 +849,15 @@ void AlddpSolver::updateAugmentedLagrangian(CDDP &context) {
   }
 
   // 2. Update path constraint dual variables (Lagrange multipliers)
-  for (const auto &constraint_pair : constraint_set) {
-    const std::string &constraint_name = constraint_pair.first;
-    const auto &constraint = constraint_pair.second;
+  const auto &blocks = context.getPathConstraintBlocks();
+  Eigen::VectorXd g_stacked;
+  for (int t = 0; t < horizon && !blocks.empty(); ++t) {
+    context.evaluatePathConstraints(X[t], U[t], g_stacked);
 
-    for (int t = 0; t < horizon; ++t) {
-      Eigen::VectorXd g =
-          constraint->evaluate(X[t], U[t]) - constraint->getUpperBound();
-      Eigen::VectorXd &y = Y_[constraint_name][t];
-      const double rho_path = rho_path_[constraint_name];
+    for (size_t b = 0; b < blocks.size(); ++b) {
+      const auto g = g_stacked.segment(blocks[b].offset, blocks[b].dim);
+      auto y = Y_[t].segment(blocks[b].offset, blocks[b].dim);
+      const double rho_path = rho_path_[b];
 
       // Update multipliers: y_new = max(0, y_old + rho_path * g) (simplified
       // for ALDDP)
@@ -866,45 +903,16 @@ void AlddpSolver::printIteration(int iter, double cost, double lagrangian,
             << constraint_violation << std::endl;
 }
 
-void AlddpSolver::printSolutionSummary(const CDDPSolution &solution) const {
+void AlddpSolver::printSolutionSummary(const SolveResult &result) const {
   std::cout << "\n=== ALDDP Solution Summary ===" << std::endl;
-  auto status_it = solution.find("status_message");
-  auto iterations_it = solution.find("iterations_completed");
-  auto solve_time_it = solution.find("solve_time_ms");
-  auto final_cost_it = solution.find("final_objective");
-  auto final_lagrangian_it = solution.find("final_lagrangian");
-  auto final_alpha_it = solution.find("final_step_length");
-
-  std::cout << "Status: "
-            << (status_it != solution.end()
-                    ? std::any_cast<std::string>(status_it->second)
-                    : "N/A")
-            << std::endl;
-  std::cout << "Iterations: "
-            << (iterations_it != solution.end()
-                    ? std::any_cast<int>(iterations_it->second)
-                    : -1)
-            << std::endl;
-  std::cout << "Solve time: "
-            << (solve_time_it != solution.end()
-                    ? std::any_cast<double>(solve_time_it->second) * 1e-3
-                    : -1.0)
-            << " seconds" << std::endl;
-  std::cout << "Final cost: "
-            << (final_cost_it != solution.end()
-                    ? std::any_cast<double>(final_cost_it->second)
-                    : -1.0)
-            << std::endl;
-  std::cout << "Final lagrangian: "
-            << (final_lagrangian_it != solution.end()
-                    ? std::any_cast<double>(final_lagrangian_it->second)
-                    : -1.0)
+  std::cout << "Status: " << result.status_message << std::endl;
+  std::cout << "Iterations: " << result.iterations_completed << std::endl;
+  std::cout << "Solve time: " << result.solve_time_ms * 1e-3 << " seconds"
             << std::endl;
-  std::cout << "Final step size: "
-            << (final_alpha_it != solution.end()
-                    ? std::any_cast<double>(final_alpha_it->second)
-                    : -1.0)
+  std::cout << "Final cost: " << result.final_objective << std::endl;
+  std::cout << "Final lagrangian: " << result.final_lagrangian.value_or(-1.0)
             << std::endl;
+  std::cout << "Final step size: " << result.final_step_length << std::endl;
   std::cout << "================================\n" << std::endl;
 }
 
@@ -18,15 +18,52 @@
 #include "cddp_core/cddp_core.hpp"
 #include "osqp++.h"
 #include "absl/status/status.h"
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <execution>
 #include <future>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 
 namespace cddp {
 
+namespace {
+
+// Writes @p dense (or its upper triangle) into @p sparse, storing every entry
+// of that region explicitly, zeros included. The pattern only depends on the
+// dimensions, so OSQP can update the values in place without a new symbolic
+// factorization.
+template <typename SparseMatrix>
+void setDenseValues(const Eigen::MatrixXd &dense, bool upper_only,
+                    SparseMatrix &sparse) {
+  const Eigen::Index rows = dense.rows();
+  const Eigen::Index cols = dense.cols();
+  const Eigen::Index nnz =
+      upper_only ? cols * (cols + 1) / 2 : rows * cols;
+  if (sparse.rows() != rows || sparse.cols() != cols ||
+      sparse.nonZeros() != nnz) {
+    sparse.resize(rows, cols);
+    sparse.reserve(Eigen::VectorXi::Constant(cols, static_cast<int>(rows)));
+    for (Eigen::Index j = 0; j < cols; ++j) {
+      const Eigen::Index last = upper_only ? j + 1 : rows;
+      for (Eigen::Index i = 0; i < last; ++i) {
+        sparse.insert(i, j) = 0.0;
+      }
+    }
+    sparse.makeCompressed();
+  }
+
+  for (Eigen::Index j = 0; j < cols; ++j) {
+    for (typename SparseMatrix::InnerIterator it(sparse, j); it; ++it) {
+      it.valueRef() = dense(it.row(), j);
+    }
+  }
+}
+
+} // namespace
+
 ASDDPSolver::ASDDPSolver() {}
 
 void ASDDPSolver::initialize(CDDP &context) {
@@ -36,6 +73,9 @@ void ASDDPSolver::initialize(CDDP &context) {
   int control_dim = context.getControlDim();
   int state_dim = context.getStateDim();
 
+  initializeForwardPassWorkspace(context);
+  F_u_.resize(horizon);
+
   // For warm starts, verify that existing state is valid
   if (options.warm_start) {
     bool valid_warm_start = (k_u_.size() == static_cast<size_t>(horizon) &&
@@ -94,7 +134,7 @@ void ASDDPSolver::initialize(CDDP &context) {
   }
 }
 
-CDDPSolution ASDDPSolver::solve(CDDP &context) {
+void ASDDPSolver::solve(CDDP &context, SolveResult &result) {
   const CDDPOptions &options = context.getOptions();
 
   // Print solver header if requested
@@ -107,34 +147,17 @@ CDDPSolution ASDDPSolver::solve(CDDP &context) {
     context.printOptions(options);
   }
 
-  // Prepare solution map
-  CDDPSolution solution;
-  solution["solver_name"] = getSolverName();
-  solution["status_message"] = std::string("Running");
-  solution["iterations_completed"] = 0;
-  solution["solve_time_ms"] = 0.0;
-
-  // Initialize history vectors only if requested
-  std::vector<double> history_objective;
-  std::vector<double> history_merit_function;
-  std::vector<double> history_step_length_primal;
-  std::vector<double> history_dual_infeasibility;
-  std::vector<double> history_regularization;
-
-  if (options.return_iteration_info) {
-    const size_t expected_size =
-        static_cast<size_t>(options.max_iterations + 1);
-    history_objective.reserve(expected_size);
-    history_merit_function.reserve(expected_size);
-    history_step_length_primal.reserve(expected_size);
-    history_dual_infeasibility.reserve(expected_size);
-    history_regularization.reserve(expected_size);
+  // History is recorded only if requested
+  result.beginSolve(getSolverName(), options.return_iteration_info,
+                    static_cast<size_t>(options.max_iterations + 1));
+  SolveHistory *history = result.history ? &*result.history : nullptr;
 
+  if (history) {
     // Initial iteration values
-    history_objective.push_back(context.cost_);
-    history_merit_function.push_back(context.merit_function_);
-    history_dual_infeasibility.push_back(context.inf_du_);
-    history_regularization.push_back(context.regularization_);
+    history->objective.push_back(context.cost_);
+    history->merit_function.push_back(context.merit_function_);
+    history->dual_infeasibility.push_back(context.inf_du_);
+    history->regularization.push_back(context.regularization_);
   }
 
   if (options.verbose) {
@@ -168,12 +191,21 @@ CDDPSolution ASDDPSolver::solve(CDDP &context) {
       }
     }
 
+    if (context.isCancellationRequested()) {
+      termination_reason = "Cancelled";
+      break;
+    }
+
     // 1. Backward pass
     bool backward_pass_success = false;
     while (!backward_pass_success) {
       backward_pass_success = backwardPass(context);
 
       if (!backward_pass_success) {
+        if (context.isCancellationRequested()) {
+          termination_reason = "Cancelled";
+          break;
+        }
         context.increaseRegularization();
         if (context.isRegularizationLimitReached()) {
           termination_reason = "RegularizationLimit_NotConverged";
@@ -201,8 +233,8 @@ CDDPSolution ASDDPSolver::solve(CDDP &context) {
 
     // Update solution if forward pass succeeded
     if (best_result.success) {
-      context.X_ = best_result.state_trajectory;
-      context.U_ = best_result.control_trajectory;
+      context.X_.swap(best_result.state_trajectory);
+      context.U_.swap(best_result.control_trajectory);
       double dJ = context.cost_ - best_result.cost;
       context.cost_ = best_result.cost;
       context.merit_function_ =
@@ -210,13 +242,14 @@ CDDPSolution ASDDPSolver::solve(CDDP &context) {
       context.alpha_pr_ = best_result.alpha_pr;
 
       // Store history only if requested
-      if (options.return_iteration_info) {
-        history_objective.push_back(context.cost_);
-        history_merit_function.push_back(context.merit_function_);
-        history_step_length_primal.push_back(context.alpha_pr_);
-        history_dual_infeasibility.push_back(context.inf_du_);
-        history_regularization.push_back(context.regularization_);
+      if (history) {
+        history->objective.push_back(context.cost_);
+        history->merit_function.push_back(context.merit_function_);
+        history->step_length_primal.push_back(context.alpha_pr_);
+        history->dual_infeasibility.push_back(context.inf_du_);
+        history->regularization.push_back(context.regularization_);
       }
+      context.notifyIteration(iter);
 
       context.decreaseRegularization();
 
@@ -227,6 +260,10 @@ CDDPSolution ASDDPSolver::solve(CDDP &context) {
         break;
       }
     } else {
+      if (context.isCancellationRequested()) {
+        termination_reason = "Cancelled";
+        break;
+      }
       context.increaseRegularization();
 
       // Check if regularization limit reached
@@ -258,44 +295,97 @@ CDDPSolution ASDDPSolver::solve(CDDP &context) {
   context.inf_pr_ = computeConstraintViolation(context);
 
   // Populate final solution
-  solution["status_message"] = termination_reason;
-  solution["iterations_completed"] = iter;
-  solution["solve_time_ms"] = static_cast<double>(duration.count());
-  solution["final_objective"] = context.cost_;
-  solution["final_step_length"] = context.alpha_pr_;
-  solution["final_dual_infeasibility"] = context.inf_du_;
-  solution["final_primal_infeasibility"] = context.inf_pr_;
+  result.status_message = termination_reason;
+  result.iterations_completed = iter;
+  result.solve_time_ms = static_cast<double>(duration.count());
+  result.final_objective = context.cost_;
+  result.final_step_length = context.alpha_pr_;
+  result.final_dual_infeasibility = context.inf_du_;
+  result.final_primal_infeasibility = context.inf_pr_;
 
   // Add trajectories
-  std::vector<double> time_points;
-  time_points.reserve(static_cast<size_t>(context.getHorizon() + 1));
-  for (int t = 0; t <= context.getHorizon(); ++t) {
-    time_points.push_back(t * context.getTimestep());
-  }
-  solution["time_points"] = time_points;
-  solution["state_trajectory"] = context.X_;
-  solution["control_trajectory"] = context.U_;
-
-  // Add iteration history if requested
-  if (options.return_iteration_info) {
-    solution["history_objective"] = history_objective;
-    solution["history_merit_function"] = history_merit_function;
-    solution["history_step_length_primal"] = history_step_length_primal;
-    solution["history_dual_infeasibility"] = history_dual_infeasibility;
-    solution["history_regularization"] = history_regularization;
-  }
+  result.setTimePoints(context.getHorizon(), context.getTimestep());
+  result.state_trajectory = context.X_;
+  result.control_trajectory = context.U_;
 
   // Add control gains
-  solution["control_feedback_gains_K"] = K_u_;
+  result.setFeedbackGains(K_u_);
 
   // Final metrics
-  solution["final_regularization"] = context.regularization_;
+  result.final_regularization = context.regularization_;
 
   if (options.verbose) {
-    printSolutionSummary(solution);
+    printSolutionSummary(result);
+  }
+}
+
+void ASDDPSolver::initializeForwardPassWorkspace(CDDP &context) {
+  const CDDPOptions &options = context.getOptions();
+  const int horizon = context.getHorizon();
+  const int state_dim = context.getStateDim();
+  const int control_dim = context.getControlDim();
+
+  // The control box is the first block of every QP; the other path
+  // constraints follow in the order of the constraint set
+  qp_constraints_.clear();
+  qp_constraint_rows_ = 0;
+  for (const auto &[name, constraint] : context.getConstraintSet()) {
+    if (name == "ControlBoxConstraint") {
+      continue;
+    }
+    QPConstraintRows rows;
+    rows.constraint = constraint.get();
+    rows.row = qp_constraint_rows_;
+    rows.upper = constraint->getUpperBound();
+    rows.dim = static_cast<int>(rows.upper.size());
+    qp_constraint_rows_ += rows.dim;
+    qp_constraints_.push_back(std::move(rows));
+  }
+  const int qp_rows = control_dim + qp_constraint_rows_;
+
+  auto control_box_constraint =
+      context.getConstraint<ControlBoxConstraint>("ControlBoxConstraint");
+  if (control_box_constraint) {
+    control_lower_ = control_box_constraint->getLowerBound();
+    control_upper_ = control_box_constraint->getUpperBound();
+  } else {
+    control_lower_ = Eigen::VectorXd::Constant(
+        control_dim, -std::numeric_limits<double>::infinity());
+    control_upper_ = Eigen::VectorXd::Constant(
+        control_dim, std::numeric_limits<double>::infinity());
   }
 
-  return solution;
+  // The parallel line search runs every alpha at once, one lane each
+  const size_t num_lanes =
+      options.enable_parallel ? std::max<size_t>(context.alphas_.size(), 1) : 1;
+  lanes_.resize(num_lanes);
+  for (ForwardPassLane &lane : lanes_) {
+    lane.knots.resize(horizon);
+    lane.delta_x.resize(state_dim);
+    lane.x_next.resize(state_dim);
+    lane.g.resize(qp_constraint_rows_);
+    lane.g_x.resize(qp_constraint_rows_, state_dim);
+    lane.g_u.resize(qp_constraint_rows_, control_dim);
+
+    for (KnotQP &knot : lane.knots) {
+      // Solvers are set up lazily in the forward pass; one whose QP no
+      // longer has the right shape is dropped here
+      if (knot.A_dense.rows() != qp_rows ||
+          knot.A_dense.cols() != control_dim) {
+        knot.solver.reset();
+      }
+      knot.A_dense = Eigen::MatrixXd::Zero(qp_rows, control_dim);
+      knot.A_dense.topRows(control_dim).setIdentity();
+      knot.q = Eigen::VectorXd::Zero(control_dim);
+      knot.lb = Eigen::VectorXd::Zero(qp_rows);
+      knot.ub = Eigen::VectorXd::Zero(qp_rows);
+      knot.lb.tail(qp_constraint_rows_)
+          .setConstant(-std::numeric_limits<double>::infinity());
+      setDenseValues(Eigen::MatrixXd::Zero(control_dim, control_dim),
+                     /*upper_only=*/true, knot.P);
+      setDenseValues(knot.A_dense, /*upper_only=*/false, knot.A);
+    }
+  }
 }
 
 std::string ASDDPSolver::getSolverName() const { return "ASDDP"; }
@@ -337,16 +427,16 @@ bool ASDDPSolver::backwardPass(CDDP &context) {
 
   // Backward Riccati recursion
   for (int t = horizon - 1; t >= 0; --t) {
+    if (context.isCancellationRequested()) {
+      return false;
+    }
+
     const Eigen::VectorXd &x = context.X_[t];
     const Eigen::VectorXd &u = context.U_[t];
 
-    // Get continuous dynamics Jacobians
-    const auto [Fx, Fu] = context.getSystem().getJacobians(x, u, t * timestep);
-
-    // Convert to discrete time
-    A = timestep * Fx;
-    A.diagonal().array() += 1.0;
-    B = timestep * Fu;
+    // Discrete dynamics Jacobians, exact for the system's integrator
+    std::tie(A, B) =
+        context.getSystem().getDiscreteJacobians(x, u, t * timestep);
 
     // Get cost and its derivatives
     auto [l_x, l_u] = context.getObjective().getRunningCostGradients(x, u, t);
@@ -485,6 +575,7 @@ bool ASDDPSolver::backwardPass(CDDP &context) {
     Q_UU_[t] = Q_uu_reg;
     Q_UX_[t] = Q_ux_reg;
     Q_U_[t] = Q_u;
+    F_u_[t] = B;
     k_u_[t] = k;
     K_u_[t] = K;
 
@@ -537,10 +628,11 @@ ForwardPassResult ASDDPSolver::performForwardPass(CDDP &context) {
     std::vector<std::future<ForwardPassResult>> futures;
     futures.reserve(context.alphas_.size());
 
-    for (double alpha_pr : context.alphas_) {
+    for (size_t i = 0; i < context.alphas_.size(); ++i) {
+      const double alpha_pr = context.alphas_[i];
       futures.push_back(
-          std::async(std::launch::async, [this, &context, alpha_pr]() {
-            return forwardPass(context, alpha_pr);
+          context.getThreadPool().submit([this, &context, alpha_pr, i]() {
+            return forwardPass(context, alpha_pr, i);
           }));
     }
 
@@ -564,7 +656,8 @@ ForwardPassResult ASDDPSolver::performForwardPass(CDDP &context) {
   return best_result;
 }
 
-ForwardPassResult ASDDPSolver::forwardPass(CDDP &context, double alpha_pr) {
+ForwardPassResult ASDDPSolver::forwardPass(CDDP &context, double alpha_pr,
+                                           size_t lane_index) {
   const CDDPOptions &options = context.getOptions();
 
   ForwardPassResult result;
@@ -572,15 +665,13 @@ ForwardPassResult ASDDPSolver::forwardPass(CDDP &context, double alpha_pr) {
   result.cost = std::numeric_limits<double>::infinity();
   result.merit_function = std::numeric_limits<double>::infinity();
   result.alpha_pr = alpha_pr;
+  if (context.isCancellationRequested()) {
+    return result;
+  }
 
-  const int state_dim = context.getStateDim();
   const int control_dim = context.getControlDim();
-  const int dual_dim = context.getTotalDualDim() - control_dim;
   const double timestep = context.getTimestep();
-
-  // Extract control box constraint
-  auto control_box_constraint =
-      context.getConstraint<ControlBoxConstraint>("ControlBoxConstraint");
+  ForwardPassLane &lane = lanes_[lane_index];
 
   // Initialize trajectories
   result.state_trajectory = context.X_;
@@ -593,91 +684,90 @@ ForwardPassResult ASDDPSolver::forwardPass(CDDP &context, double alpha_pr) {
   for (int t = 0; t < context.getHorizon(); ++t) {
     const Eigen::VectorXd &x = result.state_trajectory[t];
     const Eigen::VectorXd &u = result.control_trajectory[t];
-    const Eigen::VectorXd delta_x = x - context.X_[t];
+    KnotQP &knot = lane.knots[t];
 
     // Extract Q-function matrices computed in the backward pass
     const Eigen::VectorXd &Q_u = Q_U_[t];
     const Eigen::MatrixXd &Q_uu = Q_UU_[t];
     const Eigen::MatrixXd &Q_ux = Q_UX_[t];
 
-    // Create QP problem
-    Eigen::SparseMatrix<double> P = Q_uu.sparseView();
-    P.makeCompressed();
+    // QP Hessian; only the upper triangle is passed to OSQP
+    setDenseValues(Q_uu, /*upper_only=*/true, knot.P);
 
     // Form the gradient of the QP objective: q = alpha * Q_u + Q_ux * delta_x
-    Eigen::VectorXd q = alpha_pr * Q_u + Q_ux * delta_x;
-
-    // Create QP constraints
-    Eigen::MatrixXd A_dense =
-        Eigen::MatrixXd::Identity(control_dim, control_dim);
-    Eigen::VectorXd lb_dense = control_box_constraint->getLowerBound() - u;
-    Eigen::VectorXd ub_dense = control_box_constraint->getUpperBound() - u;
-
-    Eigen::MatrixXd A_aug = Eigen::MatrixXd::Zero(dual_dim, control_dim);
-    Eigen::VectorXd lb_aug = Eigen::VectorXd::Zero(dual_dim);
-    Eigen::VectorXd ub_aug = Eigen::VectorXd::Zero(dual_dim);
-
-    // First block: control constraints
-    A_aug.topRows(control_dim) = A_dense;
-    lb_aug.head(control_dim) = lb_dense;
-    ub_aug.head(control_dim) = ub_dense;
-
-    // Second block: state constraints
-    int row_index = control_dim;
-    if (t < context.getHorizon() - 1) {
-      auto [fx, fu] = context.getSystem().getJacobians(x, u, t * timestep);
-      Eigen::MatrixXd Fu = timestep * fu;
-
-      // Predicted next state
-      Eigen::VectorXd x_next =
-          context.getSystem().getDiscreteDynamics(x, u, t * timestep);
-
-      const auto &constraint_set = context.getConstraintSet();
-      for (const auto &[name, constraint] : constraint_set) {
-        if (name == "ControlBoxConstraint") {
-          continue;
-        }
-                    Eigen::VectorXd cons_vals = constraint->evaluate(x_next, u) - constraint->getUpperBound();
-            Eigen::MatrixXd cons_jac_x = constraint->getStateJacobian(x_next, u);
-            
-            int m = cons_vals.size();
-            A_aug.block(row_index, 0, m, control_dim) = cons_jac_x * Fu;
-            lb_aug.segment(row_index, m)
-                .setConstant(-std::numeric_limits<double>::infinity());
-            ub_aug.segment(row_index, m) = -cons_vals;
-            row_index += m;
+    lane.delta_x = x - context.X_[t];
+    knot.q.noalias() = Q_ux * lane.delta_x;
+    knot.q += alpha_pr * Q_u;
+
+    // First block: control constraints. Its rows of A are the identity,
+    // set once in initialize()
+    knot.lb.head(control_dim) = control_lower_ - u;
+    knot.ub.head(control_dim) = control_upper_ - u;
+
+    // Second block: the other path constraints, linearized at the predicted
+    // next state. The last knot keeps the zero rows from initialize()
+    if (t < context.getHorizon() - 1 && qp_constraint_rows_ > 0) {
+      // Control Jacobian of the nominal knot, from the backward pass
+      const Eigen::MatrixXd &Fu = F_u_[t];
+
+      context.getSystem().evalDiscreteDynamicsInto(x, u, t * timestep,
+                                                   lane.x_next);
+
+      for (const QPConstraintRows &rows : qp_constraints_) {
+        auto g = lane.g.segment(rows.row, rows.dim);
+        rows.constraint->evalInto(lane.x_next, u, g);
+        rows.constraint->evalJacobiansInto(
+            lane.x_next, u, lane.g_x.middleRows(rows.row, rows.dim),
+            lane.g_u.middleRows(rows.row, rows.dim));
+        knot.ub.segment(control_dim + rows.row, rows.dim) = rows.upper - g;
       }
+      knot.A_dense.bottomRows(qp_constraint_rows_).noalias() = lane.g_x * Fu;
     }
 
-    // Convert augmented constraint matrix to sparse format
-    Eigen::SparseMatrix<double> A_sparse = A_aug.sparseView();
-
-    // Initialize QP solver
-    osqp::OsqpInstance instance;
-    instance.objective_matrix = P;
-    instance.objective_vector = q;
-    instance.constraint_matrix = A_sparse;
-    instance.lower_bounds = lb_aug;
-    instance.upper_bounds = ub_aug;
-
-    // Solve the QP problem
-    osqp::OsqpSolver osqp_solver;
-    osqp::OsqpSettings osqp_settings;
-    osqp_settings.warm_start = true;
-    osqp_settings.verbose = false;
+    setDenseValues(knot.A_dense, /*upper_only=*/false, knot.A);
 
     try {
-      absl::Status init_status = osqp_solver.Init(instance, osqp_settings);
-      if (!init_status.ok()) {
-        if (options.debug) {
-          std::cerr << "ASDDP: QP solver initialization failed at time step " << t
-                    << ": " << init_status.message() << std::endl;
+      // Update the knot's solver in place; a solver that does not exist yet
+      // is set up from scratch
+      std::unique_ptr<osqp::OsqpSolver> &osqp_solver = knot.solver;
+      const bool updated =
+          osqp_solver && osqp_solver->IsInitialized() &&
+          osqp_solver->UpdateObjectiveAndConstraintMatrices(knot.P, knot.A)
+              .ok() &&
+          osqp_solver->SetObjectiveVector(knot.q).ok() &&
+          osqp_solver->SetBounds(knot.lb, knot.ub).ok();
+
+      if (!updated) {
+        osqp::OsqpInstance instance;
+        instance.objective_matrix = knot.P;
+        instance.objective_vector = knot.q;
+        instance.constraint_matrix = knot.A;
+        instance.lower_bounds = knot.lb;
+        instance.upper_bounds = knot.ub;
+
+        osqp::OsqpSettings osqp_settings;
+        osqp_settings.warm_start = true;
+        osqp_settings.verbose = false;
+        // A warm-started solve stops as soon as the previous solution is
+        // within tolerance; OSQP's default 1e-3 then leaves a bias in
+        // delta_u that keeps the iterates from converging
+        osqp_settings.eps_abs = 1e-6;
+        osqp_settings.eps_rel = 1e-6;
+
+        osqp_solver = std::make_unique<osqp::OsqpSolver>();
+        absl::Status init_status = osqp_solver->Init(instance, osqp_settings);
+        if (!init_status.ok()) {
+          if (options.debug) {
+            std::cerr << "ASDDP: QP solver initialization failed at time step "
+                      << t << ": " << init_status.message() << std::endl;
+          }
+          osqp_solver.reset();
+          result.success = false;
+          return result;
         }
-        result.success = false;
-        return result;
       }
 
-      osqp::OsqpExitCode exit_code = osqp_solver.Solve();
+      osqp::OsqpExitCode exit_code = osqp_solver->Solve();
 
       if (exit_code != osqp::OsqpExitCode::kOptimal) {
         if (options.debug) {
@@ -689,8 +779,7 @@ ForwardPassResult ASDDPSolver::forwardPass(CDDP &context, double alpha_pr) {
       }
 
       // Update control using the QP solution delta_u
-      Eigen::VectorXd delta_u = osqp_solver.primal_solution();
-      result.control_trajectory[t] += delta_u;
+      result.control_trajectory[t] += osqp_solver->primal_solution();
     } catch (const std::exception &e) {
       if (options.debug) {
         std::cerr << "ASDDP: OSQP exception at time step " << t << ": "
@@ -703,8 +792,9 @@ ForwardPassResult ASDDPSolver::forwardPass(CDDP &context, double alpha_pr) {
     // Compute running cost and propagate state
     J_new +=
         context.getObjective().running_cost(x, result.control_trajectory[t], t);
-    result.state_trajectory[t + 1] = context.getSystem().getDiscreteDynamics(
-        x, result.control_trajectory[t], t * context.getTimestep());
+    context.getSystem().evalDiscreteDynamicsInto(
+        x, result.control_trajectory[t], t * timestep,
+        result.state_trajectory[t + 1]);
   }
 
   // Add terminal cost
@@ -756,7 +846,9 @@ double ASDDPSolver::computeConstraintViolation(CDDP &context) {
   // Check constraint violations for each time step
   for (int t = 0; t <= context.getHorizon(); ++t) {
     const Eigen::VectorXd &x = context.X_[t];
-    const Eigen::VectorXd &u = (t < context.getHorizon()) ? context.U_[t] : Eigen::VectorXd::Zero(context.getControlDim());
+    const Eigen::VectorXd u = (t < context.getHorizon())
+                                  ? Eigen::VectorXd(context.U_[t])
+                                  : Eigen::VectorXd::Zero(context.getControlDim());
 
     // Control box constraints
     auto control_box_constraint =
@@ -798,17 +890,16 @@ void ASDDPSolver::printIteration(int iter, double cost, double merit,
             << std::endl;
 }
 
-void ASDDPSolver::printSolutionSummary(const CDDPSolution &solution) const {
+void ASDDPSolver::printSolutionSummary(const SolveResult &result) const {
   std::cout << "\n========================================\n";
   std::cout << "           ASDDP Solution Summary\n";
   std::cout << "========================================\n";
 
-  auto iterations = std::any_cast<int>(solution.at("iterations_completed"));
-  auto solve_time = std::any_cast<double>(solution.at("solve_time_ms"));
-  auto final_cost = std::any_cast<double>(solution.at("final_objective"));
-  auto status = std::any_cast<std::string>(solution.at("status_message"));
-  auto final_inf_pr =
-      std::any_cast<double>(solution.at("final_primal_infeasibility"));
+  auto iterations = result.iterations_completed;
+  auto solve_time = result.solve_time_ms;
+  auto final_cost = result.final_objective;
+  const auto &status = result.status_message;
+  auto final_inf_pr = result.final_primal_infeasibility.value_or(0.0);
 
   std::cout << "Status: " << status << "\n";
   std::cout << "Iterations: " << iterations << "\n";
@@ -0,0 +1,158 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "cddp_core/batch_solver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace cddp {
+
+namespace {
+
+int defaultThreadCount(int num_threads) {
+  if (num_threads > 0) {
+    return num_threads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+BatchSolver::BatchSolver(ProblemFactory factory,
+                         const std::string &solver_type, int num_threads)
+    : factory_(std::move(factory)), solver_type_(solver_type),
+      pool_(defaultThreadCount(num_threads)) {
+  if (!factory_) {
+    throw std::invalid_argument("BatchSolver: factory must not be empty");
+  }
+}
+
+std::vector<SolveResult>
+BatchSolver::solve(const std::vector<BatchProblem> &problems) {
+  std::vector<SolveResult> results;
+  solve(problems, results);
+  return results;
+}
+
+void BatchSolver::solve(const std::vector<BatchProblem> &problems,
+                        std::vector<SolveResult> &results) {
+  results.resize(problems.size());
+  if (problems.empty()) {
+    return;
+  }
+
+  const int num_tasks =
+      static_cast<int>(std::min<size_t>(pool_.size(), problems.size()));
+  createWorkers(num_tasks);
+
+  // Each task owns one worker and pulls instances until none are left, so
+  // uneven solve times balance out across the pool
+  std::atomic<size_t> next{0};
+  std::vector<std::future<void>> futures;
+  futures.reserve(num_tasks);
+  for (int w = 0; w < num_tasks; ++w) {
+    futures.push_back(pool_.submit([this, w, &problems, &results, &next]() {
+      Worker &worker = *workers_[w];
+      for (size_t i = next++; i < problems.size(); i = next++) {
+        solveOne(worker, problems[i], results[i]);
+      }
+    }));
+  }
+
+  // Wait for every task before rethrowing so that none outlives the inputs
+  std::exception_ptr error;
+  for (auto &future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void BatchSolver::createWorkers(int count) {
+  while (static_cast<int>(workers_.size()) < count) {
+    auto worker = std::make_unique<Worker>();
+    worker->problem = factory_();
+    if (!worker->problem) {
+      throw std::runtime_error("BatchSolver: factory returned a null problem");
+    }
+    worker->initial_state_trajectory = worker->problem->X_;
+    worker->initial_control_trajectory = worker->problem->U_;
+    worker->reference_state = worker->problem->getReferenceState();
+    worker->reference_states = worker->problem->getReferenceStates();
+    workers_.push_back(std::move(worker));
+  }
+}
+
+void BatchSolver::solveOne(Worker &worker, const BatchProblem &problem,
+                           SolveResult &result) {
+  CDDP &cddp = *worker.problem;
+  if (problem.initial_state.size() != cddp.getStateDim()) {
+    throw std::invalid_argument(
+        "BatchSolver: initial state has size " +
+        std::to_string(problem.initial_state.size()) + ", expected " +
+        std::to_string(cddp.getStateDim()));
+  }
+
+  if (!problem.initial_state_trajectory.empty() &&
+      !problem.initial_control_trajectory.empty()) {
+    cddp.setInitialTrajectory(problem.initial_state_trajectory,
+                              problem.initial_control_trajectory);
+  } else if (!worker.initial_state_trajectory.empty() &&
+             !worker.initial_control_trajectory.empty()) {
+    cddp.setInitialTrajectory(worker.initial_state_trajectory,
+                              worker.initial_control_trajectory);
+  } else {
+    // No initial guess: start from zeros like a freshly built problem
+    cddp.X_.setZero();
+    cddp.U_.setZero();
+  }
+  cddp.setInitialState(problem.initial_state);
+
+  if (problem.reference_state.size() > 0) {
+    cddp.setReferenceState(problem.reference_state);
+    worker.reference_state_overridden = true;
+  } else if (worker.reference_state_overridden) {
+    cddp.setReferenceState(worker.reference_state);
+    worker.reference_state_overridden = false;
+  }
+  if (!problem.reference_states.empty()) {
+    cddp.setReferenceStates(problem.reference_states);
+    worker.reference_states_overridden = true;
+  } else if (worker.reference_states_overridden) {
+    cddp.setReferenceStates(worker.reference_states);
+    worker.reference_states_overridden = false;
+  }
+
+  // Re-initialize problem and solver so every instance starts cold,
+  // independent of what this worker solved before
+  cddp.resetWarmStart();
+  cddp.solve(solver_type_, result);
+}
+
+} // namespace cddp
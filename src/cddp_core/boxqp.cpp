@@ -15,161 +15,193 @@
 */
 #include "cddp_core/boxqp.hpp"
 #include <Eigen/Dense>
-#include <tuple>
-#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <limits>
 
 namespace cddp {
 
 BoxQPSolver::BoxQPSolver(const BoxQPOptions &options) : options_(options) {}
 
+void BoxQPWorkspace::resize(int n) {
+  if (x.size() == n) {
+    return;
+  }
+  x.resize(n);
+  free.resize(n);
+  Hfree = Eigen::LDLT<Eigen::MatrixXd>(n);
+  active_set = Eigen::VectorXi::Zero(n);
+  has_active_set = false;
+  grad.resize(n);
+  grad_clamped.resize(n);
+  search.resize(n);
+  x_trial.resize(n);
+  Hx.resize(n);
+  clamped.resize(n);
+  old_clamped.resize(n);
+  H_free.resize(n, n);
+}
+
 BoxQPResult BoxQPSolver::solve(const Eigen::MatrixXd &H,
                                const Eigen::VectorXd &g,
                                const Eigen::VectorXd &lower,
                                const Eigen::VectorXd &upper,
                                const Eigen::VectorXd &x0) {
-  const int n = H.rows();
+  BoxQPWorkspace ws(H.rows());
+  solve(H, g, lower, upper, x0, ws);
+
   BoxQPResult result;
-  result.status = BoxQPStatus::MAX_ITER_EXCEEDED;
-  result.iterations = 0;
-  result.factorizations = 0;
+  result.x = ws.x;
+  result.status = ws.status;
+  result.free = ws.free;
+  result.final_value = ws.final_value;
+  result.final_grad_norm = ws.final_grad_norm;
+  result.iterations = ws.iterations;
+  result.factorizations = ws.factorizations;
+
+  // BoxQPResult::Hfree factors the free block itself
+  const int num_free = ws.free.sum();
+  if (num_free > 0 && ws.status != BoxQPStatus::HESSIAN_NOT_PD) {
+    Eigen::MatrixXd H_free(num_free, num_free);
+    for (int i = 0, fi = 0; i < H.rows(); ++i) {
+      if (!ws.free[i])
+        continue;
+      for (int j = 0, fj = 0; j < H.cols(); ++j) {
+        if (ws.free[j])
+          H_free(fi, fj++) = H(i, j);
+      }
+      ++fi;
+    }
+    result.Hfree.compute(H_free);
+  }
+  return result;
+}
+
+BoxQPStatus BoxQPSolver::solve(const Eigen::MatrixXd &H,
+                               const Eigen::VectorXd &g,
+                               const Eigen::VectorXd &lower,
+                               const Eigen::VectorXd &upper,
+                               const Eigen::VectorXd &x0, BoxQPWorkspace &ws) {
+  const int n = H.rows();
+  ws.resize(n);
+  ws.status = BoxQPStatus::MAX_ITER_EXCEEDED;
+  ws.iterations = 0;
+  ws.factorizations = 0;
+  ws.final_grad_norm = 0.0;
 
   // Initialize state vector x
-  result.x = initializeX(x0, lower, upper, n);
+  initializeX(x0, lower, upper, ws);
 
   // Initialize free/clamped sets
-  Eigen::VectorXi clamped = Eigen::VectorXi::Zero(n);
-  result.free = Eigen::VectorXi::Ones(n);
+  ws.clamped.setZero();
+  ws.free.setOnes();
 
   // Initial objective value
-  double value = evaluateObjective(result.x, H, g);
+  double value = evaluateObjective(ws.x, H, g, ws.Hx);
   double old_value = std::numeric_limits<double>::infinity();
 
   // Main iteration loop
   for (int iter = 0; iter < options_.max_iterations; ++iter) {
-    result.iterations = iter + 1;
+    ws.iterations = iter + 1;
 
     // Check relative improvement
     if (iter > 0 &&
         std::abs(old_value - value) <
             options_.min_relative_improvement * std::abs(old_value)) {
-      result.status = BoxQPStatus::SUCCESS;
+      ws.status = BoxQPStatus::SUCCESS;
       break;
     }
     old_value = value;
 
-    // Calculate gradient
-    Eigen::VectorXd grad = g + H * result.x;
+    // Calculate gradient; ws.Hx holds H * x of the current point
+    ws.grad = g + ws.Hx;
 
     // Update clamped set
-    Eigen::VectorXi old_clamped = clamped;
-    clamped = Eigen::VectorXi::Zero(n);
-
+    ws.old_clamped = ws.clamped;
     for (int i = 0; i < n; ++i) {
-      if ((result.x[i] == lower[i] && grad[i] > 0) ||
-          (result.x[i] == upper[i] && grad[i] < 0)) {
-        clamped[i] = 1;
-      }
+      ws.clamped[i] = (ws.x[i] == lower[i] && ws.grad[i] > 0) ||
+                      (ws.x[i] == upper[i] && ws.grad[i] < 0);
     }
-    result.free = Eigen::VectorXi::Ones(n) - clamped;
+    ws.free.setOnes();
+    ws.free -= ws.clamped;
 
     // Check if all dimensions are clamped
-    if (clamped.sum() == n) {
-      result.status = BoxQPStatus::ALL_CLAMPED;
+    if (ws.clamped.sum() == n) {
+      ws.status = BoxQPStatus::ALL_CLAMPED;
       break;
     }
 
-    // Factorize if clamped set changed
-    bool any_different = false;
-    for (int i = 0; i < n; i++) {
-      if (old_clamped[i] != clamped[i]) {
-        any_different = true;
-        break;
-      }
-    }
-    bool factorize = (iter == 0) || any_different;
+    // Factorize if clamped set changed. Clamped rows and columns are
+    // replaced by the identity so the factor keeps its full size.
+    bool factorize =
+        (iter == 0) || (ws.old_clamped.array() != ws.clamped.array()).any();
 
     if (factorize) {
-      std::vector<int> free_idx;
+      ws.H_free = H;
       for (int i = 0; i < n; ++i) {
-        if (!clamped[i])
-          free_idx.push_back(i);
-      }
-
-      Eigen::MatrixXd H_free(free_idx.size(), free_idx.size());
-      for (size_t i = 0; i < free_idx.size(); ++i) {
-        for (size_t j = 0; j < free_idx.size(); ++j) {
-          H_free(i, j) = H(free_idx[i], free_idx[j]);
+        if (ws.clamped[i]) {
+          ws.H_free.row(i).setZero();
+          ws.H_free.col(i).setZero();
+          ws.H_free(i, i) = 1.0;
         }
       }
 
-      result.Hfree.compute(H_free);
-      if (result.Hfree.info() != Eigen::Success) {
-        result.status = BoxQPStatus::HESSIAN_NOT_PD;
+      ws.Hfree.compute(ws.H_free);
+      if (ws.Hfree.info() != Eigen::Success) {
+        ws.status = BoxQPStatus::HESSIAN_NOT_PD;
         break;
       }
-      result.factorizations++;
+      ws.factorizations++;
     }
 
     // Check gradient norm
     double grad_norm = 0;
     for (int i = 0; i < n; ++i) {
-      if (!clamped[i])
-        grad_norm += grad[i] * grad[i];
+      if (!ws.clamped[i])
+        grad_norm += ws.grad[i] * ws.grad[i];
     }
     grad_norm = std::sqrt(grad_norm);
-    result.final_grad_norm = grad_norm;
+    ws.final_grad_norm = grad_norm;
 
     if (grad_norm < options_.min_gradient_norm) {
-      result.status = BoxQPStatus::SUCCESS;
+      ws.status = BoxQPStatus::SUCCESS;
       break;
     }
 
-    // Compute search direction
-    Eigen::VectorXd search = Eigen::VectorXd::Zero(n);
-    Eigen::VectorXd grad_clamped = g;
+    // Compute search direction: Newton step on the free variables with the
+    // clamped ones held fixed
+    ws.grad_clamped = -g;
     for (int i = 0; i < n; ++i) {
-      if (clamped[i])
-        grad_clamped += H.col(i) * result.x[i];
+      if (ws.clamped[i])
+        ws.grad_clamped.noalias() -= H.col(i) * ws.x[i];
     }
-
-    // Extract free components
-    std::vector<int> free_idx;
-    Eigen::VectorXd grad_free;
     for (int i = 0; i < n; ++i) {
-      if (!clamped[i]) {
-        free_idx.push_back(i);
-        grad_free.conservativeResize(free_idx.size());
-        grad_free[free_idx.size() - 1] = grad_clamped[i];
-      }
+      if (ws.clamped[i])
+        ws.grad_clamped[i] = 0.0;
     }
-
-    // Solve system for free variables
-    Eigen::VectorXd search_free = -result.Hfree.solve(grad_free);
-
-    // Put solution back into full vector
-    for (size_t i = 0; i < free_idx.size(); ++i) {
-      search[free_idx[i]] = search_free[i] - result.x[free_idx[i]];
+    ws.search = ws.Hfree.solve(ws.grad_clamped);
+    for (int i = 0; i < n; ++i) {
+      ws.search[i] = ws.clamped[i] ? 0.0 : ws.search[i] - ws.x[i];
     }
 
     // Check descent direction
-    double sdotg = search.dot(grad);
+    double sdotg = ws.search.dot(ws.grad);
     if (sdotg >= 0) {
-      result.status = BoxQPStatus::NO_DESCENT;
+      ws.status = BoxQPStatus::NO_DESCENT;
       break;
     }
 
     // Do line search
-    auto [linesearch_success, step_info] =
-        lineSearch(result.x, search, grad, value, H, g, lower, upper);
-    if (!linesearch_success) {
-      result.status = BoxQPStatus::MAX_LS_EXCEEDED;
+    double step = 0.0;
+    double value_new = value;
+    if (!lineSearch(H, g, lower, upper, value, sdotg, ws, step, value_new)) {
+      ws.status = BoxQPStatus::MAX_LS_EXCEEDED;
       break;
     }
 
-    // Accept step
-    double step = step_info.first;
-    result.x = step_info.second;
-    value = evaluateObjective(result.x, H, g);
+    // Accept step; ws.Hx was left at the accepted point by the line search
+    ws.x.swap(ws.x_trial);
+    value = value_new;
 
     if (options_.verbose) {
       printf("Iter %d: obj=%.6f |g|=%.6g step=%.2g\n", iter, value, grad_norm,
@@ -177,76 +209,86 @@ BoxQPResult BoxQPSolver::solve(const Eigen::MatrixXd &H,
     }
   }
 
-  result.final_value = value;
-  return result;
+  // Remember which variables ended on a bound for the next solve
+  for (int i = 0; i < n; ++i) {
+    ws.active_set[i] =
+        (ws.x[i] == lower[i]) ? -1 : ((ws.x[i] == upper[i]) ? 1 : 0);
+  }
+  ws.has_active_set = true;
+
+  ws.final_value = value;
+  return ws.status;
 }
 
-Eigen::VectorXd BoxQPSolver::initializeX(const Eigen::VectorXd &x0,
-                                         const Eigen::VectorXd &lower,
-                                         const Eigen::VectorXd &upper, int n) {
+void BoxQPSolver::initializeX(const Eigen::VectorXd &x0,
+                              const Eigen::VectorXd &lower,
+                              const Eigen::VectorXd &upper,
+                              BoxQPWorkspace &ws) const {
+  const int n = ws.x.size();
   if (x0.size() == n) {
-    return projectOntoBox(x0, lower, upper);
+    ws.x = x0.cwiseMax(lower).cwiseMin(upper);
+  } else {
+    // Initialize at midpoint of bounds
+    for (int i = 0; i < n; ++i) {
+      if (std::isfinite(lower[i]) && std::isfinite(upper[i])) {
+        ws.x[i] = 0.5 * (lower[i] + upper[i]);
+      } else if (std::isfinite(lower[i])) {
+        ws.x[i] = lower[i];
+      } else if (std::isfinite(upper[i])) {
+        ws.x[i] = upper[i];
+      } else {
+        ws.x[i] = 0.0;
+      }
+    }
   }
 
-  // Initialize at midpoint of bounds
-  Eigen::VectorXd x(n);
-  for (int i = 0; i < n; ++i) {
-    if (std::isfinite(lower[i]) && std::isfinite(upper[i])) {
-      x[i] = 0.5 * (lower[i] + upper[i]);
-    } else if (std::isfinite(lower[i])) {
-      x[i] = lower[i];
-    } else if (std::isfinite(upper[i])) {
-      x[i] = upper[i];
-    } else {
-      x[i] = 0.0;
+  // Active-set warm start: the bounds move with the nominal control, so a
+  // previous solution on a bound is no longer exactly on it; put it back
+  if (ws.has_active_set) {
+    for (int i = 0; i < n; ++i) {
+      if (ws.active_set[i] < 0 && std::isfinite(lower[i])) {
+        ws.x[i] = lower[i];
+      } else if (ws.active_set[i] > 0 && std::isfinite(upper[i])) {
+        ws.x[i] = upper[i];
+      }
     }
   }
-  return x;
 }
 
-std::pair<bool, std::pair<double, Eigen::VectorXd>>
-BoxQPSolver::lineSearch(const Eigen::VectorXd &x, const Eigen::VectorXd &search,
-                        const Eigen::VectorXd &gradient, double value,
-                        const Eigen::MatrixXd &H, const Eigen::VectorXd &g,
-                        const Eigen::VectorXd &lower,
-                        const Eigen::VectorXd &upper) {
-
-  double step = 1.0;
-  const double sdotg = search.dot(gradient);
+bool BoxQPSolver::lineSearch(const Eigen::MatrixXd &H, const Eigen::VectorXd &g,
+                             const Eigen::VectorXd &lower,
+                             const Eigen::VectorXd &upper, double value,
+                             double sdotg, BoxQPWorkspace &ws, double &step,
+                             double &value_new) const {
+  step = 1.0;
 
   while (step > options_.min_step_size) {
     // Compute candidate
-    Eigen::VectorXd x_new = projectOntoBox(x + step * search, lower, upper);
+    ws.x_trial = (ws.x + step * ws.search).cwiseMax(lower).cwiseMin(upper);
 
     // Evaluate objective
-    double value_new = evaluateObjective(x_new, H, g);
+    value_new = evaluateObjective(ws.x_trial, H, g, ws.Hx);
 
     // Check Armijo condition
     if ((value_new - value) <= options_.armijo_constant * step * sdotg) {
-      return {true, {step, x_new}};
+      return true;
     }
 
     step *= options_.step_decrease_factor;
   }
 
-  return {false, {0.0, x}};
+  // Restore H * x of the current point
+  evaluateObjective(ws.x, H, g, ws.Hx);
+  step = 0.0;
+  return false;
 }
 
 double BoxQPSolver::evaluateObjective(const Eigen::VectorXd &x,
                                       const Eigen::MatrixXd &H,
-                                      const Eigen::VectorXd &g) const {
-  return 0.5 * x.dot(H * x) + g.dot(x);
-}
-
-Eigen::VectorXd
-BoxQPSolver::projectOntoBox(const Eigen::VectorXd &x,
-                            const Eigen::VectorXd &lower,
-                            const Eigen::VectorXd &upper) const {
-  Eigen::VectorXd x_proj = x;
-  for (int i = 0; i < x.size(); ++i) {
-    x_proj[i] = std::min(std::max(x[i], lower[i]), upper[i]);
-  }
-  return x_proj;
+                                      const Eigen::VectorXd &g,
+                                      Eigen::VectorXd &Hx) const {
+  Hx.noalias() = H * x;
+  return 0.5 * x.dot(Hx) + g.dot(x);
 }
 
-} // namespace cddp
\ No newline at end of file
+} // namespace cddp
@@ -84,7 +84,7 @@ void CDDP::setDynamicalSystem(std::unique_ptr<DynamicalSystem> system) {
 
 void CDDP::setInitialState(const Eigen::VectorXd &initial_state) {
   initial_state_ = initial_state;
-  if (X_.empty() || X_[0].size() != initial_state.size()) {
+  if (X_.empty() || X_.dim() != initial_state.size()) {
     // If X_ is not compatible, it will be handled by
     // initializeProblemIfNecessary
   } else {
@@ -142,6 +142,14 @@ void CDDP::setOptions(const CDDPOptions &options) {
   alpha_pr_ = options_.line_search.initial_step_size;
 }
 
+ThreadPool &CDDP::getThreadPool() {
+  const int num_threads = std::max(1, options_.num_threads);
+  if (!thread_pool_ || thread_pool_->size() != num_threads) {
+    thread_pool_ = std::make_unique<ThreadPool>(num_threads);
+  }
+  return *thread_pool_;
+}
+
 void CDDP::setObjective(std::unique_ptr<Objective> objective) {
   objective_ = std::move(objective);
   if (objective_ && !reference_state_.isZero() &&
@@ -163,9 +171,23 @@ void CDDP::setInitialTrajectory(const std::vector<Eigen::VectorXd> &X,
                  "horizon."
               << std::endl;
   }
+  X_.assign(X);
+  U_.assign(U);
+  if (!X_.empty()) { // Ensure initial state is consistent
+    initial_state_ = X_[0];
+  }
+}
+
+void CDDP::setInitialTrajectory(const Trajectory &X, const Trajectory &U) {
+  if (X.size() != static_cast<size_t>(horizon_ + 1) ||
+      U.size() != static_cast<size_t>(horizon_)) {
+    std::cerr << "Warning: Provided initial trajectory dimensions do not match "
+                 "horizon."
+              << std::endl;
+  }
   X_ = X;
   U_ = U;
-  if (!X_.empty()) { // Ensure initial state is consistent
+  if (!X_.empty()) {
     initial_state_ = X_[0];
   }
 }
@@ -183,6 +205,74 @@ int CDDP::getControlDim() const {
 }
 int CDDP::getTotalDualDim() const { return total_dual_dim_; }
 
+void CDDP::evaluatePathConstraints(const Eigen::VectorXd &state,
+                                   const Eigen::VectorXd &control,
+                                   Eigen::VectorXd &g) const {
+  g.resize(path_dual_dim_);
+  for (const auto &block : path_constraint_blocks_) {
+    // Box constraints evaluate into the upper half and mirror it above
+    auto g_value = g.segment(block.offset + block.dim - block.value_dim,
+                             block.value_dim);
+    block.constraint->evalInto(state, control, g_value);
+    if (block.value_dim != block.dim) {
+      g.segment(block.offset, block.value_dim) = -g_value;
+    }
+    g.segment(block.offset, block.dim) -=
+        path_upper_bound_.segment(block.offset, block.dim);
+  }
+}
+
+void CDDP::evaluatePathConstraintJacobians(const ConstraintBlock &block,
+                                           const Eigen::VectorXd &state,
+                                           const Eigen::VectorXd &control,
+                                           Eigen::Ref<Eigen::MatrixXd> g_x,
+                                           Eigen::Ref<Eigen::MatrixXd> g_u) const {
+  const int value_offset = block.dim - block.value_dim;
+  block.constraint->evalJacobiansInto(
+      state, control, g_x.middleRows(value_offset, block.value_dim),
+      g_u.middleRows(value_offset, block.value_dim));
+  if (block.value_dim != block.dim) {
+    g_x.topRows(block.value_dim) = -g_x.bottomRows(block.value_dim);
+    g_u.topRows(block.value_dim) = -g_u.bottomRows(block.value_dim);
+  }
+}
+
+void CDDP::compileConstraintTables() {
+  auto compile = [](const std::map<std::string, std::unique_ptr<Constraint>> &set,
+                    std::vector<ConstraintBlock> &blocks, int &total_dim) {
+    blocks.clear();
+    blocks.reserve(set.size());
+    total_dim = 0;
+    for (const auto &constraint_pair : set) {
+      ConstraintBlock block;
+      block.name = constraint_pair.first;
+      block.constraint = constraint_pair.second.get();
+      block.offset = total_dim;
+      block.dim = constraint_pair.second->getDualDim();
+      block.value_dim =
+          static_cast<int>(constraint_pair.second->getUpperBound().size());
+      total_dim += block.dim;
+      blocks.push_back(std::move(block));
+    }
+  };
+  compile(path_constraint_set_, path_constraint_blocks_, path_dual_dim_);
+  compile(terminal_constraint_set_, terminal_constraint_blocks_,
+          terminal_dual_dim_);
+
+  // Bounds are read here rather than per evaluation; the table is recompiled
+  // at the start of every solve, so bounds changed between solves (e.g. a
+  // moved obstacle) are picked up
+  path_upper_bound_.resize(path_dual_dim_);
+  for (const auto &block : path_constraint_blocks_) {
+    block.constraint->evalUpperBoundInto(path_upper_bound_.segment(
+        block.offset + block.dim - block.value_dim, block.value_dim));
+    if (block.value_dim != block.dim) {
+      path_upper_bound_.segment(block.offset, block.value_dim) =
+          -block.constraint->getLowerBound();
+    }
+  }
+}
+
 void CDDP::addPathConstraint(std::string constraint_name,
                              std::unique_ptr<Constraint> constraint) {
   if (!constraint) {
@@ -198,6 +288,7 @@ void CDDP::addPathConstraint(std::string constraint_name,
   total_dual_dim_ += dual_dim;
 
   initialized_ = false; // Constraint set changed, need to reinitialize
+  compileConstraintTables();
 }
 
 bool CDDP::removePathConstraint(const std::string &constraint_name) {
@@ -211,6 +302,7 @@ bool CDDP::removePathConstraint(const std::string &constraint_name) {
 
     // Mark as needing reinitialization since constraint set changed
     initialized_ = false;
+    compileConstraintTables();
 
     return true; // Successfully removed
   }
@@ -233,6 +325,7 @@ void CDDP::addTerminalConstraint(std::string constraint_name,
   total_dual_dim_ += dual_dim;
 
   initialized_ = false; // Constraint set changed, need to reinitialize
+  compileConstraintTables();
 }
 
 bool CDDP::removeTerminalConstraint(const std::string &constraint_name) {
@@ -246,6 +339,7 @@ bool CDDP::removeTerminalConstraint(const std::string &constraint_name) {
 
     // Mark as needing reinitialization since constraint set changed
     initialized_ = false;
+    compileConstraintTables();
 
     return true; // Successfully removed
   }
@@ -306,29 +400,114 @@ CDDP::createSolver(const std::string &solver_type) {
 }
 
 CDDPSolution CDDP::solve(const std::string &solver_type) {
-  // This is where strategy selection and invocation will happen.
+  SolveResult unknown;
+  if (!prepareSolver(solver_type, unknown)) {
+    return toSolution(std::move(unknown));
+  }
+  return solver_->solve(*this);
+}
+
+void CDDP::solve(SolverType solver_type, SolveResult &result) {
+  solve(solverTypeToString(solver_type), result);
+}
+
+void CDDP::solve(const std::string &solver_type, SolveResult &result) {
+  if (!prepareSolver(solver_type, result)) {
+    return;
+  }
+  solver_->solve(*this, result);
+}
+
+void CDDP::prepare(SolverType solver_type) {
+  prepare(solverTypeToString(solver_type));
+}
+
+void CDDP::prepare(const std::string &solver_type) {
+  SolveResult unknown;
+  if (!prepareSolver(solver_type, unknown)) {
+    throw std::runtime_error(unknown.status_message);
+  }
+  solver_->prepare(*this);
+  rti_prepared_ = true;
+}
+
+void CDDP::feedback(const Eigen::VectorXd &initial_state,
+                    SolveResult &result) {
+  if (!rti_prepared_ || !solver_) {
+    throw std::runtime_error("CDDP::feedback() requires a preceding prepare()");
+  }
+  if (initial_state.size() != X_.dim()) {
+    throw std::runtime_error("CDDP::feedback(): initial state has dimension " +
+                             std::to_string(initial_state.size()) +
+                             ", expected " + std::to_string(X_.dim()));
+  }
+  rti_prepared_ = false;
+
+  // X_[0] keeps the linearization point so that the forward pass sees the
+  // deviation of the measured state from it
+  initial_state_ = initial_state;
+  solver_->feedback(*this, result);
+}
+
+void CDDP::setIterationCallback(IterationCallback callback) {
+  iteration_callback_ = std::move(callback);
+}
+
+void CDDP::setCancellationToken(const CancellationToken &token) {
+  cancellation_token_ = token;
+}
+
+std::future<SolveResult> CDDP::solveAsync(SolverType solver_type,
+                                          CancellationToken token) {
+  return solveAsync(solverTypeToString(solver_type), std::move(token));
+}
+
+std::future<SolveResult> CDDP::solveAsync(const std::string &solver_type,
+                                          CancellationToken token) {
+  // A dedicated thread rather than the worker pool: the solve itself may
+  // wait on pool tasks
+  return std::async(std::launch::async, [this, solver_type, token]() {
+    const CancellationToken previous = cancellation_token_;
+    cancellation_token_ = token;
+    SolveResult result;
+    try {
+      solve(solver_type, result);
+    } catch (...) {
+      cancellation_token_ = previous;
+      throw;
+    }
+    cancellation_token_ = previous;
+    return result;
+  });
+}
+
+bool CDDP::prepareSolver(const std::string &solver_type,
+                         SolveResult &unknown) {
+  rti_prepared_ = false;
+
+  // On warm-started re-solves of an unchanged problem, keep the existing
+  // solver instance so that its workspaces, gains and duals are reused.
+  const bool reuse_solver = solver_ && initialized_ && options_.warm_start &&
+                            solver_type == solver_type_;
 
   initializeProblemIfNecessary(); // Ensure X_, U_ are sized etc.
 
   // Strategy selection and instantiation
-  solver_ = createSolver(solver_type);
+  if (!reuse_solver) {
+    solver_ = createSolver(solver_type);
+    solver_type_ = solver_type;
+  }
 
   if (!solver_) {
-    // Solver not found - return error solution
-    CDDPSolution solution;
-    solution["solver_name"] = solver_type;
-    solution["status_message"] =
+    // Solver not found - report an empty solution
+    unknown.beginSolve(solver_type, false);
+    unknown.status_message =
         std::string("UnknownSolver - No solver registered for '") +
         solver_type + "'";
-    solution["iterations_completed"] = 0;
-    solution["solve_time_ms"] = 0.0;
-    solution["final_objective"] = 0.0;
-    solution["final_step_length"] = 1.0;
-
-    // Add empty trajectories
-    solution["time_points"] = std::vector<double>();
-    solution["state_trajectory"] = std::vector<Eigen::VectorXd>();
-    solution["control_trajectory"] = std::vector<Eigen::VectorXd>();
+    unknown.time_points.clear();
+    unknown.state_trajectory = Trajectory();
+    unknown.control_trajectory = Trajectory();
+    unknown.control_feedback_gains_K.clear();
 
     if (options_.verbose) {
       std::cout << "Solver type '" << solver_type
@@ -340,12 +519,44 @@ CDDPSolution CDDP::solve(const std::string &solver_type) {
       std::cout << "CLDDP ASDDP LogDDP IPDDP MSIPDDP ALDDP" << std::endl;
     }
 
-    return solution;
+    return false;
   }
 
-  // Use the strategy to solve the problem
   solver_->initialize(*this);
-  return solver_->solve(*this);
+  return true;
+}
+
+void CDDP::resetWarmStart() {
+  initialized_ = false;
+  solver_.reset();
+  solver_type_.clear();
+  rti_prepared_ = false;
+}
+
+void CDDP::shiftTrajectory(int steps) {
+  if (steps <= 0 || X_.empty() || U_.empty()) {
+    return;
+  }
+  if (!system_) {
+    throw std::runtime_error("Dynamical system must be set before shifting.");
+  }
+
+  const int horizon = static_cast<int>(U_.size());
+  const int s = std::min(steps, horizon);
+
+  // Rotate in place and hold the last control over the vacated tail
+  cddp::shiftTrajectory(U_, s);
+  cddp::shiftTrajectory(X_, s);
+
+  // Re-propagate the tail states so the shifted trajectory stays dynamically
+  // consistent
+  for (int t = horizon - s; t < horizon; ++t) {
+    X_[t + 1] = system_->getDiscreteDynamics(X_[t], U_[t], t * timestep_);
+  }
+
+  if (solver_) {
+    solver_->shift(*this, s);
+  }
 }
 
 void CDDP::initializeProblemIfNecessary() {
@@ -363,57 +574,20 @@ void CDDP::initializeProblemIfNecessary() {
   int state_dim = system_->getStateDim();
   int control_dim = system_->getControlDim();
 
-  // For warm start: preserve existing trajectories if they have compatible
-  // dimensions
-  bool preserve_trajectories =
-      options_.warm_start && !X_.empty() && !U_.empty() &&
-      static_cast<int>(X_.size()) == horizon_ + 1 &&
-      static_cast<int>(U_.size()) == horizon_ && X_[0].size() == state_dim &&
-      U_[0].size() == control_dim;
-
-  // Initialize state trajectory
-  if (X_.empty() || static_cast<int>(X_.size()) != horizon_ + 1) {
-    if (preserve_trajectories) {
-      // Warm start: resize existing trajectory carefully
-      if (options_.verbose) {
-        std::cout << "CDDP: Warm start detected - preserving existing state "
-                     "trajectory"
-                  << std::endl;
-      }
-      // Keep existing X_ but ensure correct size
-      X_.resize(horizon_ + 1);
-    } else {
-      // Cold start: initialize with zeros
-      X_.clear();
-      X_.resize(horizon_ + 1);
-      for (int k = 0; k <= horizon_; ++k) {
-        X_[k] = Eigen::VectorXd::Zero(state_dim);
-      }
-    }
+  compileConstraintTables();
+
+  // Existing trajectories with compatible dimensions are kept (warm start);
+  // anything else is reset to zeros
+  if (static_cast<int>(X_.size()) != horizon_ + 1 || X_.dim() != state_dim) {
+    X_ = Trajectory(state_dim, horizon_ + 1);
   }
 
   // Ensure initial state is set correctly (always required)
   X_[0] = initial_state_;
 
   // Initialize control trajectory
-  if (U_.empty() || static_cast<int>(U_.size()) != horizon_) {
-    if (preserve_trajectories) {
-      // Warm start: resize existing trajectory carefully
-      if (options_.verbose) {
-        std::cout << "CDDP: Warm start detected - preserving existing control "
-                     "trajectory"
-                  << std::endl;
-      }
-      // Keep existing U_ but ensure correct size
-      U_.resize(horizon_);
-    } else {
-      // Cold start: initialize with zeros
-      U_.clear();
-      U_.resize(horizon_);
-      for (int k = 0; k < horizon_; ++k) {
-        U_[k] = Eigen::VectorXd::Zero(control_dim);
-      }
-    }
+  if (static_cast<int>(U_.size()) != horizon_ || U_.dim() != control_dim) {
+    U_ = Trajectory(control_dim, horizon_);
   }
 
   // Initialize cost and merit function
@@ -23,6 +23,7 @@
 #include <future>
 #include <iomanip>
 #include <iostream>
+#include <utility>
 
 namespace cddp {
 
@@ -35,6 +36,9 @@ void CLDDPSolver::initialize(CDDP &context) {
   int control_dim = context.getControlDim();
   int state_dim = context.getStateDim();
 
+  control_box_constraint_ =
+      context.getConstraint<ControlBoxConstraint>("ControlBoxConstraint");
+
   // For warm starts, verify that existing state is valid
   if (options.warm_start) {
     // Check if solver state is properly initialized and compatible
@@ -92,8 +96,9 @@ void CLDDPSolver::initialize(CDDP &context) {
 
   dV_ = Eigen::Vector2d::Zero();
 
-  // Setup BoxQP solver
+  // Setup BoxQP solver; the per-knot active sets are not carried over
   boxqp_solver_ = BoxQPSolver(options.box_qp);
+  boxqp_workspaces_.clear();
 
   // Compute initial cost if trajectories exist
   if (!context.X_.empty() && !context.U_.empty()) {
@@ -101,7 +106,7 @@ void CLDDPSolver::initialize(CDDP &context) {
   }
 }
 
-CDDPSolution CLDDPSolver::solve(CDDP &context) {
+void CLDDPSolver::solve(CDDP &context, SolveResult &result) {
   const CDDPOptions &options = context.getOptions();
 
   // Print solver header if requested
@@ -114,36 +119,18 @@ CDDPSolution CLDDPSolver::solve(CDDP &context) {
     context.printOptions(options);
   }
 
-  // Prepare solution map
-  CDDPSolution solution;
-  solution["solver_name"] = getSolverName();
-  solution["status_message"] = std::string("Running");
-  solution["iterations_completed"] = 0;
-  solution["solve_time_ms"] = 0.0;
-
-  // Initialize history vectors only if requested
-  std::vector<double> history_objective;
-  std::vector<double> history_merit_function;
-  std::vector<double> history_step_length_primal;
-  std::vector<double> history_dual_infeasibility;
-  std::vector<double> history_regularization;
-
-  if (options.return_iteration_info) {
-    // Pre-allocate history vectors for efficiency (max_iterations + 1 for
-    // initial iteration)
-    const size_t expected_size =
-        static_cast<size_t>(options.max_iterations + 1);
-    history_objective.reserve(expected_size);
-    history_merit_function.reserve(expected_size);
-    history_step_length_primal.reserve(expected_size);
-    history_dual_infeasibility.reserve(expected_size);
-    history_regularization.reserve(expected_size);
+  // History is recorded only if requested (max_iterations + 1 entries for
+  // the initial iteration)
+  result.beginSolve(getSolverName(), options.return_iteration_info,
+                    static_cast<size_t>(options.max_iterations + 1));
+  SolveHistory *history = result.history ? &*result.history : nullptr;
 
+  if (history) {
     // Initial iteration values
-    history_objective.push_back(context.cost_);
-    history_merit_function.push_back(context.merit_function_);
-    history_dual_infeasibility.push_back(context.inf_du_);
-    history_regularization.push_back(context.regularization_);
+    history->objective.push_back(context.cost_);
+    history->merit_function.push_back(context.merit_function_);
+    history->dual_infeasibility.push_back(context.inf_du_);
+    history->regularization.push_back(context.regularization_);
   }
 
   if (options.verbose) {
@@ -177,12 +164,21 @@ CDDPSolution CLDDPSolver::solve(CDDP &context) {
       }
     }
 
+    if (context.isCancellationRequested()) {
+      termination_reason = "Cancelled";
+      break;
+    }
+
     // 1. Backward pass
     bool backward_pass_success = false;
     while (!backward_pass_success) {
       backward_pass_success = backwardPass(context);
 
       if (!backward_pass_success) {
+        if (context.isCancellationRequested()) {
+          termination_reason = "Cancelled";
+          break;
+        }
         context.increaseRegularization();
         if (context.isRegularizationLimitReached()) {
           termination_reason = "RegularizationLimit_NotConverged";
@@ -206,26 +202,27 @@ CDDPSolution CLDDPSolver::solve(CDDP &context) {
     }
 
     // 2. Forward pass
-    ForwardPassResult best_result = performForwardPass(context);
+    ForwardPassResult &best_result = performForwardPass(context);
 
     // Update solution if forward pass succeeded
     if (best_result.success) {
-      context.X_ = best_result.state_trajectory;
-      context.U_ = best_result.control_trajectory;
+      context.X_.swap(best_result.state_trajectory);
+      context.U_.swap(best_result.control_trajectory);
       double dJ = context.cost_ - best_result.cost;
       context.cost_ = best_result.cost;
       context.merit_function_ = best_result.merit_function;
       context.alpha_pr_ = best_result.alpha_pr;
 
       // Store history only if requested
-      if (options.return_iteration_info) {
-        history_objective.push_back(context.cost_);
-        history_merit_function.push_back(context.merit_function_);
-        history_step_length_primal.push_back(
+      if (history) {
+        history->objective.push_back(context.cost_);
+        history->merit_function.push_back(context.merit_function_);
+        history->step_length_primal.push_back(
             context.getCurrentPrimalStepSize());
-        history_dual_infeasibility.push_back(context.inf_du_);
-        history_regularization.push_back(context.regularization_);
+        history->dual_infeasibility.push_back(context.inf_du_);
+        history->regularization.push_back(context.regularization_);
       }
+      context.notifyIteration(iter);
 
       context.decreaseRegularization();
 
@@ -236,6 +233,10 @@ CDDPSolution CLDDPSolver::solve(CDDP &context) {
         break;
       }
     } else {
+      if (context.isCancellationRequested()) {
+        termination_reason = "Cancelled";
+        break;
+      }
       context.increaseRegularization();
 
       // Check if regularization limit reached
@@ -264,76 +265,157 @@ CDDPSolution CLDDPSolver::solve(CDDP &context) {
       end_time - start_time);
 
   // Populate final solution with detailed status
-  solution["status_message"] = termination_reason;
-  solution["iterations_completed"] = iter;
-  solution["solve_time_ms"] = static_cast<double>(duration.count());
-  solution["final_objective"] = context.cost_;
-  solution["final_step_length"] = context.alpha_pr_;
-
-  // Add trajectories
-  std::vector<double> time_points;
-  time_points.reserve(static_cast<size_t>(context.getHorizon() +
-                                          1)); // Pre-allocate for efficiency
-  for (int t = 0; t <= context.getHorizon(); ++t) {
-    time_points.push_back(t * context.getTimestep());
-  }
-  solution["time_points"] = time_points;
-  solution["state_trajectory"] = context.X_;
-  solution["control_trajectory"] = context.U_;
-
-  // Add iteration history if requested
-  if (options.return_iteration_info) {
-    solution["history_objective"] = history_objective;
-    solution["history_merit_function"] = history_merit_function;
-    solution["history_step_length_primal"] = history_step_length_primal;
-    solution["history_dual_infeasibility"] = history_dual_infeasibility;
-    std::map<std::string, std::vector<double>> history_regularization_map;
-    history_regularization_map["control"] = history_regularization;
-    solution["history_regularization"] = history_regularization_map;
-  }
-
-  // Add control gains
-  solution["control_feedback_gains_K"] = K_u_;
+  result.status_message = termination_reason;
+  result.iterations_completed = iter;
+  result.solve_time_ms = static_cast<double>(duration.count());
+  result.final_objective = context.cost_;
+  result.final_step_length = context.alpha_pr_;
+
+  // Trajectories and gains are copied into the result's existing storage
+  result.setTimePoints(context.getHorizon(), context.getTimestep());
+  result.state_trajectory = context.X_;
+  result.control_trajectory = context.U_;
+  result.setFeedbackGains(K_u_);
 
   // Final metrics
-  solution["final_regularization"] = context.regularization_;
+  result.final_regularization = context.regularization_;
 
   if (options.verbose) {
-    printSolutionSummary(solution);
+    printSolutionSummary(result);
   }
-
-  return solution;
 }
 
 std::string CLDDPSolver::getSolverName() const { return "CLDDP"; }
 
+void CLDDPSolver::shift(CDDP &context, int steps) {
+  cddp::shiftTrajectory(k_u_, steps);
+  cddp::shiftTrajectory(K_u_, steps);
+}
+
+void CLDDPSolver::prepare(CDDP &context) {
+  // The backward pass only depends on the nominal trajectory, not on the
+  // initial state, so all of it runs ahead of the measurement
+  prepared_ = false;
+  while (!prepared_) {
+    prepared_ = backwardPass(context);
+    if (!prepared_) {
+      if (context.isCancellationRequested()) {
+        break;
+      }
+      context.increaseRegularization();
+      if (context.isRegularizationLimitReached()) {
+        break;
+      }
+    }
+  }
+
+  if (!prepared_) {
+    // Gains may be partially overwritten; feedback() then replays the
+    // nominal controls
+    for (int t = 0; t < context.getHorizon(); ++t) {
+      k_u_[t].setZero();
+      K_u_[t].setZero();
+    }
+    if (context.getOptions().verbose) {
+      std::cerr << "CLDDP: Backward pass regularization limit reached"
+                << std::endl;
+    }
+  }
+}
+
+void CLDDPSolver::feedback(CDDP &context, SolveResult &result) {
+  result.beginSolve(getSolverName(), false);
+  auto start_time = std::chrono::high_resolution_clock::now();
+
+  // Take the full step without a line search: forwardPass()'s acceptance
+  // test compares against the cost of a nominal trajectory that started
+  // from a different initial state, so only a diverged rollout is rejected
+  forwardPass(context, context.alphas_.front(), trial_result_,
+              forward_workspace_);
+  const bool success =
+      std::isfinite(trial_result_.cost) &&
+      trial_result_.state_trajectory.matrix().allFinite() &&
+      trial_result_.control_trajectory.matrix().allFinite();
+
+  if (success) {
+    context.X_.swap(trial_result_.state_trajectory);
+    context.U_.swap(trial_result_.control_trajectory);
+    context.cost_ = trial_result_.cost;
+    context.merit_function_ = trial_result_.merit_function;
+    context.alpha_pr_ = trial_result_.alpha_pr;
+    if (prepared_) {
+      context.decreaseRegularization();
+    }
+    context.notifyIteration(1);
+  } else {
+    // Keep the nominal trajectory as the linearization point for the
+    // next iteration
+    context.increaseRegularization();
+  }
+
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start_time);
+
+  if (!prepared_) {
+    result.status_message = "RegularizationLimitReached_NotConverged";
+  } else if (success) {
+    result.status_message = "RealTimeIterationCompleted";
+  } else {
+    result.status_message = "ForwardPassFailed_NotConverged";
+  }
+  result.iterations_completed = 1;
+  result.solve_time_ms = duration.count() / 1000.0;
+  result.final_objective = context.cost_;
+  result.final_step_length = context.alpha_pr_;
+  result.setTimePoints(context.getHorizon(), context.getTimestep());
+  result.state_trajectory = context.X_;
+  result.control_trajectory = context.U_;
+  result.setFeedbackGains(K_u_);
+  result.final_regularization = context.regularization_;
+}
+
 bool CLDDPSolver::backwardPass(CDDP &context) {
   const CDDPOptions &options = context.getOptions();
   const int state_dim = context.getStateDim();
   const int control_dim = context.getControlDim();
   const int horizon = context.getHorizon();
-
-  // Extract control box constraint
-  auto control_box_constraint =
-      context.getConstraint<ControlBoxConstraint>("ControlBoxConstraint");
+  const double timestep = context.getTimestep();
+
+  Workspace &ws = workspace_;
+  Eigen::VectorXd &x = ws.x;
+  Eigen::VectorXd &u = ws.u;
+  Eigen::MatrixXd &A = ws.A;
+  Eigen::MatrixXd &B = ws.B;
+  Eigen::VectorXd &Q_x = ws.Q_x;
+  Eigen::VectorXd &Q_u = ws.Q_u;
+  Eigen::MatrixXd &Q_xx = ws.Q_xx;
+  Eigen::MatrixXd &Q_ux = ws.Q_ux;
+  Eigen::MatrixXd &Q_uu = ws.Q_uu;
+  Eigen::MatrixXd &Q_uu_reg = ws.Q_uu_reg;
+  Eigen::VectorXd &V_x = ws.V_x;
+  Eigen::MatrixXd &V_xx = ws.V_xx;
+  const Objective &objective = context.getObjective();
+  const DynamicalSystem &system = context.getSystem();
+
+  // The eval*Into calls below write into these; resizing is a no-op once
+  // the workspace has been sized
+  A.resize(state_dim, state_dim);
+  B.resize(state_dim, control_dim);
+  ws.l_x.resize(state_dim);
+  ws.l_u.resize(control_dim);
+  ws.l_xx.resize(state_dim, state_dim);
+  ws.l_uu.resize(control_dim, control_dim);
+  ws.l_ux.resize(control_dim, state_dim);
+  V_x.resize(state_dim);
+  V_xx.resize(state_dim, state_dim);
+  if (control_box_constraint_ != nullptr) {
+    boxqp_workspaces_.resize(horizon);
+  }
 
   // Terminal cost and its derivatives
-  Eigen::VectorXd V_x =
-      context.getObjective().getFinalCostGradient(context.X_.back());
-  Eigen::MatrixXd V_xx =
-      context.getObjective().getFinalCostHessian(context.X_.back());
-
-  // Pre-allocate matrices
-  Eigen::MatrixXd A(state_dim, state_dim);
-  Eigen::MatrixXd B(state_dim, control_dim);
-  Eigen::VectorXd Q_x(state_dim);
-  Eigen::VectorXd Q_u(control_dim);
-  Eigen::MatrixXd Q_xx(state_dim, state_dim);
-  Eigen::MatrixXd Q_uu(control_dim, control_dim);
-  Eigen::MatrixXd Q_uu_reg(control_dim, control_dim);
-  Eigen::MatrixXd Q_ux(control_dim, state_dim);
-  Eigen::VectorXd k(control_dim);
-  Eigen::MatrixXd K(control_dim, state_dim);
+  x = context.X_.back();
+  objective.evalFinalCostGradientInto(x, V_x);
+  objective.evalFinalCostHessianInto(x, V_xx);
 
   dV_ = Eigen::Vector2d::Zero();
   double norm_Vx = V_x.lpNorm<1>();
@@ -341,37 +423,48 @@ bool CLDDPSolver::backwardPass(CDDP &context) {
 
   // Backward Riccati recursion
   for (int t = horizon - 1; t >= 0; --t) {
-    const Eigen::VectorXd &x = context.X_[t];
-    const Eigen::VectorXd &u = context.U_[t];
+    if (context.isCancellationRequested()) {
+      return false;
+    }
 
-    // Get continuous dynamics Jacobians
-    const auto [Fx, Fu] =
-        context.getSystem().getJacobians(x, u, t * context.getTimestep());
+    x = context.X_[t];
+    u = context.U_[t];
 
-    // Convert to discrete time
-    A = context.getTimestep() * Fx;
-    A.diagonal().array() += 1.0;
-    B = context.getTimestep() * Fu;
+    // Discrete dynamics Jacobians, exact for the system's integrator
+    system.evalDiscreteJacobiansInto(x, u, t * timestep, A, B);
 
     // Get cost and its derivatives
-    auto [l_x, l_u] = context.getObjective().getRunningCostGradients(x, u, t);
-    auto [l_xx, l_uu, l_ux] =
-        context.getObjective().getRunningCostHessians(x, u, t);
-
-    // Compute Q-function matrices
-    Q_x = l_x + A.transpose() * V_x;
-    Q_u = l_u + B.transpose() * V_x;
-    Q_xx = l_xx + A.transpose() * V_xx * A;
-    Q_ux = l_ux + B.transpose() * V_xx * A;
-    Q_uu = l_uu + B.transpose() * V_xx * B;
+    objective.evalRunningCostGradientsInto(x, u, t, ws.l_x, ws.l_u);
+    objective.evalRunningCostHessiansInto(x, u, t, ws.l_xx, ws.l_uu,
+                                          ws.l_ux);
+    const Eigen::VectorXd &l_x = ws.l_x;
+    const Eigen::VectorXd &l_u = ws.l_u;
+    const Eigen::MatrixXd &l_xx = ws.l_xx;
+    const Eigen::MatrixXd &l_uu = ws.l_uu;
+    const Eigen::MatrixXd &l_ux = ws.l_ux;
+
+    // Compute Q-function matrices; products go through preallocated
+    // intermediates so that no temporaries are created
+    ws.V_xx_A.noalias() = V_xx * A;
+    ws.V_xx_B.noalias() = V_xx * B;
+    Q_x = l_x;
+    Q_x.noalias() += A.transpose() * V_x;
+    Q_u = l_u;
+    Q_u.noalias() += B.transpose() * V_x;
+    Q_xx = l_xx;
+    Q_xx.noalias() += A.transpose() * ws.V_xx_A;
+    Q_ux = l_ux;
+    Q_ux.noalias() += B.transpose() * ws.V_xx_A;
+    Q_uu = l_uu;
+    Q_uu.noalias() += B.transpose() * ws.V_xx_B;
 
     // Apply regularization
     Q_uu_reg = Q_uu;
     Q_uu_reg.diagonal().array() += context.regularization_;
 
     // Check positive definiteness
-    Eigen::EigenSolver<Eigen::MatrixXd> es(Q_uu_reg);
-    if (es.eigenvalues().real().minCoeff() <= 0) {
+    ws.llt.compute(Q_uu_reg);
+    if (ws.llt.info() != Eigen::Success) {
       if (options.debug) {
         std::cerr << "CLDDP: Q_uu is not positive definite at time " << t
                   << std::endl;
@@ -379,66 +472,73 @@ bool CLDDPSolver::backwardPass(CDDP &context) {
       return false;
     }
 
+    Eigen::VectorXd &k = k_u_[t];
+    Eigen::MatrixXd &K = K_u_[t];
+
     // Solve for control law
-    if (control_box_constraint == nullptr) {
-      const Eigen::MatrixXd H = Q_uu_reg.inverse();
-      k = -H * Q_u;
-      K = -H * Q_ux;
+    if (control_box_constraint_ == nullptr) {
+      k = -Q_u;
+      ws.llt.solveInPlace(k);
+      K = -Q_ux;
+      ws.llt.solveInPlace(K);
     } else {
-      // Solve constrained QP
-      const Eigen::VectorXd lb = control_box_constraint->getLowerBound() - u;
-      const Eigen::VectorXd ub = control_box_constraint->getUpperBound() - u;
-      const Eigen::VectorXd x0 = k_u_[t];
+      // Solve constrained QP, warm-started from this knot's active set of
+      // the previous iteration
+      ws.lb = control_box_constraint_->getLowerBound() - u;
+      ws.ub = control_box_constraint_->getUpperBound() - u;
+      BoxQPWorkspace &qp = boxqp_workspaces_[t];
 
-      BoxQPResult qp_result = boxqp_solver_.solve(Q_uu_reg, Q_u, lb, ub, x0);
+      const BoxQPStatus qp_status =
+          boxqp_solver_.solve(Q_uu_reg, Q_u, ws.lb, ws.ub, k, qp);
 
-      if (qp_result.status == BoxQPStatus::HESSIAN_NOT_PD ||
-          qp_result.status == BoxQPStatus::NO_DESCENT) {
+      if (qp_status == BoxQPStatus::HESSIAN_NOT_PD ||
+          qp_status == BoxQPStatus::NO_DESCENT) {
         if (options.debug) {
           std::cerr << "CLDDP: BoxQP failed at time step " << t << std::endl;
         }
         return false;
       }
 
-      k = qp_result.x;
+      k = qp.x;
 
-      // Compute feedback gain
-      K = Eigen::MatrixXd::Zero(control_dim, state_dim);
-      if (qp_result.free.sum() > 0) {
-        std::vector<int> free_idx;
+      // Compute feedback gain on the free subspace; qp.Hfree keeps clamped
+      // rows decoupled, so their gains come out zero
+      if (qp.free.sum() > 0) {
+        ws.Q_ux_free = -Q_ux;
         for (int i = 0; i < control_dim; i++) {
-          if (qp_result.free(i)) {
-            free_idx.push_back(i);
+          if (!qp.free(i)) {
+            ws.Q_ux_free.row(i).setZero();
           }
         }
-
-        Eigen::MatrixXd Q_ux_free(free_idx.size(), state_dim);
-        for (size_t i = 0; i < free_idx.size(); i++) {
-          Q_ux_free.row(i) = Q_ux.row(free_idx[i]);
-        }
-
-        Eigen::MatrixXd K_free = -qp_result.Hfree.solve(Q_ux_free);
-
-        for (size_t i = 0; i < free_idx.size(); i++) {
-          K.row(free_idx[i]) = K_free.row(i);
+        K = qp.Hfree.solve(ws.Q_ux_free);
+        for (int i = 0; i < control_dim; i++) {
+          if (!qp.free(i)) {
+            K.row(i).setZero();
+          }
         }
+      } else {
+        K.setZero(control_dim, state_dim);
       }
     }
 
-    // Store gains
-    k_u_[t] = k;
-    K_u_[t] = K;
-
     // Update value function
+    ws.Q_uu_k.noalias() = Q_uu * k;
+    ws.Q_uu_K.noalias() = Q_uu * K;
+
     Eigen::Vector2d dV_step;
-    dV_step << Q_u.dot(k), 0.5 * k.dot(Q_uu * k);
+    dV_step << Q_u.dot(k), 0.5 * k.dot(ws.Q_uu_k);
     dV_ += dV_step;
 
-    V_x = Q_x + K.transpose() * Q_uu * k + Q_ux.transpose() * k +
-          K.transpose() * Q_u;
-    V_xx = Q_xx + K.transpose() * Q_uu * K + Q_ux.transpose() * K +
-           K.transpose() * Q_ux;
-    V_xx = 0.5 * (V_xx + V_xx.transpose()); // Symmetrize
+    V_x = Q_x;
+    V_x.noalias() += K.transpose() * ws.Q_uu_k;
+    V_x.noalias() += Q_ux.transpose() * k;
+    V_x.noalias() += K.transpose() * Q_u;
+    V_xx = Q_xx;
+    V_xx.noalias() += K.transpose() * ws.Q_uu_K;
+    V_xx.noalias() += Q_ux.transpose() * K;
+    V_xx.noalias() += K.transpose() * Q_ux;
+    ws.V_xx_T = V_xx.transpose();
+    V_xx = 0.5 * (V_xx + ws.V_xx_T); // Symmetrize
 
     norm_Vx += V_x.lpNorm<1>();
 
@@ -460,22 +560,27 @@ bool CLDDPSolver::backwardPass(CDDP &context) {
   return true;
 }
 
-ForwardPassResult CLDDPSolver::performForwardPass(CDDP &context) {
+ForwardPassResult &CLDDPSolver::performForwardPass(CDDP &context) {
   const CDDPOptions &options = context.getOptions();
-  ForwardPassResult best_result;
+  ForwardPassResult &best_result = best_result_;
   best_result.cost = std::numeric_limits<double>::infinity();
   best_result.success = false;
 
   if (!options.enable_parallel) {
+    // Both buffers rotate with X_/U_ through swaps; give them storage up
+    // front so that rollouts only ever overwrite it
+    for (ForwardPassResult *buffer : {&trial_result_, &best_result_}) {
+      buffer->state_trajectory.resize(context.X_.dim(), context.X_.size());
+      buffer->control_trajectory.resize(context.U_.dim(), context.U_.size());
+    }
+
     // Single-threaded execution with early termination
     for (double alpha_pr : context.alphas_) {
-      ForwardPassResult result = forwardPass(context, alpha_pr);
+      forwardPass(context, alpha_pr, trial_result_, forward_workspace_);
 
-      if (result.success && result.cost < best_result.cost) {
-        best_result = result;
-        if (result.success) {
-          break; // Early termination
-        }
+      if (trial_result_.success && trial_result_.cost < best_result.cost) {
+        std::swap(best_result, trial_result_);
+        break; // Early termination
       }
     }
   } else {
@@ -485,8 +590,11 @@ ForwardPassResult CLDDPSolver::performForwardPass(CDDP &context) {
 
     for (double alpha_pr : context.alphas_) {
       futures.push_back(
-          std::async(std::launch::async, [this, &context, alpha_pr]() {
-            return forwardPass(context, alpha_pr);
+          context.getThreadPool().submit([this, &context, alpha_pr]() {
+            ForwardPassResult result;
+            ForwardPassWorkspace ws;
+            forwardPass(context, alpha_pr, result, ws);
+            return result;
           }));
     }
 
@@ -495,7 +603,7 @@ ForwardPassResult CLDDPSolver::performForwardPass(CDDP &context) {
         if (future.valid()) {
           ForwardPassResult result = future.get();
           if (result.success && result.cost < best_result.cost) {
-            best_result = result;
+            best_result = std::move(result);
           }
         }
       } catch (const std::exception &e) {
@@ -510,14 +618,18 @@ ForwardPassResult CLDDPSolver::performForwardPass(CDDP &context) {
   return best_result;
 }
 
-ForwardPassResult CLDDPSolver::forwardPass(CDDP &context, double alpha_pr) {
+void CLDDPSolver::forwardPass(CDDP &context, double alpha_pr,
+                              ForwardPassResult &result,
+                              ForwardPassWorkspace &ws) {
   const CDDPOptions &options = context.getOptions();
 
-  ForwardPassResult result;
   result.success = false;
   result.cost = std::numeric_limits<double>::infinity();
   result.merit_function = std::numeric_limits<double>::infinity();
   result.alpha_pr = alpha_pr;
+  if (context.isCancellationRequested()) {
+    return;
+  }
 
   // Initialize trajectories
   result.state_trajectory = context.X_;
@@ -525,35 +637,34 @@ ForwardPassResult CLDDPSolver::forwardPass(CDDP &context, double alpha_pr) {
   result.state_trajectory[0] = context.getInitialState();
 
   double J_new = 0.0;
-  auto control_box_constraint =
-      context.getConstraint<ControlBoxConstraint>("ControlBoxConstraint");
 
   // Forward simulation
   for (int t = 0; t < context.getHorizon(); ++t) {
-    const Eigen::VectorXd &x = result.state_trajectory[t];
-    const Eigen::VectorXd &u = result.control_trajectory[t];
-    const Eigen::VectorXd delta_x = x - context.X_[t];
+    ws.x = result.state_trajectory[t];
+    ws.delta_x = ws.x - context.X_[t];
 
     // Apply control update
-    result.control_trajectory[t] = u + alpha_pr * k_u_[t] + K_u_[t] * delta_x;
+    Trajectory::ColumnView u_new = result.control_trajectory[t];
+    u_new += alpha_pr * k_u_[t];
+    u_new.noalias() += K_u_[t] * ws.delta_x;
 
     // Apply control constraints
-    if (control_box_constraint != nullptr) {
-      result.control_trajectory[t] =
-          control_box_constraint->clamp(result.control_trajectory[t]);
+    if (control_box_constraint_ != nullptr) {
+      u_new = control_box_constraint_->clamp(u_new);
     }
+    ws.u = u_new;
 
     // Compute running cost
-    J_new +=
-        context.getObjective().running_cost(x, result.control_trajectory[t], t);
+    J_new += context.getObjective().running_cost(ws.x, ws.u, t);
 
     // Propagate dynamics
-    result.state_trajectory[t + 1] = context.getSystem().getDiscreteDynamics(
-        x, result.control_trajectory[t], t * context.getTimestep());
+    context.getSystem().evalDiscreteDynamicsInto(
+        ws.x, ws.u, t * context.getTimestep(), result.state_trajectory[t + 1]);
   }
 
   // Add terminal cost
-  J_new += context.getObjective().terminal_cost(result.state_trajectory.back());
+  ws.x = result.state_trajectory.back();
+  J_new += context.getObjective().terminal_cost(ws.x);
 
   // Check improvement
   double dJ = context.cost_ - J_new;
@@ -565,8 +676,6 @@ ForwardPassResult CLDDPSolver::forwardPass(CDDP &context, double alpha_pr) {
   result.success = reduction_ratio > options.filter.armijo_constant;
   result.cost = J_new;
   result.merit_function = J_new; // For CLDDP, merit function equals cost
-
-  return result;
 }
 
 void CLDDPSolver::computeCost(CDDP &context) {
@@ -601,20 +710,17 @@ void CLDDPSolver::printIteration(int iter, double cost, double merit,
             << std::setprecision(4) << alpha << std::endl;
 }
 
-void CLDDPSolver::printSolutionSummary(const CDDPSolution &solution) const {
+void CLDDPSolver::printSolutionSummary(const SolveResult &result) const {
   std::cout << "\n========================================\n";
   std::cout << "           CLDDP Solution Summary\n";
   std::cout << "========================================\n";
 
-  auto iterations = std::any_cast<int>(solution.at("iterations_completed"));
-  auto solve_time = std::any_cast<double>(solution.at("solve_time_ms"));
-  auto final_cost = std::any_cast<double>(solution.at("final_objective"));
-  auto status = std::any_cast<std::string>(solution.at("status_message"));
-
-  std::cout << "Status: " << status << "\n";
-  std::cout << "Iterations: " << iterations << "\n";
-  std::cout << "Solve Time: " << std::setprecision(2) << solve_time << " ms\n";
-  std::cout << "Final Cost: " << std::setprecision(6) << final_cost << "\n";
+  std::cout << "Status: " << result.status_message << "\n";
+  std::cout << "Iterations: " << result.iterations_completed << "\n";
+  std::cout << "Solve Time: " << std::setprecision(2) << result.solve_time_ms
+            << " ms\n";
+  std::cout << "Final Cost: " << std::setprecision(6) << result.final_objective
+            << "\n";
   std::cout << "========================================\n\n";
 }
 
@@ -24,62 +24,15 @@
 using namespace cddp;
 using namespace autodiff; // Use autodiff namespace
 
-// Implement integration methods
-Eigen::VectorXd DynamicalSystem::euler_step(const Eigen::VectorXd &state,
-                                            const Eigen::VectorXd &control,
-                                            double dt, double time) const {
-  return state + dt * getContinuousDynamics(state, control, time);
-}
-
-Eigen::VectorXd DynamicalSystem::heun_step(const Eigen::VectorXd &state,
-                                           const Eigen::VectorXd &control,
-                                           double dt, double time) const {
-  Eigen::VectorXd k1 = getContinuousDynamics(state, control, time);
-  Eigen::VectorXd k2 =
-      getContinuousDynamics(state + dt * k1, control, time + dt);
-  return state + 0.5 * dt * (k1 + k2);
-}
-
-Eigen::VectorXd DynamicalSystem::rk3_step(const Eigen::VectorXd &state,
-                                          const Eigen::VectorXd &control,
-                                          double dt, double time) const {
-  Eigen::VectorXd k1 = getContinuousDynamics(state, control, time);
-  Eigen::VectorXd k2 =
-      getContinuousDynamics(state + 0.5 * dt * k1, control, time + 0.5 * dt);
-  Eigen::VectorXd k3 =
-      getContinuousDynamics(state - dt * k1 + 2 * dt * k2, control, time + dt);
-  return state + (dt / 6) * (k1 + 4 * k2 + k3);
-}
-
-Eigen::VectorXd DynamicalSystem::rk4_step(const Eigen::VectorXd &state,
-                                          const Eigen::VectorXd &control,
-                                          double dt, double time) const {
-  Eigen::VectorXd k1 = getContinuousDynamics(state, control, time);
-  Eigen::VectorXd k2 =
-      getContinuousDynamics(state + 0.5 * dt * k1, control, time + 0.5 * dt);
-  Eigen::VectorXd k3 =
-      getContinuousDynamics(state + 0.5 * dt * k2, control, time + 0.5 * dt);
-  Eigen::VectorXd k4 =
-      getContinuousDynamics(state + dt * k3, control, time + dt);
-  return state + (dt / 6) * (k1 + 2 * k2 + 2 * k3 + k4);
-}
-
 Eigen::VectorXd
 DynamicalSystem::getDiscreteDynamics(const Eigen::VectorXd &state,
                                      const Eigen::VectorXd &control,
                                      double time) const {
-  if (integration_type_ == "euler") {
-    return euler_step(state, control, timestep_, time);
-  } else if (integration_type_ == "heun") {
-    return heun_step(state, control, timestep_, time);
-  } else if (integration_type_ == "rk3") {
-    return rk3_step(state, control, timestep_, time);
-  } else if (integration_type_ == "rk4") {
-    return rk4_step(state, control, timestep_, time);
-  } else {
+  if (!integrator_) {
     std::cerr << "Integration type not supported!" << std::endl;
     return Eigen::VectorXd::Zero(state.size());
   }
+  return integrator_->step(*this, state, control, timestep_, time);
 }
 
 Eigen::VectorXd
@@ -132,86 +85,244 @@ DynamicalSystem::getControlJacobian(const Eigen::VectorXd &state,
   return Ju;
 }
 
+// --- Discrete-time Jacobians through the integrator ---
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+DynamicalSystem::getDiscreteJacobians(const Eigen::VectorXd &state,
+                                      const Eigen::VectorXd &control,
+                                      double time) const {
+  if (!integrator_) {
+    std::cerr << "Integration type not supported!" << std::endl;
+    return {Eigen::MatrixXd::Zero(state_dim_, state_dim_),
+            Eigen::MatrixXd::Zero(state_dim_, control_dim_)};
+  }
+  return integrator_->stepJacobians(*this, state, control, timestep_, time);
+}
+
+void DynamicalSystem::integrateInto(
+    const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time,
+    Eigen::Ref<Eigen::VectorXd> next_state) const {
+  if (!integrator_) {
+    std::cerr << "Integration type not supported!" << std::endl;
+    next_state.setZero();
+    return;
+  }
+  integrator_->stepInto(*this, state, control, timestep_, time, next_state);
+}
+
+void DynamicalSystem::integrateJacobiansInto(
+    const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time,
+    Eigen::Ref<Eigen::MatrixXd> A, Eigen::Ref<Eigen::MatrixXd> B) const {
+  if (!integrator_) {
+    std::cerr << "Integration type not supported!" << std::endl;
+    A.setZero();
+    B.setZero();
+    return;
+  }
+  integrator_->stepJacobiansInto(*this, state, control, timestep_, time, A, B);
+}
+
+// --- Batched evaluation, looping over the per-knot functions ---
+
+void DynamicalSystem::getContinuousDynamicsBatch(
+    const Eigen::Ref<const Eigen::MatrixXd> &states,
+    const Eigen::Ref<const Eigen::MatrixXd> &controls,
+    const Eigen::Ref<const Eigen::VectorXd> &times,
+    Eigen::Ref<Eigen::MatrixXd> state_dots) const {
+  for (Eigen::Index j = 0; j < states.cols(); ++j) {
+    state_dots.col(j) =
+        getContinuousDynamics(states.col(j), controls.col(j), times(j));
+  }
+}
+
+void DynamicalSystem::getDiscreteDynamicsBatch(
+    const Eigen::Ref<const Eigen::MatrixXd> &states,
+    const Eigen::Ref<const Eigen::MatrixXd> &controls,
+    const Eigen::Ref<const Eigen::VectorXd> &times,
+    Eigen::Ref<Eigen::MatrixXd> next_states) const {
+  for (Eigen::Index j = 0; j < states.cols(); ++j) {
+    next_states.col(j) =
+        getDiscreteDynamics(states.col(j), controls.col(j), times(j));
+  }
+}
+
+void DynamicalSystem::getJacobiansBatch(
+    const Eigen::Ref<const Eigen::MatrixXd> &states,
+    const Eigen::Ref<const Eigen::MatrixXd> &controls,
+    const Eigen::Ref<const Eigen::VectorXd> &times,
+    Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+    Eigen::Ref<Eigen::MatrixXd> control_jacobians) const {
+  for (Eigen::Index j = 0; j < states.cols(); ++j) {
+    const auto [A, B] = getJacobians(states.col(j), controls.col(j), times(j));
+    state_jacobians.middleCols(j * state_dim_, state_dim_) = A;
+    control_jacobians.middleCols(j * control_dim_, control_dim_) = B;
+  }
+}
+
+void DynamicalSystem::getDiscreteJacobiansBatch(
+    const Eigen::Ref<const Eigen::MatrixXd> &states,
+    const Eigen::Ref<const Eigen::MatrixXd> &controls,
+    const Eigen::Ref<const Eigen::VectorXd> &times,
+    Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+    Eigen::Ref<Eigen::MatrixXd> control_jacobians) const {
+  for (Eigen::Index j = 0; j < states.cols(); ++j) {
+    const auto [A, B] =
+        getDiscreteJacobians(states.col(j), controls.col(j), times(j));
+    state_jacobians.middleCols(j * state_dim_, state_dim_) = A;
+    control_jacobians.middleCols(j * control_dim_, control_dim_) = B;
+  }
+}
+
+void DynamicalSystem::integrateBatch(
+    const Eigen::Ref<const Eigen::MatrixXd> &states,
+    const Eigen::Ref<const Eigen::MatrixXd> &controls,
+    const Eigen::Ref<const Eigen::VectorXd> &times,
+    Eigen::Ref<Eigen::MatrixXd> next_states) const {
+  if (!integrator_) {
+    std::cerr << "Integration type not supported!" << std::endl;
+    next_states.setZero();
+    return;
+  }
+  integrator_->stepBatch(*this, states, controls, timestep_, times,
+                         next_states);
+}
+
 // --- Autodiff Default Implementations for Hessians ---
 
+namespace {
+// Full Hessian of every output f_i w.r.t. z = [x, u], one (n+m)x(n+m) matrix
+// per output; the block accessors below split out the part they need.
 std::vector<Eigen::MatrixXd>
-DynamicalSystem::getStateHessian(const Eigen::VectorXd &state,
-                                 const Eigen::VectorXd &control,
-                                 double time) const {
-  int n = state_dim_;
-  int m = control_dim_;
-  std::vector<Eigen::MatrixXd> state_hessian_tensor(state_dim_);
+fullHessians(const DynamicalSystem &system, const Eigen::VectorXd &state,
+             const Eigen::VectorXd &control, double time) {
+  const int n = system.getStateDim();
+  const int m = system.getControlDim();
+  std::vector<Eigen::MatrixXd> hessians(n);
 
   // Create the combined state-control vector using second-order duals
   VectorXdual2nd z(n + m);
   z.head(n) = state;
   z.tail(m) = control;
 
-  // Compute Hessian for each output dimension
-  for (int i = 0; i < state_dim_; ++i) {
+  for (int i = 0; i < n; ++i) {
     // Define a scalar function for the i-th output dimension
     auto f_i = [&](const VectorXdual2nd &z_ad) -> autodiff::dual2nd {
       VectorXdual2nd x_ad = z_ad.head(n);
       VectorXdual2nd u_ad = z_ad.tail(m);
-      // Return the i-th component of the dynamics vector
-      return this->getContinuousDynamicsAutodiff(x_ad, u_ad, time)(i);
+      return system.getContinuousDynamicsAutodiff(x_ad, u_ad, time)(i);
     };
+    hessians[i] = hessian(f_i, wrt(z), at(z));
+  }
+  return hessians;
+}
+} // namespace
 
-    // Compute the full Hessian matrix for the i-th output w.r.t z = [x, u]
-    Eigen::MatrixXd H_i = hessian(f_i, wrt(z), at(z));
-
-    // Extract the top-left (n x n) block (d^2 f_i / dx^2)
-    state_hessian_tensor[i] = H_i.topLeftCorner(n, n);
+std::vector<Eigen::MatrixXd>
+DynamicalSystem::getStateHessian(const Eigen::VectorXd &state,
+                                 const Eigen::VectorXd &control,
+                                 double time) const {
+  std::vector<Eigen::MatrixXd> hessians =
+      fullHessians(*this, state, control, time);
+  for (Eigen::MatrixXd &H_i : hessians) {
+    // Top-left (n x n) block: d^2 f_i / dx^2
+    H_i = H_i.topLeftCorner(state_dim_, state_dim_).eval();
   }
-  return state_hessian_tensor;
+  return hessians;
 }
 
 std::vector<Eigen::MatrixXd>
 DynamicalSystem::getControlHessian(const Eigen::VectorXd &state,
                                    const Eigen::VectorXd &control,
                                    double time) const {
-  int n = state_dim_;
-  int m = control_dim_;
-  std::vector<Eigen::MatrixXd> control_hessian_tensor(state_dim_);
-
-  VectorXdual2nd z(n + m);
-  z.head(n) = state;
-  z.tail(m) = control;
-
-  for (int i = 0; i < state_dim_; ++i) {
-    auto f_i = [&](const VectorXdual2nd &z_ad) -> autodiff::dual2nd {
-      VectorXdual2nd x_ad = z_ad.head(n);
-      VectorXdual2nd u_ad = z_ad.tail(m);
-      return this->getContinuousDynamicsAutodiff(x_ad, u_ad, time)(i);
-    };
-    Eigen::MatrixXd H_i = hessian(f_i, wrt(z), at(z));
-    // Extract the bottom-right (m x m) block (d^2 f_i / du^2)
-    control_hessian_tensor[i] = H_i.bottomRightCorner(m, m);
+  std::vector<Eigen::MatrixXd> hessians =
+      fullHessians(*this, state, control, time);
+  for (Eigen::MatrixXd &H_i : hessians) {
+    // Bottom-right (m x m) block: d^2 f_i / du^2
+    H_i = H_i.bottomRightCorner(control_dim_, control_dim_).eval();
   }
-  return control_hessian_tensor;
+  return hessians;
 }
 
 std::vector<Eigen::MatrixXd>
 DynamicalSystem::getCrossHessian(const Eigen::VectorXd &state,
                                  const Eigen::VectorXd &control,
                                  double time) const {
-  int n = state_dim_;
-  int m = control_dim_;
-  std::vector<Eigen::MatrixXd> cross_hessian_tensor(state_dim_);
+  std::vector<Eigen::MatrixXd> hessians =
+      fullHessians(*this, state, control, time);
+  for (Eigen::MatrixXd &H_i : hessians) {
+    // Bottom-left (m x n) block: d^2 f_i / dudx
+    H_i = H_i.bottomLeftCorner(control_dim_, state_dim_).eval();
+  }
+  return hessians;
+}
+
+std::tuple<std::vector<Eigen::MatrixXd>, std::vector<Eigen::MatrixXd>,
+           std::vector<Eigen::MatrixXd>>
+DynamicalSystem::getHessiansAutodiff(const Eigen::VectorXd &state,
+                                     const Eigen::VectorXd &control,
+                                     double time) const {
+  const int n = state_dim_;
+  const int m = control_dim_;
+  const std::vector<Eigen::MatrixXd> hessians =
+      fullHessians(*this, state, control, time);
+
+  std::vector<Eigen::MatrixXd> state_hessian_tensor(n);
+  std::vector<Eigen::MatrixXd> control_hessian_tensor(n);
+  std::vector<Eigen::MatrixXd> cross_hessian_tensor(n);
+  for (int i = 0; i < n; ++i) {
+    state_hessian_tensor[i] = hessians[i].topLeftCorner(n, n);
+    control_hessian_tensor[i] = hessians[i].bottomRightCorner(m, m);
+    cross_hessian_tensor[i] = hessians[i].bottomLeftCorner(m, n);
+  }
+  return {std::move(state_hessian_tensor), std::move(control_hessian_tensor),
+          std::move(cross_hessian_tensor)};
+}
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+DynamicalSystem::getHessianContraction(const Eigen::VectorXd &state,
+                                       const Eigen::VectorXd &control,
+                                       const Eigen::VectorXd &lambda,
+                                       double time) const {
+  const auto [Fxx, Fuu, Fux] = getHessians(state, control, time);
+
+  Eigen::MatrixXd lambda_Fxx = Eigen::MatrixXd::Zero(state_dim_, state_dim_);
+  Eigen::MatrixXd lambda_Fuu =
+      Eigen::MatrixXd::Zero(control_dim_, control_dim_);
+  Eigen::MatrixXd lambda_Fux = Eigen::MatrixXd::Zero(control_dim_, state_dim_);
+  for (int i = 0; i < state_dim_; ++i) {
+    lambda_Fxx += lambda(i) * Fxx[i];
+    lambda_Fuu += lambda(i) * Fuu[i];
+    lambda_Fux += lambda(i) * Fux[i];
+  }
+  return {std::move(lambda_Fxx), std::move(lambda_Fuu),
+          std::move(lambda_Fux)};
+}
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+DynamicalSystem::getHessianContractionAutodiff(const Eigen::VectorXd &state,
+                                               const Eigen::VectorXd &control,
+                                               const Eigen::VectorXd &lambda,
+                                               double time) const {
+  const int n = state_dim_;
+  const int m = control_dim_;
 
   VectorXdual2nd z(n + m);
   z.head(n) = state;
   z.tail(m) = control;
 
-  for (int i = 0; i < state_dim_; ++i) {
-    auto f_i = [&](const VectorXdual2nd &z_ad) -> autodiff::dual2nd {
-      VectorXdual2nd x_ad = z_ad.head(n);
-      VectorXdual2nd u_ad = z_ad.tail(m);
-      return this->getContinuousDynamicsAutodiff(x_ad, u_ad, time)(i);
-    };
-    Eigen::MatrixXd H_i = hessian(f_i, wrt(z), at(z));
-    // Extract the bottom-left (m x n) block (d^2 f_i / dudx)
-    cross_hessian_tensor[i] = H_i.bottomLeftCorner(m, n);
-  }
-  return cross_hessian_tensor;
+  // Scalar lambda^T f(x, u); its Hessian is the contracted tensor
+  auto lambda_f = [&](const VectorXdual2nd &z_ad) -> autodiff::dual2nd {
+    VectorXdual2nd x_ad = z_ad.head(n);
+    VectorXdual2nd u_ad = z_ad.tail(m);
+    VectorXdual2nd f = this->getContinuousDynamicsAutodiff(x_ad, u_ad, time);
+    autodiff::dual2nd value = 0.0;
+    for (int i = 0; i < n; ++i) {
+      value += lambda(i) * f(i);
+    }
+    return value;
+  };
+  const Eigen::MatrixXd H = hessian(lambda_f, wrt(z), at(z));
+
+  return {H.topLeftCorner(n, n), H.bottomRightCorner(m, m),
+          H.bottomLeftCorner(m, n)};
 }
@@ -0,0 +1,588 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "cddp_core/integrator.hpp"
+#include "cddp_core/dynamical_system.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace cddp {
+
+namespace {
+
+// Explicit Runge-Kutta scheme:
+//   k_i = f(x + h * sum_j a[i][j] k_j, u, t + c[i] h),
+//   x_next = x + h * sum_i b[i] k_i,
+// with optional embedded error weights e[i] = b[i] - b_hat[i].
+struct ButcherTableau {
+  std::vector<std::vector<double>> a;
+  std::vector<double> b;
+  std::vector<double> c;
+  std::vector<double> e;
+};
+
+const ButcherTableau &getButcherTableau(IntegrationType type) {
+  static const ButcherTableau euler{{{}}, {1.0}, {0.0}, {}};
+  static const ButcherTableau heun{{{}, {1.0}}, {0.5, 0.5}, {0.0, 1.0}, {}};
+  static const ButcherTableau rk3{{{}, {0.5}, {-1.0, 2.0}},
+                                  {1.0 / 6, 4.0 / 6, 1.0 / 6},
+                                  {0.0, 0.5, 1.0},
+                                  {}};
+  static const ButcherTableau rk4{{{}, {0.5}, {0.0, 0.5}, {0.0, 0.0, 1.0}},
+                                  {1.0 / 6, 2.0 / 6, 2.0 / 6, 1.0 / 6},
+                                  {0.0, 0.5, 0.5, 1.0},
+                                  {}};
+  // Dormand-Prince 5(4); the last stage is evaluated at x_next (FSAL)
+  static const ButcherTableau dopri5{
+      {{},
+       {1.0 / 5},
+       {3.0 / 40, 9.0 / 40},
+       {44.0 / 45, -56.0 / 15, 32.0 / 9},
+       {19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729},
+       {9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176,
+        -5103.0 / 18656},
+       {35.0 / 384, 0.0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784,
+        11.0 / 84}},
+      {35.0 / 384, 0.0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784, 11.0 / 84,
+       0.0},
+      {0.0, 1.0 / 5, 3.0 / 10, 4.0 / 5, 8.0 / 9, 1.0, 1.0},
+      {71.0 / 57600, 0.0, -71.0 / 16695, 71.0 / 1920, -17253.0 / 339200,
+       22.0 / 525, -1.0 / 40}};
+
+  switch (type) {
+  case IntegrationType::Euler:
+    return euler;
+  case IntegrationType::Heun:
+    return heun;
+  case IntegrationType::RK3:
+    return rk3;
+  case IntegrationType::RK4:
+    return rk4;
+  case IntegrationType::RK45:
+    return dopri5;
+  default:
+    throw std::invalid_argument("No Butcher tableau for this integrator");
+  }
+}
+
+// Per-thread stage storage. Buffers are handed out by nesting depth, so a
+// model whose derivatives integrate something themselves does not clobber
+// the stages of the step in progress.
+struct StageBuffers {
+  std::vector<Eigen::VectorXd> y;   // stage points
+  std::vector<Eigen::VectorXd> k;   // stage derivatives
+  std::vector<Eigen::MatrixXd> K_x; // dk_i/dx
+  std::vector<Eigen::MatrixXd> K_u; // dk_i/du
+  Eigen::MatrixXd Y_x;              // dy_i/dx
+  Eigen::MatrixXd Y_u;              // dy_i/du
+  Eigen::MatrixXd F_x;              // df/dx at the current stage point
+  Eigen::MatrixXd F_u;              // df/du at the current stage point
+
+  // RK45 substep state and sensitivities
+  Eigen::VectorXd x;
+  Eigen::VectorXd x_next;
+  Eigen::MatrixXd A_sub;
+  Eigen::MatrixXd B_sub;
+  Eigen::MatrixXd product;
+
+  void resize(int stages) {
+    if (static_cast<int>(k.size()) < stages) {
+      y.resize(stages);
+      k.resize(stages);
+      K_x.resize(stages);
+      K_u.resize(stages);
+    }
+  }
+};
+
+class ScopedStageBuffers {
+public:
+  explicit ScopedStageBuffers(int stages) {
+    if (static_cast<int>(pool().size()) <= depth()) {
+      pool().emplace_back(std::make_unique<StageBuffers>());
+    }
+    buffers_ = pool()[depth()].get();
+    ++depth();
+    buffers_->resize(stages);
+  }
+  ~ScopedStageBuffers() { --depth(); }
+  ScopedStageBuffers(const ScopedStageBuffers &) = delete;
+  ScopedStageBuffers &operator=(const ScopedStageBuffers &) = delete;
+
+  StageBuffers &operator*() const { return *buffers_; }
+  StageBuffers *operator->() const { return buffers_; }
+
+private:
+  static std::vector<std::unique_ptr<StageBuffers>> &pool() {
+    thread_local std::vector<std::unique_ptr<StageBuffers>> buffers;
+    return buffers;
+  }
+  static int &depth() {
+    thread_local int depth = 0;
+    return depth;
+  }
+
+  StageBuffers *buffers_;
+};
+
+// Evaluates stage points and derivatives [first, stages) into @p buffers.
+void evaluateStages(const DynamicalSystem &system,
+                    const ButcherTableau &tableau, const Eigen::VectorXd &x,
+                    const Eigen::VectorXd &u, double h, double t, int first,
+                    int stages, StageBuffers &buffers) {
+  for (int i = first; i < stages; ++i) {
+    Eigen::VectorXd &y = buffers.y[i];
+    y = x;
+    for (int j = 0; j < i; ++j) {
+      const double a_ij = tableau.a[i][j];
+      if (a_ij != 0.0) {
+        y.noalias() += (h * a_ij) * buffers.k[j];
+      }
+    }
+    buffers.k[i].resize(x.size());
+    system.evalContinuousDynamicsInto(y, u, t + tableau.c[i] * h,
+                                      buffers.k[i]);
+  }
+}
+
+// x + h * sum_i b_i k_i over the evaluated stages.
+void combineStages(const ButcherTableau &tableau, const Eigen::VectorXd &x,
+                   double h, const StageBuffers &buffers,
+                   Eigen::Ref<Eigen::VectorXd> x_next) {
+  x_next = x;
+  for (size_t i = 0; i < tableau.b.size(); ++i) {
+    if (tableau.b[i] != 0.0) {
+      x_next.noalias() += (h * tableau.b[i]) * buffers.k[i];
+    }
+  }
+}
+
+// Jacobians of one Runge-Kutta step, propagating the variational equations
+// through the stages. With @p stages_evaluated the stage points are taken
+// from @p buffers, otherwise they are evaluated here; the derivative of the
+// last weighted stage is never needed.
+void stageJacobians(const DynamicalSystem &system,
+                    const ButcherTableau &tableau, const Eigen::VectorXd &x,
+                    const Eigen::VectorXd &u, double h, double t,
+                    bool stages_evaluated, StageBuffers &buffers,
+                    Eigen::Ref<Eigen::MatrixXd> A,
+                    Eigen::Ref<Eigen::MatrixXd> B) {
+  const int n = static_cast<int>(x.size());
+  const int m = static_cast<int>(u.size());
+  int stages = static_cast<int>(tableau.b.size());
+  while (stages > 1 && tableau.b[stages - 1] == 0.0) {
+    --stages;
+  }
+
+  A.setIdentity();
+  B.setZero();
+  buffers.F_x.resize(n, n);
+  buffers.F_u.resize(n, m);
+  for (int i = 0; i < stages; ++i) {
+    buffers.Y_x.setIdentity(n, n);
+    buffers.Y_u.setZero(n, m);
+    for (int j = 0; j < i; ++j) {
+      const double a_ij = tableau.a[i][j];
+      if (a_ij != 0.0) {
+        buffers.Y_x.noalias() += (h * a_ij) * buffers.K_x[j];
+        buffers.Y_u.noalias() += (h * a_ij) * buffers.K_u[j];
+      }
+    }
+    if (!stages_evaluated) {
+      Eigen::VectorXd &y = buffers.y[i];
+      y = x;
+      for (int j = 0; j < i; ++j) {
+        const double a_ij = tableau.a[i][j];
+        if (a_ij != 0.0) {
+          y.noalias() += (h * a_ij) * buffers.k[j];
+        }
+      }
+    }
+
+    const double t_i = t + tableau.c[i] * h;
+    system.evalJacobiansInto(buffers.y[i], u, t_i, buffers.F_x, buffers.F_u);
+    buffers.K_x[i].noalias() = buffers.F_x * buffers.Y_x;
+    buffers.K_u[i] = buffers.F_u;
+    buffers.K_u[i].noalias() += buffers.F_x * buffers.Y_u;
+    if (!stages_evaluated && i + 1 < stages) {
+      buffers.k[i].resize(n);
+      system.evalContinuousDynamicsInto(buffers.y[i], u, t_i, buffers.k[i]);
+    }
+
+    A.noalias() += (h * tableau.b[i]) * buffers.K_x[i];
+    B.noalias() += (h * tableau.b[i]) * buffers.K_u[i];
+  }
+}
+
+} // namespace
+
+void Integrator::stepInto(const DynamicalSystem &system,
+                          const Eigen::VectorXd &state,
+                          const Eigen::VectorXd &control, double dt,
+                          double time,
+                          Eigen::Ref<Eigen::VectorXd> next_state) const {
+  next_state = step(system, state, control, dt, time);
+}
+
+void Integrator::stepJacobiansInto(const DynamicalSystem &system,
+                                   const Eigen::VectorXd &state,
+                                   const Eigen::VectorXd &control, double dt,
+                                   double time, Eigen::Ref<Eigen::MatrixXd> A,
+                                   Eigen::Ref<Eigen::MatrixXd> B) const {
+  const auto [A_step, B_step] = stepJacobians(system, state, control, dt, time);
+  A = A_step;
+  B = B_step;
+}
+
+void Integrator::stepBatch(const DynamicalSystem &system,
+                           const Eigen::Ref<const Eigen::MatrixXd> &states,
+                           const Eigen::Ref<const Eigen::MatrixXd> &controls,
+                           double dt,
+                           const Eigen::Ref<const Eigen::VectorXd> &times,
+                           Eigen::Ref<Eigen::MatrixXd> next_states) const {
+  for (Eigen::Index j = 0; j < states.cols(); ++j) {
+    next_states.col(j) =
+        step(system, states.col(j), controls.col(j), dt, times(j));
+  }
+}
+
+// ---------------------------------------------------------------------------
+// ExplicitRungeKuttaIntegrator
+// ---------------------------------------------------------------------------
+
+ExplicitRungeKuttaIntegrator::ExplicitRungeKuttaIntegrator(IntegrationType type)
+    : type_(type) {
+  if (type != IntegrationType::Euler && type != IntegrationType::Heun &&
+      type != IntegrationType::RK3 && type != IntegrationType::RK4) {
+    throw std::invalid_argument(
+        "ExplicitRungeKuttaIntegrator: not a fixed-step explicit scheme");
+  }
+}
+
+std::string ExplicitRungeKuttaIntegrator::getName() const {
+  switch (type_) {
+  case IntegrationType::Euler:
+    return "euler";
+  case IntegrationType::Heun:
+    return "heun";
+  case IntegrationType::RK3:
+    return "rk3";
+  default:
+    return "rk4";
+  }
+}
+
+Eigen::VectorXd ExplicitRungeKuttaIntegrator::step(
+    const DynamicalSystem &system, const Eigen::VectorXd &state,
+    const Eigen::VectorXd &control, double dt, double time) const {
+  Eigen::VectorXd next_state(state.size());
+  stepInto(system, state, control, dt, time, next_state);
+  return next_state;
+}
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+ExplicitRungeKuttaIntegrator::stepJacobians(const DynamicalSystem &system,
+                                            const Eigen::VectorXd &state,
+                                            const Eigen::VectorXd &control,
+                                            double dt, double time) const {
+  Eigen::MatrixXd A(state.size(), state.size());
+  Eigen::MatrixXd B(state.size(), control.size());
+  stepJacobiansInto(system, state, control, dt, time, A, B);
+  return {A, B};
+}
+
+void ExplicitRungeKuttaIntegrator::stepInto(
+    const DynamicalSystem &system, const Eigen::VectorXd &state,
+    const Eigen::VectorXd &control, double dt, double time,
+    Eigen::Ref<Eigen::VectorXd> next_state) const {
+  const ButcherTableau &tableau = getButcherTableau(type_);
+  const int stages = static_cast<int>(tableau.b.size());
+  ScopedStageBuffers buffers(stages);
+  evaluateStages(system, tableau, state, control, dt, time, 0, stages,
+                 *buffers);
+  combineStages(tableau, state, dt, *buffers, next_state);
+}
+
+void ExplicitRungeKuttaIntegrator::stepJacobiansInto(
+    const DynamicalSystem &system, const Eigen::VectorXd &state,
+    const Eigen::VectorXd &control, double dt, double time,
+    Eigen::Ref<Eigen::MatrixXd> A, Eigen::Ref<Eigen::MatrixXd> B) const {
+  const ButcherTableau &tableau = getButcherTableau(type_);
+  ScopedStageBuffers buffers(static_cast<int>(tableau.b.size()));
+  stageJacobians(system, tableau, state, control, dt, time, false, *buffers,
+                 A, B);
+}
+
+void ExplicitRungeKuttaIntegrator::stepBatch(
+    const DynamicalSystem &system,
+    const Eigen::Ref<const Eigen::MatrixXd> &states,
+    const Eigen::Ref<const Eigen::MatrixXd> &controls, double dt,
+    const Eigen::Ref<const Eigen::VectorXd> &times,
+    Eigen::Ref<Eigen::MatrixXd> next_states) const {
+  const ButcherTableau &tableau = getButcherTableau(type_);
+  const int stages = static_cast<int>(tableau.b.size());
+
+  // Each stage is one (state_dim x N) matrix, so every stage of every knot
+  // comes from a single getContinuousDynamicsBatch call.
+  std::vector<Eigen::MatrixXd> k(stages);
+  Eigen::MatrixXd y;
+  Eigen::VectorXd t_i;
+  for (int i = 0; i < stages; ++i) {
+    y = states;
+    for (int j = 0; j < i; ++j) {
+      const double a_ij = tableau.a[i][j];
+      if (a_ij != 0.0) {
+        y.noalias() += (dt * a_ij) * k[j];
+      }
+    }
+    t_i = times.array() + tableau.c[i] * dt;
+    k[i].resize(states.rows(), states.cols());
+    system.getContinuousDynamicsBatch(y, controls, t_i, k[i]);
+  }
+
+  next_states = states;
+  for (int i = 0; i < stages; ++i) {
+    if (tableau.b[i] != 0.0) {
+      next_states.noalias() += (dt * tableau.b[i]) * k[i];
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// RK45Integrator
+// ---------------------------------------------------------------------------
+
+RK45Integrator::RK45Integrator(double abs_tolerance, double rel_tolerance,
+                               int max_substeps)
+    : abs_tolerance_(abs_tolerance), rel_tolerance_(rel_tolerance),
+      max_substeps_(max_substeps) {}
+
+Eigen::VectorXd RK45Integrator::step(const DynamicalSystem &system,
+                                     const Eigen::VectorXd &state,
+                                     const Eigen::VectorXd &control, double dt,
+                                     double time) const {
+  Eigen::VectorXd next_state(state.size());
+  stepInto(system, state, control, dt, time, next_state);
+  return next_state;
+}
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+RK45Integrator::stepJacobians(const DynamicalSystem &system,
+                              const Eigen::VectorXd &state,
+                              const Eigen::VectorXd &control, double dt,
+                              double time) const {
+  Eigen::MatrixXd A(state.size(), state.size());
+  Eigen::MatrixXd B(state.size(), control.size());
+  stepJacobiansInto(system, state, control, dt, time, A, B);
+  return {A, B};
+}
+
+void RK45Integrator::stepInto(const DynamicalSystem &system,
+                              const Eigen::VectorXd &state,
+                              const Eigen::VectorXd &control, double dt,
+                              double time,
+                              Eigen::Ref<Eigen::VectorXd> next_state) const {
+  integrate(system, state, control, dt, time, &next_state, nullptr, nullptr);
+}
+
+void RK45Integrator::stepJacobiansInto(const DynamicalSystem &system,
+                                       const Eigen::VectorXd &state,
+                                       const Eigen::VectorXd &control,
+                                       double dt, double time,
+                                       Eigen::Ref<Eigen::MatrixXd> A,
+                                       Eigen::Ref<Eigen::MatrixXd> B) const {
+  integrate(system, state, control, dt, time, nullptr, &A, &B);
+}
+
+void RK45Integrator::integrate(const DynamicalSystem &system,
+                               const Eigen::VectorXd &state,
+                               const Eigen::VectorXd &control, double dt,
+                               double time,
+                               Eigen::Ref<Eigen::VectorXd> *next_state,
+                               Eigen::Ref<Eigen::MatrixXd> *A,
+                               Eigen::Ref<Eigen::MatrixXd> *B) const {
+  const ButcherTableau &tableau = getButcherTableau(IntegrationType::RK45);
+  const int stages = static_cast<int>(tableau.b.size());
+  const bool with_jacobians = A != nullptr && B != nullptr;
+  ScopedStageBuffers buffers(stages);
+
+  const int n = static_cast<int>(state.size());
+  const int m = static_cast<int>(control.size());
+  Eigen::VectorXd &x = buffers->x;
+  Eigen::VectorXd &x_next = buffers->x_next;
+  x = state;
+  x_next.resize(n);
+  if (with_jacobians) {
+    A->setIdentity();
+    B->setZero();
+    buffers->A_sub.resize(n, n);
+    buffers->B_sub.resize(n, m);
+  }
+
+  const double t_end = time + dt;
+  double t = time;
+  double h = dt; // try the whole interval first
+  // The first stage does not depend on h; after an accepted substep it is
+  // the last stage of that substep (first same as last)
+  evaluateStages(system, tableau, x, control, h, t, 0, 1, *buffers);
+  for (int substep = 0; t_end - t > 1e-12 * std::abs(dt); ++substep) {
+    // Past the substep limit the rest of the interval is one last substep
+    const bool limit_reached = substep >= max_substeps_;
+    h = limit_reached ? t_end - t : std::min(h, t_end - t);
+    evaluateStages(system, tableau, x, control, h, t, 1, stages, *buffers);
+    combineStages(tableau, x, h, *buffers, x_next);
+
+    // Scaled max-norm of the embedded error estimate
+    double error = 0.0;
+    for (int i = 0; i < x.size(); ++i) {
+      double e_i = 0.0;
+      for (int s = 0; s < stages; ++s) {
+        e_i += tableau.e[s] * buffers->k[s](i);
+      }
+      const double scale =
+          abs_tolerance_ +
+          rel_tolerance_ * std::max(std::abs(x(i)), std::abs(x_next(i)));
+      error = std::max(error, std::abs(h * e_i) / scale);
+    }
+
+    if (error <= 1.0 || limit_reached) {
+      if (error > 1.0) {
+        substep_limit_count_.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (with_jacobians) {
+        stageJacobians(system, tableau, x, control, h, t, true, *buffers,
+                       buffers->A_sub, buffers->B_sub);
+        buffers->product.noalias() = buffers->A_sub * (*B);
+        *B = buffers->product + buffers->B_sub;
+        buffers->product.noalias() = buffers->A_sub * (*A);
+        *A = buffers->product;
+      }
+      t += h;
+      x.swap(x_next);
+      buffers->y[0].swap(buffers->y[stages - 1]);
+      buffers->k[0].swap(buffers->k[stages - 1]);
+    }
+
+    const double factor = error > 0.0 ? 0.9 * std::pow(error, -0.2) : 5.0;
+    h *= std::clamp(factor, 0.2, 5.0);
+  }
+  if (next_state != nullptr) {
+    *next_state = x;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// ImplicitMidpointIntegrator
+// ---------------------------------------------------------------------------
+
+ImplicitMidpointIntegrator::ImplicitMidpointIntegrator(double tolerance,
+                                                       int max_iterations)
+    : tolerance_(tolerance), max_iterations_(max_iterations) {}
+
+Eigen::VectorXd ImplicitMidpointIntegrator::solveStage(
+    const DynamicalSystem &system, const Eigen::VectorXd &state,
+    const Eigen::VectorXd &control, double dt, double time) const {
+  const int n = static_cast<int>(state.size());
+  const double t_mid = time + 0.5 * dt;
+
+  // Explicit midpoint guess, then Newton on r(k) = k - f(x + dt/2 k)
+  Eigen::VectorXd k = system.getContinuousDynamics(state, control, time);
+  Eigen::VectorXd y(n);
+  Eigen::VectorXd residual(n);
+  Eigen::MatrixXd jacobian(n, n);
+  for (int iter = 0; iter < max_iterations_; ++iter) {
+    y = state;
+    y.noalias() += (0.5 * dt) * k;
+    residual = k - system.getContinuousDynamics(y, control, t_mid);
+    if (residual.lpNorm<Eigen::Infinity>() <=
+        tolerance_ * (1.0 + k.lpNorm<Eigen::Infinity>())) {
+      return k;
+    }
+    jacobian.setIdentity();
+    jacobian.noalias() -= (0.5 * dt) * system.getStateJacobian(y, control, t_mid);
+    k.noalias() -= jacobian.partialPivLu().solve(residual);
+  }
+  newton_failure_count_.fetch_add(1, std::memory_order_relaxed);
+  return k;
+}
+
+Eigen::VectorXd ImplicitMidpointIntegrator::step(
+    const DynamicalSystem &system, const Eigen::VectorXd &state,
+    const Eigen::VectorXd &control, double dt, double time) const {
+  Eigen::VectorXd next_state = state;
+  next_state.noalias() += dt * solveStage(system, state, control, dt, time);
+  return next_state;
+}
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+ImplicitMidpointIntegrator::stepJacobians(const DynamicalSystem &system,
+                                          const Eigen::VectorXd &state,
+                                          const Eigen::VectorXd &control,
+                                          double dt, double time) const {
+  const int n = static_cast<int>(state.size());
+  const Eigen::VectorXd k = solveStage(system, state, control, dt, time);
+  Eigen::VectorXd y = state;
+  y.noalias() += (0.5 * dt) * k;
+
+  // Implicit function theorem on k = f(x + dt/2 k, u):
+  //   (I - dt/2 Fx) dk/dx = Fx,  (I - dt/2 Fx) dk/du = Fu
+  const auto [Fx, Fu] = system.getJacobians(y, control, time + 0.5 * dt);
+  Eigen::MatrixXd M = Eigen::MatrixXd::Identity(n, n);
+  M.noalias() -= (0.5 * dt) * Fx;
+  const Eigen::PartialPivLU<Eigen::MatrixXd> lu(M);
+
+  Eigen::MatrixXd A = dt * lu.solve(Fx);
+  A.diagonal().array() += 1.0;
+  Eigen::MatrixXd B = dt * lu.solve(Fu);
+  return {A, B};
+}
+
+// ---------------------------------------------------------------------------
+// Factories
+// ---------------------------------------------------------------------------
+
+std::shared_ptr<const Integrator> makeIntegrator(IntegrationType type) {
+  switch (type) {
+  case IntegrationType::RK45:
+    return std::make_shared<RK45Integrator>();
+  case IntegrationType::ImplicitMidpoint:
+    return std::make_shared<ImplicitMidpointIntegrator>();
+  default:
+    return std::make_shared<ExplicitRungeKuttaIntegrator>(type);
+  }
+}
+
+std::shared_ptr<const Integrator> makeIntegrator(const std::string &name) {
+  if (name == "euler") {
+    return makeIntegrator(IntegrationType::Euler);
+  } else if (name == "heun") {
+    return makeIntegrator(IntegrationType::Heun);
+  } else if (name == "rk3") {
+    return makeIntegrator(IntegrationType::RK3);
+  } else if (name == "rk4") {
+    return makeIntegrator(IntegrationType::RK4);
+  } else if (name == "rk45") {
+    return makeIntegrator(IntegrationType::RK45);
+  } else if (name == "implicit_midpoint") {
+    return makeIntegrator(IntegrationType::ImplicitMidpoint);
+  }
+  return nullptr;
+}
+
+} // namespace cddp
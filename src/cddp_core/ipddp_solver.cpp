@@ -23,6 +23,7 @@
 #include <iomanip>
 #include <iostream>
 #include <thread>
+#include <utility>
 
 namespace cddp
 {
@@ -31,6 +32,7 @@ namespace cddp
 
   void IPDDPSolver::initialize(CDDP &context)
   {
+    derivatives_valid_ = false;
     const CDDPOptions &options = context.getOptions();
     const auto &constraint_set = context.getConstraintSet();
 
@@ -38,11 +40,11 @@ namespace cddp
     int control_dim = context.getControlDim();
     int state_dim = context.getStateDim();
 
-    // Initialize workspace if not already done
-    if (!workspace_.initialized) {
+    // Initialize workspace if not already done, or if the horizon changed
+    // since the last solve
+    if (!workspace_.initialized ||
+        workspace_.Q_xx_matrices.size() != static_cast<size_t>(horizon)) {
       // Allocate backward pass workspace
-      workspace_.A_matrices.resize(horizon);
-      workspace_.B_matrices.resize(horizon);
       workspace_.Q_xx_matrices.resize(horizon);
       workspace_.Q_ux_matrices.resize(horizon);
       workspace_.Q_uu_matrices.resize(horizon);
@@ -57,8 +59,6 @@ namespace cddp
       workspace_.delta_x_vectors.resize(horizon + 1);
       
       for (int t = 0; t < horizon; ++t) {
-        workspace_.A_matrices[t] = Eigen::MatrixXd::Zero(state_dim, state_dim);
-        workspace_.B_matrices[t] = Eigen::MatrixXd::Zero(state_dim, control_dim);
         workspace_.Q_xx_matrices[t] = Eigen::MatrixXd::Zero(state_dim, state_dim);
         workspace_.Q_ux_matrices[t] = Eigen::MatrixXd::Zero(control_dim, state_dim);
         workspace_.Q_uu_matrices[t] = Eigen::MatrixXd::Zero(control_dim, control_dim);
@@ -70,21 +70,25 @@ namespace cddp
         workspace_.delta_x_vectors[t] = Eigen::VectorXd::Zero(state_dim);
       }
       
-      // Allocate constraint workspace if needed
-      if (!constraint_set.empty()) {
-        int total_dual_dim = getTotalDualDim(context);
-        workspace_.y_combined = Eigen::VectorXd::Zero(total_dual_dim);
-        workspace_.s_combined = Eigen::VectorXd::Zero(total_dual_dim);
-        workspace_.g_combined = Eigen::VectorXd::Zero(total_dual_dim);
-        workspace_.Q_yu_combined = Eigen::MatrixXd::Zero(total_dual_dim, control_dim);
-        workspace_.Q_yx_combined = Eigen::MatrixXd::Zero(total_dual_dim, state_dim);
-        workspace_.YSinv = Eigen::MatrixXd::Zero(total_dual_dim, total_dual_dim);
+      workspace_.initialized = true;
+    }
+
+    // Constraint workspace follows the stacked dual dimension, which can
+    // change between solves
+    if (!constraint_set.empty()) {
+      const int total_dual_dim = context.getPathDualDim();
+      if (workspace_.YSinv.rows() != total_dual_dim) {
+        workspace_.YSinv = Eigen::VectorXd::Zero(total_dual_dim);
+      }
+      if (workspace_.bigRHS.rows() != control_dim ||
+          workspace_.bigRHS.cols() != 1 + state_dim) {
         workspace_.bigRHS = Eigen::MatrixXd::Zero(control_dim, 1 + state_dim);
       }
-      
-      workspace_.initialized = true;
     }
 
+    // Cached factorizations belong to the previous solve
+    std::fill(workspace_.ldlt_valid.begin(), workspace_.ldlt_valid.end(), false);
+
     // Validate reference state consistency
     if ((context.getReferenceState() - context.getObjective().getReferenceState()).norm() > 1e-6)
     {
@@ -191,8 +195,8 @@ namespace cddp
     if (!trajectory_provided)
     {
       // Create interpolated initial trajectory
-      context.X_.resize(horizon + 1);
-      context.U_.resize(horizon);
+      context.X_.resize(state_dim, horizon + 1);
+      context.U_.resize(control_dim, horizon);
 
       for (int t = 0; t <= horizon; ++t)
       {
@@ -240,18 +244,129 @@ namespace cddp
 
   std::string IPDDPSolver::getSolverName() const { return "IPDDP"; }
 
-  int IPDDPSolver::getTotalDualDim(const CDDP &context) const
+  void IPDDPSolver::shift(CDDP &context, int steps)
   {
-    int total_dual_dim = 0;
-    const auto &constraint_set = context.getConstraintSet();
-    for (const auto &constraint_pair : constraint_set)
+    cddp::shiftTrajectory(k_u_, steps);
+    cddp::shiftTrajectory(K_u_, steps);
+    for (auto *storage : {&G_, &Y_, &S_, &k_y_, &k_s_})
+    {
+      cddp::shiftTrajectory(*storage, steps);
+    }
+    for (auto *storage : {&K_y_, &K_s_})
+    {
+      cddp::shiftTrajectory(*storage, steps);
+    }
+    std::fill(workspace_.ldlt_valid.begin(), workspace_.ldlt_valid.end(), false);
+    derivatives_valid_ = false;
+  }
+
+  void IPDDPSolver::prepare(CDDP &context)
+  {
+    // Derivatives and the backward pass only depend on the nominal
+    // trajectory, so all of it runs ahead of the measurement
+    prepared_ = false;
+    while (!prepared_)
+    {
+      prepared_ = backwardPass(context);
+      if (!prepared_)
+      {
+        if (context.isCancellationRequested())
+          break;
+        context.increaseRegularization();
+        if (context.isRegularizationLimitReached())
+        {
+          if (context.getOptions().verbose)
+          {
+            std::cerr << "IPDDP: Regularization limit reached" << std::endl;
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  void IPDDPSolver::feedback(CDDP &context, SolveResult &result)
+  {
+    result.beginSolve(getSolverName(), false);
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Largest step that keeps slacks and duals inside the fraction-to-boundary
+    // limits. The filter is bypassed: its entries belong to the nominal
+    // trajectory, which started from a different initial state.
+    bool success = false;
+    if (prepared_)
+    {
+      for (double alpha_pr : context.alphas_)
+      {
+        forwardPass(context, alpha_pr, trial_result_, forward_workspace_, false);
+        // NaN passes the fraction-to-boundary tests, so a diverged rollout
+        // is caught here
+        if (trial_result_.success && std::isfinite(trial_result_.cost) &&
+            trial_result_.state_trajectory.matrix().allFinite() &&
+            trial_result_.control_trajectory.matrix().allFinite())
+        {
+          success = true;
+          break;
+        }
+      }
+    }
+
+    if (success)
+    {
+      context.X_.swap(trial_result_.state_trajectory);
+      context.U_.swap(trial_result_.control_trajectory);
+      derivatives_valid_ = false;
+      if (trial_result_.dual_trajectory)
+        Y_.swap(*trial_result_.dual_trajectory);
+      if (trial_result_.slack_trajectory)
+        S_.swap(*trial_result_.slack_trajectory);
+      if (trial_result_.constraint_eval_trajectory)
+        G_.swap(*trial_result_.constraint_eval_trajectory);
+
+      context.cost_ = trial_result_.cost;
+      context.merit_function_ = trial_result_.merit_function;
+      context.alpha_pr_ = trial_result_.alpha_pr;
+      context.decreaseRegularization();
+
+      // Restart the filter (and infeasibility metrics) from the new iterate
+      resetFilter(context);
+      updateBarrierParameters(context, true);
+      context.notifyIteration(1);
+    }
+    else
     {
-      total_dual_dim += constraint_pair.second->getDualDim();
+      // Keep the nominal trajectory as the linearization point for the
+      // next iteration
+      context.increaseRegularization();
     }
-    return total_dual_dim;
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start_time);
+
+    if (success)
+      result.status_message = "RealTimeIterationCompleted";
+    else if (!prepared_)
+      result.status_message = "RegularizationLimitReached_NotConverged";
+    else
+      result.status_message = "ForwardPassFailed_NotConverged";
+    result.iterations_completed = 1;
+    result.solve_time_ms = duration.count() / 1000.0;
+    result.final_objective = context.cost_;
+    result.final_step_length = context.alpha_pr_;
+
+    result.setTimePoints(context.getHorizon(), context.getTimestep());
+    result.state_trajectory = context.X_;
+    result.control_trajectory = context.U_;
+    result.setFeedbackGains(K_u_);
+
+    result.final_regularization = context.regularization_;
+    result.final_barrier_parameter_mu = mu_;
+    result.final_primal_infeasibility = context.inf_pr_;
+    result.final_dual_infeasibility = context.inf_du_;
+    result.final_complementary_infeasibility = context.inf_comp_;
   }
 
-  CDDPSolution IPDDPSolver::solve(CDDP &context)
+  void IPDDPSolver::solve(CDDP &context, SolveResult &result)
   {
     const CDDPOptions &options = context.getOptions();
 
@@ -265,45 +380,22 @@ namespace cddp
       context.printOptions(options);
     }
 
-    // Prepare solution map
-    CDDPSolution solution;
-    solution["solver_name"] = getSolverName();
-    solution["status_message"] = std::string("Running");
-    solution["iterations_completed"] = 0;
-    solution["solve_time_ms"] = 0.0;
-
-    // Initialize history vectors only if requested
-    std::vector<double> history_objective;
-    std::vector<double> history_merit_function;
-    std::vector<double> history_step_length_primal;
-    std::vector<double> history_step_length_dual;
-    std::vector<double> history_dual_infeasibility;
-    std::vector<double> history_primal_infeasibility;
-    std::vector<double> history_complementary_infeasibility;
-    std::vector<double> history_barrier_mu;
-
-    if (options.return_iteration_info)
-    {
-      const size_t expected_size =
-          static_cast<size_t>(options.max_iterations + 1);
-      history_objective.reserve(expected_size);
-      history_merit_function.reserve(expected_size);
-      history_step_length_primal.reserve(expected_size);
-      history_step_length_dual.reserve(expected_size);
-      history_dual_infeasibility.reserve(expected_size);
-      history_primal_infeasibility.reserve(expected_size);
-      history_complementary_infeasibility.reserve(expected_size);
-      history_barrier_mu.reserve(expected_size);
+    // History is recorded only if requested
+    result.beginSolve(getSolverName(), options.return_iteration_info,
+                      static_cast<size_t>(options.max_iterations + 1));
+    SolveHistory *history = result.history ? &*result.history : nullptr;
 
+    if (history)
+    {
       // Initial iteration values
-      history_objective.push_back(context.cost_);
-      history_merit_function.push_back(context.merit_function_);
-      history_step_length_primal.push_back(1.0); // Initial step length
-      history_step_length_dual.push_back(1.0);   // Initial dual step length
-      history_dual_infeasibility.push_back(context.inf_du_);
-      history_primal_infeasibility.push_back(context.inf_pr_);
-      history_complementary_infeasibility.push_back(context.inf_comp_);
-      history_barrier_mu.push_back(mu_);
+      history->objective.push_back(context.cost_);
+      history->merit_function.push_back(context.merit_function_);
+      history->step_length_primal.push_back(1.0); // Initial step length
+      history->step_length_dual.push_back(1.0);   // Initial dual step length
+      history->dual_infeasibility.push_back(context.inf_du_);
+      history->primal_infeasibility.push_back(context.inf_pr_);
+      history->complementary_infeasibility.push_back(context.inf_comp_);
+      history->barrier_mu.push_back(mu_);
     }
 
     if (options.verbose)
@@ -341,6 +433,12 @@ namespace cddp
         }
       }
 
+      if (context.isCancellationRequested())
+      {
+        termination_reason = "Cancelled";
+        break;
+      }
+
       // Backward pass with regularization
       bool backward_pass_success = false;
       while (!backward_pass_success)
@@ -348,6 +446,11 @@ namespace cddp
         backward_pass_success = backwardPass(context);
         if (!backward_pass_success)
         {
+          if (context.isCancellationRequested())
+          {
+            termination_reason = "Cancelled";
+            break;
+          }
           context.increaseRegularization();
           if (context.isRegularizationLimitReached())
           {
@@ -364,7 +467,7 @@ namespace cddp
         break;
 
       // Forward pass
-      ForwardPassResult best_result = performForwardPass(context);
+      ForwardPassResult &best_result = performForwardPass(context);
 
       // Update trajectories if forward pass succeeded
       if (best_result.success)
@@ -377,14 +480,15 @@ namespace cddp
         }
 
         // Update trajectories and variables
-        context.X_ = best_result.state_trajectory;
-        context.U_ = best_result.control_trajectory;
+        context.X_.swap(best_result.state_trajectory);
+        context.U_.swap(best_result.control_trajectory);
+        derivatives_valid_ = false;
         if (best_result.dual_trajectory)
-          Y_ = *best_result.dual_trajectory;
+          Y_.swap(*best_result.dual_trajectory);
         if (best_result.slack_trajectory)
-          S_ = *best_result.slack_trajectory;
+          S_.swap(*best_result.slack_trajectory);
         if (best_result.constraint_eval_trajectory)
-          G_ = *best_result.constraint_eval_trajectory;
+          G_.swap(*best_result.constraint_eval_trajectory);
 
         // Update costs and step lengths
         dJ = context.cost_ - best_result.cost;
@@ -392,16 +496,21 @@ namespace cddp
         context.merit_function_ = best_result.merit_function;
         context.alpha_pr_ = best_result.alpha_pr;
 
-        updateIterationHistory(options, context, history_objective, history_merit_function,
-                               history_step_length_primal, history_step_length_dual,
-                               history_dual_infeasibility, history_primal_infeasibility,
-                               history_complementary_infeasibility, history_barrier_mu,
-                               best_result.alpha_du);
+        if (history)
+        {
+          updateIterationHistory(context, *history, best_result.alpha_du);
+        }
+        context.notifyIteration(iter);
 
         context.decreaseRegularization();
       }
       else
       {
+        if (context.isCancellationRequested())
+        {
+          termination_reason = "Cancelled";
+          break;
+        }
         context.increaseRegularization();
         if (context.isRegularizationLimitReached())
         {
@@ -439,53 +548,31 @@ namespace cddp
         end_time - start_time);
 
     // Populate final solution
-    solution["status_message"] = termination_reason;
-    solution["iterations_completed"] = iter;
-    solution["solve_time_ms"] = static_cast<double>(duration.count());
-    solution["final_objective"] = context.cost_;
-    solution["final_step_length"] = context.alpha_pr_;
+    result.status_message = termination_reason;
+    result.iterations_completed = iter;
+    result.solve_time_ms = static_cast<double>(duration.count());
+    result.final_objective = context.cost_;
+    result.final_step_length = context.alpha_pr_;
 
     // Add trajectories
-    std::vector<double> time_points;
-    time_points.reserve(static_cast<size_t>(context.getHorizon() + 1));
-    for (int t = 0; t <= context.getHorizon(); ++t)
-    {
-      time_points.push_back(t * context.getTimestep());
-    }
-    solution["time_points"] = time_points;
-    solution["state_trajectory"] = context.X_;
-    solution["control_trajectory"] = context.U_;
-
-    // Add iteration history if requested
-    if (options.return_iteration_info)
-    {
-      solution["history_objective"] = history_objective;
-      solution["history_merit_function"] = history_merit_function;
-      solution["history_step_length_primal"] = history_step_length_primal;
-      solution["history_step_length_dual"] = history_step_length_dual;
-      solution["history_dual_infeasibility"] = history_dual_infeasibility;
-      solution["history_primal_infeasibility"] = history_primal_infeasibility;
-      solution["history_complementary_infeasibility"] = history_complementary_infeasibility;
-      solution["history_barrier_mu"] = history_barrier_mu;
-    }
+    result.setTimePoints(context.getHorizon(), context.getTimestep());
+    result.state_trajectory = context.X_;
+    result.control_trajectory = context.U_;
 
     // Add control gains
-    solution["control_feedback_gains_K"] = K_u_;
+    result.setFeedbackGains(K_u_);
 
     // Final metrics
-    solution["final_regularization"] = context.regularization_;
-    solution["final_barrier_parameter_mu"] = mu_;
-    solution["final_primal_infeasibility"] = context.inf_pr_;
-    solution["final_dual_infeasibility"] = context.inf_du_;
-    solution["final_complementary_infeasibility"] = context.inf_comp_;
+    result.final_regularization = context.regularization_;
+    result.final_barrier_parameter_mu = mu_;
+    result.final_primal_infeasibility = context.inf_pr_;
+    result.final_dual_infeasibility = context.inf_du_;
+    result.final_complementary_infeasibility = context.inf_comp_;
 
     if (options.verbose)
     {
-      printSolutionSummary(solution);
+      printSolutionSummary(result);
     }
-
-
-    return solution;
   }
 
   void IPDDPSolver::evaluateTrajectory(CDDP &context)
@@ -496,6 +583,7 @@ namespace cddp
 
     // Set initial state
     context.X_[0] = context.getInitialState();
+    G_.resize(horizon);
 
     // Rollout dynamics and calculate cost
     for (int t = 0; t < horizon; ++t)
@@ -506,19 +594,12 @@ namespace cddp
       // Compute stage cost
       cost += context.getObjective().running_cost(x, u, t);
 
-      // For each constraint, evaluate and store the constraint value
-      const auto &constraint_set = context.getConstraintSet();
-      for (const auto &constraint_pair : constraint_set)
-      {
-        const std::string &constraint_name = constraint_pair.first;
-        Eigen::VectorXd g_val = constraint_pair.second->evaluate(x, u) -
-                                constraint_pair.second->getUpperBound();
-        G_[constraint_name][t] = g_val;
-      }
+      // Evaluate and store the stacked constraint values
+      context.evaluatePathConstraints(x, u, G_[t]);
 
       // Compute next state using dynamics
-      context.X_[t + 1] = context.getSystem().getDiscreteDynamics(
-          x, u, t * context.getTimestep());
+      context.getSystem().evalDiscreteDynamicsInto(
+          x, u, t * context.getTimestep(), context.X_[t + 1]);
     }
 
     // Add terminal cost
@@ -537,12 +618,7 @@ namespace cddp
     // We just need to evaluate the cost and constraints
 
     // Initialize constraint storage first
-    const auto &constraint_set = context.getConstraintSet();
-    for (const auto &constraint_pair : constraint_set)
-    {
-      const std::string &constraint_name = constraint_pair.first;
-      G_[constraint_name].resize(horizon);
-    }
+    G_.resize(horizon);
 
     // Rollout dynamics and calculate cost
     for (int t = 0; t < horizon; ++t)
@@ -553,14 +629,8 @@ namespace cddp
       // Compute stage cost
       cost += context.getObjective().running_cost(x, u, t);
 
-      // For each constraint, evaluate and store the constraint value
-      for (const auto &constraint_pair : constraint_set)
-      {
-        const std::string &constraint_name = constraint_pair.first;
-        Eigen::VectorXd g_val = constraint_pair.second->evaluate(x, u) -
-                                constraint_pair.second->getUpperBound();
-        G_[constraint_name][t] = g_val;
-      }
+      // Evaluate and store the stacked constraint values
+      context.evaluatePathConstraints(x, u, G_[t]);
     }
 
     // Add terminal cost
@@ -574,133 +644,98 @@ namespace cddp
   {
     const CDDPOptions &options = context.getOptions();
     const int horizon = context.getHorizon();
-    const auto &constraint_set = context.getConstraintSet();
+    const int state_dim = context.getStateDim();
+    const int total_dual_dim = context.getPathDualDim();
 
     // Check if we have existing dual/slack variables from previous solve
-    bool has_existing_dual_slack = true;
-    for (const auto &constraint_pair : constraint_set)
+    bool has_existing_dual_slack =
+        Y_.size() == static_cast<size_t>(horizon) &&
+        S_.size() == static_cast<size_t>(horizon);
+
+    // Resize storage; existing buffers are reused
+    if (!has_existing_dual_slack)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      if (Y_.find(constraint_name) == Y_.end() ||
-          S_.find(constraint_name) == S_.end() ||
-          Y_[constraint_name].size() != static_cast<size_t>(horizon) ||
-          S_[constraint_name].size() != static_cast<size_t>(horizon))
-      {
-        has_existing_dual_slack = false;
-        break;
-      }
+      Y_.resize(horizon);
+      S_.resize(horizon);
     }
+    k_y_.resize(horizon);
+    K_y_.resize(horizon);
+    k_s_.resize(horizon);
+    K_s_.resize(horizon);
 
-    // Initialize/resize gains storage for all constraints
-    k_y_.clear();
-    K_y_.clear();
-    k_s_.clear();
-    K_s_.clear();
-
-    for (const auto &constraint_pair : constraint_set)
+    for (int t = 0; t < horizon; ++t)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      int dual_dim = constraint_pair.second->getDualDim();
-
-      // Ensure proper sizing
-      if (!has_existing_dual_slack)
+      // Use the already evaluated constraint values from
+      // evaluateTrajectoryWarmStart
+      const Eigen::VectorXd &g_val = G_[t];
+
+      // Stacked layout changed (or no previous solve): reinitialize this knot
+      const bool compatible = has_existing_dual_slack &&
+                              Y_[t].size() == total_dual_dim &&
+                              S_[t].size() == total_dual_dim;
+      if (!compatible)
       {
-        Y_[constraint_name].resize(horizon);
-        S_[constraint_name].resize(horizon);
+        Y_[t].resize(total_dual_dim);
+        S_[t].resize(total_dual_dim);
       }
 
-      k_y_[constraint_name].resize(horizon);
-      K_y_[constraint_name].resize(horizon);
-      k_s_[constraint_name].resize(horizon);
-      K_s_[constraint_name].resize(horizon);
-
-      for (int t = 0; t < horizon; ++t)
+      for (const auto &block : context.getPathConstraintBlocks())
       {
-        // Use the already evaluated constraint values from
-        // evaluateTrajectoryWarmStart
-        const Eigen::VectorXd &g_val = G_[constraint_name][t];
-
-        bool need_reinit = false;
-        Eigen::VectorXd y_current, s_current;
+        auto y_current = Y_[t].segment(block.offset, block.dim);
+        auto s_current = S_[t].segment(block.offset, block.dim);
+        const auto g_block = g_val.segment(block.offset, block.dim);
 
-        if (has_existing_dual_slack)
+        bool need_reinit = !compatible;
+        if (!need_reinit)
         {
-          y_current = Y_[constraint_name][t];
-          s_current = S_[constraint_name][t];
-
-          // Check if existing dual/slack variables are feasible and compatible
-          if (y_current.size() != dual_dim || s_current.size() != dual_dim)
-          {
-            need_reinit = true;
-          }
-          else
+          // Check feasibility conditions
+          for (int i = 0; i < block.dim; ++i)
           {
-            // Check feasibility conditions
-            for (int i = 0; i < dual_dim; ++i)
+            // Check positivity: y_i > 0 and s_i > 0
+            if (y_current(i) <= 1e-12 || s_current(i) <= 1e-12)
             {
-              // Check positivity: y_i > 0 and s_i > 0
-              if (y_current(i) <= 1e-12 || s_current(i) <= 1e-12)
-              {
-                need_reinit = true;
-                break;
-              }
+              need_reinit = true;
+              break;
+            }
 
-              // Check if constraint is severely violated (slack should be
-              // reasonable)
-              double required_slack =
-                  std::max(options.ipddp.slack_var_init_scale, -g_val(i));
-              if (s_current(i) < 0.1 * required_slack)
-              {
-                need_reinit = true;
-                break;
-              }
+            // Check if constraint is severely violated (slack should be
+            // reasonable)
+            double required_slack =
+                std::max(options.ipddp.slack_var_init_scale, -g_block(i));
+            if (s_current(i) < 0.1 * required_slack)
+            {
+              need_reinit = true;
+              break;
             }
           }
         }
-        else
-        {
-          need_reinit = true;
-        }
 
         if (need_reinit)
         {
           // Use the same initialization as cold start for consistency
-          Eigen::VectorXd s_init = Eigen::VectorXd::Zero(dual_dim);
-          Eigen::VectorXd y_init = Eigen::VectorXd::Zero(dual_dim);
-
-          for (int i = 0; i < dual_dim; ++i)
+          for (int i = 0; i < block.dim; ++i)
           {
             // Initialize s_i = max(slack_scale, -g_i) to ensure s_i > 0 (same as
             // cold start)
-            s_init(i) = std::max(options.ipddp.slack_var_init_scale, -g_val(i));
+            s_current(i) = std::max(options.ipddp.slack_var_init_scale, -g_block(i));
 
             // Initialize y_i = mu / s_i to satisfy s_i * y_i = mu (same as cold
             // start)
-            if (s_init(i) < 1e-12)
-            {
-              y_init(i) = mu_ / 1e-12;
-            }
-            else
-            {
-              y_init(i) = mu_ / s_init(i);
-            }
+            double y_init = (s_current(i) < 1e-12) ? mu_ / 1e-12 : mu_ / s_current(i);
+
             // Clamp dual variable (same as cold start)
-            y_init(i) = std::max(
+            y_current(i) = std::max(
                 options.ipddp.dual_var_init_scale * 0.01,
-                std::min(y_init(i), options.ipddp.dual_var_init_scale * 100.0));
+                std::min(y_init, options.ipddp.dual_var_init_scale * 100.0));
           }
-          Y_[constraint_name][t] = y_init;
-          S_[constraint_name][t] = s_init;
         }
-
-        // Always initialize gains to zero
-        k_y_[constraint_name][t] = Eigen::VectorXd::Zero(dual_dim);
-        K_y_[constraint_name][t] =
-            Eigen::MatrixXd::Zero(dual_dim, context.getStateDim());
-        k_s_[constraint_name][t] = Eigen::VectorXd::Zero(dual_dim);
-        K_s_[constraint_name][t] =
-            Eigen::MatrixXd::Zero(dual_dim, context.getStateDim());
       }
+
+      // Always initialize gains to zero
+      k_y_[t].setZero(total_dual_dim);
+      K_y_[t].setZero(total_dual_dim, state_dim);
+      k_s_[t].setZero(total_dual_dim);
+      K_s_[t].setZero(total_dual_dim, state_dim);
     }
 
     if (options.verbose)
@@ -715,63 +750,54 @@ namespace cddp
   {
     const CDDPOptions &options = context.getOptions();
     const int horizon = context.getHorizon();
-    const auto &constraint_set = context.getConstraintSet();
+    const int state_dim = context.getStateDim();
+    const int total_dual_dim = context.getPathDualDim();
+
+    G_.resize(horizon);
+    Y_.resize(horizon);
+    S_.resize(horizon);
+    k_y_.resize(horizon);
+    K_y_.resize(horizon);
+    k_s_.resize(horizon);
+    K_s_.resize(horizon);
 
-    // Initialize dual and slack variables for each constraint
-    for (const auto &constraint_pair : constraint_set)
+    // Initialize dual and slack variables for all constraints at once
+    for (int t = 0; t < horizon; ++t)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      int dual_dim = constraint_pair.second->getDualDim();
+      // Evaluate constraint g(x,u) = evaluate(x,u) - getUpperBound()
+      context.evaluatePathConstraints(context.X_[t], context.U_[t], G_[t]);
+      const Eigen::VectorXd &g_val = G_[t];
 
-      G_[constraint_name].resize(horizon);
-      Y_[constraint_name].resize(horizon);
-      S_[constraint_name].resize(horizon);
-      k_y_[constraint_name].resize(horizon);
-      K_y_[constraint_name].resize(horizon);
-      k_s_[constraint_name].resize(horizon);
-      K_s_[constraint_name].resize(horizon);
+      Eigen::VectorXd &s_init = S_[t];
+      Eigen::VectorXd &y_init = Y_[t];
+      s_init.resize(total_dual_dim);
+      y_init.resize(total_dual_dim);
 
-      for (int t = 0; t < horizon; ++t)
+      for (int i = 0; i < total_dual_dim; ++i)
       {
-        // Evaluate constraint g(x,u) = evaluate(x,u) - getUpperBound()
-        Eigen::VectorXd g_val =
-            constraint_pair.second->evaluate(context.X_[t], context.U_[t]) -
-            constraint_pair.second->getUpperBound();
-        G_[constraint_name][t] = g_val;
+        // Initialize s_i = max(slack_scale, -g_i) to ensure s_i > 0
+        s_init(i) = std::max(options.ipddp.slack_var_init_scale, -g_val(i));
 
-        Eigen::VectorXd s_init = Eigen::VectorXd::Zero(dual_dim);
-        Eigen::VectorXd y_init = Eigen::VectorXd::Zero(dual_dim);
-
-        for (int i = 0; i < dual_dim; ++i)
+        // Initialize y_i = mu / s_i to satisfy s_i * y_i = mu
+        if (s_init(i) < 1e-12)
         {
-          // Initialize s_i = max(slack_scale, -g_i) to ensure s_i > 0
-          s_init(i) = std::max(options.ipddp.slack_var_init_scale, -g_val(i));
-
-          // Initialize y_i = mu / s_i to satisfy s_i * y_i = mu
-          if (s_init(i) < 1e-12)
-          {
-            y_init(i) = mu_ / 1e-12;
-          }
-          else
-          {
-            y_init(i) = mu_ / s_init(i);
-          }
-          // Clamp dual variable
-          y_init(i) = std::max(
-              options.ipddp.dual_var_init_scale * 0.01,
-              std::min(y_init(i), options.ipddp.dual_var_init_scale * 100.0));
+          y_init(i) = mu_ / 1e-12;
+        }
+        else
+        {
+          y_init(i) = mu_ / s_init(i);
         }
-        Y_[constraint_name][t] = y_init;
-        S_[constraint_name][t] = s_init;
-
-        // Initialize gains to zero
-        k_y_[constraint_name][t] = Eigen::VectorXd::Zero(dual_dim);
-        K_y_[constraint_name][t] =
-            Eigen::MatrixXd::Zero(dual_dim, context.getStateDim());
-        k_s_[constraint_name][t] = Eigen::VectorXd::Zero(dual_dim);
-        K_s_[constraint_name][t] =
-            Eigen::MatrixXd::Zero(dual_dim, context.getStateDim());
+        // Clamp dual variable
+        y_init(i) = std::max(
+            options.ipddp.dual_var_init_scale * 0.01,
+            std::min(y_init(i), options.ipddp.dual_var_init_scale * 100.0));
       }
+
+      // Initialize gains to zero
+      k_y_[t].setZero(total_dual_dim);
+      K_y_[t].setZero(total_dual_dim, state_dim);
+      k_s_[t].setZero(total_dual_dim);
+      K_s_[t].setZero(total_dual_dim, state_dim);
     }
 
     // Initialize cost using objective evaluation
@@ -793,29 +819,26 @@ namespace cddp
     {
       for (int t = 0; t < context.getHorizon(); ++t)
       {
-        for (const auto &constraint_pair : constraint_set)
-        {
-          const std::string &constraint_name = constraint_pair.first;
-          const Eigen::VectorXd &s_vec = S_[constraint_name][t];
-          const Eigen::VectorXd &g_vec = G_[constraint_name][t];
-          const Eigen::VectorXd &y_vec = Y_[constraint_name][t];
+        const Eigen::VectorXd &s_vec = S_[t];
+        const Eigen::VectorXd &g_vec = G_[t];
+        const Eigen::VectorXd &y_vec = Y_[t];
 
-          // Add log-barrier term
-          merit_function -= mu_ * s_vec.array().log().sum();
+        // Add log-barrier term
+        merit_function -= mu_ * s_vec.array().log().sum();
 
-          // Compute primal residual vector
-          Eigen::VectorXd primal_residual = g_vec + s_vec;
+        // Primal residual g + s
+        const auto primal_residual = g_vec + s_vec;
 
-          // inf_pr: infinity norm (largest absolute residual)
-          inf_pr = std::max(inf_pr, primal_residual.lpNorm<Eigen::Infinity>());
+        // inf_pr: infinity norm (largest absolute residual)
+        inf_pr = std::max(inf_pr, primal_residual.lpNorm<Eigen::Infinity>());
 
-          // Filter constraint violation: l1 norm (sum of residuals)
-          filter_constraint_violation += primal_residual.lpNorm<1>();
+        // Filter constraint violation: l1 norm (sum of residuals)
+        filter_constraint_violation += primal_residual.lpNorm<1>();
 
-          // Compute complementary infeasibility: ||y .* s - mu||_inf
-          Eigen::VectorXd complementary_residual = y_vec.cwiseProduct(s_vec).array() - mu_;
-          inf_comp = std::max(inf_comp, complementary_residual.lpNorm<Eigen::Infinity>());
-        }
+        // Compute complementary infeasibility: ||y .* s - mu||_inf
+        inf_comp = std::max(
+            inf_comp,
+            (y_vec.cwiseProduct(s_vec).array() - mu_).matrix().lpNorm<Eigen::Infinity>());
       }
     }
     else
@@ -844,14 +867,17 @@ namespace cddp
     const CDDPOptions &options = context.getOptions();
     const int horizon = context.getHorizon();
     const int state_dim = context.getStateDim();
+    const int control_dim = context.getControlDim();
     const double timestep = context.getTimestep();
 
-    // Resize storage
+    // Resize storage; the Jacobians are written in place below
     F_x_.resize(horizon);
     F_u_.resize(horizon);
-    F_xx_.resize(horizon);
-    F_uu_.resize(horizon);
-    F_ux_.resize(horizon);
+    for (int t = 0; t < horizon; ++t)
+    {
+      F_x_[t].resize(state_dim, state_dim);
+      F_u_[t].resize(state_dim, control_dim);
+    }
 
     // Use parallel computation for larger horizons
     const int MIN_HORIZON_FOR_PARALLEL = 50;
@@ -860,33 +886,16 @@ namespace cddp
     if (!use_parallel)
     {
       // Single-threaded computation
+      Eigen::VectorXd &x = workspace_.x;
+      Eigen::VectorXd &u = workspace_.u;
       for (int t = 0; t < horizon; ++t)
       {
-        const Eigen::VectorXd &x = context.X_[t];
-        const Eigen::VectorXd &u = context.U_[t];
+        x = context.X_[t];
+        u = context.U_[t];
 
-        // Compute jacobians
-        const auto [Fx, Fu] =
-            context.getSystem().getJacobians(x, u, t * timestep);
-        F_x_[t] = Fx;
-        F_u_[t] = Fu;
-
-        // Compute hessians if not using iLQR
-        if (!options.use_ilqr)
-        {
-          const auto hessians =
-              context.getSystem().getHessians(x, u, t * timestep);
-          F_xx_[t] = std::get<0>(hessians);
-          F_uu_[t] = std::get<1>(hessians);
-          F_ux_[t] = std::get<2>(hessians);
-        }
-        else
-        {
-          // Initialize empty hessians for iLQR
-          F_xx_[t] = std::vector<Eigen::MatrixXd>();
-          F_uu_[t] = std::vector<Eigen::MatrixXd>();
-          F_ux_[t] = std::vector<Eigen::MatrixXd>();
-        }
+        // Discrete dynamics Jacobians, exact for the system's integrator
+        context.getSystem().evalDiscreteJacobiansInto(x, u, t * timestep,
+                                                      F_x_[t], F_u_[t]);
       }
     }
     else
@@ -907,7 +916,7 @@ namespace cddp
         if (start_t >= horizon)
           break;
 
-        futures.push_back(std::async(std::launch::async,
+        futures.push_back(context.getThreadPool().submit(
                                      [this, &context, &options, start_t, end_t, timestep]()
                                      {
             // Process chunk of time steps
@@ -915,25 +924,9 @@ namespace cddp
               const Eigen::VectorXd &x = context.X_[t];
               const Eigen::VectorXd &u = context.U_[t];
 
-              // Compute jacobians
-              const auto [Fx, Fu] =
-                  context.getSystem().getJacobians(x, u, t * timestep);
-              F_x_[t] = Fx;
-              F_u_[t] = Fu;
-
-              // Compute hessians if not using iLQR
-              if (!options.use_ilqr) {
-                const auto hessians =
-                    context.getSystem().getHessians(x, u, t * timestep);
-                F_xx_[t] = std::get<0>(hessians);
-                F_uu_[t] = std::get<1>(hessians);
-                F_ux_[t] = std::get<2>(hessians);
-              } else {
-                // Initialize empty hessians for iLQR
-                F_xx_[t] = std::vector<Eigen::MatrixXd>();
-                F_uu_[t] = std::vector<Eigen::MatrixXd>();
-                F_ux_[t] = std::vector<Eigen::MatrixXd>();
-              }
+              // Discrete dynamics Jacobians, exact for the system's integrator
+              context.getSystem().evalDiscreteJacobiansInto(
+                  x, u, t * timestep, F_x_[t], F_u_[t]);
             } }));
       }
 
@@ -964,30 +957,24 @@ namespace cddp
   {
     const CDDPOptions &options = context.getOptions();
     const int horizon = context.getHorizon();
-    const auto &constraint_set = context.getConstraintSet();
+    const auto &blocks = context.getPathConstraintBlocks();
 
     // If no constraints, return early
-    if (constraint_set.empty())
+    if (blocks.empty())
     {
       return;
     }
 
-    // Initialize storage for each constraint only if not already allocated
-    for (const auto &constraint_pair : constraint_set)
+    // Stacked Jacobians: one (total_dual_dim x n) matrix per knot
+    const int total_dual_dim = context.getPathDualDim();
+    const int state_dim = context.getStateDim();
+    const int control_dim = context.getControlDim();
+    G_x_.resize(horizon);
+    G_u_.resize(horizon);
+    for (int t = 0; t < horizon; ++t)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      if (G_x_.find(constraint_name) == G_x_.end() || G_x_[constraint_name].size() != horizon) {
-        G_x_[constraint_name].resize(horizon);
-        G_u_[constraint_name].resize(horizon);
-        // Pre-allocate matrices with correct dimensions
-        int state_dim = context.getStateDim();
-        int control_dim = context.getControlDim();
-        int constraint_dim = constraint_pair.second->getDualDim();
-        for (int t = 0; t < horizon; ++t) {
-          G_x_[constraint_name][t] = Eigen::MatrixXd::Zero(constraint_dim, state_dim);
-          G_u_[constraint_name][t] = Eigen::MatrixXd::Zero(constraint_dim, control_dim);
-        }
-      }
+      G_x_[t].resize(total_dual_dim, state_dim);
+      G_u_[t].resize(total_dual_dim, control_dim);
     }
 
     // Threshold for when parallelization is worth it - increased for better
@@ -999,18 +986,18 @@ namespace cddp
     if (!use_parallel)
     {
       // Single-threaded computation
+      Eigen::VectorXd &x = workspace_.x;
+      Eigen::VectorXd &u = workspace_.u;
       for (int t = 0; t < horizon; ++t)
       {
-        const Eigen::VectorXd &x = context.X_[t];
-        const Eigen::VectorXd &u = context.U_[t];
+        x = context.X_[t];
+        u = context.U_[t];
 
-        for (const auto &constraint_pair : constraint_set)
+        for (const auto &block : blocks)
         {
-          const std::string &constraint_name = constraint_pair.first;
-          G_x_[constraint_name][t] =
-              constraint_pair.second->getStateJacobian(x, u);
-          G_u_[constraint_name][t] =
-              constraint_pair.second->getControlJacobian(x, u);
+          context.evaluatePathConstraintJacobians(
+              block, x, u, G_x_[t].middleRows(block.offset, block.dim),
+              G_u_[t].middleRows(block.offset, block.dim));
         }
       }
     }
@@ -1035,7 +1022,7 @@ namespace cddp
           break;
 
         futures.push_back(
-            std::async(std::launch::async, [this, &context, &constraint_set,
+            context.getThreadPool().submit([this, &context, &blocks,
                                             start_t, end_t]()
                        {
             // Process a chunk of time steps
@@ -1043,12 +1030,10 @@ namespace cddp
               const Eigen::VectorXd &x = context.X_[t];
               const Eigen::VectorXd &u = context.U_[t];
 
-              for (const auto &constraint_pair : constraint_set) {
-                const std::string &constraint_name = constraint_pair.first;
-                G_x_[constraint_name][t] =
-                    constraint_pair.second->getStateJacobian(x, u);
-                G_u_[constraint_name][t] =
-                    constraint_pair.second->getControlJacobian(x, u);
+              for (const auto &block : blocks) {
+                context.evaluatePathConstraintJacobians(
+                    block, x, u, G_x_[t].middleRows(block.offset, block.dim),
+                    G_u_[t].middleRows(block.offset, block.dim));
               }
             } }));
       }
@@ -1084,20 +1069,38 @@ namespace cddp
     const int horizon = context.getHorizon();
     const double timestep = context.getTimestep();
     const auto &constraint_set = context.getConstraintSet();
-    const int total_dual_dim = getTotalDualDim(context);
 
-    // Pre-compute dynamics jacobians and hessians for all time steps
-    precomputeDynamicsDerivatives(context);
+    // Derivatives depend only on X_/U_, which regularization retries leave
+    // unchanged
+    if (!derivatives_valid_)
+    {
+      precomputeDynamicsDerivatives(context);
+      precomputeConstraintGradients(context);
+      derivatives_valid_ = true;
+    }
 
-    // Pre-compute constraint gradients for all time steps and constraints
-    precomputeConstraintGradients(context);
+    // All temporaries live in the workspace so that, once sized by the first
+    // iteration, the recursion below does not allocate
+    Workspace &ws = workspace_;
+    Eigen::VectorXd &x = ws.x;
+    Eigen::VectorXd &u = ws.u;
+    Eigen::VectorXd &V_x = ws.V_x;
+    Eigen::MatrixXd &V_xx = ws.V_xx;
+    const Objective &objective = context.getObjective();
+    ws.l_x.resize(state_dim);
+    ws.l_u.resize(control_dim);
+    ws.l_xx.resize(state_dim, state_dim);
+    ws.l_uu.resize(control_dim, control_dim);
+    ws.l_ux.resize(control_dim, state_dim);
+    V_x.resize(state_dim);
+    V_xx.resize(state_dim, state_dim);
 
     // Terminal cost and its derivatives
-    Eigen::VectorXd V_x =
-        context.getObjective().getFinalCostGradient(context.X_.back());
-    Eigen::MatrixXd V_xx =
-        context.getObjective().getFinalCostHessian(context.X_.back());
-    V_xx = 0.5 * (V_xx + V_xx.transpose()); // Symmetrize
+    x = context.X_.back();
+    objective.evalFinalCostGradientInto(x, V_x);
+    objective.evalFinalCostHessianInto(x, V_xx);
+    ws.V_xx_T = V_xx.transpose();
+    V_xx = 0.5 * (V_xx + ws.V_xx_T); // Symmetrize
 
     dV_ = Eigen::Vector2d::Zero();
     double inf_du = 0.0;   // dual infeasibility (optimality gap; Qu_err)
@@ -1110,23 +1113,25 @@ namespace cddp
     {
       for (int t = horizon - 1; t >= 0; --t)
       {
-        const Eigen::VectorXd &x = context.X_[t];
-        const Eigen::VectorXd &u = context.U_[t];
+        if (context.isCancellationRequested())
+          return false;
 
-        // Use pre-computed dynamics Jacobians
-        const Eigen::MatrixXd &Fx = F_x_[t];
-        const Eigen::MatrixXd &Fu = F_u_[t];
-        
-        // Use pre-allocated workspace matrices
-        Eigen::MatrixXd &A = workspace_.A_matrices[t];
-        Eigen::MatrixXd &B = workspace_.B_matrices[t];
-        A.noalias() = Eigen::MatrixXd::Identity(state_dim, state_dim) + timestep * Fx;
-        B.noalias() = timestep * Fu;
+        x = context.X_[t];
+        u = context.U_[t];
+
+        // Use pre-computed discrete dynamics Jacobians
+        const Eigen::MatrixXd &A = F_x_[t];
+        const Eigen::MatrixXd &B = F_u_[t];
 
         // Cost & derivatives
-        auto [l_x, l_u] = context.getObjective().getRunningCostGradients(x, u, t);
-        auto [l_xx, l_uu, l_ux] =
-            context.getObjective().getRunningCostHessians(x, u, t);
+        objective.evalRunningCostGradientsInto(x, u, t, ws.l_x, ws.l_u);
+        objective.evalRunningCostHessiansInto(x, u, t, ws.l_xx, ws.l_uu,
+                                              ws.l_ux);
+        const Eigen::VectorXd &l_x = ws.l_x;
+        const Eigen::VectorXd &l_u = ws.l_u;
+        const Eigen::MatrixXd &l_xx = ws.l_xx;
+        const Eigen::MatrixXd &l_uu = ws.l_uu;
+        const Eigen::MatrixXd &l_ux = ws.l_ux;
 
         // Q expansions from cost - use pre-allocated workspace
         Eigen::VectorXd &Q_x = workspace_.Q_x_vectors[t];
@@ -1135,30 +1140,33 @@ namespace cddp
         Eigen::MatrixXd &Q_ux = workspace_.Q_ux_matrices[t];
         Eigen::MatrixXd &Q_uu = workspace_.Q_uu_matrices[t];
         
-        Q_x.noalias() = l_x + A.transpose() * V_x;
-        Q_u.noalias() = l_u + B.transpose() * V_x;
-        Q_xx.noalias() = l_xx + A.transpose() * V_xx * A;
-        Q_ux.noalias() = l_ux + B.transpose() * V_xx * A;
-        Q_uu.noalias() = l_uu + B.transpose() * V_xx * B;
+        ws.V_xx_A.noalias() = V_xx * A;
+        ws.V_xx_B.noalias() = V_xx * B;
+        Q_x = l_x;
+        Q_x.noalias() += A.transpose() * V_x;
+        Q_u = l_u;
+        Q_u.noalias() += B.transpose() * V_x;
+        Q_xx = l_xx;
+        Q_xx.noalias() += A.transpose() * ws.V_xx_A;
+        Q_ux = l_ux;
+        Q_ux.noalias() += B.transpose() * ws.V_xx_A;
+        Q_uu = l_uu;
+        Q_uu.noalias() += B.transpose() * ws.V_xx_B;
 
         // Add state hessian term if not using iLQR
         if (!options.use_ilqr)
         {
-          // Use pre-computed hessians
-          const auto &Fxx = F_xx_[t];
-          const auto &Fuu = F_uu_[t];
-          const auto &Fux = F_ux_[t];
-
-          for (int i = 0; i < state_dim; ++i)
-          {
-            Q_xx += timestep * V_x(i) * Fxx[i];
-            Q_ux += timestep * V_x(i) * Fux[i];
-            Q_uu += timestep * V_x(i) * Fuu[i];
-          }
+          // Second-order dynamics terms, contracted with V_x
+          const auto [Fxx, Fuu, Fux] =
+              context.getSystem().getHessianContraction(x, u, V_x, t * timestep);
+          Q_xx += timestep * Fxx;
+          Q_ux += timestep * Fux;
+          Q_uu += timestep * Fuu;
         }
 
         // Apply standard DDP regularization
-        Q_uu = 0.5 * (Q_uu + Q_uu.transpose()); // symmetrize NOTE: This is critical
+        ws.Q_uu_T = Q_uu.transpose();
+        Q_uu = 0.5 * (Q_uu + ws.Q_uu_T); // symmetrize NOTE: This is critical
         Q_uu.diagonal().array() += context.regularization_;
 
         // Use cached LDLT solver or compute new factorization
@@ -1181,21 +1189,30 @@ namespace cddp
           return false;
         }
 
-        Eigen::VectorXd k_u = -workspace_.ldlt_solvers[t].solve(Q_u);
-        Eigen::MatrixXd K_u = -workspace_.ldlt_solvers[t].solve(Q_ux);
-        k_u_[t] = k_u;
-        K_u_[t] = K_u;
+        Eigen::VectorXd &k_u = k_u_[t];
+        Eigen::MatrixXd &K_u = K_u_[t];
+        k_u = -Q_u;
+        workspace_.ldlt_solvers[t].solveInPlace(k_u);
+        K_u = -Q_ux;
+        workspace_.ldlt_solvers[t].solveInPlace(K_u);
 
         // Update value function
-        V_x = Q_x + K_u.transpose() * Q_u + Q_ux.transpose() * k_u +
-              K_u.transpose() * Q_uu * k_u;
-        V_xx = Q_xx + K_u.transpose() * Q_ux + Q_ux.transpose() * K_u +
-               K_u.transpose() * Q_uu * K_u;
-        V_xx = 0.5 * (V_xx + V_xx.transpose()); // Symmetrize
+        ws.Q_uu_k.noalias() = Q_uu * k_u;
+        ws.Q_uu_K.noalias() = Q_uu * K_u;
+        V_x = Q_x;
+        V_x.noalias() += K_u.transpose() * Q_u;
+        V_x.noalias() += Q_ux.transpose() * k_u;
+        V_x.noalias() += K_u.transpose() * ws.Q_uu_k;
+        V_xx = Q_xx;
+        V_xx.noalias() += K_u.transpose() * Q_ux;
+        V_xx.noalias() += Q_ux.transpose() * K_u;
+        V_xx.noalias() += K_u.transpose() * ws.Q_uu_K;
+        ws.V_xx_T = V_xx.transpose();
+        V_xx = 0.5 * (V_xx + ws.V_xx_T); // Symmetrize
 
         // Accumulate cost improvement
         dV_[0] += k_u.dot(Q_u);
-        dV_[1] += 0.5 * k_u.dot(Q_uu * k_u);
+        dV_[1] += 0.5 * k_u.dot(ws.Q_uu_k);
 
         // Error tracking
         inf_du = std::max(inf_du, Q_u.lpNorm<Eigen::Infinity>());
@@ -1220,95 +1237,93 @@ namespace cddp
       // Constrained backward recursion
       for (int t = horizon - 1; t >= 0; --t)
       {
-        const Eigen::VectorXd &x = context.X_[t];
-        const Eigen::VectorXd &u = context.U_[t];
-
-        // Use pre-computed dynamics Jacobians
-        const Eigen::MatrixXd &Fx = F_x_[t];
-        const Eigen::MatrixXd &Fu = F_u_[t];
-        Eigen::MatrixXd A =
-            Eigen::MatrixXd::Identity(state_dim, state_dim) + timestep * Fx;
-        Eigen::MatrixXd B = timestep * Fu;
-
-        // Use pre-allocated workspace for constraint variables
-        Eigen::VectorXd &y = workspace_.y_combined;
-        Eigen::VectorXd &s = workspace_.s_combined;
-        Eigen::VectorXd &g = workspace_.g_combined;
-        Eigen::MatrixXd &Q_yu = workspace_.Q_yu_combined;
-        Eigen::MatrixXd &Q_yx = workspace_.Q_yx_combined;
-
-        int offset = 0;
-        for (const auto &constraint_pair : constraint_set)
-        {
-          const std::string &constraint_name = constraint_pair.first;
-          int dual_dim = constraint_pair.second->getDualDim();
-
-          const Eigen::VectorXd &y_vec = Y_[constraint_name][t];
-          const Eigen::VectorXd &s_vec = S_[constraint_name][t];
-          const Eigen::VectorXd &g_vec = G_[constraint_name][t];
-          const Eigen::MatrixXd &g_x = G_x_[constraint_name][t];
-          const Eigen::MatrixXd &g_u = G_u_[constraint_name][t];
-
-          y.segment(offset, dual_dim) = y_vec;
-          s.segment(offset, dual_dim) = s_vec;
-          g.segment(offset, dual_dim) = g_vec;
-          Q_yx.block(offset, 0, dual_dim, state_dim) = g_x;
-          Q_yu.block(offset, 0, dual_dim, control_dim) = g_u;
-
-          offset += dual_dim;
-        }
+        if (context.isCancellationRequested())
+          return false;
+
+        x = context.X_[t];
+        u = context.U_[t];
+
+        // Use pre-computed discrete dynamics Jacobians
+        const Eigen::MatrixXd &A = F_x_[t];
+        const Eigen::MatrixXd &B = F_u_[t];
+
+        // Constraint variables are already stacked per knot
+        const Eigen::VectorXd &y = Y_[t];
+        const Eigen::VectorXd &s = S_[t];
+        const Eigen::VectorXd &g = G_[t];
+        const Eigen::MatrixXd &Q_yx = G_x_[t];
+        const Eigen::MatrixXd &Q_yu = G_u_[t];
 
         // Cost & derivatives
-        auto [l_x, l_u] = context.getObjective().getRunningCostGradients(x, u, t);
-        auto [l_xx, l_uu, l_ux] =
-            context.getObjective().getRunningCostHessians(x, u, t);
+        objective.evalRunningCostGradientsInto(x, u, t, ws.l_x, ws.l_u);
+        objective.evalRunningCostHessiansInto(x, u, t, ws.l_xx, ws.l_uu,
+                                              ws.l_ux);
+        const Eigen::VectorXd &l_x = ws.l_x;
+        const Eigen::VectorXd &l_u = ws.l_u;
+        const Eigen::MatrixXd &l_xx = ws.l_xx;
+        const Eigen::MatrixXd &l_uu = ws.l_uu;
+        const Eigen::MatrixXd &l_ux = ws.l_ux;
 
         // Q expansions from cost
-        Eigen::VectorXd Q_x = l_x + Q_yx.transpose() * y + A.transpose() * V_x;
-        Eigen::VectorXd Q_u = l_u + Q_yu.transpose() * y + B.transpose() * V_x;
-        Eigen::MatrixXd Q_xx = l_xx + A.transpose() * V_xx * A;
-        Eigen::MatrixXd Q_ux = l_ux + B.transpose() * V_xx * A;
-        Eigen::MatrixXd Q_uu = l_uu + B.transpose() * V_xx * B;
+        Eigen::VectorXd &Q_x = workspace_.Q_x_vectors[t];
+        Eigen::VectorXd &Q_u = workspace_.Q_u_vectors[t];
+        Eigen::MatrixXd &Q_xx = workspace_.Q_xx_matrices[t];
+        Eigen::MatrixXd &Q_ux = workspace_.Q_ux_matrices[t];
+        Eigen::MatrixXd &Q_uu = workspace_.Q_uu_matrices[t];
+
+        ws.V_xx_A.noalias() = V_xx * A;
+        ws.V_xx_B.noalias() = V_xx * B;
+        Q_x = l_x;
+        Q_x.noalias() += Q_yx.transpose() * y;
+        Q_x.noalias() += A.transpose() * V_x;
+        Q_u = l_u;
+        Q_u.noalias() += Q_yu.transpose() * y;
+        Q_u.noalias() += B.transpose() * V_x;
+        Q_xx = l_xx;
+        Q_xx.noalias() += A.transpose() * ws.V_xx_A;
+        Q_ux = l_ux;
+        Q_ux.noalias() += B.transpose() * ws.V_xx_A;
+        Q_uu = l_uu;
+        Q_uu.noalias() += B.transpose() * ws.V_xx_B;
 
         // Add state hessian term if not using iLQR
         if (!options.use_ilqr)
         {
-          // Use pre-computed hessians
-          const auto &Fxx = F_xx_[t];
-          const auto &Fuu = F_uu_[t];
-          const auto &Fux = F_ux_[t];
-
-          for (int i = 0; i < state_dim; ++i)
-          {
-            Q_xx += timestep * V_x(i) * Fxx[i];
-            Q_ux += timestep * V_x(i) * Fux[i];
-            Q_uu += timestep * V_x(i) * Fuu[i];
-          }
+          // Second-order dynamics terms, contracted with V_x
+          const auto [Fxx, Fuu, Fux] =
+              context.getSystem().getHessianContraction(x, u, V_x, t * timestep);
+          Q_xx += timestep * Fxx;
+          Q_ux += timestep * Fux;
+          Q_uu += timestep * Fuu;
         }
 
-        // Optimize diagonal matrix operations
-        Eigen::MatrixXd &YSinv = workspace_.YSinv;
-        YSinv.setZero();
-        for (int i = 0; i < total_dual_dim; ++i) {
-          YSinv(i, i) = y(i) / s(i);
-        }
+        // Y * S^{-1} is diagonal; apply it as a row scaling
+        Eigen::VectorXd &YSinv = ws.YSinv;
+        YSinv = y.cwiseQuotient(s);
+        ws.YSinv_Q_yx.noalias() = YSinv.asDiagonal() * Q_yx;
+        ws.YSinv_Q_yu.noalias() = YSinv.asDiagonal() * Q_yu;
 
         // Residuals
-        Eigen::VectorXd primal_residual = g + s;                                  // primal infeasibility
-        Eigen::VectorXd complementary_residual = y.cwiseProduct(s).array() - mu_; // complementary infeasibility
-        Eigen::VectorXd rhat = y.cwiseProduct(primal_residual) - complementary_residual;
+        Eigen::VectorXd &primal_residual = ws.primal_residual;
+        Eigen::VectorXd &complementary_residual = ws.complementary_residual;
+        Eigen::VectorXd &rhat = ws.rhat;
+        primal_residual = g + s;                                        // primal infeasibility
+        complementary_residual = y.cwiseProduct(s).array() - mu_;       // complementary infeasibility
+        rhat = y.cwiseProduct(primal_residual) - complementary_residual;
 
         // Apply standard DDP regularization
-        Eigen::MatrixXd Q_uu_reg = Q_uu;
-        Q_uu_reg = 0.5 * (Q_uu_reg + Q_uu_reg.transpose()); // symmetrize
+        Eigen::MatrixXd &Q_uu_reg = ws.Q_uu_reg;
+        ws.Q_uu_T = Q_uu.transpose();
+        Q_uu_reg = 0.5 * (Q_uu + ws.Q_uu_T); // symmetrize
         
         // Add constraint contribution
-        Q_uu_reg.noalias() += Q_yu.transpose() * YSinv * Q_yu;
+        Q_uu_reg.noalias() += Q_yu.transpose() * ws.YSinv_Q_yu;
         
         // Apply standard DDP regularization
         Q_uu_reg.diagonal().array() += context.regularization_;
 
-        Eigen::LDLT<Eigen::MatrixXd> ldlt(Q_uu_reg);
+        Eigen::LDLT<Eigen::MatrixXd> &ldlt = ws.ldlt;
+        ldlt.compute(Q_uu_reg);
         if (ldlt.info() != Eigen::Success)
         {
           if (options.debug)
@@ -1320,69 +1335,56 @@ namespace cddp
 
         // Use pre-allocated workspace
         Eigen::MatrixXd &bigRHS = workspace_.bigRHS;
-        // Compute S_inv * rhat efficiently
-        Eigen::VectorXd S_inv_rhat(total_dual_dim);
-        for (int i = 0; i < total_dual_dim; ++i) {
-          S_inv_rhat(i) = rhat(i) / s(i);
-        }
-        bigRHS.col(0).noalias() = Q_u + Q_yu.transpose() * S_inv_rhat;
-        // Compute M = Q_ux + Q_yu.transpose() * YSinv * Q_yx efficiently
-        bigRHS.rightCols(state_dim).noalias() = Q_ux + Q_yu.transpose() * YSinv * Q_yx;
+        Eigen::VectorXd &S_inv_rhat = ws.S_inv_rhat;
+        S_inv_rhat = rhat.cwiseQuotient(s);
+        bigRHS.col(0) = Q_u;
+        bigRHS.col(0).noalias() += Q_yu.transpose() * S_inv_rhat;
+        // M = Q_ux + Q_yu.transpose() * YSinv * Q_yx
+        bigRHS.rightCols(state_dim) = Q_ux;
+        bigRHS.rightCols(state_dim).noalias() += Q_yu.transpose() * ws.YSinv_Q_yx;
 
-        Eigen::MatrixXd kK = -ldlt.solve(bigRHS);
+        Eigen::MatrixXd &kK = ws.kK;
+        kK = ldlt.solve(bigRHS);
 
         // Parse out feedforward and feedback gains
-        Eigen::VectorXd k_u = kK.col(0);
-        Eigen::MatrixXd K_u(control_dim, state_dim);
-        for (int col = 0; col < state_dim; col++)
-        {
-          K_u.col(col) = kK.col(col + 1);
-        }
-
-        k_u_[t] = k_u;
-        K_u_[t] = K_u;
+        Eigen::VectorXd &k_u = k_u_[t];
+        Eigen::MatrixXd &K_u = K_u_[t];
+        k_u = -kK.col(0);
+        K_u = -kK.rightCols(state_dim);
 
         // Compute gains for constraints efficiently
-        Eigen::VectorXd k_y(total_dual_dim);
-        Eigen::VectorXd temp = Q_yu * k_u;
-        for (int i = 0; i < total_dual_dim; ++i) {
-          k_y(i) = (rhat(i) + y(i) * temp(i)) / s(i);
-        }
-        Eigen::MatrixXd K_y = YSinv * (Q_yx + Q_yu * K_u);
-        Eigen::VectorXd k_s = -primal_residual - temp;
-        Eigen::MatrixXd K_s = -Q_yx - Q_yu * K_u;
-
-        offset = 0;
-        for (const auto &constraint_pair : constraint_set)
-        {
-          const std::string &constraint_name = constraint_pair.first;
-          int dual_dim = constraint_pair.second->getDualDim();
-
-          k_y_[constraint_name][t] = k_y.segment(offset, dual_dim);
-          K_y_[constraint_name][t] = K_y.block(offset, 0, dual_dim, state_dim);
-          k_s_[constraint_name][t] = k_s.segment(offset, dual_dim);
-          K_s_[constraint_name][t] = K_s.block(offset, 0, dual_dim, state_dim);
-
-          offset += dual_dim;
-        }
+        Eigen::VectorXd &temp = ws.Q_yu_k;
+        temp.noalias() = Q_yu * k_u;
+        k_y_[t] = (rhat + y.cwiseProduct(temp)).cwiseQuotient(s);
+        K_s_[t] = -Q_yx;
+        K_s_[t].noalias() -= Q_yu * K_u;
+        K_y_[t] = -(YSinv.asDiagonal() * K_s_[t]);
+        k_s_[t] = -primal_residual - temp;
 
         // Update Q expansions efficiently
         Q_u.noalias() += Q_yu.transpose() * S_inv_rhat;
         Q_x.noalias() += Q_yx.transpose() * S_inv_rhat;
-        Q_xx.noalias() += Q_yx.transpose() * YSinv * Q_yx;
-        Q_ux.noalias() += Q_yx.transpose() * YSinv * Q_yu;
-        Q_uu.noalias() += Q_yu.transpose() * YSinv * Q_yu;
+        Q_xx.noalias() += Q_yx.transpose() * ws.YSinv_Q_yx;
+        Q_ux.noalias() += Q_yu.transpose() * ws.YSinv_Q_yx;
+        Q_uu.noalias() += Q_yu.transpose() * ws.YSinv_Q_yu;
 
         // Update cost improvement
+        ws.Q_uu_k.noalias() = Q_uu * k_u;
+        ws.Q_uu_K.noalias() = Q_uu * K_u;
         dV_[0] += k_u.dot(Q_u);
-        dV_[1] += 0.5 * k_u.dot(Q_uu * k_u);
+        dV_[1] += 0.5 * k_u.dot(ws.Q_uu_k);
 
         // Update value function
-        V_x = Q_x + K_u.transpose() * Q_u + Q_ux.transpose() * k_u +
-              K_u.transpose() * Q_uu * k_u;
-        V_xx = Q_xx + K_u.transpose() * Q_ux + Q_ux.transpose() * K_u +
-               K_u.transpose() * Q_uu * K_u;
-        V_xx = 0.5 * (V_xx + V_xx.transpose()); // Symmetrize
+        V_x = Q_x;
+        V_x.noalias() += K_u.transpose() * Q_u;
+        V_x.noalias() += Q_ux.transpose() * k_u;
+        V_x.noalias() += K_u.transpose() * ws.Q_uu_k;
+        V_xx = Q_xx;
+        V_xx.noalias() += K_u.transpose() * Q_ux;
+        V_xx.noalias() += Q_ux.transpose() * K_u;
+        V_xx.noalias() += K_u.transpose() * ws.Q_uu_K;
+        ws.V_xx_T = V_xx.transpose();
+        V_xx = 0.5 * (V_xx + ws.V_xx_T); // Symmetrize
 
         // Error tracking
         inf_du = std::max(inf_du, Q_u.lpNorm<Eigen::Infinity>());
@@ -1407,10 +1409,10 @@ namespace cddp
     }
   }
 
-  ForwardPassResult IPDDPSolver::performForwardPass(CDDP &context)
+  ForwardPassResult &IPDDPSolver::performForwardPass(CDDP &context)
   {
     const CDDPOptions &options = context.getOptions();
-    ForwardPassResult best_result;
+    ForwardPassResult &best_result = best_result_;
     best_result.cost = std::numeric_limits<double>::infinity();
     best_result.merit_function = std::numeric_limits<double>::infinity();
     best_result.success = false;
@@ -1425,19 +1427,34 @@ namespace cddp
     
     if (!options.enable_parallel)
     {
+      // Both buffers rotate with the iterate through swaps; give them
+      // storage up front so that rollouts only ever overwrite it
+      const bool constrained = !context.getConstraintSet().empty();
+      for (ForwardPassResult *buffer : {&trial_result_, &best_result_})
+      {
+        buffer->state_trajectory.resize(context.X_.dim(), context.X_.size());
+        buffer->control_trajectory.resize(context.U_.dim(), context.U_.size());
+        if (constrained)
+        {
+          if (!buffer->dual_trajectory)
+            buffer->dual_trajectory = Y_;
+          if (!buffer->slack_trajectory)
+            buffer->slack_trajectory = S_;
+          if (!buffer->constraint_eval_trajectory)
+            buffer->constraint_eval_trajectory = G_;
+        }
+      }
+
       // Single-threaded execution with early termination
       for (double alpha_pr : context.alphas_)
       {
-        ForwardPassResult result = forwardPass(context, alpha_pr);
+        forwardPass(context, alpha_pr, trial_result_, forward_workspace_);
 
-        if (result.success &&
-            result.merit_function < best_result.merit_function)
+        if (trial_result_.success &&
+            trial_result_.merit_function < best_result.merit_function)
         {
-          best_result = result;
-          if (result.success)
-          {
-            break; // Early termination
-          }
+          std::swap(best_result, trial_result_);
+          break; // Early termination
         }
       }
     }
@@ -1450,8 +1467,12 @@ namespace cddp
       for (double alpha_pr : context.alphas_)
       {
         futures.push_back(
-            std::async(std::launch::async, [this, &context, alpha_pr]()
-                       { return forwardPass(context, alpha_pr); }));
+            context.getThreadPool().submit([this, &context, alpha_pr]()
+                       {
+              ForwardPassResult result;
+              ForwardPassWorkspace ws;
+              forwardPass(context, alpha_pr, result, ws);
+              return result; }));
       }
 
       for (auto &future : futures)
@@ -1464,7 +1485,7 @@ namespace cddp
             if (result.success &&
                 result.merit_function < best_result.merit_function)
             {
-              best_result = result;
+              best_result = std::move(result);
             }
           }
         }
@@ -1483,18 +1504,22 @@ namespace cddp
     return best_result;
   }
 
-  ForwardPassResult IPDDPSolver::forwardPass(CDDP &context, double alpha)
+  void IPDDPSolver::forwardPass(CDDP &context, double alpha,
+                                ForwardPassResult &result,
+                                ForwardPassWorkspace &ws, bool use_filter)
   {
     const CDDPOptions &options = context.getOptions();
     const auto &constraint_set = context.getConstraintSet();
 
-    ForwardPassResult result;
     result.success = false;
     result.cost = std::numeric_limits<double>::infinity();
     result.merit_function = std::numeric_limits<double>::infinity();
     result.alpha_pr = alpha;
+    if (context.isCancellationRequested())
+      return;
 
     const int horizon = context.getHorizon();
+    const double timestep = context.getTimestep();
     const double tau =
         std::max(options.ipddp.barrier.min_fraction_to_boundary, 1.0 - mu_);
 
@@ -1503,10 +1528,6 @@ namespace cddp
     result.control_trajectory = context.U_;
     result.state_trajectory[0] = context.getInitialState();
 
-    std::map<std::string, std::vector<Eigen::VectorXd>> Y_new = Y_;
-    std::map<std::string, std::vector<Eigen::VectorXd>> S_new = S_;
-    std::map<std::string, std::vector<Eigen::VectorXd>> G_new = G_;
-
     double cost_new = 0.0;
     double merit_function_new = 0.0;
     double constraint_violation_new = 0.0;
@@ -1516,36 +1537,54 @@ namespace cddp
     {
       for (int t = 0; t < horizon; ++t)
       {
-        const Eigen::VectorXd delta_x =
-            result.state_trajectory[t] - context.X_[t];
-        result.control_trajectory[t] =
-            context.U_[t] + alpha * k_u_[t] + K_u_[t] * delta_x;
+        ws.x = result.state_trajectory[t];
+        ws.delta_x = ws.x - context.X_[t];
+        Trajectory::ColumnView u_new = result.control_trajectory[t];
+        u_new += alpha * k_u_[t];
+        u_new.noalias() += K_u_[t] * ws.delta_x;
+        ws.u = u_new;
 
         // Propagate dynamics
-        result.state_trajectory[t + 1] = context.getSystem().getDiscreteDynamics(
-            result.state_trajectory[t], result.control_trajectory[t],
-            t * context.getTimestep());
+        context.getSystem().evalDiscreteDynamicsInto(
+            ws.x, ws.u, t * timestep, result.state_trajectory[t + 1]);
 
         // Accumulate stage cost
-        cost_new += context.getObjective().running_cost(
-            result.state_trajectory[t], result.control_trajectory[t], t);
+        cost_new += context.getObjective().running_cost(ws.x, ws.u, t);
       }
-      cost_new +=
-          context.getObjective().terminal_cost(result.state_trajectory.back());
+      ws.x = result.state_trajectory.back();
+      cost_new += context.getObjective().terminal_cost(ws.x);
 
       double dJ = context.cost_ - cost_new;
       double expected = -alpha * (dV_(0) + 0.5 * alpha * dV_(1));
       double reduction_ratio =
           expected > 0.0 ? dJ / expected : std::copysign(1.0, dJ);
 
-      result.success = reduction_ratio > 1e-6;
+      result.success = !use_filter || reduction_ratio > 1e-6;
       result.cost = cost_new;
       result.merit_function = cost_new;
       result.constraint_violation = 0.0;
       result.alpha_du = 1.0; // No dual variables for unconstrained case
-      return result;
+      result.dual_trajectory.reset();
+      result.slack_trajectory.reset();
+      result.constraint_eval_trajectory.reset();
+      return;
     }
 
+    // Trial duals, slacks and residuals are written into the result's own
+    // buffers, which keep their storage across line search iterations
+    if (!result.dual_trajectory)
+      result.dual_trajectory.emplace();
+    if (!result.slack_trajectory)
+      result.slack_trajectory.emplace();
+    if (!result.constraint_eval_trajectory)
+      result.constraint_eval_trajectory.emplace();
+    std::vector<Eigen::VectorXd> &Y_new = *result.dual_trajectory;
+    std::vector<Eigen::VectorXd> &S_new = *result.slack_trajectory;
+    std::vector<Eigen::VectorXd> &G_new = *result.constraint_eval_trajectory;
+    Y_new = Y_;
+    S_new = S_;
+    G_new = G_;
+
     // Constrained forward pass
     double alpha_s = alpha;
 
@@ -1553,53 +1592,41 @@ namespace cddp
     bool s_trajectory_feasible = true;
     for (int t = 0; t < horizon; ++t)
     {
-      const Eigen::VectorXd delta_x = result.state_trajectory[t] - context.X_[t];
+      ws.x = result.state_trajectory[t];
+      ws.delta_x = ws.x - context.X_[t];
 
       // Update slack variables first
-      for (const auto &constraint_pair : constraint_set)
-      {
-        const std::string &constraint_name = constraint_pair.first;
-        int dual_dim = constraint_pair.second->getDualDim();
-        const Eigen::VectorXd &s_old = S_[constraint_name][t];
-
-        Eigen::VectorXd s_new = s_old + alpha_s * k_s_[constraint_name][t] +
-                                K_s_[constraint_name][t] * delta_x;
-        Eigen::VectorXd s_min = (1.0 - tau) * s_old;
-
-        for (int i = 0; i < dual_dim; ++i)
-        {
-          if (s_new[i] < s_min[i])
-          {
-            s_trajectory_feasible = false;
-            break;
-          }
-        }
-        if (!s_trajectory_feasible)
-          break;
+      const Eigen::VectorXd &s_old = S_[t];
+      Eigen::VectorXd &s_new = S_new[t];
+      s_new = s_old + alpha_s * k_s_[t];
+      s_new.noalias() += K_s_[t] * ws.delta_x;
 
-        S_new[constraint_name][t] = s_new;
-      }
-      if (!s_trajectory_feasible)
+      // Fraction-to-boundary rule
+      if (((s_new - (1.0 - tau) * s_old).array() < 0.0).any())
+      {
+        s_trajectory_feasible = false;
         break;
+      }
 
       // Update control
-      result.control_trajectory[t] =
-          context.U_[t] + alpha_s * k_u_[t] + K_u_[t] * delta_x;
+      Trajectory::ColumnView u_new = result.control_trajectory[t];
+      u_new += alpha_s * k_u_[t];
+      u_new.noalias() += K_u_[t] * ws.delta_x;
+      ws.u = u_new;
 
       // Propagate dynamics
-      result.state_trajectory[t + 1] = context.getSystem().getDiscreteDynamics(
-          result.state_trajectory[t], result.control_trajectory[t],
-          t * context.getTimestep());
+      context.getSystem().evalDiscreteDynamicsInto(
+          ws.x, ws.u, t * timestep, result.state_trajectory[t + 1]);
     }
 
     if (!s_trajectory_feasible)
     {
-      return result; // Failed slack update
+      return; // Failed slack update
     }
 
     // Step 2: Separate line search for dual variables
     bool suitable_alpha_y_found = false;
-    std::map<std::string, std::vector<Eigen::VectorXd>> Y_trial;
+    std::vector<Eigen::VectorXd> &Y_trial = ws.Y_trial;
 
     for (double alpha_y_candidate : context.alphas_)
     {
@@ -1608,41 +1635,24 @@ namespace cddp
 
       for (int t = 0; t < horizon; ++t)
       {
-        const Eigen::VectorXd delta_x =
-            result.state_trajectory[t] - context.X_[t];
+        ws.delta_x = result.state_trajectory[t] - context.X_[t];
 
-        for (const auto &constraint_pair : constraint_set)
-        {
-          const std::string &constraint_name = constraint_pair.first;
-          int dual_dim = constraint_pair.second->getDualDim();
-          const Eigen::VectorXd &y_old = Y_[constraint_name][t];
-
-          Eigen::VectorXd y_new = y_old +
-                                  alpha_y_candidate * k_y_[constraint_name][t] +
-                                  K_y_[constraint_name][t] * delta_x;
-          Eigen::VectorXd y_min = (1.0 - tau) * y_old;
-
-          for (int i = 0; i < dual_dim; ++i)
-          {
-            if (y_new[i] < y_min[i])
-            {
-              current_alpha_y_globally_feasible = false;
-              break;
-            }
-          }
-          if (!current_alpha_y_globally_feasible)
-            break;
+        const Eigen::VectorXd &y_old = Y_[t];
+        Eigen::VectorXd &y_new = Y_trial[t];
+        y_new = y_old + alpha_y_candidate * k_y_[t];
+        y_new.noalias() += K_y_[t] * ws.delta_x;
 
-          Y_trial[constraint_name][t] = y_new;
-        }
-        if (!current_alpha_y_globally_feasible)
+        if (((y_new - (1.0 - tau) * y_old).array() < 0.0).any())
+        {
+          current_alpha_y_globally_feasible = false;
           break;
+        }
       }
 
       if (current_alpha_y_globally_feasible)
       {
         suitable_alpha_y_found = true;
-        Y_new = Y_trial;
+        Y_new.swap(Y_trial);
         result.alpha_du = alpha_y_candidate; // Store the dual step size
         break;
       }
@@ -1650,34 +1660,27 @@ namespace cddp
 
     if (!suitable_alpha_y_found)
     {
-      return result; // Failed dual variable update
+      return; // Failed dual variable update
     }
 
     // Cost computation and filter line-search
     for (int t = 0; t < horizon; ++t)
     {
-      cost_new += context.getObjective().running_cost(
-          result.state_trajectory[t], result.control_trajectory[t], t);
+      ws.x = result.state_trajectory[t];
+      ws.u = result.control_trajectory[t];
+      cost_new += context.getObjective().running_cost(ws.x, ws.u, t);
 
-      for (const auto &constraint_pair : constraint_set)
-      {
-        const std::string &constraint_name = constraint_pair.first;
-        G_new[constraint_name][t] =
-            constraint_pair.second->evaluate(result.state_trajectory[t],
-                                             result.control_trajectory[t]) -
-            constraint_pair.second->getUpperBound();
-
-        const Eigen::VectorXd &s_vec = S_new[constraint_name][t];
-        merit_function_new -= mu_ * s_vec.array().log().sum();
-
-        // Primal infeasibility: g + s
-        Eigen::VectorXd primal_residual = G_new[constraint_name][t] + s_vec;
-        constraint_violation_new += primal_residual.lpNorm<1>();
-      }
+      context.evaluatePathConstraints(ws.x, ws.u, G_new[t]);
+
+      const Eigen::VectorXd &s_vec = S_new[t];
+      merit_function_new -= mu_ * s_vec.array().log().sum();
+
+      // Primal infeasibility: g + s
+      constraint_violation_new += (G_new[t] + s_vec).lpNorm<1>();
     }
 
-    cost_new +=
-        context.getObjective().terminal_cost(result.state_trajectory.back());
+    ws.x = result.state_trajectory.back();
+    cost_new += context.getObjective().terminal_cost(ws.x);
     merit_function_new += cost_new;
 
     // Filter acceptance logic
@@ -1687,7 +1690,11 @@ namespace cddp
     double merit_function_old = context.merit_function_;
 
     // Filter logic
-    if (constraint_violation_new > options.filter.max_violation_threshold)
+    if (!use_filter)
+    {
+      filter_acceptance = true;
+    }
+    else if (constraint_violation_new > options.filter.max_violation_threshold)
     {
       if (constraint_violation_new < (1 - options.filter.violation_acceptance_threshold) * constraint_violation_old)
       {
@@ -1724,12 +1731,7 @@ namespace cddp
       result.cost = cost_new;
       result.merit_function = merit_function_new;
       result.constraint_violation = constraint_violation_new;
-      result.dual_trajectory = Y_new;
-      result.slack_trajectory = S_new;
-      result.constraint_eval_trajectory = G_new;
     }
-
-    return result;
   }
 
   void IPDDPSolver::printIteration(int iter, double objective, double inf_pr,
@@ -1804,18 +1806,17 @@ namespace cddp
   }
 
 
-  void IPDDPSolver::printSolutionSummary(const CDDPSolution &solution) const
+  void IPDDPSolver::printSolutionSummary(const SolveResult &result) const
   {
     std::cout << "\n========================================\n";
     std::cout << "           IPDDP Solution Summary\n";
     std::cout << "========================================\n";
 
-    auto iterations = std::any_cast<int>(solution.at("iterations_completed"));
-    auto solve_time = std::any_cast<double>(solution.at("solve_time_ms"));
-    auto final_cost = std::any_cast<double>(solution.at("final_objective"));
-    auto status = std::any_cast<std::string>(solution.at("status_message"));
-    auto final_mu =
-        std::any_cast<double>(solution.at("final_barrier_parameter_mu"));
+    auto iterations = result.iterations_completed;
+    auto solve_time = result.solve_time_ms;
+    auto final_cost = result.final_objective;
+    const auto &status = result.status_message;
+    auto final_mu = result.final_barrier_parameter_mu.value_or(0.0);
 
     std::cout << "Status: " << status << "\n";
     std::cout << "Iterations: " << iterations << "\n";
@@ -1922,30 +1923,18 @@ namespace cddp
     }
   }
 
-  void IPDDPSolver::updateIterationHistory(
-      const CDDPOptions &options,
-      const CDDP &context,
-      std::vector<double> &history_objective,
-      std::vector<double> &history_merit_function,
-      std::vector<double> &history_step_length_primal,
-      std::vector<double> &history_step_length_dual,
-      std::vector<double> &history_dual_infeasibility,
-      std::vector<double> &history_primal_infeasibility,
-      std::vector<double> &history_complementary_infeasibility,
-      std::vector<double> &history_barrier_mu,
-      double alpha_du) const
+  void IPDDPSolver::updateIterationHistory(const CDDP &context,
+                                           SolveHistory &history,
+                                           double alpha_du) const
   {
-    if (options.return_iteration_info)
-    {
-      history_objective.push_back(context.cost_);
-      history_merit_function.push_back(context.merit_function_);
-      history_step_length_primal.push_back(context.alpha_pr_);
-      history_step_length_dual.push_back(alpha_du);
-      history_dual_infeasibility.push_back(context.inf_du_);
-      history_primal_infeasibility.push_back(context.inf_pr_);
-      history_complementary_infeasibility.push_back(context.inf_comp_);
-      history_barrier_mu.push_back(mu_);
-    }
+    history.objective.push_back(context.cost_);
+    history.merit_function.push_back(context.merit_function_);
+    history.step_length_primal.push_back(context.alpha_pr_);
+    history.step_length_dual.push_back(alpha_du);
+    history.dual_infeasibility.push_back(context.inf_du_);
+    history.primal_infeasibility.push_back(context.inf_pr_);
+    history.complementary_infeasibility.push_back(context.inf_comp_);
+    history.barrier_mu.push_back(mu_);
   }
 
   bool IPDDPSolver::checkConvergence(
@@ -2013,10 +2002,9 @@ namespace cddp
 
   void IPDDPSolver::initializeConstraintStorage(CDDP &context)
   {
-    const auto &constraint_set = context.getConstraintSet();
     const int horizon = context.getHorizon();
 
-    // Clear and initialize constraint storage
+    // Clear and initialize stacked constraint storage (one entry per knot)
     G_.clear();
     G_x_.clear();
     G_u_.clear();
@@ -2027,37 +2015,31 @@ namespace cddp
     k_s_.clear();
     K_s_.clear();
 
-    // Initialize storage for each constraint
-    for (const auto &constraint_pair : constraint_set)
+    if (context.getPathConstraintBlocks().empty())
     {
-      const std::string &constraint_name = constraint_pair.first;
-      G_[constraint_name].resize(horizon);
-      Y_[constraint_name].resize(horizon);
-      S_[constraint_name].resize(horizon);
-      k_y_[constraint_name].resize(horizon);
-      K_y_[constraint_name].resize(horizon);
-      k_s_[constraint_name].resize(horizon);
-      K_s_[constraint_name].resize(horizon);
+      return;
     }
+
+    G_.resize(horizon);
+    Y_.resize(horizon);
+    S_.resize(horizon);
+    k_y_.resize(horizon);
+    K_y_.resize(horizon);
+    k_s_.resize(horizon);
+    K_s_.resize(horizon);
   }
 
   double IPDDPSolver::computeMaxConstraintViolation(const CDDP &context) const
   {
-    const auto &constraint_set = context.getConstraintSet();
-    const int horizon = context.getHorizon();
+    const int horizon = std::min<int>(context.getHorizon(), G_.size());
     double max_violation = 0.0;
 
-    for (const auto &constraint_pair : constraint_set)
+    for (int t = 0; t < horizon; ++t)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      auto g_it = G_.find(constraint_name);
-      if (g_it != G_.end())
+      const Eigen::VectorXd &g_vec = G_[t];
+      if (g_vec.size() > 0)
       {
-        for (int t = 0; t < horizon; ++t)
-        {
-          const Eigen::VectorXd &g_vec = g_it->second[t];
-          max_violation = std::max(max_violation, g_vec.maxCoeff());
-        }
+        max_violation = std::max(max_violation, g_vec.maxCoeff());
       }
     }
     return max_violation;
@@ -2065,12 +2047,11 @@ namespace cddp
 
   double IPDDPSolver::computeScaledDualInfeasibility(const CDDP &context) const
   {
-    const auto &constraint_set = context.getConstraintSet();
     const int horizon = context.getHorizon();
     const int control_dim = context.getControlDim();
     
     // If no constraints, return the unscaled dual infeasibility
-    if (constraint_set.empty())
+    if (context.getPathConstraintBlocks().empty())
     {
       return context.inf_du_;
     }
@@ -2083,24 +2064,12 @@ namespace cddp
     double s_norm_l1 = 0.0;
     int total_dual_dim = 0; // m: total number of constraints
 
-    for (const auto &constraint_pair : constraint_set)
+    const int num_knots = std::min<int>(horizon, std::min(Y_.size(), S_.size()));
+    for (int t = 0; t < num_knots; ++t)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      auto y_it = Y_.find(constraint_name);
-      auto s_it = S_.find(constraint_name);
-      
-      if (y_it != Y_.end() && s_it != S_.end())
-      {
-        for (int t = 0; t < horizon; ++t)
-        {
-          const Eigen::VectorXd &y_vec = y_it->second[t];
-          const Eigen::VectorXd &s_vec = s_it->second[t];
-          
-          y_norm_l1 += y_vec.lpNorm<1>();
-          s_norm_l1 += s_vec.lpNorm<1>();
-          total_dual_dim += y_vec.size();
-        }
-      }
+      y_norm_l1 += Y_[t].lpNorm<1>();
+      s_norm_l1 += S_[t].lpNorm<1>();
+      total_dual_dim += Y_[t].size();
     }
 
     // m = total_dual_dim (number of constraints)
@@ -30,6 +30,7 @@ LogDDPSolver::LogDDPSolver()
       ms_segment_length_(5) {}
 
 void LogDDPSolver::initialize(CDDP &context) {
+  derivatives_valid_ = false;
   const CDDPOptions &options = context.getOptions();
 
   int horizon = context.getHorizon();
@@ -116,8 +117,8 @@ void LogDDPSolver::initialize(CDDP &context) {
   // reference states
   if (context.X_.size() != static_cast<size_t>(horizon + 1) ||
       context.U_.size() != static_cast<size_t>(horizon)) {
-    context.X_.resize(horizon + 1);
-    context.U_.resize(horizon);
+    context.X_.resize(state_dim, horizon + 1);
+    context.U_.resize(control_dim, horizon);
 
     // Create X_ initial guess using initial_state and reference_state by
     // interpolating between them
@@ -134,16 +135,9 @@ void LogDDPSolver::initialize(CDDP &context) {
   }
 
   // Resize linearized dynamics storage
-  F_.resize(horizon);
+  F_.assign(horizon, Eigen::VectorXd::Zero(state_dim));
   F_x_.resize(horizon);
   F_u_.resize(horizon);
-  F_xx_.resize(horizon);
-  F_uu_.resize(horizon);
-  F_ux_.resize(horizon);
-
-  for (int t = 0; t < horizon; ++t) {
-    F_[t] = Eigen::VectorXd::Zero(state_dim);
-  }
 
   k_u_.resize(horizon);
   K_u_.resize(horizon);
@@ -215,7 +209,7 @@ void LogDDPSolver::initialize(CDDP &context) {
 
 std::string LogDDPSolver::getSolverName() const { return "LogDDP"; }
 
-CDDPSolution LogDDPSolver::solve(CDDP &context) {
+void LogDDPSolver::solve(CDDP &context, SolveResult &result) {
   const CDDPOptions &options = context.getOptions();
 
   // Print solver header if requested
@@ -228,46 +222,25 @@ CDDPSolution LogDDPSolver::solve(CDDP &context) {
     context.printOptions(options);
   }
 
-  // Prepare solution map with old-style structure for compatibility
-  CDDPSolution solution;
-  solution["solver_name"] = getSolverName();
-  solution["status_message"] = std::string("Running");
-  solution["iterations_completed"] = 0;
-  solution["solve_time_ms"] = 0.0;
-
-  // Initialize history vectors only if requested
-  std::vector<double> history_objective;
-  std::vector<double> history_lagrangian;
-  std::vector<double> history_step_length_primal;
-  std::vector<double> history_dual_infeasibility;
-  std::vector<double> history_primal_infeasibility;
-  std::vector<double> history_barrier_mu;
-
-  if (options.return_iteration_info) {
-    const size_t expected_size =
-        static_cast<size_t>(options.max_iterations + 1);
-    history_objective.reserve(expected_size);
-    history_lagrangian.reserve(expected_size);
-    history_step_length_primal.reserve(expected_size);
-    history_dual_infeasibility.reserve(expected_size);
-    history_primal_infeasibility.reserve(expected_size);
-    history_barrier_mu.reserve(expected_size);
-  }
+  // History is recorded only if requested
+  result.beginSolve(getSolverName(), options.return_iteration_info,
+                    static_cast<size_t>(options.max_iterations + 1));
+  SolveHistory *history = result.history ? &*result.history : nullptr;
 
   // Initialize trajectories and gaps
   evaluateTrajectory(context); // context.cost_ is computed inside this function
-  if (options.return_iteration_info) {
-    history_objective.push_back(context.cost_);
+  if (history) {
+    history->objective.push_back(context.cost_);
   }
 
   // Reset LogDDP filter
   resetFilter(context); // L_ and constraint_violation_ are computed inside this
                         // function
-  if (options.return_iteration_info) {
-    history_lagrangian.push_back(context.merit_function_);
-    history_dual_infeasibility.push_back(context.inf_du_);
-    history_primal_infeasibility.push_back(constraint_violation_);
-    history_barrier_mu.push_back(mu_);
+  if (history) {
+    history->merit_function.push_back(context.merit_function_);
+    history->dual_infeasibility.push_back(context.inf_du_);
+    history->primal_infeasibility.push_back(constraint_violation_);
+    history->barrier_mu.push_back(mu_);
   }
 
   if (options.verbose) {
@@ -304,6 +277,11 @@ CDDPSolution LogDDPSolver::solve(CDDP &context) {
       }
     }
 
+    if (context.isCancellationRequested()) {
+      termination_reason = "Cancelled";
+      break;
+    }
+
     // 1. Backward pass: Solve Riccati recursion to compute optimal control law
     bool backward_pass_success = false;
     while (!backward_pass_success) {
@@ -313,6 +291,10 @@ CDDPSolution LogDDPSolver::solve(CDDP &context) {
         if (options.debug) {
           std::cerr << "LogDDP: Backward pass failed" << std::endl;
         }
+        if (context.isCancellationRequested()) {
+          termination_reason = "Cancelled";
+          break;
+        }
 
         context.increaseRegularization();
 
@@ -329,7 +311,7 @@ CDDPSolution LogDDPSolver::solve(CDDP &context) {
       }
     }
 
-    if (converged) {
+    if (converged || !backward_pass_success) {
       break;
     }
 
@@ -349,8 +331,9 @@ CDDPSolution LogDDPSolver::solve(CDDP &context) {
                   << std::endl;
       }
 
-      context.X_ = best_result.state_trajectory;
-      context.U_ = best_result.control_trajectory;
+      context.X_.swap(best_result.state_trajectory);
+      context.U_.swap(best_result.control_trajectory);
+      derivatives_valid_ = false;
       if (best_result.dynamics_trajectory)
         F_ = *best_result.dynamics_trajectory;
 
@@ -361,17 +344,22 @@ CDDPSolution LogDDPSolver::solve(CDDP &context) {
       context.alpha_pr_ = best_result.alpha_pr;
       constraint_violation_ = best_result.constraint_violation;
 
-      if (options.return_iteration_info) {
-        history_objective.push_back(context.cost_);
-        history_lagrangian.push_back(context.merit_function_);
-        history_step_length_primal.push_back(context.alpha_pr_);
-        history_dual_infeasibility.push_back(context.inf_du_);
-        history_primal_infeasibility.push_back(constraint_violation_);
-        history_barrier_mu.push_back(mu_);
+      if (history) {
+        history->objective.push_back(context.cost_);
+        history->merit_function.push_back(context.merit_function_);
+        history->step_length_primal.push_back(context.alpha_pr_);
+        history->dual_infeasibility.push_back(context.inf_du_);
+        history->primal_infeasibility.push_back(constraint_violation_);
+        history->barrier_mu.push_back(mu_);
       }
+      context.notifyIteration(iter);
 
       context.decreaseRegularization();
     } else {
+      if (context.isCancellationRequested()) {
+        termination_reason = "Cancelled";
+        break;
+      }
       context.increaseRegularization();
 
       if (context.isRegularizationLimitReached()) {
@@ -434,66 +422,50 @@ CDDPSolution LogDDPSolver::solve(CDDP &context) {
       end_time - start_time);
 
   // Populate final solution
-  solution["status_message"] = termination_reason;
-  solution["iterations_completed"] = iter;
-  solution["solve_time_ms"] = static_cast<double>(duration.count());
-  solution["final_objective"] = context.cost_;
-  solution["final_step_length"] = context.alpha_pr_;
+  result.status_message = termination_reason;
+  result.iterations_completed = iter;
+  result.solve_time_ms = static_cast<double>(duration.count());
+  result.final_objective = context.cost_;
+  result.final_step_length = context.alpha_pr_;
 
   // Add trajectories
-  std::vector<double> time_points;
-  time_points.reserve(static_cast<size_t>(context.getHorizon() + 1));
-  for (int t = 0; t <= context.getHorizon(); ++t) {
-    time_points.push_back(t * context.getTimestep());
-  }
-  solution["time_points"] = time_points;
-  solution["state_trajectory"] = context.X_;
-  solution["control_trajectory"] = context.U_;
-
-  // Add iteration history if requested
-  if (options.return_iteration_info) {
-    solution["history_objective"] = history_objective;
-    solution["history_merit_function"] = history_lagrangian;
-    solution["history_step_length_primal"] = history_step_length_primal;
-    solution["history_dual_infeasibility"] = history_dual_infeasibility;
-    solution["history_primal_infeasibility"] = history_primal_infeasibility;
-    solution["history_barrier_mu"] = history_barrier_mu;
-  }
+  result.setTimePoints(context.getHorizon(), context.getTimestep());
+  result.state_trajectory = context.X_;
+  result.control_trajectory = context.U_;
 
   // Add control gains
-  solution["control_feedback_gains_K"] = K_u_;
+  result.setFeedbackGains(K_u_);
 
   // Final metrics
-  solution["final_regularization"] = context.regularization_;
-  solution["final_barrier_parameter_mu"] = mu_;
-  solution["final_primal_infeasibility"] = constraint_violation_;
-  solution["final_dual_infeasibility"] = context.inf_du_;
+  result.final_regularization = context.regularization_;
+  result.final_barrier_parameter_mu = mu_;
+  result.final_primal_infeasibility = constraint_violation_;
+  result.final_dual_infeasibility = context.inf_du_;
 
   if (options.verbose) {
-    printSolutionSummary(solution);
+    printSolutionSummary(result);
   }
-
-
-  return solution;
 }
 
 void LogDDPSolver::evaluateTrajectory(CDDP &context) {
   const int horizon = context.getHorizon();
   double cost = 0.0;
 
-  // Rollout dynamics and calculate cost
+  // Calculate cost at the guessed states/controls
   for (int t = 0; t < horizon; ++t) {
     const Eigen::VectorXd &x_t = context.X_[t];
     const Eigen::VectorXd &u_t = context.U_[t];
-
-    // Compute stage cost using the guessed state/control
     cost += context.getObjective().running_cost(x_t, u_t, t);
-
-    // Compute dynamics
-    F_[t] = context.getSystem().getDiscreteDynamics(x_t, u_t,
-                                                    t * context.getTimestep());
   }
 
+  // Every shooting segment starts from a known knot, so the dynamics of the
+  // whole horizon are evaluated in one batch
+  const double timestep = context.getTimestep();
+  context.getSystem().getDiscreteDynamicsBatch(
+      context.X_.matrix().leftCols(horizon), context.U_.matrix(),
+      Eigen::VectorXd::LinSpaced(horizon, 0.0, (horizon - 1) * timestep),
+      F_.matrix());
+
   // Add terminal cost based on the final guessed state
   cost += context.getObjective().terminal_cost(context.X_.back());
 
@@ -539,14 +511,16 @@ void LogDDPSolver::precomputeDynamicsDerivatives(CDDP &context) {
   const CDDPOptions &options = context.getOptions();
   const int horizon = context.getHorizon();
   const int state_dim = context.getStateDim();
+  const int control_dim = context.getControlDim();
   const double timestep = context.getTimestep();
 
-  // Resize storage
+  // Resize storage; the Jacobians are written in place below
   F_x_.resize(horizon);
   F_u_.resize(horizon);
-  F_xx_.resize(horizon);
-  F_uu_.resize(horizon);
-  F_ux_.resize(horizon);
+  for (int t = 0; t < horizon; ++t) {
+    F_x_[t].resize(state_dim, state_dim);
+    F_u_[t].resize(state_dim, control_dim);
+  }
 
   // Threshold for when parallelization is worth it
   const int MIN_HORIZON_FOR_PARALLEL = 20;
@@ -559,25 +533,9 @@ void LogDDPSolver::precomputeDynamicsDerivatives(CDDP &context) {
       const Eigen::VectorXd &x = context.X_[t];
       const Eigen::VectorXd &u = context.U_[t];
 
-      // Compute jacobians
-      const auto [Fx, Fu] =
-          context.getSystem().getJacobians(x, u, t * timestep);
-      F_x_[t] = Fx;
-      F_u_[t] = Fu;
-
-      // Compute hessians if not using iLQR
-      if (!options.use_ilqr) {
-        const auto hessians =
-            context.getSystem().getHessians(x, u, t * timestep);
-        F_xx_[t] = std::get<0>(hessians);
-        F_uu_[t] = std::get<1>(hessians);
-        F_ux_[t] = std::get<2>(hessians);
-      } else {
-        // Initialize empty hessians for iLQR
-        F_xx_[t] = std::vector<Eigen::MatrixXd>();
-        F_uu_[t] = std::vector<Eigen::MatrixXd>();
-        F_ux_[t] = std::vector<Eigen::MatrixXd>();
-      }
+      // Discrete dynamics Jacobians, exact for the system's integrator
+      context.getSystem().evalDiscreteJacobiansInto(x, u, t * timestep,
+                                                    F_x_[t], F_u_[t]);
     }
   } else {
     // Chunked parallel computation - much more efficient
@@ -598,32 +556,16 @@ void LogDDPSolver::precomputeDynamicsDerivatives(CDDP &context) {
         break;
 
       futures.push_back(
-          std::async(std::launch::async, [this, &context, &options, start_t,
+          context.getThreadPool().submit([this, &context, &options, start_t,
                                           end_t, timestep]() {
             // Process a chunk of time steps
             for (int t = start_t; t < end_t; ++t) {
               const Eigen::VectorXd &x = context.X_[t];
               const Eigen::VectorXd &u = context.U_[t];
 
-              // Compute jacobians
-              const auto [Fx, Fu] =
-                  context.getSystem().getJacobians(x, u, t * timestep);
-              F_x_[t] = Fx;
-              F_u_[t] = Fu;
-
-              // Compute hessians if not using iLQR
-              if (!options.use_ilqr) {
-                const auto hessians =
-                    context.getSystem().getHessians(x, u, t * timestep);
-                F_xx_[t] = std::get<0>(hessians);
-                F_uu_[t] = std::get<1>(hessians);
-                F_ux_[t] = std::get<2>(hessians);
-              } else {
-                // Initialize empty hessians for iLQR
-                F_xx_[t] = std::vector<Eigen::MatrixXd>();
-                F_uu_[t] = std::vector<Eigen::MatrixXd>();
-                F_ux_[t] = std::vector<Eigen::MatrixXd>();
-              }
+              // Discrete dynamics Jacobians, exact for the system's integrator
+              context.getSystem().evalDiscreteJacobiansInto(
+                  x, u, t * timestep, F_x_[t], F_u_[t]);
             }
           }));
     }
@@ -661,8 +603,12 @@ bool LogDDPSolver::backwardPass(CDDP &context) {
   const double timestep = context.getTimestep();
   const auto &constraint_set = context.getConstraintSet();
 
-  // Pre-compute dynamics jacobians and hessians for all time steps
-  precomputeDynamicsDerivatives(context);
+  // Derivatives depend only on X_/U_, which regularization retries leave
+  // unchanged
+  if (!derivatives_valid_) {
+    precomputeDynamicsDerivatives(context);
+    derivatives_valid_ = true;
+  }
 
   // Terminal cost and derivatives (V_x, V_xx at t=N)
   Eigen::VectorXd V_x =
@@ -676,17 +622,18 @@ bool LogDDPSolver::backwardPass(CDDP &context) {
 
   // Backward Riccati recursion
   for (int t = horizon - 1; t >= 0; --t) {
+    if (context.isCancellationRequested()) {
+      return false;
+    }
+
     const Eigen::VectorXd &x = context.X_[t];
     const Eigen::VectorXd &u = context.U_[t];
     const Eigen::VectorXd &f = F_[t];
     const Eigen::VectorXd &d = f - context.X_[t + 1]; // Defect
 
-    // Use pre-computed dynamics Jacobians
-    const Eigen::MatrixXd &Fx = F_x_[t];
-    const Eigen::MatrixXd &Fu = F_u_[t];
-    const Eigen::MatrixXd &A =
-        timestep * Fx + Eigen::MatrixXd::Identity(state_dim, state_dim);
-    const Eigen::MatrixXd &B = timestep * Fu;
+    // Use pre-computed discrete dynamics Jacobians
+    const Eigen::MatrixXd &A = F_x_[t];
+    const Eigen::MatrixXd &B = F_u_[t];
 
     // Cost derivatives at (x_t, u_t)
     auto [l_x, l_u] = context.getObjective().getRunningCostGradients(x, u, t);
@@ -701,16 +648,12 @@ bool LogDDPSolver::backwardPass(CDDP &context) {
 
     // Add state hessian term if not using iLQR
     if (!options.use_ilqr) {
-      // Use pre-computed hessians
-      const auto &Fxx = F_xx_[t];
-      const auto &Fuu = F_uu_[t];
-      const auto &Fux = F_ux_[t];
-
-      for (int i = 0; i < state_dim; ++i) {
-        Q_xx += timestep * V_x(i) * Fxx[i];
-        Q_ux += timestep * V_x(i) * Fux[i];
-        Q_uu += timestep * V_x(i) * Fuu[i];
-      }
+      // Second-order dynamics terms, contracted with V_x
+      const auto [Fxx, Fuu, Fux] =
+          context.getSystem().getHessianContraction(x, u, V_x, t * timestep);
+      Q_xx += timestep * Fxx;
+      Q_ux += timestep * Fux;
+      Q_uu += timestep * Fuu;
     }
 
     // Apply Log-barrier cost gradients and Hessians
@@ -812,7 +755,7 @@ ForwardPassResult LogDDPSolver::performForwardPass(CDDP &context) {
 
     for (double alpha_pr : context.alphas_) {
       futures.push_back(
-          std::async(std::launch::async, [this, &context, alpha_pr]() {
+          context.getThreadPool().submit([this, &context, alpha_pr]() {
             return forwardPass(context, alpha_pr);
           }));
     }
@@ -847,6 +790,9 @@ ForwardPassResult LogDDPSolver::forwardPass(CDDP &context, double alpha) {
   result.cost = std::numeric_limits<double>::infinity();
   result.merit_function = std::numeric_limits<double>::infinity();
   result.alpha_pr = alpha;
+  if (context.isCancellationRequested()) {
+    return result;
+  }
 
   const int horizon = context.getHorizon();
   const int state_dim = context.getStateDim();
@@ -893,12 +839,9 @@ ForwardPassResult LogDDPSolver::forwardPass(CDDP &context, double alpha) {
         F_new[t] = context.getSystem().getDiscreteDynamics(
             result.state_trajectory[t], result.control_trajectory[t],
             t * context.getTimestep());
-        const auto [Fx, Fu] = context.getSystem().getJacobians(
-            context.X_[t], context.U_[t], t * context.getTimestep());
-        const Eigen::MatrixXd A =
-            Eigen::MatrixXd::Identity(state_dim, state_dim) +
-            context.getTimestep() * Fx;
-        const Eigen::MatrixXd B = context.getTimestep() * Fu;
+        // Discrete Jacobians at the current iterate from the last precompute
+        const Eigen::MatrixXd &A = F_x_[t];
+        const Eigen::MatrixXd &B = F_u_[t];
         result.state_trajectory[t + 1] =
             context.X_[t + 1] + (A + B * K_u_[t]) * delta_x_t +
             alpha * (B * k_u_[t] + F_[t] - context.X_[t + 1]);
@@ -1029,17 +972,16 @@ void LogDDPSolver::printIteration(int iter, double cost, double lagrangian,
             << std::setprecision(2) << constraint_violation << std::endl;
 }
 
-void LogDDPSolver::printSolutionSummary(const CDDPSolution &solution) const {
+void LogDDPSolver::printSolutionSummary(const SolveResult &result) const {
   std::cout << "\n========================================\n";
   std::cout << "           LogDDP Solution Summary\n";
   std::cout << "========================================\n";
 
-  auto iterations = std::any_cast<int>(solution.at("iterations_completed"));
-  auto solve_time = std::any_cast<double>(solution.at("solve_time_ms"));
-  auto final_cost = std::any_cast<double>(solution.at("final_objective"));
-  auto status = std::any_cast<std::string>(solution.at("status_message"));
-  auto final_mu =
-      std::any_cast<double>(solution.at("final_barrier_parameter_mu"));
+  auto iterations = result.iterations_completed;
+  auto solve_time = result.solve_time_ms;
+  auto final_cost = result.final_objective;
+  const auto &status = result.status_message;
+  auto final_mu = result.final_barrier_parameter_mu.value_or(0.0);
 
   std::cout << "Status: " << status << "\n";
   std::cout << "Iterations: " << iterations << "\n";
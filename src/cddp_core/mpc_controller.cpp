@@ -0,0 +1,106 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "cddp_core/mpc_controller.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace cddp {
+
+MPCController::MPCController(std::unique_ptr<CDDP> problem,
+                             const std::string &solver_type)
+    : problem_(std::move(problem)), solver_type_(solver_type) {
+  if (!problem_) {
+    throw std::invalid_argument("MPCController: problem must not be null");
+  }
+  user_warm_start_ = problem_->getOptions().warm_start;
+}
+
+const SolveResult &MPCController::step(const Eigen::VectorXd &current_state,
+                                       double time) {
+  advanceTo(time);
+  problem_->setInitialState(current_state);
+  problem_->solve(solver_type_, last_solution_);
+  finishTick();
+  return last_solution_;
+}
+
+void MPCController::prepare(double time) {
+  advanceTo(time);
+  problem_->prepare(solver_type_);
+}
+
+const SolveResult &
+MPCController::feedback(const Eigen::VectorXd &current_state) {
+  problem_->feedback(current_state, last_solution_);
+  finishTick();
+  return last_solution_;
+}
+
+void MPCController::advanceTo(double time) {
+  if (has_solution_) {
+    // Advance the previous solution by the number of elapsed knots
+    const int steps = static_cast<int>(
+        std::lround((time - last_time_) / problem_->getTimestep()));
+    if (steps > 0) {
+      problem_->shiftTrajectory(steps);
+    }
+  }
+  last_time_ = time;
+}
+
+void MPCController::finishTick() {
+  if (!has_solution_) {
+    has_solution_ = true;
+    // Every subsequent tick re-solves from the shifted solution
+    if (!problem_->getOptions().warm_start) {
+      CDDPOptions options = problem_->getOptions();
+      options.warm_start = true;
+      problem_->setOptions(options);
+    }
+  }
+}
+
+void MPCController::setReferenceStates(
+    const std::vector<Eigen::VectorXd> &reference_states) {
+  if (reference_states.empty()) {
+    return;
+  }
+  problem_->setReferenceState(reference_states.back());
+  problem_->setReferenceStates(reference_states);
+}
+
+Eigen::VectorXd MPCController::getControl() const {
+  if (problem_->U_.empty()) {
+    throw std::runtime_error("MPCController: no control available before the "
+                             "first call to step()");
+  }
+  return problem_->U_.front();
+}
+
+void MPCController::reset() {
+  has_solution_ = false;
+  last_time_ = 0.0;
+  last_solution_ = SolveResult();
+  if (problem_->getOptions().warm_start != user_warm_start_) {
+    CDDPOptions options = problem_->getOptions();
+    options.warm_start = user_warm_start_;
+    problem_->setOptions(options);
+  }
+  problem_->resetWarmStart();
+}
+
+} // namespace cddp
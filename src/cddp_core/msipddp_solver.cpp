@@ -31,6 +31,7 @@ namespace cddp
 
   void MSIPDDPSolver::initialize(CDDP &context)
   {
+    derivatives_valid_ = false;
     const CDDPOptions &options = context.getOptions();
     const auto &constraint_set = context.getConstraintSet();
 
@@ -38,11 +39,11 @@ namespace cddp
     int control_dim = context.getControlDim();
     int state_dim = context.getStateDim();
 
-    // Initialize workspace if not already done
-    if (!workspace_.initialized) {
+    // Initialize workspace if not already done, or if the horizon changed
+    // since the last solve
+    if (!workspace_.initialized ||
+        workspace_.Q_xx_matrices.size() != static_cast<size_t>(horizon)) {
       // Allocate backward pass workspace
-      workspace_.A_matrices.resize(horizon);
-      workspace_.B_matrices.resize(horizon);
       workspace_.Q_xx_matrices.resize(horizon);
       workspace_.Q_ux_matrices.resize(horizon);
       workspace_.Q_uu_matrices.resize(horizon);
@@ -60,8 +61,6 @@ namespace cddp
       workspace_.d_vectors.resize(horizon);
       
       for (int t = 0; t < horizon; ++t) {
-        workspace_.A_matrices[t] = Eigen::MatrixXd::Zero(state_dim, state_dim);
-        workspace_.B_matrices[t] = Eigen::MatrixXd::Zero(state_dim, control_dim);
         workspace_.Q_xx_matrices[t] = Eigen::MatrixXd::Zero(state_dim, state_dim);
         workspace_.Q_ux_matrices[t] = Eigen::MatrixXd::Zero(control_dim, state_dim);
         workspace_.Q_uu_matrices[t] = Eigen::MatrixXd::Zero(control_dim, control_dim);
@@ -74,21 +73,25 @@ namespace cddp
         workspace_.delta_x_vectors[t] = Eigen::VectorXd::Zero(state_dim);
       }
       
-      // Allocate constraint workspace if needed
-      if (!constraint_set.empty()) {
-        int total_dual_dim = getTotalDualDim(context);
-        workspace_.y_combined = Eigen::VectorXd::Zero(total_dual_dim);
-        workspace_.s_combined = Eigen::VectorXd::Zero(total_dual_dim);
-        workspace_.g_combined = Eigen::VectorXd::Zero(total_dual_dim);
-        workspace_.Q_yu_combined = Eigen::MatrixXd::Zero(total_dual_dim, control_dim);
-        workspace_.Q_yx_combined = Eigen::MatrixXd::Zero(total_dual_dim, state_dim);
-        workspace_.YSinv = Eigen::MatrixXd::Zero(total_dual_dim, total_dual_dim);
+      workspace_.initialized = true;
+    }
+
+    // Constraint workspace follows the stacked dual dimension, which can
+    // change between solves
+    if (!constraint_set.empty()) {
+      const int total_dual_dim = context.getPathDualDim();
+      if (workspace_.YSinv.rows() != total_dual_dim) {
+        workspace_.YSinv = Eigen::VectorXd::Zero(total_dual_dim);
+      }
+      if (workspace_.bigRHS.rows() != control_dim ||
+          workspace_.bigRHS.cols() != 1 + state_dim) {
         workspace_.bigRHS = Eigen::MatrixXd::Zero(control_dim, 1 + state_dim);
       }
-      
-      workspace_.initialized = true;
     }
 
+    // Cached factorizations belong to the previous solve
+    std::fill(workspace_.ldlt_valid.begin(), workspace_.ldlt_valid.end(), false);
+
     // Validate reference state consistency
     if ((context.getReferenceState() - context.getObjective().getReferenceState()).norm() > 1e-6)
     {
@@ -217,8 +220,8 @@ namespace cddp
     if (!trajectory_provided)
     {
       // Create interpolated initial trajectory
-      context.X_.resize(horizon + 1);
-      context.U_.resize(horizon);
+      context.X_.resize(state_dim, horizon + 1);
+      context.U_.resize(control_dim, horizon);
 
       for (int t = 0; t <= horizon; ++t)
       {
@@ -288,18 +291,27 @@ namespace cddp
 
   std::string MSIPDDPSolver::getSolverName() const { return "MSIPDDP"; }
 
-  int MSIPDDPSolver::getTotalDualDim(const CDDP &context) const
+  void MSIPDDPSolver::shift(CDDP &context, int steps)
   {
-    int total_dual_dim = 0;
-    const auto &constraint_set = context.getConstraintSet();
-    for (const auto &constraint_pair : constraint_set)
+    cddp::shiftTrajectory(k_u_, steps);
+    cddp::shiftTrajectory(K_u_, steps);
+    for (auto *storage : {&G_, &Y_, &S_, &k_y_, &k_s_})
+    {
+      cddp::shiftTrajectory(*storage, steps);
+    }
+    for (auto *storage : {&K_y_, &K_s_})
     {
-      total_dual_dim += constraint_pair.second->getDualDim();
+      cddp::shiftTrajectory(*storage, steps);
     }
-    return total_dual_dim;
+    cddp::shiftTrajectory(F_, steps);
+    cddp::shiftTrajectory(Lambda_, steps);
+    cddp::shiftTrajectory(k_lambda_, steps);
+    cddp::shiftTrajectory(K_lambda_, steps);
+    derivatives_valid_ = false;
+    std::fill(workspace_.ldlt_valid.begin(), workspace_.ldlt_valid.end(), false);
   }
 
-  CDDPSolution MSIPDDPSolver::solve(CDDP &context)
+  void MSIPDDPSolver::solve(CDDP &context, SolveResult &result)
   {
     const CDDPOptions &options = context.getOptions();
 
@@ -313,45 +325,22 @@ namespace cddp
       context.printOptions(options);
     }
 
-    // Prepare solution map
-    CDDPSolution solution;
-    solution["solver_name"] = getSolverName();
-    solution["status_message"] = std::string("Running");
-    solution["iterations_completed"] = 0;
-    solution["solve_time_ms"] = 0.0;
-
-    // Initialize history vectors only if requested
-    std::vector<double> history_objective;
-    std::vector<double> history_merit_function;
-    std::vector<double> history_step_length_primal;
-    std::vector<double> history_step_length_dual;
-    std::vector<double> history_dual_infeasibility;
-    std::vector<double> history_primal_infeasibility;
-    std::vector<double> history_complementary_infeasibility;
-    std::vector<double> history_barrier_mu;
-
-    if (options.return_iteration_info)
-    {
-      const size_t expected_size =
-          static_cast<size_t>(options.max_iterations + 1);
-      history_objective.reserve(expected_size);
-      history_merit_function.reserve(expected_size);
-      history_step_length_primal.reserve(expected_size);
-      history_step_length_dual.reserve(expected_size);
-      history_dual_infeasibility.reserve(expected_size);
-      history_primal_infeasibility.reserve(expected_size);
-      history_complementary_infeasibility.reserve(expected_size);
-      history_barrier_mu.reserve(expected_size);
+    // History is recorded only if requested
+    result.beginSolve(getSolverName(), options.return_iteration_info,
+                      static_cast<size_t>(options.max_iterations + 1));
+    SolveHistory *history = result.history ? &*result.history : nullptr;
 
+    if (history)
+    {
       // Initial iteration values
-      history_objective.push_back(context.cost_);
-      history_merit_function.push_back(context.merit_function_);
-      history_step_length_primal.push_back(1.0); // Initial step length
-      history_step_length_dual.push_back(1.0);   // Initial dual step length
-      history_dual_infeasibility.push_back(context.inf_du_);
-      history_primal_infeasibility.push_back(context.inf_pr_);
-      history_complementary_infeasibility.push_back(context.inf_comp_);
-      history_barrier_mu.push_back(mu_);
+      history->objective.push_back(context.cost_);
+      history->merit_function.push_back(context.merit_function_);
+      history->step_length_primal.push_back(1.0); // Initial step length
+      history->step_length_dual.push_back(1.0);   // Initial dual step length
+      history->dual_infeasibility.push_back(context.inf_du_);
+      history->primal_infeasibility.push_back(context.inf_pr_);
+      history->complementary_infeasibility.push_back(context.inf_comp_);
+      history->barrier_mu.push_back(mu_);
     }
 
     if (options.verbose)
@@ -389,6 +378,12 @@ namespace cddp
         }
       }
 
+      if (context.isCancellationRequested())
+      {
+        termination_reason = "Cancelled";
+        break;
+      }
+
       // Backward pass with regularization
       bool backward_pass_success = false;
       while (!backward_pass_success)
@@ -396,6 +391,11 @@ namespace cddp
         backward_pass_success = backwardPass(context);
         if (!backward_pass_success)
         {
+          if (context.isCancellationRequested())
+          {
+            termination_reason = "Cancelled";
+            break;
+          }
           context.increaseRegularization();
           if (context.isRegularizationLimitReached())
           {
@@ -425,14 +425,15 @@ namespace cddp
         }
 
         // Update trajectories and variables
-        context.X_ = best_result.state_trajectory;
-        context.U_ = best_result.control_trajectory;
+        context.X_.swap(best_result.state_trajectory);
+        context.U_.swap(best_result.control_trajectory);
+        derivatives_valid_ = false;
         if (best_result.dual_trajectory)
-          Y_ = *best_result.dual_trajectory;
+          Y_.swap(*best_result.dual_trajectory);
         if (best_result.slack_trajectory)
-          S_ = *best_result.slack_trajectory;
+          S_.swap(*best_result.slack_trajectory);
         if (best_result.constraint_eval_trajectory)
-          G_ = *best_result.constraint_eval_trajectory;
+          G_.swap(*best_result.constraint_eval_trajectory);
         if (best_result.dynamics_trajectory)
           F_ = *best_result.dynamics_trajectory;
         if (best_result.costate_trajectory)
@@ -447,16 +448,22 @@ namespace cddp
         // Update filter with accepted point
         acceptFilterEntry(best_result.merit_function, best_result.constraint_violation);
 
-        updateIterationHistory(options, context, history_objective, history_merit_function,
-                               history_step_length_primal, history_step_length_dual,
-                               history_dual_infeasibility, history_primal_infeasibility,
-                               history_complementary_infeasibility, history_barrier_mu,
-                               best_result.alpha_du);
+        if (history)
+        {
+          updateIterationHistory(context, *history, best_result.alpha_du);
+        }
+        context.notifyIteration(iter);
 
         context.decreaseRegularization();
       }
       else
       {
+        if (context.isCancellationRequested())
+        {
+          termination_reason = "Cancelled";
+          break;
+        }
+
         // Try filter restoration before increasing regularization
         bool restoration_performed = checkAndPerformFilterRestoration(context);
         
@@ -504,53 +511,31 @@ namespace cddp
         end_time - start_time);
 
     // Populate final solution
-    solution["status_message"] = termination_reason;
-    solution["iterations_completed"] = iter;
-    solution["solve_time_ms"] = static_cast<double>(duration.count());
-    solution["final_objective"] = context.cost_;
-    solution["final_step_length"] = context.alpha_pr_;
+    result.status_message = termination_reason;
+    result.iterations_completed = iter;
+    result.solve_time_ms = static_cast<double>(duration.count());
+    result.final_objective = context.cost_;
+    result.final_step_length = context.alpha_pr_;
 
     // Add trajectories
-    std::vector<double> time_points;
-    time_points.reserve(static_cast<size_t>(context.getHorizon() + 1));
-    for (int t = 0; t <= context.getHorizon(); ++t)
-    {
-      time_points.push_back(t * context.getTimestep());
-    }
-    solution["time_points"] = time_points;
-    solution["state_trajectory"] = context.X_;
-    solution["control_trajectory"] = context.U_;
-
-    // Add iteration history if requested
-    if (options.return_iteration_info)
-    {
-      solution["history_objective"] = history_objective;
-      solution["history_merit_function"] = history_merit_function;
-      solution["history_step_length_primal"] = history_step_length_primal;
-      solution["history_step_length_dual"] = history_step_length_dual;
-      solution["history_dual_infeasibility"] = history_dual_infeasibility;
-      solution["history_primal_infeasibility"] = history_primal_infeasibility;
-      solution["history_complementary_infeasibility"] = history_complementary_infeasibility;
-      solution["history_barrier_mu"] = history_barrier_mu;
-    }
+    result.setTimePoints(context.getHorizon(), context.getTimestep());
+    result.state_trajectory = context.X_;
+    result.control_trajectory = context.U_;
 
     // Add control gains
-    solution["control_feedback_gains_K"] = K_u_;
+    result.setFeedbackGains(K_u_);
 
     // Final metrics
-    solution["final_regularization"] = context.regularization_;
-    solution["final_barrier_parameter_mu"] = mu_;
-    solution["final_primal_infeasibility"] = context.inf_pr_;
-    solution["final_dual_infeasibility"] = context.inf_du_;
-    solution["final_complementary_infeasibility"] = context.inf_comp_;
+    result.final_regularization = context.regularization_;
+    result.final_barrier_parameter_mu = mu_;
+    result.final_primal_infeasibility = context.inf_pr_;
+    result.final_dual_infeasibility = context.inf_du_;
+    result.final_complementary_infeasibility = context.inf_comp_;
 
     if (options.verbose)
     {
-      printSolutionSummary(solution);
+      printSolutionSummary(result);
     }
-
-
-    return solution;
   }
 
   void MSIPDDPSolver::evaluateTrajectory(CDDP &context)
@@ -561,6 +546,7 @@ namespace cddp
 
     // Set initial state
     context.X_[0] = context.getInitialState();
+    G_.resize(horizon);
 
     // Rollout dynamics and calculate cost
     for (int t = 0; t < horizon; ++t)
@@ -571,15 +557,8 @@ namespace cddp
       // Compute stage cost
       cost += context.getObjective().running_cost(x, u, t);
 
-      // For each constraint, evaluate and store the constraint value
-      const auto &constraint_set = context.getConstraintSet();
-      for (const auto &constraint_pair : constraint_set)
-      {
-        const std::string &constraint_name = constraint_pair.first;
-        Eigen::VectorXd g_val = constraint_pair.second->evaluate(x, u) -
-                                constraint_pair.second->getUpperBound();
-        G_[constraint_name][t] = g_val;
-      }
+      // Evaluate and store the stacked constraint values
+      context.evaluatePathConstraints(x, u, G_[t]);
 
       // Evaluate and store dynamics for multi-shooting
       F_[t] = context.getSystem().getDiscreteDynamics(x, u, t * context.getTimestep());
@@ -606,11 +585,19 @@ namespace cddp
     // We just need to evaluate the cost and constraints
 
     // Initialize constraint storage first
-    const auto &constraint_set = context.getConstraintSet();
-    for (const auto &constraint_pair : constraint_set)
+    G_.resize(horizon);
+
+    const bool controlled_rollout = options.msipddp.use_controlled_rollout;
+    if (!controlled_rollout)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      G_[constraint_name].resize(horizon);
+      // Every shooting segment starts from a given knot, so the dynamics of
+      // the whole horizon are evaluated in one batch
+      const double timestep = context.getTimestep();
+      F_.resize(context.getStateDim(), horizon);
+      context.getSystem().getDiscreteDynamicsBatch(
+          context.X_.matrix().leftCols(horizon), context.U_.matrix(),
+          Eigen::VectorXd::LinSpaced(horizon, 0.0, (horizon - 1) * timestep),
+          F_.matrix());
     }
 
     // Rollout dynamics and calculate cost
@@ -622,20 +609,13 @@ namespace cddp
       // Compute stage cost
       cost += context.getObjective().running_cost(x, u, t);
 
-      // For each constraint, evaluate and store the constraint value
-      for (const auto &constraint_pair : constraint_set)
-      {
-        const std::string &constraint_name = constraint_pair.first;
-        Eigen::VectorXd g_val = constraint_pair.second->evaluate(x, u) -
-                                constraint_pair.second->getUpperBound();
-        G_[constraint_name][t] = g_val;
-      }
+      // Evaluate and store the stacked constraint values
+      context.evaluatePathConstraints(x, u, G_[t]);
 
-      // Evaluate dynamics for multi-shooting
-      F_[t] = context.getSystem().getDiscreteDynamics(x, u, t * context.getTimestep());
-
-      if (options.msipddp.use_controlled_rollout)
+      if (controlled_rollout)
       {
+        // Evaluate dynamics for multi-shooting
+        F_[t] = context.getSystem().getDiscreteDynamics(x, u, t * context.getTimestep());
         context.X_[t + 1] = F_[t];
       }
     }
@@ -651,133 +631,98 @@ namespace cddp
   {
     const CDDPOptions &options = context.getOptions();
     const int horizon = context.getHorizon();
-    const auto &constraint_set = context.getConstraintSet();
+    const int state_dim = context.getStateDim();
+    const int total_dual_dim = context.getPathDualDim();
 
     // Check if we have existing dual/slack variables from previous solve
-    bool has_existing_dual_slack = true;
-    for (const auto &constraint_pair : constraint_set)
-    {
-      const std::string &constraint_name = constraint_pair.first;
-      if (Y_.find(constraint_name) == Y_.end() ||
-          S_.find(constraint_name) == S_.end() ||
-          Y_[constraint_name].size() != static_cast<size_t>(horizon) ||
-          S_[constraint_name].size() != static_cast<size_t>(horizon))
-      {
-        has_existing_dual_slack = false;
-        break;
-      }
-    }
+    bool has_existing_dual_slack =
+        Y_.size() == static_cast<size_t>(horizon) &&
+        S_.size() == static_cast<size_t>(horizon);
 
-    // Initialize/resize gains storage for all constraints
-    k_y_.clear();
-    K_y_.clear();
-    k_s_.clear();
-    K_s_.clear();
+    // Resize storage; existing buffers are reused
+    if (!has_existing_dual_slack)
+    {
+      Y_.resize(horizon);
+      S_.resize(horizon);
+    }
+    k_y_.resize(horizon);
+    K_y_.resize(horizon);
+    k_s_.resize(horizon);
+    K_s_.resize(horizon);
 
-    for (const auto &constraint_pair : constraint_set)
+    for (int t = 0; t < horizon; ++t)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      int dual_dim = constraint_pair.second->getDualDim();
+      // Use the already evaluated constraint values from
+      // evaluateTrajectoryWarmStart
+      const Eigen::VectorXd &g_val = G_[t];
 
-      // Ensure proper sizing
-      if (!has_existing_dual_slack)
+      // Stacked layout changed (or no previous solve): reinitialize this knot
+      const bool compatible = has_existing_dual_slack &&
+                              Y_[t].size() == total_dual_dim &&
+                              S_[t].size() == total_dual_dim;
+      if (!compatible)
       {
-        Y_[constraint_name].resize(horizon);
-        S_[constraint_name].resize(horizon);
+        Y_[t].resize(total_dual_dim);
+        S_[t].resize(total_dual_dim);
       }
 
-      k_y_[constraint_name].resize(horizon);
-      K_y_[constraint_name].resize(horizon);
-      k_s_[constraint_name].resize(horizon);
-      K_s_[constraint_name].resize(horizon);
-
-      for (int t = 0; t < horizon; ++t)
+      for (const auto &block : context.getPathConstraintBlocks())
       {
-        // Use the already evaluated constraint values from
-        // evaluateTrajectoryWarmStart
-        const Eigen::VectorXd &g_val = G_[constraint_name][t];
-
-        bool need_reinit = false;
-        Eigen::VectorXd y_current, s_current;
+        auto y_current = Y_[t].segment(block.offset, block.dim);
+        auto s_current = S_[t].segment(block.offset, block.dim);
+        const auto g_block = g_val.segment(block.offset, block.dim);
 
-        if (has_existing_dual_slack)
+        bool need_reinit = !compatible;
+        if (!need_reinit)
         {
-          y_current = Y_[constraint_name][t];
-          s_current = S_[constraint_name][t];
-
-          // Check if existing dual/slack variables are feasible and compatible
-          if (y_current.size() != dual_dim || s_current.size() != dual_dim)
+          // Check feasibility conditions
+          for (int i = 0; i < block.dim; ++i)
           {
-            need_reinit = true;
-          }
-          else
-          {
-            // Check feasibility conditions
-            for (int i = 0; i < dual_dim; ++i)
+            // Check positivity: y_i > 0 and s_i > 0
+            if (y_current(i) <= 1e-12 || s_current(i) <= 1e-12)
+            {
+              need_reinit = true;
+              break;
+            }
+
+            // Check if constraint is severely violated (slack should be
+            // reasonable)
+            double required_slack =
+                std::max(options.msipddp.slack_var_init_scale, -g_block(i));
+            if (s_current(i) < 0.1 * required_slack)
             {
-              // Check positivity: y_i > 0 and s_i > 0
-              if (y_current(i) <= 1e-12 || s_current(i) <= 1e-12)
-              {
-                need_reinit = true;
-                break;
-              }
-
-              // Check if constraint is severely violated (slack should be
-              // reasonable)
-              double required_slack =
-                  std::max(options.msipddp.slack_var_init_scale, -g_val(i));
-              if (s_current(i) < 0.1 * required_slack)
-              {
-                need_reinit = true;
-                break;
-              }
+              need_reinit = true;
+              break;
             }
           }
         }
-        else
-        {
-          need_reinit = true;
-        }
 
         if (need_reinit)
         {
           // Use the same initialization as cold start for consistency
-          Eigen::VectorXd s_init = Eigen::VectorXd::Zero(dual_dim);
-          Eigen::VectorXd y_init = Eigen::VectorXd::Zero(dual_dim);
-
-          for (int i = 0; i < dual_dim; ++i)
+          for (int i = 0; i < block.dim; ++i)
           {
             // Initialize s_i = max(slack_scale, -g_i) to ensure s_i > 0 (same as
             // cold start)
-            s_init(i) = std::max(options.msipddp.slack_var_init_scale, -g_val(i));
+            s_current(i) = std::max(options.msipddp.slack_var_init_scale, -g_block(i));
 
             // Initialize y_i = mu / s_i to satisfy s_i * y_i = mu (same as cold
             // start)
-            if (s_init(i) < 1e-12)
-            {
-              y_init(i) = mu_ / 1e-12;
-            }
-            else
-            {
-              y_init(i) = mu_ / s_init(i);
-            }
+            double y_init = (s_current(i) < 1e-12) ? mu_ / 1e-12 : mu_ / s_current(i);
+
             // Clamp dual variable (same as cold start)
-            y_init(i) = std::max(
+            y_current(i) = std::max(
                 options.msipddp.dual_var_init_scale * 0.01,
-                std::min(y_init(i), options.msipddp.dual_var_init_scale * 100.0));
+                std::min(y_init, options.msipddp.dual_var_init_scale * 100.0));
           }
-          Y_[constraint_name][t] = y_init;
-          S_[constraint_name][t] = s_init;
         }
-
-        // Always initialize gains to zero
-        k_y_[constraint_name][t] = Eigen::VectorXd::Zero(dual_dim);
-        K_y_[constraint_name][t] =
-            Eigen::MatrixXd::Zero(dual_dim, context.getStateDim());
-        k_s_[constraint_name][t] = Eigen::VectorXd::Zero(dual_dim);
-        K_s_[constraint_name][t] =
-            Eigen::MatrixXd::Zero(dual_dim, context.getStateDim());
       }
+
+      // Always initialize gains to zero
+      k_y_[t].setZero(total_dual_dim);
+      K_y_[t].setZero(total_dual_dim, state_dim);
+      k_s_[t].setZero(total_dual_dim);
+      K_s_[t].setZero(total_dual_dim, state_dim);
     }
 
     // Initialize or preserve costate variables for MSIPDDP
@@ -816,63 +761,54 @@ namespace cddp
   {
     const CDDPOptions &options = context.getOptions();
     const int horizon = context.getHorizon();
-    const auto &constraint_set = context.getConstraintSet();
+    const int state_dim = context.getStateDim();
+    const int total_dual_dim = context.getPathDualDim();
+
+    G_.resize(horizon);
+    Y_.resize(horizon);
+    S_.resize(horizon);
+    k_y_.resize(horizon);
+    K_y_.resize(horizon);
+    k_s_.resize(horizon);
+    K_s_.resize(horizon);
 
-    // Initialize dual and slack variables for each constraint
-    for (const auto &constraint_pair : constraint_set)
+    // Initialize dual and slack variables for all constraints at once
+    for (int t = 0; t < horizon; ++t)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      int dual_dim = constraint_pair.second->getDualDim();
+      // Evaluate constraint g(x,u) = evaluate(x,u) - getUpperBound()
+      context.evaluatePathConstraints(context.X_[t], context.U_[t], G_[t]);
+      const Eigen::VectorXd &g_val = G_[t];
 
-      G_[constraint_name].resize(horizon);
-      Y_[constraint_name].resize(horizon);
-      S_[constraint_name].resize(horizon);
-      k_y_[constraint_name].resize(horizon);
-      K_y_[constraint_name].resize(horizon);
-      k_s_[constraint_name].resize(horizon);
-      K_s_[constraint_name].resize(horizon);
+      Eigen::VectorXd &s_init = S_[t];
+      Eigen::VectorXd &y_init = Y_[t];
+      s_init.resize(total_dual_dim);
+      y_init.resize(total_dual_dim);
 
-      for (int t = 0; t < horizon; ++t)
+      for (int i = 0; i < total_dual_dim; ++i)
       {
-        // Evaluate constraint g(x,u) = evaluate(x,u) - getUpperBound()
-        Eigen::VectorXd g_val =
-            constraint_pair.second->evaluate(context.X_[t], context.U_[t]) -
-            constraint_pair.second->getUpperBound();
-        G_[constraint_name][t] = g_val;
-
-        Eigen::VectorXd s_init = Eigen::VectorXd::Zero(dual_dim);
-        Eigen::VectorXd y_init = Eigen::VectorXd::Zero(dual_dim);
+        // Initialize s_i = max(slack_scale, -g_i) to ensure s_i > 0
+        s_init(i) = std::max(options.msipddp.slack_var_init_scale, -g_val(i));
 
-        for (int i = 0; i < dual_dim; ++i)
+        // Initialize y_i = mu / s_i to satisfy s_i * y_i = mu
+        if (s_init(i) < 1e-12)
         {
-          // Initialize s_i = max(slack_scale, -g_i) to ensure s_i > 0
-          s_init(i) = std::max(options.msipddp.slack_var_init_scale, -g_val(i));
-
-          // Initialize y_i = mu / s_i to satisfy s_i * y_i = mu
-          if (s_init(i) < 1e-12)
-          {
-            y_init(i) = mu_ / 1e-12;
-          }
-          else
-          {
-            y_init(i) = mu_ / s_init(i);
-          }
-          // Clamp dual variable
-          y_init(i) = std::max(
-              options.msipddp.dual_var_init_scale * 0.01,
-              std::min(y_init(i), options.msipddp.dual_var_init_scale * 100.0));
+          y_init(i) = mu_ / 1e-12;
+        }
+        else
+        {
+          y_init(i) = mu_ / s_init(i);
         }
-        Y_[constraint_name][t] = y_init;
-        S_[constraint_name][t] = s_init;
-
-        // Initialize gains to zero
-        k_y_[constraint_name][t] = Eigen::VectorXd::Zero(dual_dim);
-        K_y_[constraint_name][t] =
-            Eigen::MatrixXd::Zero(dual_dim, context.getStateDim());
-        k_s_[constraint_name][t] = Eigen::VectorXd::Zero(dual_dim);
-        K_s_[constraint_name][t] =
-            Eigen::MatrixXd::Zero(dual_dim, context.getStateDim());
+        // Clamp dual variable
+        y_init(i) = std::max(
+            options.msipddp.dual_var_init_scale * 0.01,
+            std::min(y_init(i), options.msipddp.dual_var_init_scale * 100.0));
       }
+
+      // Initialize gains to zero
+      k_y_[t].setZero(total_dual_dim);
+      K_y_[t].setZero(total_dual_dim, state_dim);
+      k_s_[t].setZero(total_dual_dim);
+      K_s_[t].setZero(total_dual_dim, state_dim);
     }
 
     // Initialize costate variables for MSIPDDP
@@ -906,29 +842,25 @@ namespace cddp
     {
       for (int t = 0; t < context.getHorizon(); ++t)
       {
-        for (const auto &constraint_pair : constraint_set)
-        {
-          const std::string &constraint_name = constraint_pair.first;
-          const Eigen::VectorXd &s_vec = S_[constraint_name][t];
-          const Eigen::VectorXd &g_vec = G_[constraint_name][t];
-          const Eigen::VectorXd &y_vec = Y_[constraint_name][t];
+        const Eigen::VectorXd &s_vec = S_[t];
+        const Eigen::VectorXd &g_vec = G_[t];
+        const Eigen::VectorXd &y_vec = Y_[t];
 
-          // Add log-barrier term
-          merit_function -= mu_ * s_vec.array().log().sum();
+        // Add log-barrier term
+        merit_function -= mu_ * s_vec.array().log().sum();
 
-          // Compute primal residual vector
-          Eigen::VectorXd primal_residual = g_vec + s_vec;
+        // Compute primal residual vector
+        Eigen::VectorXd primal_residual = g_vec + s_vec;
 
-          // inf_pr: infinity norm (largest absolute residual)
-          inf_pr = std::max(inf_pr, primal_residual.lpNorm<Eigen::Infinity>());
+        // inf_pr: infinity norm (largest absolute residual)
+        inf_pr = std::max(inf_pr, primal_residual.lpNorm<Eigen::Infinity>());
 
-          // Filter constraint violation: l1 norm (sum of residuals)
-          filter_constraint_violation += primal_residual.lpNorm<1>();
+        // Filter constraint violation: l1 norm (sum of residuals)
+        filter_constraint_violation += primal_residual.lpNorm<1>();
 
-          // Compute complementary infeasibility: ||y .* s - mu||_inf
-          Eigen::VectorXd complementary_residual = y_vec.cwiseProduct(s_vec).array() - mu_;
-          inf_comp = std::max(inf_comp, complementary_residual.lpNorm<Eigen::Infinity>());
-        }
+        // Compute complementary infeasibility: ||y .* s - mu||_inf
+        Eigen::VectorXd complementary_residual = y_vec.cwiseProduct(s_vec).array() - mu_;
+        inf_comp = std::max(inf_comp, complementary_residual.lpNorm<Eigen::Infinity>());
 
         // Add defect residual calculation 
         if (t < static_cast<int>(F_.size()) && (t + 1) < static_cast<int>(context.X_.size()))
@@ -1103,14 +1035,17 @@ namespace cddp
     const CDDPOptions &options = context.getOptions();
     const int horizon = context.getHorizon();
     const int state_dim = context.getStateDim();
+    const int control_dim = context.getControlDim();
     const double timestep = context.getTimestep();
 
-    // Resize storage
+    // Resize storage; the Jacobians are written in place below
     F_x_.resize(horizon);
     F_u_.resize(horizon);
-    F_xx_.resize(horizon);
-    F_uu_.resize(horizon);
-    F_ux_.resize(horizon);
+    for (int t = 0; t < horizon; ++t)
+    {
+      F_x_[t].resize(state_dim, state_dim);
+      F_u_[t].resize(state_dim, control_dim);
+    }
 
     // Use parallel computation for larger horizons
     const int MIN_HORIZON_FOR_PARALLEL = 50;
@@ -1124,28 +1059,9 @@ namespace cddp
         const Eigen::VectorXd &x = context.X_[t];
         const Eigen::VectorXd &u = context.U_[t];
 
-        // Compute jacobians
-        const auto [Fx, Fu] =
-            context.getSystem().getJacobians(x, u, t * timestep);
-        F_x_[t] = Fx;
-        F_u_[t] = Fu;
-
-        // Compute hessians if not using iLQR
-        if (!options.use_ilqr)
-        {
-          const auto hessians =
-              context.getSystem().getHessians(x, u, t * timestep);
-          F_xx_[t] = std::get<0>(hessians);
-          F_uu_[t] = std::get<1>(hessians);
-          F_ux_[t] = std::get<2>(hessians);
-        }
-        else
-        {
-          // Initialize empty hessians for iLQR
-          F_xx_[t] = std::vector<Eigen::MatrixXd>();
-          F_uu_[t] = std::vector<Eigen::MatrixXd>();
-          F_ux_[t] = std::vector<Eigen::MatrixXd>();
-        }
+        // Discrete dynamics Jacobians, exact for the system's integrator
+        context.getSystem().evalDiscreteJacobiansInto(x, u, t * timestep,
+                                                      F_x_[t], F_u_[t]);
       }
     }
     else
@@ -1166,7 +1082,7 @@ namespace cddp
         if (start_t >= horizon)
           break;
 
-        futures.push_back(std::async(std::launch::async,
+        futures.push_back(context.getThreadPool().submit(
                                      [this, &context, &options, start_t, end_t, timestep]()
                                      {
             // Process chunk of time steps
@@ -1174,25 +1090,9 @@ namespace cddp
               const Eigen::VectorXd &x = context.X_[t];
               const Eigen::VectorXd &u = context.U_[t];
 
-              // Compute jacobians
-              const auto [Fx, Fu] =
-                  context.getSystem().getJacobians(x, u, t * timestep);
-              F_x_[t] = Fx;
-              F_u_[t] = Fu;
-
-              // Compute hessians if not using iLQR
-              if (!options.use_ilqr) {
-                const auto hessians =
-                    context.getSystem().getHessians(x, u, t * timestep);
-                F_xx_[t] = std::get<0>(hessians);
-                F_uu_[t] = std::get<1>(hessians);
-                F_ux_[t] = std::get<2>(hessians);
-              } else {
-                // Initialize empty hessians for iLQR
-                F_xx_[t] = std::vector<Eigen::MatrixXd>();
-                F_uu_[t] = std::vector<Eigen::MatrixXd>();
-                F_ux_[t] = std::vector<Eigen::MatrixXd>();
-              }
+              // Discrete dynamics Jacobians, exact for the system's integrator
+              context.getSystem().evalDiscreteJacobiansInto(
+                  x, u, t * timestep, F_x_[t], F_u_[t]);
             } }));
       }
 
@@ -1223,41 +1123,76 @@ namespace cddp
   {
     const CDDPOptions &options = context.getOptions();
     const int horizon = context.getHorizon();
-    const auto &constraint_set = context.getConstraintSet();
-
-    // Clear and resize storage
-    G_x_.clear();
-    G_u_.clear();
-    G_xx_.clear();
-    G_uu_.clear();
-    G_ux_.clear();
+    const auto &blocks = context.getPathConstraintBlocks();
 
     // If no constraints, return early
-    if (constraint_set.empty())
+    if (blocks.empty())
     {
+      G_x_.clear();
+      G_u_.clear();
+      G_xx_.clear();
+      G_uu_.clear();
+      G_ux_.clear();
       return;
     }
 
-    // Initialize storage for each constraint only if not already allocated
-    for (const auto &constraint_pair : constraint_set)
-    {
-      const std::string &constraint_name = constraint_pair.first;
-      if (G_x_.find(constraint_name) == G_x_.end() || G_x_[constraint_name].size() != horizon) {
-        G_x_[constraint_name].resize(horizon);
-        G_u_[constraint_name].resize(horizon);
-        // Pre-allocate matrices with correct dimensions
-        int state_dim = context.getStateDim();
-        int control_dim = context.getControlDim();
-        int constraint_dim = constraint_pair.second->getDualDim();
-        for (int t = 0; t < horizon; ++t) {
-          G_x_[constraint_name][t] = Eigen::MatrixXd::Zero(constraint_dim, state_dim);
-          G_u_[constraint_name][t] = Eigen::MatrixXd::Zero(constraint_dim, control_dim);
+    // Stacked Jacobians: one (total_dual_dim x n) matrix per knot. Hessians
+    // are indexed by the stacked dual index.
+    const int total_dual_dim = context.getPathDualDim();
+    const int state_dim = context.getStateDim();
+    const int control_dim = context.getControlDim();
+    G_x_.resize(horizon);
+    G_u_.resize(horizon);
+    G_xx_.resize(horizon);
+    G_uu_.resize(horizon);
+    G_ux_.resize(horizon);
+    for (int t = 0; t < horizon; ++t)
+    {
+      G_x_[t].resize(total_dual_dim, state_dim);
+      G_u_[t].resize(total_dual_dim, control_dim);
+      G_xx_[t].resize(total_dual_dim);
+      G_uu_[t].resize(total_dual_dim);
+      G_ux_[t].resize(total_dual_dim);
+    }
+
+    // Fill every constraint block of one knot
+    auto evaluate_knot = [this, &context, &blocks, state_dim, control_dim](
+                             int t, const Eigen::VectorXd &x,
+                             const Eigen::VectorXd &u, bool with_hessians)
+    {
+      for (const auto &block : blocks)
+      {
+        context.evaluatePathConstraintJacobians(
+            block, x, u, G_x_[t].middleRows(block.offset, block.dim),
+            G_u_[t].middleRows(block.offset, block.dim));
+
+        if (with_hessians)
+        {
+          const auto Gxx = block.constraint->getStateHessian(x, u);
+          const auto Guu = block.constraint->getControlHessian(x, u);
+          const auto Gux = block.constraint->getCrossHessian(x, u);
+
+          // Box constraints stack [-g; g] and only return the Hessians of
+          // g, all zero, which may come as a single matrix
+          const int mirrored = block.dim - block.value_dim;
+          for (int i = 0; i < block.dim; ++i)
+          {
+            const int k = i < mirrored ? i : i - mirrored;
+            if (k >= static_cast<int>(Gxx.size()))
+            {
+              G_xx_[t][block.offset + i].setZero(state_dim, state_dim);
+              G_uu_[t][block.offset + i].setZero(control_dim, control_dim);
+              G_ux_[t][block.offset + i].setZero(control_dim, state_dim);
+              continue;
+            }
+            const double sign = i < mirrored ? -1.0 : 1.0;
+            G_xx_[t][block.offset + i] = sign * Gxx[k];
+            G_uu_[t][block.offset + i] = sign * Guu[k];
+            G_ux_[t][block.offset + i] = sign * Gux[k];
+          }
         }
       }
-      G_xx_[constraint_name].resize(horizon);
-      G_uu_[constraint_name].resize(horizon);
-      G_ux_[constraint_name].resize(horizon);
-    }
+    };
 
     // Threshold for when parallelization is worth it - increased for better
     // performance
@@ -1270,25 +1205,8 @@ namespace cddp
       // Single-threaded computation
       for (int t = 0; t < horizon; ++t)
       {
-        const Eigen::VectorXd &x = context.X_[t];
-        const Eigen::VectorXd &u = context.U_[t];
-
-        for (const auto &constraint_pair : constraint_set)
-        {
-          const std::string &constraint_name = constraint_pair.first;
-          G_x_[constraint_name][t] =
-              constraint_pair.second->getStateJacobian(x, u);
-          G_u_[constraint_name][t] =
-              constraint_pair.second->getControlJacobian(x, u);
-
-          // Compute constraint hessians if not using iLQR
-          if (!options.use_ilqr)
-          {
-            G_xx_[constraint_name][t] = constraint_pair.second->getStateHessian(x, u);
-            G_uu_[constraint_name][t] = constraint_pair.second->getControlHessian(x, u);
-            G_ux_[constraint_name][t] = constraint_pair.second->getCrossHessian(x, u);
-          }
-        }
+        // Compute constraint hessians if not using iLQR
+        evaluate_knot(t, context.X_[t], context.U_[t], !options.use_ilqr);
       }
     }
     else
@@ -1312,30 +1230,14 @@ namespace cddp
           break;
 
         futures.push_back(
-            std::async(std::launch::async, [this, &context, &constraint_set,
+            context.getThreadPool().submit([&context, &evaluate_knot,
                                             start_t, end_t]()
                        {
             // Process a chunk of time steps
             const CDDPOptions &options = context.getOptions();
             for (int t = start_t; t < end_t; ++t) {
-              const Eigen::VectorXd &x = context.X_[t];
-              const Eigen::VectorXd &u = context.U_[t];
-
-              for (const auto &constraint_pair : constraint_set) {
-                const std::string &constraint_name = constraint_pair.first;
-                G_x_[constraint_name][t] =
-                    constraint_pair.second->getStateJacobian(x, u);
-                G_u_[constraint_name][t] =
-                    constraint_pair.second->getControlJacobian(x, u);
-                
-                // Compute constraint hessians if not using iLQR
-                if (!options.use_ilqr)
-                {
-                  G_xx_[constraint_name][t] = constraint_pair.second->getStateHessian(x, u);
-                  G_uu_[constraint_name][t] = constraint_pair.second->getControlHessian(x, u);
-                  G_ux_[constraint_name][t] = constraint_pair.second->getCrossHessian(x, u);
-                }
-              }
+              // Compute constraint hessians if not using iLQR
+              evaluate_knot(t, context.X_[t], context.U_[t], !options.use_ilqr);
             } }));
       }
 
@@ -1370,13 +1272,16 @@ namespace cddp
     const int horizon = context.getHorizon();
     const double timestep = context.getTimestep();
     const auto &constraint_set = context.getConstraintSet();
-    const int total_dual_dim = getTotalDualDim(context);
+    const int total_dual_dim = context.getPathDualDim();
 
-    // Pre-compute dynamics jacobians and hessians for all time steps
-    precomputeDynamicsDerivatives(context);
-
-    // Pre-compute constraint gradients for all time steps and constraints
-    precomputeConstraintGradients(context);
+    // Derivatives depend only on X_/U_, which regularization retries leave
+    // unchanged
+    if (!derivatives_valid_)
+    {
+      precomputeDynamicsDerivatives(context);
+      precomputeConstraintGradients(context);
+      derivatives_valid_ = true;
+    }
 
     // Terminal cost and its derivatives
     Eigen::VectorXd V_x =
@@ -1397,12 +1302,15 @@ namespace cddp
     {
       for (int t = horizon - 1; t >= 0; --t)
       {
+        if (context.isCancellationRequested())
+          return false;
+
         const Eigen::VectorXd &x = context.X_[t];
         const Eigen::VectorXd &u = context.U_[t];
 
         // MSIPDDP: Access costate variables and compute defect
         const Eigen::VectorXd &lambda = Lambda_[t];
-        const Eigen::VectorXd &f = F_[t];
+        const auto f = F_[t]; // view into the contiguous dynamics storage
         Eigen::VectorXd &d = workspace_.d_vectors[t];
         d.setZero();
         if ((t + 1) < static_cast<int>(context.X_.size()))
@@ -1410,15 +1318,9 @@ namespace cddp
           d = f - context.X_[t + 1]; // defect: dynamics mismatch
         }
 
-        // Use pre-computed dynamics Jacobians
-        const Eigen::MatrixXd &Fx = F_x_[t];
-        const Eigen::MatrixXd &Fu = F_u_[t];
-        
-        // Use pre-allocated workspace matrices
-        Eigen::MatrixXd &A = workspace_.A_matrices[t];
-        Eigen::MatrixXd &B = workspace_.B_matrices[t];
-        A.noalias() = Eigen::MatrixXd::Identity(state_dim, state_dim) + timestep * Fx;
-        B.noalias() = timestep * Fu;
+        // Use pre-computed discrete dynamics Jacobians
+        const Eigen::MatrixXd &A = F_x_[t];
+        const Eigen::MatrixXd &B = F_u_[t];
 
         // Cost & derivatives
         auto [l_x, l_u] = context.getObjective().getRunningCostGradients(x, u, t);
@@ -1441,17 +1343,12 @@ namespace cddp
         // Add state hessian term if not using iLQR
         if (!options.use_ilqr)
         {
-          // Use pre-computed hessians
-          const auto &Fxx = F_xx_[t];
-          const auto &Fuu = F_uu_[t];
-          const auto &Fux = F_ux_[t];
-
-          for (int i = 0; i < state_dim; ++i)
-          {
-            Q_xx += timestep * lambda(i) * Fxx[i];
-            Q_ux += timestep * lambda(i) * Fux[i];
-            Q_uu += timestep * lambda(i) * Fuu[i];
-          }
+          // Second-order dynamics terms, contracted with lambda
+          const auto [Fxx, Fuu, Fux] =
+              context.getSystem().getHessianContraction(x, u, lambda, t * timestep);
+          Q_xx += timestep * Fxx;
+          Q_ux += timestep * Fux;
+          Q_uu += timestep * Fuu;
         }
 
         // Apply standard DDP regularization
@@ -1523,12 +1420,15 @@ namespace cddp
       // Constrained backward recursion
       for (int t = horizon - 1; t >= 0; --t)
       {
+        if (context.isCancellationRequested())
+          return false;
+
         const Eigen::VectorXd &x = context.X_[t];
         const Eigen::VectorXd &u = context.U_[t];
 
         // MSIPDDP: Access costate variables and compute defect
         const Eigen::VectorXd &lambda = Lambda_[t];
-        const Eigen::VectorXd &f = F_[t];
+        const auto f = F_[t]; // view into the contiguous dynamics storage
         Eigen::VectorXd &d = workspace_.d_vectors[t];
         d.setZero();
         if ((t + 1) < static_cast<int>(context.X_.size()))
@@ -1536,43 +1436,16 @@ namespace cddp
           d = f - context.X_[t + 1]; // defect: dynamics mismatch
         }
 
-        // Use pre-computed dynamics Jacobians
-        const Eigen::MatrixXd &Fx = F_x_[t];
-        const Eigen::MatrixXd &Fu = F_u_[t];
-        
-        // Use pre-allocated workspace matrices
-        Eigen::MatrixXd &A = workspace_.A_matrices[t];
-        Eigen::MatrixXd &B = workspace_.B_matrices[t];
-        A.noalias() = Eigen::MatrixXd::Identity(state_dim, state_dim) + timestep * Fx;
-        B.noalias() = timestep * Fu;
-
-        // Use pre-allocated workspace for constraint variables
-        Eigen::VectorXd &y = workspace_.y_combined;
-        Eigen::VectorXd &s = workspace_.s_combined;
-        Eigen::VectorXd &g = workspace_.g_combined;
-        Eigen::MatrixXd &Q_yu = workspace_.Q_yu_combined;
-        Eigen::MatrixXd &Q_yx = workspace_.Q_yx_combined;
-
-        int offset = 0;
-        for (const auto &constraint_pair : constraint_set)
-        {
-          const std::string &constraint_name = constraint_pair.first;
-          int dual_dim = constraint_pair.second->getDualDim();
-
-          const Eigen::VectorXd &y_vec = Y_[constraint_name][t];
-          const Eigen::VectorXd &s_vec = S_[constraint_name][t];
-          const Eigen::VectorXd &g_vec = G_[constraint_name][t];
-          const Eigen::MatrixXd &g_x = G_x_[constraint_name][t];
-          const Eigen::MatrixXd &g_u = G_u_[constraint_name][t];
-
-          y.segment(offset, dual_dim) = y_vec;
-          s.segment(offset, dual_dim) = s_vec;
-          g.segment(offset, dual_dim) = g_vec;
-          Q_yx.block(offset, 0, dual_dim, state_dim) = g_x;
-          Q_yu.block(offset, 0, dual_dim, control_dim) = g_u;
-
-          offset += dual_dim;
-        }
+        // Use pre-computed discrete dynamics Jacobians
+        const Eigen::MatrixXd &A = F_x_[t];
+        const Eigen::MatrixXd &B = F_u_[t];
+
+        // Constraint variables are already stacked per knot
+        const Eigen::VectorXd &y = Y_[t];
+        const Eigen::VectorXd &s = S_[t];
+        const Eigen::VectorXd &g = G_[t];
+        const Eigen::MatrixXd &Q_yx = G_x_[t];
+        const Eigen::MatrixXd &Q_yu = G_u_[t];
 
         // Cost & derivatives
         auto [l_x, l_u] = context.getObjective().getRunningCostGradients(x, u, t);
@@ -1595,45 +1468,31 @@ namespace cddp
         // Add state hessian term if not using iLQR
         if (!options.use_ilqr)
         {
-          // Use pre-computed hessians
-          const auto &Fxx = F_xx_[t];
-          const auto &Fuu = F_uu_[t];
-          const auto &Fux = F_ux_[t];
-
-          for (int i = 0; i < state_dim; ++i)
-          {
-            Q_xx += timestep * lambda(i) * Fxx[i];
-            Q_ux += timestep * lambda(i) * Fux[i];
-            Q_uu += timestep * lambda(i) * Fuu[i];
-          }
+          // Second-order dynamics terms, contracted with lambda
+          const auto [Fxx, Fuu, Fux] =
+              context.getSystem().getHessianContraction(x, u, lambda, t * timestep);
+          Q_xx += timestep * Fxx;
+          Q_ux += timestep * Fux;
+          Q_uu += timestep * Fuu;
 
           // Add constraint hessian terms
-          int offset = 0;
-          for (const auto &constraint_pair : constraint_set)
-          {
-            const std::string &constraint_name = constraint_pair.first;
-            int dual_dim = constraint_pair.second->getDualDim();
-
-            const auto &G_xx = G_xx_[constraint_name][t];
-            const auto &G_uu = G_uu_[constraint_name][t];
-            const auto &G_ux = G_ux_[constraint_name][t];
+          const auto &G_xx = G_xx_[t];
+          const auto &G_uu = G_uu_[t];
+          const auto &G_ux = G_ux_[t];
 
-            for (int i = 0; i < dual_dim; ++i)
-            {
-              Q_xx += y(offset + i) * G_xx[i];
-              Q_ux += y(offset + i) * G_ux[i];
-              Q_uu += y(offset + i) * G_uu[i];
-            }
-            offset += dual_dim;
+          for (int i = 0; i < total_dual_dim; ++i)
+          {
+            Q_xx += y(i) * G_xx[i];
+            Q_ux += y(i) * G_ux[i];
+            Q_uu += y(i) * G_uu[i];
           }
         }
 
-        // Optimize diagonal matrix operations
-        Eigen::MatrixXd &YSinv = workspace_.YSinv;
-        YSinv.setZero();
-        for (int i = 0; i < total_dual_dim; ++i) {
-          YSinv(i, i) = y(i) / s(i);
-        }
+        // Y * S^{-1} is diagonal; keep it as a vector and scale rows
+        Eigen::VectorXd &YSinv = workspace_.YSinv;
+        YSinv = y.cwiseQuotient(s);
+        workspace_.YSinv_Q_yx.noalias() = YSinv.asDiagonal() * Q_yx;
+        workspace_.YSinv_Q_yu.noalias() = YSinv.asDiagonal() * Q_yu;
 
         // Residuals
         Eigen::VectorXd primal_residual = g + s;                                  // primal infeasibility
@@ -1645,7 +1504,7 @@ namespace cddp
         Q_uu_reg = 0.5 * (Q_uu_reg + Q_uu_reg.transpose()); // symmetrize
         
         // Add constraint contribution
-        Q_uu_reg.noalias() += Q_yu.transpose() * YSinv * Q_yu;
+        Q_uu_reg.noalias() += Q_yu.transpose() * workspace_.YSinv_Q_yu;
         
         // Apply standard DDP regularization
         Q_uu_reg.diagonal().array() += context.regularization_;
@@ -1669,7 +1528,8 @@ namespace cddp
         }
         bigRHS.col(0).noalias() = Q_u + Q_yu.transpose() * S_inv_rhat;
         // Compute M = Q_ux + Q_yu.transpose() * YSinv * Q_yx efficiently
-        bigRHS.rightCols(state_dim).noalias() = Q_ux + Q_yu.transpose() * YSinv * Q_yx;
+        bigRHS.rightCols(state_dim) = Q_ux;
+        bigRHS.rightCols(state_dim).noalias() += Q_yu.transpose() * workspace_.YSinv_Q_yx;
 
         Eigen::MatrixXd kK = -ldlt.solve(bigRHS);
 
@@ -1685,28 +1545,15 @@ namespace cddp
         K_u_[t] = K_u;
 
         // Compute gains for constraints efficiently
-        Eigen::VectorXd k_y(total_dual_dim);
+        Eigen::VectorXd &k_y = k_y_[t];
         Eigen::VectorXd temp = Q_yu * k_u;
+        k_y.resize(total_dual_dim);
         for (int i = 0; i < total_dual_dim; ++i) {
           k_y(i) = (rhat(i) + y(i) * temp(i)) / s(i);
         }
-        Eigen::MatrixXd K_y = YSinv * (Q_yx + Q_yu * K_u);
-        Eigen::VectorXd k_s = -primal_residual - temp;
-        Eigen::MatrixXd K_s = -Q_yx - Q_yu * K_u;
-
-        offset = 0;
-        for (const auto &constraint_pair : constraint_set)
-        {
-          const std::string &constraint_name = constraint_pair.first;
-          int dual_dim = constraint_pair.second->getDualDim();
-
-          k_y_[constraint_name][t] = k_y.segment(offset, dual_dim);
-          K_y_[constraint_name][t] = K_y.block(offset, 0, dual_dim, state_dim);
-          k_s_[constraint_name][t] = k_s.segment(offset, dual_dim);
-          K_s_[constraint_name][t] = K_s.block(offset, 0, dual_dim, state_dim);
-
-          offset += dual_dim;
-        }
+        K_y_[t].noalias() = YSinv.asDiagonal() * (Q_yx + Q_yu * K_u);
+        k_s_[t] = -primal_residual - temp;
+        K_s_[t] = -Q_yx - Q_yu * K_u;
 
         // MSIPDDP: Compute costate gains for multi-shooting
         k_lambda_[t] = -lambda + V_x + V_xx * d;
@@ -1716,9 +1563,9 @@ namespace cddp
         // Update Q expansions efficiently
         Q_u.noalias() += Q_yu.transpose() * S_inv_rhat;
         Q_x.noalias() += Q_yx.transpose() * S_inv_rhat;
-        Q_xx.noalias() += Q_yx.transpose() * YSinv * Q_yx;
-        Q_ux.noalias() += Q_yx.transpose() * YSinv * Q_yu;
-        Q_uu.noalias() += Q_yu.transpose() * YSinv * Q_yu;
+        Q_xx.noalias() += Q_yx.transpose() * workspace_.YSinv_Q_yx;
+        Q_ux.noalias() += Q_yu.transpose() * workspace_.YSinv_Q_yx;
+        Q_uu.noalias() += Q_yu.transpose() * workspace_.YSinv_Q_yu;
 
         // Update cost improvement
         dV_[0] += k_u.dot(Q_u);
@@ -1790,7 +1637,7 @@ namespace cddp
       for (double alpha_pr : context.alphas_)
       {
         futures.push_back(
-            std::async(std::launch::async, [this, &context, alpha_pr]()
+            context.getThreadPool().submit([this, &context, alpha_pr]()
                        { return forwardPass(context, alpha_pr); }));
       }
 
@@ -1832,6 +1679,8 @@ namespace cddp
     result.cost = std::numeric_limits<double>::infinity();
     result.merit_function = std::numeric_limits<double>::infinity();
     result.alpha_pr = alpha;
+    if (context.isCancellationRequested())
+      return result;
 
     const int horizon = context.getHorizon();
     const double tau =
@@ -1845,9 +1694,9 @@ namespace cddp
     // Initialize trajectories for forward pass
     std::vector<Eigen::VectorXd> F_new = F_;
     std::vector<Eigen::VectorXd> Lambda_new = Lambda_;
-    std::map<std::string, std::vector<Eigen::VectorXd>> Y_new = Y_;
-    std::map<std::string, std::vector<Eigen::VectorXd>> S_new = S_;
-    std::map<std::string, std::vector<Eigen::VectorXd>> G_new = G_;
+    std::vector<Eigen::VectorXd> Y_new = Y_;
+    std::vector<Eigen::VectorXd> S_new = S_;
+    std::vector<Eigen::VectorXd> G_new = G_;
 
     double cost_new = 0.0;
     double merit_function_new = 0.0;
@@ -1894,11 +1743,9 @@ namespace cddp
           else if (options.msipddp.rollout_type == "hybrid")
           {
             // Hybrid rollout: Linear approximation + defect correction
-            const auto [Fx, Fu] = context.getSystem().getJacobians(
-                context.X_[t], context.U_[t], t * context.getTimestep());
-            const double timestep = context.getTimestep();
-            Eigen::MatrixXd A = Eigen::MatrixXd::Identity(context.getStateDim(), context.getStateDim()) + timestep * Fx;
-            Eigen::MatrixXd B = timestep * Fu;
+            // Discrete Jacobians at the current iterate from the last precompute
+            const Eigen::MatrixXd &A = F_x_[t];
+            const Eigen::MatrixXd &B = F_u_[t];
 
             result.state_trajectory[t + 1] = context.X_[t + 1] +
                                              (A + B * K_u_[t]) * delta_x +
@@ -1950,31 +1797,16 @@ namespace cddp
       workspace_.delta_x_vectors[t] = result.state_trajectory[t] - context.X_[t];
 
       // Update slack variables first
-      for (const auto &constraint_pair : constraint_set)
-      {
-        const std::string &constraint_name = constraint_pair.first;
-        int dual_dim = constraint_pair.second->getDualDim();
-        const Eigen::VectorXd &s_old = S_[constraint_name][t];
-
-        Eigen::VectorXd s_new = s_old + alpha_s * k_s_[constraint_name][t] +
-                                K_s_[constraint_name][t] * delta_x;
-        Eigen::VectorXd s_min = (1.0 - tau) * s_old;
-
-        for (int i = 0; i < dual_dim; ++i)
-        {
-          if (s_new[i] < s_min[i])
-          {
-            s_trajectory_feasible = false;
-            break;
-          }
-        }
-        if (!s_trajectory_feasible)
-          break;
+      const Eigen::VectorXd &s_old = S_[t];
+      Eigen::VectorXd &s_new = S_new[t];
+      s_new = s_old + alpha_s * k_s_[t] + K_s_[t] * delta_x;
 
-        S_new[constraint_name][t] = s_new;
-      }
-      if (!s_trajectory_feasible)
+      // Fraction-to-boundary rule
+      if (((s_new - (1.0 - tau) * s_old).array() < 0.0).any())
+      {
+        s_trajectory_feasible = false;
         break;
+      }
 
       // Update control
       result.control_trajectory[t] =
@@ -2005,11 +1837,9 @@ namespace cddp
         else if (options.msipddp.rollout_type == "hybrid")
         {
           // Hybrid rollout: Linear approximation + defect correction
-          const auto [Fx, Fu] = context.getSystem().getJacobians(
-              context.X_[t], context.U_[t], t * context.getTimestep());
-          const double timestep = context.getTimestep();
-          Eigen::MatrixXd A = Eigen::MatrixXd::Identity(context.getStateDim(), context.getStateDim()) + timestep * Fx;
-          Eigen::MatrixXd B = timestep * Fu;
+          // Discrete Jacobians at the current iterate from the last precompute
+          const Eigen::MatrixXd &A = F_x_[t];
+          const Eigen::MatrixXd &B = F_u_[t];
 
           result.state_trajectory[t + 1] = context.X_[t + 1] +
                                            (A + B * K_u_[t]) * delta_x +
@@ -2035,7 +1865,7 @@ namespace cddp
 
     // Step 2: Separate line search for dual variables
     bool suitable_alpha_y_found = false;
-    std::map<std::string, std::vector<Eigen::VectorXd>> Y_trial;
+    std::vector<Eigen::VectorXd> Y_trial;
 
     for (double alpha_y_candidate : context.alphas_)
     {
@@ -2046,29 +1876,13 @@ namespace cddp
       {
         const Eigen::VectorXd &delta_x = workspace_.delta_x_vectors[t];
 
-        for (const auto &constraint_pair : constraint_set)
-        {
-          const std::string &constraint_name = constraint_pair.first;
-          int dual_dim = constraint_pair.second->getDualDim();
-          const Eigen::VectorXd &y_old = Y_[constraint_name][t];
-
-          Eigen::VectorXd y_new = y_old +
-                                  alpha_y_candidate * k_y_[constraint_name][t] +
-                                  K_y_[constraint_name][t] * delta_x;
-          Eigen::VectorXd y_min = (1.0 - tau) * y_old;
+        const Eigen::VectorXd &y_old = Y_[t];
+        Eigen::VectorXd &y_new = Y_trial[t];
+        y_new = y_old + alpha_y_candidate * k_y_[t] + K_y_[t] * delta_x;
 
-          for (int i = 0; i < dual_dim; ++i)
-          {
-            if (y_new[i] < y_min[i])
-            {
-              current_alpha_y_globally_feasible = false;
-              break;
-            }
-          }
-          if (!current_alpha_y_globally_feasible)
-            break;
-
-          Y_trial[constraint_name][t] = y_new;
+        if (((y_new - (1.0 - tau) * y_old).array() < 0.0).any())
+        {
+          current_alpha_y_globally_feasible = false;
         }
 
         // Update costate variables for multi-shooting
@@ -2084,7 +1898,7 @@ namespace cddp
       if (current_alpha_y_globally_feasible)
       {
         suitable_alpha_y_found = true;
-        Y_new = Y_trial;
+        Y_new.swap(Y_trial);
         result.alpha_du = alpha_y_candidate; // Store the dual step size
         break;
       }
@@ -2102,21 +1916,14 @@ namespace cddp
       cost_new += context.getObjective().running_cost(
           result.state_trajectory[t], result.control_trajectory[t], t);
 
-      for (const auto &constraint_pair : constraint_set)
-      {
-        const std::string &constraint_name = constraint_pair.first;
-        G_new[constraint_name][t] =
-            constraint_pair.second->evaluate(result.state_trajectory[t],
-                                             result.control_trajectory[t]) -
-            constraint_pair.second->getUpperBound();
-
-        const Eigen::VectorXd &s_vec = S_new[constraint_name][t];
-        merit_function_new -= mu_ * s_vec.array().log().sum();
-
-        // Primal infeasibility: g + s
-        Eigen::VectorXd primal_residual = G_new[constraint_name][t] + s_vec;
-        constraint_violation_new += primal_residual.lpNorm<1>();
-      }
+      context.evaluatePathConstraints(result.state_trajectory[t],
+                                      result.control_trajectory[t], G_new[t]);
+
+      const Eigen::VectorXd &s_vec = S_new[t];
+      merit_function_new -= mu_ * s_vec.array().log().sum();
+
+      // Primal infeasibility: g + s
+      constraint_violation_new += (G_new[t] + s_vec).lpNorm<1>();
 
       // Defect infeasibility: d = f - x_{k+1}
       Eigen::VectorXd defect_residual = F_new[t] - result.state_trajectory[t + 1];
@@ -2138,11 +1945,11 @@ namespace cddp
       result.cost = cost_new;
       result.merit_function = merit_function_new;
       result.constraint_violation = constraint_violation_new;
-      result.dual_trajectory = Y_new;
-      result.slack_trajectory = S_new;
-      result.constraint_eval_trajectory = G_new;
-      result.dynamics_trajectory = F_new;
-      result.costate_trajectory = Lambda_new;
+      result.dual_trajectory = std::move(Y_new);
+      result.slack_trajectory = std::move(S_new);
+      result.constraint_eval_trajectory = std::move(G_new);
+      result.dynamics_trajectory = std::move(F_new);
+      result.costate_trajectory = std::move(Lambda_new);
     }
 
     return result;
@@ -2219,18 +2026,17 @@ namespace cddp
     std::cout << std::endl;
   }
 
-  void MSIPDDPSolver::printSolutionSummary(const CDDPSolution &solution) const
+  void MSIPDDPSolver::printSolutionSummary(const SolveResult &result) const
   {
     std::cout << "\n========================================\n";
     std::cout << "           MSIPDDP Solution Summary\n";
     std::cout << "========================================\n";
 
-    auto iterations = std::any_cast<int>(solution.at("iterations_completed"));
-    auto solve_time = std::any_cast<double>(solution.at("solve_time_ms"));
-    auto final_cost = std::any_cast<double>(solution.at("final_objective"));
-    auto status = std::any_cast<std::string>(solution.at("status_message"));
-    auto final_mu =
-        std::any_cast<double>(solution.at("final_barrier_parameter_mu"));
+    auto iterations = result.iterations_completed;
+    auto solve_time = result.solve_time_ms;
+    auto final_cost = result.final_objective;
+    const auto &status = result.status_message;
+    auto final_mu = result.final_barrier_parameter_mu.value_or(0.0);
 
     std::cout << "Status: " << status << "\n";
     std::cout << "Iterations: " << iterations << "\n";
@@ -2361,30 +2167,18 @@ namespace cddp
     }
   }
 
-  void MSIPDDPSolver::updateIterationHistory(
-      const CDDPOptions &options,
-      const CDDP &context,
-      std::vector<double> &history_objective,
-      std::vector<double> &history_merit_function,
-      std::vector<double> &history_step_length_primal,
-      std::vector<double> &history_step_length_dual,
-      std::vector<double> &history_dual_infeasibility,
-      std::vector<double> &history_primal_infeasibility,
-      std::vector<double> &history_complementary_infeasibility,
-      std::vector<double> &history_barrier_mu,
-      double alpha_du) const
+  void MSIPDDPSolver::updateIterationHistory(const CDDP &context,
+                                             SolveHistory &history,
+                                             double alpha_du) const
   {
-    if (options.return_iteration_info)
-    {
-      history_objective.push_back(context.cost_);
-      history_merit_function.push_back(context.merit_function_);
-      history_step_length_primal.push_back(context.alpha_pr_);
-      history_step_length_dual.push_back(alpha_du);
-      history_dual_infeasibility.push_back(context.inf_du_);
-      history_primal_infeasibility.push_back(context.inf_pr_);
-      history_complementary_infeasibility.push_back(context.inf_comp_);
-      history_barrier_mu.push_back(mu_);
-    }
+    history.objective.push_back(context.cost_);
+    history.merit_function.push_back(context.merit_function_);
+    history.step_length_primal.push_back(context.alpha_pr_);
+    history.step_length_dual.push_back(alpha_du);
+    history.dual_infeasibility.push_back(context.inf_du_);
+    history.primal_infeasibility.push_back(context.inf_pr_);
+    history.complementary_infeasibility.push_back(context.inf_comp_);
+    history.barrier_mu.push_back(mu_);
   }
 
   bool MSIPDDPSolver::checkConvergence(
@@ -2450,10 +2244,9 @@ namespace cddp
 
   void MSIPDDPSolver::initializeConstraintStorage(CDDP &context)
   {
-    const auto &constraint_set = context.getConstraintSet();
     const int horizon = context.getHorizon();
 
-    // Clear and initialize constraint storage
+    // Clear and initialize stacked constraint storage (one entry per knot)
     G_.clear();
     G_x_.clear();
     G_u_.clear();
@@ -2464,37 +2257,31 @@ namespace cddp
     k_s_.clear();
     K_s_.clear();
 
-    // Initialize storage for each constraint
-    for (const auto &constraint_pair : constraint_set)
+    if (context.getPathConstraintBlocks().empty())
     {
-      const std::string &constraint_name = constraint_pair.first;
-      G_[constraint_name].resize(horizon);
-      Y_[constraint_name].resize(horizon);
-      S_[constraint_name].resize(horizon);
-      k_y_[constraint_name].resize(horizon);
-      K_y_[constraint_name].resize(horizon);
-      k_s_[constraint_name].resize(horizon);
-      K_s_[constraint_name].resize(horizon);
+      return;
     }
+
+    G_.resize(horizon);
+    Y_.resize(horizon);
+    S_.resize(horizon);
+    k_y_.resize(horizon);
+    K_y_.resize(horizon);
+    k_s_.resize(horizon);
+    K_s_.resize(horizon);
   }
 
   double MSIPDDPSolver::computeMaxConstraintViolation(const CDDP &context) const
   {
-    const auto &constraint_set = context.getConstraintSet();
-    const int horizon = context.getHorizon();
+    const int horizon = std::min<int>(context.getHorizon(), G_.size());
     double max_violation = 0.0;
 
-    for (const auto &constraint_pair : constraint_set)
+    for (int t = 0; t < horizon; ++t)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      auto g_it = G_.find(constraint_name);
-      if (g_it != G_.end())
+      const Eigen::VectorXd &g_vec = G_[t];
+      if (g_vec.size() > 0)
       {
-        for (int t = 0; t < horizon; ++t)
-        {
-          const Eigen::VectorXd &g_vec = g_it->second[t];
-          max_violation = std::max(max_violation, g_vec.maxCoeff());
-        }
+        max_violation = std::max(max_violation, g_vec.maxCoeff());
       }
     }
     return max_violation;
@@ -2502,12 +2289,11 @@ namespace cddp
 
   double MSIPDDPSolver::computeScaledDualInfeasibility(const CDDP &context) const
   {
-    const auto &constraint_set = context.getConstraintSet();
     const int horizon = context.getHorizon();
     const int control_dim = context.getControlDim();
 
     // If no constraints, return the unscaled dual infeasibility
-    if (constraint_set.empty())
+    if (context.getPathConstraintBlocks().empty())
     {
       return context.inf_du_;
     }
@@ -2520,24 +2306,12 @@ namespace cddp
     double s_norm_l1 = 0.0;
     int total_dual_dim = 0; // m: total number of constraints
 
-    for (const auto &constraint_pair : constraint_set)
+    const int num_knots = std::min<int>(horizon, std::min(Y_.size(), S_.size()));
+    for (int t = 0; t < num_knots; ++t)
     {
-      const std::string &constraint_name = constraint_pair.first;
-      auto y_it = Y_.find(constraint_name);
-      auto s_it = S_.find(constraint_name);
-
-      if (y_it != Y_.end() && s_it != S_.end())
-      {
-        for (int t = 0; t < horizon; ++t)
-        {
-          const Eigen::VectorXd &y_vec = y_it->second[t];
-          const Eigen::VectorXd &s_vec = s_it->second[t];
-
-          y_norm_l1 += y_vec.lpNorm<1>();
-          s_norm_l1 += s_vec.lpNorm<1>();
-          total_dual_dim += y_vec.size();
-        }
-      }
+      y_norm_l1 += Y_[t].lpNorm<1>();
+      s_norm_l1 += S_[t].lpNorm<1>();
+      total_dual_dim += Y_[t].size();
     }
 
     // m = total_dual_dim (number of constraints)
@@ -141,6 +141,22 @@ Eigen::MatrixXd NeuralDynamicalSystem::getControlJacobian(const Eigen::VectorXd&
     return B;
 }
 
+// ----------------------------------------------------------------------------
+//                           getDiscreteJacobians
+// ----------------------------------------------------------------------------
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+NeuralDynamicalSystem::getDiscreteJacobians(const Eigen::VectorXd& state,
+                                            const Eigen::VectorXd& control,
+                                            double time) const
+{
+    // getDiscreteDynamics is x + dt * f(x, u) regardless of integration_type_
+    auto [A, B] = getJacobians(state, control, time);
+    A *= timestep_;
+    A.diagonal().array() += 1.0;
+    B *= timestep_;
+    return {A, B};
+}
+
 // ----------------------------------------------------------------------------
 //                         Hessians (placeholders)
 // ----------------------------------------------------------------------------
@@ -76,25 +76,34 @@ double QuadraticObjective::evaluate(
   return total_cost;
 }
 
+namespace {
+// e^T M e accumulated column by column, so that an error expression such as
+// x - x_ref is never materialized
+template <typename Derived>
+double quadraticForm(const Eigen::MatrixXd &M,
+                     const Eigen::MatrixBase<Derived> &e) {
+  double value = 0.0;
+  for (Eigen::Index j = 0; j < M.cols(); ++j) {
+    value += e(j) * M.col(j).dot(e);
+  }
+  return value;
+}
+} // namespace
+
 // Evaluate the running cost: (x - x_ref)^T Q (x - x_ref) +  u^T R u
 double QuadraticObjective::running_cost(const Eigen::VectorXd &state,
                                         const Eigen::VectorXd &control,
                                         int index) const {
-  Eigen::VectorXd state_error;
-  if (reference_states_.size() > 0) {
-    state_error = state - reference_states_[index];
-  } else {
-    state_error = state - reference_state_; // Otherwise, use reference_state_
-  }
-  return ((state_error.transpose() * Q_ * state_error).value() +
-          (control.transpose() * R_ * control).value());
+  const Eigen::VectorXd &reference = reference_states_.size() > 0
+                                         ? reference_states_[index]
+                                         : reference_state_;
+  return quadraticForm(Q_, state - reference) + quadraticForm(R_, control);
 }
 
 // Evaluate the final/terminal cost: (x_T - x_ref)^T Qf (x_T - x_ref)
 double
 QuadraticObjective::terminal_cost(const Eigen::VectorXd &final_state) const {
-  Eigen::VectorXd state_error = final_state - reference_state_;
-  return (state_error.transpose() * Qf_ * state_error).value();
+  return quadraticForm(Qf_, final_state - reference_state_);
 }
 
 // Gradient of the running cost w.r.t state
@@ -153,6 +162,40 @@ Eigen::MatrixXd QuadraticObjective::getFinalCostHessian(
   return 2.0 * Qf_;
 }
 
+// In-place gradients: 2 Q (x - x_ref) as two products, 2 R u
+void QuadraticObjective::evalRunningCostGradientsInto(
+    const Eigen::VectorXd &state, const Eigen::VectorXd &control, int index,
+    Eigen::Ref<Eigen::VectorXd> l_x, Eigen::Ref<Eigen::VectorXd> l_u) const {
+  const Eigen::VectorXd &reference = reference_states_.size() > 0
+                                         ? reference_states_[index]
+                                         : reference_state_;
+  l_x.noalias() = 2.0 * Q_ * state;
+  l_x.noalias() -= 2.0 * Q_ * reference;
+  l_u.noalias() = 2.0 * R_ * control;
+}
+
+void QuadraticObjective::evalRunningCostHessiansInto(
+    const Eigen::VectorXd &state, const Eigen::VectorXd &control, int index,
+    Eigen::Ref<Eigen::MatrixXd> l_xx, Eigen::Ref<Eigen::MatrixXd> l_uu,
+    Eigen::Ref<Eigen::MatrixXd> l_ux) const {
+  l_xx = 2.0 * Q_;
+  l_uu = 2.0 * R_;
+  l_ux.setZero();
+}
+
+void QuadraticObjective::evalFinalCostGradientInto(
+    const Eigen::VectorXd &final_state,
+    Eigen::Ref<Eigen::VectorXd> lf_x) const {
+  lf_x.noalias() = 2.0 * Qf_ * final_state;
+  lf_x.noalias() -= 2.0 * Qf_ * reference_state_;
+}
+
+void QuadraticObjective::evalFinalCostHessianInto(
+    const Eigen::VectorXd &final_state,
+    Eigen::Ref<Eigen::MatrixXd> lf_xx) const {
+  lf_xx = 2.0 * Qf_;
+}
+
 NonlinearObjective::NonlinearObjective(double timestep) : timestep_(timestep) {}
 
 double NonlinearObjective::evaluate(
@@ -15,7 +15,13 @@
 */
 
 #include "cddp_core/qp_solver.hpp"
+#include "cddp_core/thread_pool.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <exception>
+#include <future>
+#include <limits>
 
 namespace cddp {
 
@@ -32,13 +38,26 @@ void QPSolver::setDimensions(int num_vars, int num_constraints) {
   c_.resize(num_vars_);
   A_.resize(num_constraints_, num_vars_);
   b_.resize(num_constraints_);
+  basis_.setConstant(std::max(num_vars_, 0), -1);
 
   // Pre-allocate workspace
-  halves_.resize(num_vars_ + 1, num_constraints_);
-  work_vectors_.resize((num_constraints_ + 2) * (num_vars_ + 2) *
-                           (num_vars_ - 1) / 2 +
-                       1 - num_vars_);
-  work_indices_.resize(2 * num_constraints_ + 1);
+  const int n = std::max(num_vars_, 0);
+  const int m = std::max(num_constraints_, 0);
+  llt_ = Eigen::LLT<Eigen::MatrixXd>(n);
+  As_.resize(m, n);
+  v_.resize(n);
+  bs_.resize(m);
+  order_.resize(m);
+  levels_.resize(n + 1);
+  for (int d = 0; d <= n; ++d) {
+    levels_[d].halves.resize(d + 1, m);
+    levels_[d].x.resize(d);
+    levels_[d].reflx.resize(d);
+    levels_[d].lifted.resize(d);
+  }
+  next_.resize(m + 1);
+  prev_.resize(m + 1);
+  marked_.resize(m);
 }
 
 void QPSolver::setHessian(const Eigen::MatrixXd &Q) { Q_ = Q; }
@@ -61,35 +80,10 @@ QPResult QPSolver::solve() {
     return result;
   }
 
-  // Initialize solution vector
   result.x.resize(num_vars_);
-  result.x.setZero();
-
-  // Compute Cholesky factorization of Q
-  Eigen::LLT<Eigen::MatrixXd> llt(Q_);
-  if (llt.info() != Eigen::Success) {
-    result.status = QPStatus::NUMERICAL_ERROR;
-    return result;
-  }
-
-  // Transform problem using Cholesky factorization
-  const Eigen::MatrixXd As = llt.matrixU().solve<Eigen::OnTheRight>(A_);
-  const Eigen::VectorXd v = llt.solve(c_);
-  const Eigen::VectorXd bs = A_ * v + b_;
-
-  // Scale rows of A
-  const Eigen::VectorXd scale = As.rowwise().norm();
-  halves_.topRows(As.cols()) =
-      (As.array().colwise() / scale.array()).transpose();
-  halves_.bottomRows(1) = (-bs.array() / scale.array()).transpose();
-
-  // Solve minimum norm problem
-  QPStatus status = solveMinNorm(result.x);
+  const QPStatus status = solve(Q_, c_, A_, b_, result.x, basis_);
 
   if (status == QPStatus::OPTIMAL) {
-    // Transform solution back
-    llt.matrixU().solveInPlace(result.x);
-    result.x -= v;
     result.objective_value =
         0.5 * result.x.dot(Q_ * result.x) + c_.dot(result.x);
   } else {
@@ -97,6 +91,7 @@ QPResult QPSolver::solve() {
   }
 
   result.status = status;
+  result.iterations = iterations_;
 
   auto end_time = std::chrono::high_resolution_clock::now();
   result.solve_time =
@@ -105,86 +100,165 @@ QPResult QPSolver::solve() {
   return result;
 }
 
-QPStatus QPSolver::solveMinNorm(Eigen::VectorXd &x) {
-  x.setZero();
+QPStatus QPSolver::solve(const Eigen::Ref<const Eigen::MatrixXd> &Q,
+                         const Eigen::Ref<const Eigen::VectorXd> &c,
+                         const Eigen::Ref<const Eigen::MatrixXd> &A,
+                         const Eigen::Ref<const Eigen::VectorXd> &b,
+                         Eigen::Ref<Eigen::VectorXd> x,
+                         Eigen::Ref<Eigen::VectorXi> basis) {
+  const int n = num_vars_;
+  const int m = num_constraints_;
+  iterations_ = 0;
+
+  if (n <= 0 || Q.rows() != n || Q.cols() != n || c.size() != n ||
+      A.rows() != m || A.cols() != n || b.size() != m || x.size() != n ||
+      basis.size() != n) {
+    return QPStatus::NUMERICAL_ERROR;
+  }
+
+  // Compute Cholesky factorization of Q
+  llt_.compute(Q);
+  if (llt_.info() != Eigen::Success) {
+    x.setZero();
+    return QPStatus::NUMERICAL_ERROR;
+  }
 
-  if (num_constraints_ < 1) {
-    return QPStatus::OPTIMAL;
+  // Transform problem using Cholesky factorization
+  As_ = A;
+  llt_.matrixU().solveInPlace<Eigen::OnTheRight>(As_);
+  v_ = c;
+  llt_.solveInPlace(v_);
+  bs_.noalias() = A * v_;
+  bs_ += b;
+
+  // Processing order: the previous basis first, the rest shuffled
+  int num_fixed = 0;
+  marked_.setZero();
+  if (options_.warm_start) {
+    for (int k = 0; k < n; ++k) {
+      const int j = basis(k);
+      if (j >= 0 && j < m && !marked_(j)) {
+        marked_(j) = 1;
+        order_(num_fixed++) = j;
+      }
+    }
   }
+  for (int j = 0, k = num_fixed; j < m; ++j) {
+    if (!marked_(j))
+      order_(k++) = j;
+  }
+  generateRandomPermutation(num_fixed);
 
-  // Initialize linked list for active set management
-  Eigen::VectorXi next = Eigen::VectorXi::Zero(num_constraints_);
-  Eigen::VectorXi prev = Eigen::VectorXi::Zero(num_constraints_ + 1);
+  // Scale rows of A
+  Eigen::MatrixXd &halves = levels_[n].halves;
+  for (int k = 0; k < m; ++k) {
+    const int j = order_(k);
+    const double norm = As_.row(j).norm();
+    const double scale = norm > 0.0 ? norm : 1.0;
+    halves.col(k).head(n) = As_.row(j).transpose() / scale;
+    halves(n, k) = -bs_(j) / scale;
+  }
 
-  if (num_constraints_ > 1) {
-    Eigen::VectorXi perm(num_constraints_ - 1);
-    generateRandomPermutation(num_constraints_ - 1, perm);
+  for (int k = 0; k < m; ++k) {
+    next_(k) = k + 1;
+    prev_(k + 1) = k;
+  }
+  prev_(0) = 0;
 
-    prev(0) = 0;
-    next(0) = perm(0) + 1;
-    prev(perm(0) + 1) = 0;
+  // Solve minimum norm problem
+  const QPStatus status = solveMinNorm(n, m);
+  const Eigen::VectorXd &y = levels_[n].x;
 
-    for (int i = 0; i < num_constraints_ - 2; ++i) {
-      next(perm(i) + 1) = perm(i + 1) + 1;
-      prev(perm(i + 1) + 1) = perm(i) + 1;
+  // Constraints on the boundary at the solution
+  basis.setConstant(-1);
+  if (status == QPStatus::OPTIMAL) {
+    const double tol = (n + 1) * options_.eps;
+    for (int k = 0, num_active = 0; k < m && num_active < n; ++k) {
+      if (halves.col(k).head(n).dot(y) + halves(n, k) >= -tol)
+        basis(num_active++) = order_(k);
     }
-    next(perm(num_constraints_ - 2) + 1) = num_constraints_;
-  } else {
-    prev(0) = 0;
-    next(0) = 1;
-    next(1) = 1;
   }
 
-  // Main minimum norm algorithm
-  for (int i = 0; i != num_constraints_; i = next(i)) {
-    const Eigen::VectorXd plane_i = halves_.col(i).head(num_vars_);
-    const double bi = halves_(num_vars_, i);
+  // Transform solution back
+  x = y;
+  llt_.matrixU().solveInPlace(x);
+  x -= v_;
 
-    if (x.dot(plane_i) + bi > (num_vars_ + 1) * options_.eps) {
-      const double s = plane_i.squaredNorm();
+  return status;
+}
 
-      if (s < (num_vars_ + 1) * options_.eps * options_.eps) {
-        return QPStatus::INFEASIBLE;
-      }
+QPStatus QPSolver::solveMinNorm(int d, int m) {
+  MinNormLevel &level = levels_[d];
+  Eigen::VectorXd &x = level.x;
+  x.setZero();
 
-      x = -bi * plane_i / s;
+  const double tol = (d + 1) * options_.eps;
 
-      if (i == 0)
-        continue;
+  for (int i = 0; i != m; i = next_(i)) {
+    const auto plane_i = level.halves.col(i).head(d);
+    const double bi = level.halves(d, i);
 
-      // Householder reflection with pivoting
-      const int id = x.array().abs().maxCoeff(); // Fixed line
-      const double xnorm = x.norm();
+    if (x.dot(plane_i) + bi <= tol)
+      continue;
 
-      Eigen::VectorXd reflx = x;
-      reflx(id) += x(id) < 0.0 ? -xnorm : xnorm;
-      const double h = -2.0 / reflx.squaredNorm();
+    ++iterations_;
+    const double s = plane_i.squaredNorm();
+    if (s < tol * options_.eps) {
+      return QPStatus::INFEASIBLE;
+    }
 
-      // Update remaining constraints
-      for (int j = 0; j != i; j = next(j)) {
-        // Create single block expression that can be reused
-        auto new_plane = halves_.col(j).head(num_vars_);
-        const double coeff = h * new_plane.dot(reflx);
-        new_plane += reflx * coeff;
+    // Closest point of plane i
+    x = (-bi / s) * plane_i;
+
+    if (i == 0)
+      continue;
+
+    // Householder reflection with pivoting, mapping the normal of plane i
+    // onto coordinate id; the other coordinates parametrize the plane
+    int id = 0;
+    plane_i.cwiseAbs().maxCoeff(&id);
+    Eigen::VectorXd &reflx = level.reflx;
+    reflx = plane_i;
+    reflx(id) += plane_i(id) < 0.0 ? -std::sqrt(s) : std::sqrt(s);
+    const double h = -2.0 / reflx.squaredNorm();
+
+    // Earlier constraints restricted to plane i
+    Eigen::MatrixXd &new_halves = levels_[d - 1].halves;
+    for (int j = 0; j != i; j = next_(j)) {
+      const auto plane_j = level.halves.col(j).head(d);
+      const double coeff = h * plane_j.dot(reflx);
+      for (int k = 0; k < d - 1; ++k) {
+        const int l = k < id ? k : k + 1;
+        new_halves(k, j) = plane_j(l) + reflx(l) * coeff;
       }
+      new_halves(d - 1, j) = level.halves(d, j) + plane_j.dot(x);
+    }
 
-      i = moveToFront(i, next, prev);
+    const QPStatus status = solveMinNorm(d - 1, i);
+    if (status != QPStatus::OPTIMAL) {
+      return status;
     }
+
+    // Map the solution on the plane back
+    const Eigen::VectorXd &new_x = levels_[d - 1].x;
+    Eigen::VectorXd &lifted = level.lifted;
+    for (int k = 0; k < d - 1; ++k) {
+      lifted(k < id ? k : k + 1) = new_x(k);
+    }
+    lifted(id) = 0.0;
+    x += lifted + reflx * (h * reflx.dot(lifted));
+
+    i = moveToFront(i, next_, prev_);
   }
 
   return QPStatus::OPTIMAL;
 }
 
-void QPSolver::generateRandomPermutation(int n, Eigen::VectorXi &perm) {
-  perm.resize(n);
-  for (int i = 0; i < n; ++i) {
-    perm(i) = i;
-  }
-
-  for (int i = n - 1; i > 0; --i) {
-    std::uniform_int_distribution<int> dist(0, i);
+void QPSolver::generateRandomPermutation(int begin) {
+  for (int i = static_cast<int>(order_.size()) - 1; i > begin; --i) {
+    std::uniform_int_distribution<int> dist(begin, i);
     int j = dist(rng_);
-    std::swap(perm(i), perm(j));
+    std::swap(order_(i), order_(j));
   }
 }
 
@@ -204,4 +278,90 @@ int QPSolver::moveToFront(int i, Eigen::VectorXi &next, Eigen::VectorXi &prev) {
   return previ;
 }
 
-} // namespace cddp
\ No newline at end of file
+BatchQPSolver::BatchQPSolver(const QPSolverOptions &options)
+    : options_(options) {}
+
+void BatchQPSolver::setDimensions(int num_vars, int num_constraints) {
+  num_vars_ = num_vars;
+  num_constraints_ = num_constraints;
+  for (auto &solver : solvers_) {
+    solver->setDimensions(num_vars_, num_constraints_);
+  }
+  bases_.resize(0, 0);
+}
+
+void BatchQPSolver::solve(const Eigen::Ref<const Eigen::MatrixXd> &Q,
+                          const Eigen::Ref<const Eigen::MatrixXd> &c,
+                          const Eigen::Ref<const Eigen::MatrixXd> &A,
+                          const Eigen::Ref<const Eigen::MatrixXd> &b,
+                          Eigen::Ref<Eigen::MatrixXd> X,
+                          std::vector<QPStatus> &status, ThreadPool *pool) {
+  const int num_problems = static_cast<int>(c.cols());
+  status.resize(num_problems);
+  if (num_problems == 0) {
+    return;
+  }
+
+  if (bases_.rows() != num_vars_ || bases_.cols() != num_problems) {
+    bases_.setConstant(num_vars_, num_problems, -1);
+  }
+
+  const int num_tasks =
+      pool == nullptr ? 1 : std::min(pool->size(), num_problems);
+  while (static_cast<int>(solvers_.size()) < num_tasks) {
+    solvers_.push_back(std::make_unique<QPSolver>(options_));
+    solvers_.back()->setDimensions(num_vars_, num_constraints_);
+  }
+
+  if (num_tasks == 1) {
+    solveRange(*solvers_[0], 0, num_problems, Q, c, A, b, X, status);
+    return;
+  }
+
+  // One contiguous chunk and one solver per task
+  const int chunk = (num_problems + num_tasks - 1) / num_tasks;
+  std::vector<std::future<void>> futures;
+  futures.reserve(num_tasks);
+  for (int w = 0; w < num_tasks; ++w) {
+    const int begin = w * chunk;
+    const int end = std::min(begin + chunk, num_problems);
+    if (begin >= end) {
+      break;
+    }
+    futures.push_back(pool->submit([&, w, begin, end]() {
+      solveRange(*solvers_[w], begin, end, Q, c, A, b, X, status);
+    }));
+  }
+
+  // Wait for every task before rethrowing so that none outlives the inputs
+  std::exception_ptr error;
+  for (auto &future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void BatchQPSolver::solveRange(QPSolver &solver, int begin, int end,
+                               const Eigen::Ref<const Eigen::MatrixXd> &Q,
+                               const Eigen::Ref<const Eigen::MatrixXd> &c,
+                               const Eigen::Ref<const Eigen::MatrixXd> &A,
+                               const Eigen::Ref<const Eigen::MatrixXd> &b,
+                               Eigen::Ref<Eigen::MatrixXd> X,
+                               std::vector<QPStatus> &status) {
+  const int n = num_vars_;
+  for (int k = begin; k < end; ++k) {
+    status[k] = solver.solve(Q.middleCols(k * n, n), c.col(k),
+                             A.middleCols(k * n, n), b.col(k), X.col(k),
+                             bases_.col(k));
+  }
+}
+
+} // namespace cddp
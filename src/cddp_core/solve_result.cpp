@@ -0,0 +1,200 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "cddp_core/cddp_core.hpp"
+
+#include <utility>
+
+namespace cddp {
+
+namespace {
+
+void putOptional(CDDPSolution &solution, const char *key,
+                 const std::optional<double> &value) {
+  if (value) {
+    solution[key] = *value;
+  }
+}
+
+void putSeries(CDDPSolution &solution, const char *key,
+               std::vector<double> &series) {
+  if (!series.empty()) {
+    solution[key] = std::move(series);
+  }
+}
+
+// Shared body of both toSolution() overloads; containers are moved out of
+// @p result.
+CDDPSolution buildSolution(SolveResult &result) {
+  CDDPSolution solution;
+  solution["solver_name"] = result.solver_name;
+  solution["status_message"] = result.status_message;
+  solution["iterations_completed"] = result.iterations_completed;
+  solution["solve_time_ms"] = result.solve_time_ms;
+  solution["final_objective"] = result.final_objective;
+  solution["final_step_length"] = result.final_step_length;
+
+  solution["state_trajectory"] = result.state_trajectory.toVector();
+  solution["control_trajectory"] = result.control_trajectory.toVector();
+  solution["time_points"] = std::move(result.time_points);
+  solution["control_feedback_gains_K"] =
+      std::move(result.control_feedback_gains_K);
+
+  putOptional(solution, "final_regularization", result.final_regularization);
+  putOptional(solution, "final_primal_infeasibility",
+              result.final_primal_infeasibility);
+  putOptional(solution, "final_dual_infeasibility",
+              result.final_dual_infeasibility);
+  putOptional(solution, "final_complementary_infeasibility",
+              result.final_complementary_infeasibility);
+  putOptional(solution, "final_barrier_parameter_mu",
+              result.final_barrier_parameter_mu);
+  putOptional(solution, "final_penalty_parameter",
+              result.final_penalty_parameter);
+  putOptional(solution, "final_lagrangian", result.final_lagrangian);
+
+  if (result.history) {
+    SolveHistory &history = *result.history;
+    putSeries(solution, "history_objective", history.objective);
+    putSeries(solution, "history_merit_function", history.merit_function);
+    putSeries(solution, "history_lagrangian", history.lagrangian);
+    putSeries(solution, "history_step_length_primal",
+              history.step_length_primal);
+    putSeries(solution, "history_step_length_dual", history.step_length_dual);
+    putSeries(solution, "history_primal_infeasibility",
+              history.primal_infeasibility);
+    putSeries(solution, "history_dual_infeasibility",
+              history.dual_infeasibility);
+    putSeries(solution, "history_complementary_infeasibility",
+              history.complementary_infeasibility);
+    putSeries(solution, "history_barrier_mu", history.barrier_mu);
+    putSeries(solution, "history_penalty_parameter",
+              history.penalty_parameter);
+    if (!history.regularization.empty()) {
+      std::map<std::string, std::vector<double>> regularization;
+      regularization["control"] = std::move(history.regularization);
+      solution["history_regularization"] = std::move(regularization);
+    }
+  }
+
+  return solution;
+}
+
+template <typename T>
+bool getValue(const CDDPSolution &solution, const char *key, T &value) {
+  auto it = solution.find(key);
+  if (it == solution.end()) {
+    return false;
+  }
+  if (const T *stored = std::any_cast<T>(&it->second)) {
+    value = *stored;
+    return true;
+  }
+  return false;
+}
+
+void getOptional(const CDDPSolution &solution, const char *key,
+                 std::optional<double> &value) {
+  double stored;
+  if (getValue(solution, key, stored)) {
+    value = stored;
+  }
+}
+
+void getTrajectory(const CDDPSolution &solution, const char *key,
+                   Trajectory &trajectory) {
+  auto it = solution.find(key);
+  if (it == solution.end()) {
+    return;
+  }
+  if (const auto *knots =
+          std::any_cast<std::vector<Eigen::VectorXd>>(&it->second)) {
+    trajectory.assign(*knots);
+  }
+}
+
+} // namespace
+
+CDDPSolution toSolution(const SolveResult &result) {
+  SolveResult copy = result;
+  return buildSolution(copy);
+}
+
+CDDPSolution toSolution(SolveResult &&result) {
+  return buildSolution(result);
+}
+
+void fromSolution(const CDDPSolution &solution, SolveResult &result) {
+  std::string solver_name;
+  getValue(solution, "solver_name", solver_name);
+  result.beginSolve(solver_name, false);
+
+  getValue(solution, "status_message", result.status_message);
+  getValue(solution, "iterations_completed", result.iterations_completed);
+  getValue(solution, "solve_time_ms", result.solve_time_ms);
+  getValue(solution, "final_objective", result.final_objective);
+  getValue(solution, "final_step_length", result.final_step_length);
+
+  getValue(solution, "time_points", result.time_points);
+  getTrajectory(solution, "state_trajectory", result.state_trajectory);
+  getTrajectory(solution, "control_trajectory", result.control_trajectory);
+  getValue(solution, "control_feedback_gains_K",
+           result.control_feedback_gains_K);
+
+  getOptional(solution, "final_regularization", result.final_regularization);
+  getOptional(solution, "final_primal_infeasibility",
+              result.final_primal_infeasibility);
+  getOptional(solution, "final_dual_infeasibility",
+              result.final_dual_infeasibility);
+  getOptional(solution, "final_complementary_infeasibility",
+              result.final_complementary_infeasibility);
+  getOptional(solution, "final_barrier_parameter_mu",
+              result.final_barrier_parameter_mu);
+  getOptional(solution, "final_penalty_parameter",
+              result.final_penalty_parameter);
+  getOptional(solution, "final_lagrangian", result.final_lagrangian);
+
+  SolveHistory history;
+  bool has_history = false;
+  has_history |= getValue(solution, "history_objective", history.objective);
+  has_history |=
+      getValue(solution, "history_merit_function", history.merit_function);
+  has_history |= getValue(solution, "history_lagrangian", history.lagrangian);
+  has_history |= getValue(solution, "history_step_length_primal",
+                          history.step_length_primal);
+  has_history |= getValue(solution, "history_step_length_dual",
+                          history.step_length_dual);
+  has_history |= getValue(solution, "history_primal_infeasibility",
+                          history.primal_infeasibility);
+  has_history |= getValue(solution, "history_dual_infeasibility",
+                          history.dual_infeasibility);
+  has_history |= getValue(solution, "history_complementary_infeasibility",
+                          history.complementary_infeasibility);
+  has_history |= getValue(solution, "history_barrier_mu", history.barrier_mu);
+  has_history |= getValue(solution, "history_penalty_parameter",
+                          history.penalty_parameter);
+  std::map<std::string, std::vector<double>> regularization;
+  if (getValue(solution, "history_regularization", regularization) &&
+      regularization.count("control")) {
+    history.regularization = regularization.at("control");
+    has_history = true;
+  }
+  if (has_history) {
+    result.history = std::move(history);
+  }
+}
+
+} // namespace cddp
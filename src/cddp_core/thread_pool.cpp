@@ -0,0 +1,116 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include "cddp_core/thread_pool.hpp"
+#include <algorithm>
+
+namespace cddp {
+
+namespace {
+// Identifies the pool and queue owned by the current worker thread, if any
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local int current_index = -1;
+} // namespace
+
+ThreadPool::ThreadPool(int num_threads) {
+  const int n = std::max(1, num_threads);
+  queues_.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  workers_.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    workers_.emplace_back([this, i]() { workerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+  const int n = static_cast<int>(queues_.size());
+  const int index = (current_pool == this)
+                        ? current_index
+                        : static_cast<int>(next_queue_++ % n);
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    ++pending_;
+  }
+  wake_.notify_one();
+}
+
+bool ThreadPool::popTask(int index, std::function<void()> &task) {
+  const int n = static_cast<int>(queues_.size());
+
+  // Own queue first (LIFO for locality)
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    if (!queues_[index]->tasks.empty()) {
+      task = std::move(queues_[index]->tasks.back());
+      queues_[index]->tasks.pop_back();
+      return true;
+    }
+  }
+
+  // Steal from the others (FIFO)
+  for (int offset = 1; offset < n; ++offset) {
+    WorkerQueue &victim = *queues_[(index + offset) % n];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::workerLoop(int index) {
+  current_pool = this;
+  current_index = index;
+
+  std::function<void()> task;
+  while (true) {
+    if (popTask(index, task)) {
+      --pending_;
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [this]() { return stop_ || pending_ > 0; });
+    if (stop_ && pending_ <= 0) {
+      return;
+    }
+  }
+}
+
+} // namespace cddp
@@ -26,11 +26,18 @@ Bicycle::Bicycle(double timestep, double wheelbase,
     : DynamicalSystem(STATE_DIM, CONTROL_DIM, timestep, integration_type),
       wheelbase_(wheelbase) {}
 
-Eigen::VectorXd Bicycle::getContinuousDynamics(const Eigen::VectorXd &state,
-                                               const Eigen::VectorXd &control,
-                                               double time) const {
+Eigen::VectorXd Bicycle::getContinuousDynamics(
+    const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time) const {
+  Eigen::VectorXd state_dot(STATE_DIM);
+  evalContinuousDynamicsInto(state, control, time, state_dot);
+  return state_dot;
+}
+
+void Bicycle::evalContinuousDynamicsInto(
+    const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
 
-  Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+  state_dot.setZero();
 
   // Extract state variables
   const double theta = state(STATE_THETA); // heading angle
@@ -45,8 +52,6 @@ Eigen::VectorXd Bicycle::getContinuousDynamics(const Eigen::VectorXd &state,
   state_dot(STATE_Y) = v * std::sin(theta);                    // dy/dt
   state_dot(STATE_THETA) = (v / wheelbase_) * std::tan(delta); // dtheta/dt
   state_dot(STATE_V) = a;                                      // dv/dt
-
-  return state_dot;
 }
 
 VectorXdual2nd
@@ -13,7 +13,15 @@ Car::Car(double timestep, double wheelbase, std::string integration_type)
 
 Eigen::VectorXd Car::getDiscreteDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    
+    Eigen::VectorXd next_state(STATE_DIM);
+    evalDiscreteDynamicsInto(state, control, time, next_state);
+    return next_state;
+}
+
+void Car::evalDiscreteDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> next_state) const {
+
     // Extract states
     const double x = state(STATE_X);         // x position
     const double y = state(STATE_Y);         // y position
@@ -31,7 +39,6 @@ Eigen::VectorXd Car::getDiscreteDynamics(
     // Compute unit vector in car direction
     const double cos_theta = std::cos(theta);
     const double sin_theta = std::sin(theta);
-    Eigen::Vector2d z(cos_theta, sin_theta);
 
     // Front wheel rolling distance
     const double f = h * v;
@@ -45,15 +52,40 @@ Eigen::VectorXd Car::getDiscreteDynamics(
     // dtheta = asin(sin(w)*f/d)
     const double dtheta = std::asin(std::sin(delta) * f / d);
 
-    // Compute state change
-    Eigen::VectorXd dy = Eigen::VectorXd::Zero(STATE_DIM);
-    dy(STATE_X) = b * cos_theta;
-    dy(STATE_Y) = b * sin_theta;
-    dy(STATE_THETA) = dtheta;
-    dy(STATE_V) = h * a;
+    // Apply state change
+    next_state(STATE_X) = x + b * cos_theta;
+    next_state(STATE_Y) = y + b * sin_theta;
+    next_state(STATE_THETA) = theta + dtheta;
+    next_state(STATE_V) = v + h * a;
+}
 
-    // Return next state
-    return state + dy;
+void Car::getDiscreteDynamicsBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& states,
+    const Eigen::Ref<const Eigen::MatrixXd>& controls,
+    const Eigen::Ref<const Eigen::VectorXd>& times,
+    Eigen::Ref<Eigen::MatrixXd> next_states) const {
+
+    // Gather the strided rows into contiguous arrays so the transcendental
+    // functions below run on full SIMD packets
+    const Eigen::ArrayXd theta = states.row(STATE_THETA).transpose();
+    const Eigen::ArrayXd v = states.row(STATE_V).transpose();
+    const Eigen::ArrayXd delta = controls.row(CONTROL_DELTA).transpose();
+    const Eigen::ArrayXd a = controls.row(CONTROL_A).transpose();
+
+    const double d = wheelbase_;
+    const double h = timestep_;
+
+    // Same geometry as getDiscreteDynamics, one knot per array element
+    const Eigen::ArrayXd f = h * v;
+    const Eigen::ArrayXd sin_delta = delta.sin();
+    const Eigen::ArrayXd b = d + f * delta.cos() - (d * d - (f * sin_delta).square()).sqrt();
+    const Eigen::ArrayXd dtheta = (sin_delta * f / d).asin();
+
+    next_states = states;
+    next_states.row(STATE_X) += (b * theta.cos()).matrix().transpose();
+    next_states.row(STATE_Y) += (b * theta.sin()).matrix().transpose();
+    next_states.row(STATE_THETA) += dtheta.matrix().transpose();
+    next_states.row(STATE_V) += (h * a).matrix().transpose();
 }
 
 Eigen::MatrixXd Car::getStateJacobian(
@@ -62,21 +94,12 @@ Eigen::MatrixXd Car::getStateJacobian(
     // Convert inputs to autodiff types
     VectorXdual2nd state_dual = state.cast<autodiff::dual2nd>();
     VectorXdual2nd control_dual = control.cast<autodiff::dual2nd>();
-    
-    // Initialize Jacobian
-    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(STATE_DIM, STATE_DIM);
 
-    // Calculate Jacobian using autodiff
-    for (int i = 0; i < STATE_DIM; ++i) {
-        // Create a lambda that returns the i-th component of the dynamics
-        auto dynamics_i = [this, i, &control_dual, time](const VectorXdual2nd& x) -> autodiff::dual2nd {
-            VectorXdual2nd dynamics = this->getDiscreteDynamicsAutodiff(x, control_dual, time);
-            return dynamics(i);
-        };
-
-        // Calculate gradient of the i-th output with respect to state
-        J.row(i) = autodiff::gradient(dynamics_i, autodiff::wrt(state_dual), at(state_dual));
-    }
+    // Full discrete Jacobian from one jacobian() call
+    auto dynamics_x = [this, &control_dual, time](const VectorXdual2nd& x) -> VectorXdual2nd {
+        return this->getDiscreteDynamicsAutodiff(x, control_dual, time);
+    };
+    Eigen::MatrixXd J = autodiff::jacobian(dynamics_x, autodiff::wrt(state_dual), at(state_dual));
 
     // Convert discrete Jacobian to continuous time Jacobian
     J.diagonal().array() -= 1.0;
@@ -91,21 +114,12 @@ Eigen::MatrixXd Car::getControlJacobian(
     // Convert inputs to autodiff types
     VectorXdual2nd state_dual = state.cast<autodiff::dual2nd>();
     VectorXdual2nd control_dual = control.cast<autodiff::dual2nd>();
-    
-    // Initialize Jacobian
-    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(STATE_DIM, CONTROL_DIM);
 
-    // Calculate Jacobian using autodiff
-    for (int i = 0; i < STATE_DIM; ++i) {
-        // Create a lambda that returns the i-th component of the dynamics
-        auto dynamics_i = [this, i, &state_dual, time](const VectorXdual2nd& u) -> autodiff::dual2nd {
-            VectorXdual2nd dynamics = this->getDiscreteDynamicsAutodiff(state_dual, u, time);
-            return dynamics(i);
-        };
-
-        // Calculate gradient of the i-th output with respect to control
-        J.row(i) = autodiff::gradient(dynamics_i, autodiff::wrt(control_dual), at(control_dual));
-    }
+    // Full discrete Jacobian from one jacobian() call
+    auto dynamics_u = [this, &state_dual, time](const VectorXdual2nd& u) -> VectorXdual2nd {
+        return this->getDiscreteDynamicsAutodiff(state_dual, u, time);
+    };
+    Eigen::MatrixXd J = autodiff::jacobian(dynamics_u, autodiff::wrt(control_dual), at(control_dual));
 
     // Convert discrete Jacobian to continuous time Jacobian
     J /= timestep_;
@@ -113,6 +127,46 @@ Eigen::MatrixXd Car::getControlJacobian(
     return J;
 }
 
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> Car::getJacobians(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+
+    auto [A, B] = getDiscreteJacobians(state, control, time);
+
+    // Convert discrete Jacobians to continuous time Jacobians
+    A.diagonal().array() -= 1.0;
+    A /= timestep_;
+    B /= timestep_;
+
+    return {A, B};
+}
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> Car::getDiscreteJacobians(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::MatrixXd A(STATE_DIM, STATE_DIM);
+    Eigen::MatrixXd B(STATE_DIM, CONTROL_DIM);
+    evalDiscreteJacobiansInto(state, control, time, A, B);
+    return {A, B};
+}
+
+void Car::evalDiscreteJacobiansInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::MatrixXd> A, Eigen::Ref<Eigen::MatrixXd> B) const {
+
+    // Differentiate once w.r.t. z = [x, u] to get [df/dx, df/du] together
+    VectorXdual2nd z(STATE_DIM + CONTROL_DIM);
+    z.head(STATE_DIM) = state.cast<autodiff::dual2nd>();
+    z.tail(CONTROL_DIM) = control.cast<autodiff::dual2nd>();
+
+    auto dynamics_z = [this, time](const VectorXdual2nd& z_ad) -> VectorXdual2nd {
+        VectorXdual2nd x = z_ad.head(STATE_DIM);
+        VectorXdual2nd u = z_ad.tail(CONTROL_DIM);
+        return this->getDiscreteDynamicsAutodiff(x, u, time);
+    };
+    const Eigen::MatrixXd J = autodiff::jacobian(dynamics_z, autodiff::wrt(z), at(z));
+    A = J.leftCols(STATE_DIM);
+    B = J.rightCols(CONTROL_DIM);
+}
+
 std::vector<Eigen::MatrixXd> Car::getStateHessian(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
     
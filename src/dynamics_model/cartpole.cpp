@@ -27,7 +27,7 @@ namespace cddp {
 CartPole::CartPole(double timestep, std::string integration_type,
                    double cart_mass, double pole_mass, double pole_length,
                    double gravity, double damping)
-    : DynamicalSystem(STATE_DIM, CONTROL_DIM, timestep, integration_type),
+    : TemplatedDynamicalSystem(STATE_DIM, CONTROL_DIM, timestep, integration_type),
       cart_mass_(cart_mass),
       pole_mass_(pole_mass),
       pole_length_(pole_length),
@@ -35,51 +35,27 @@ CartPole::CartPole(double timestep, std::string integration_type,
       damping_(damping) {
 }
 
-Eigen::VectorXd CartPole::getContinuousDynamics(
-    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
-    
-    const double x = state(STATE_X);
-    const double theta = state(STATE_THETA);
-    const double x_dot = state(STATE_X_DOT);
-    const double theta_dot = state(STATE_THETA_DOT);
-    const double force = control(CONTROL_FORCE);
-    
-    const double sin_theta = std::sin(theta);
-    const double cos_theta = std::cos(theta);
-    const double total_mass = cart_mass_ + pole_mass_;
-    
-    const double den = cart_mass_ + pole_mass_ * sin_theta * sin_theta;
-    
-    state_dot(STATE_X) = x_dot;
-    
-    state_dot(STATE_THETA) = theta_dot;
-    
-    state_dot(STATE_X_DOT) = (force + pole_mass_ * sin_theta * (pole_length_ * theta_dot * theta_dot + gravity_ * cos_theta)) / den;
-
-    state_dot(STATE_THETA_DOT) = (-force * cos_theta - pole_mass_ * pole_length_ * theta_dot * theta_dot * cos_theta * sin_theta - total_mass * gravity_ * sin_theta) / (pole_length_ * den);
-    
-    return state_dot;
-}
+template <typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, 1> CartPole::dynamics(
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& state,
+    const Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& control, double time) const {
+    using std::cos;
+    using std::sin;
 
-cddp::VectorXdual2nd CartPole::getContinuousDynamicsAutodiff(
-    const cddp::VectorXdual2nd& state, const cddp::VectorXdual2nd& control, double time) const {
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 1> state_dot(STATE_DIM);
 
-    VectorXdual2nd state_dot = VectorXdual2nd::Zero(STATE_DIM);
+    const Scalar theta = state(STATE_THETA);
+    const Scalar x_dot = state(STATE_X_DOT);
+    const Scalar theta_dot = state(STATE_THETA_DOT);
 
-    const autodiff::dual2nd theta = state(STATE_THETA);
-    const autodiff::dual2nd x_dot = state(STATE_X_DOT);
-    const autodiff::dual2nd theta_dot = state(STATE_THETA_DOT);
-
-    const autodiff::dual2nd force = control(CONTROL_FORCE);
+    const Scalar force = control(CONTROL_FORCE);
 
     const double total_mass = cart_mass_ + pole_mass_;
 
-    const autodiff::dual2nd sin_theta = sin(theta);
-    const autodiff::dual2nd cos_theta = cos(theta);
+    const Scalar sin_theta = sin(theta);
+    const Scalar cos_theta = cos(theta);
 
-    const autodiff::dual2nd mp_sin2_theta = pole_mass_ * sin_theta * sin_theta;
-    const autodiff::dual2nd den = cart_mass_ + mp_sin2_theta;
+    const Scalar den = cart_mass_ + pole_mass_ * sin_theta * sin_theta;
 
     state_dot(STATE_X) = x_dot;
 
@@ -92,15 +68,12 @@ cddp::VectorXdual2nd CartPole::getContinuousDynamicsAutodiff(
     return state_dot;
 }
 
-Eigen::MatrixXd CartPole::getStateJacobian(
-    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    return DynamicalSystem::getStateJacobian(state, control, time); // Use autodiff
-}
-
-Eigen::MatrixXd CartPole::getControlJacobian(
-    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    return DynamicalSystem::getControlJacobian(state, control, time); // Use autodiff
-}
+template Eigen::VectorXd CartPole::dynamics<double>(
+    const Eigen::VectorXd&, const Eigen::VectorXd&, double) const;
+template VectorXdual CartPole::dynamics<autodiff::dual>(
+    const VectorXdual&, const VectorXdual&, double) const;
+template VectorXdual2nd CartPole::dynamics<autodiff::dual2nd>(
+    const VectorXdual2nd&, const VectorXdual2nd&, double) const;
 
 // Eigen::MatrixXd CartPole::getStateJacobian(
 //     const Eigen::VectorXd& state, const Eigen::VectorXd& control) const {
@@ -188,14 +161,4 @@ Eigen::MatrixXd CartPole::getControlJacobian(
 //     return B;
 // }
 
-std::vector<Eigen::MatrixXd> CartPole::getStateHessian(
-    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    return DynamicalSystem::getStateHessian(state, control, time); // Use autodiff
-}
-
-std::vector<Eigen::MatrixXd> CartPole::getControlHessian(
-    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    return DynamicalSystem::getControlHessian(state, control, time); // Use autodiff
-}
-
 } // namespace cddp
\ No newline at end of file
@@ -31,16 +31,22 @@ DreyfusRocket::DreyfusRocket(double timestep, std::string integration_type,
 
 Eigen::VectorXd DreyfusRocket::getContinuousDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void DreyfusRocket::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
     
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    state_dot.setZero();
     
     const double x_dot = state(STATE_X_DOT);
     const double theta = control(CONTROL_THETA);
     
     state_dot(STATE_X) = x_dot;
     state_dot(STATE_X_DOT) = thrust_acceleration_ * std::cos(theta) - gravity_acceleration_;
-    
-    return state_dot;
 }
 
 Eigen::MatrixXd DreyfusRocket::getStateJacobian(
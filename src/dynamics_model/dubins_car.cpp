@@ -30,11 +30,18 @@ DubinsCar::DubinsCar(double speed,
 }
 
 Eigen::VectorXd DubinsCar::getContinuousDynamics(
-    const Eigen::VectorXd& state,
-    const Eigen::VectorXd& control,
-    double time) const
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const
 {
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void DubinsCar::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const
+{
+    state_dot.setZero();
 
     // Extract state components
     const double theta = state(STATE_THETA);
@@ -46,8 +53,6 @@ Eigen::VectorXd DubinsCar::getContinuousDynamics(
     state_dot(STATE_X)     = speed_ * std::cos(theta);
     state_dot(STATE_Y)     = speed_ * std::sin(theta);
     state_dot(STATE_THETA) = omega;
-
-    return state_dot;
 }
 
 cddp::VectorXdual2nd DubinsCar::getContinuousDynamicsAutodiff(
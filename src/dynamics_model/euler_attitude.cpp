@@ -34,7 +34,14 @@ namespace cddp
         const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time) const
     {
         Eigen::VectorXd state_dot(STATE_DIM);
+        evalContinuousDynamicsInto(state, control, time, state_dot);
+        return state_dot;
+    }
 
+    void EulerAttitude::evalContinuousDynamicsInto(
+        const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time,
+        Eigen::Ref<Eigen::VectorXd> state_dot) const
+    {
         // Extract states
         Eigen::Vector3d euler_angles = state.segment<3>(STATE_EULER_Z); // [psi, theta, phi]
         Eigen::Vector3d omega = state.segment<3>(STATE_OMEGA_X);
@@ -47,8 +54,6 @@ namespace cddp
 
         // Euler's Rotational Dynamics: I * d(omega)/dt = -omega x (I * omega) + tau
         state_dot.segment<3>(STATE_OMEGA_X) = this->inertia_inv_ * (-this->skew<double>(omega) * (this->inertia_ * omega) + tau);
-
-        return state_dot;
     }
 
     Eigen::MatrixXd EulerAttitude::getStateJacobian(
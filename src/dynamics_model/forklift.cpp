@@ -16,7 +16,15 @@ Forklift::Forklift(double timestep, double wheelbase, std::string integration_ty
 
 Eigen::VectorXd Forklift::getDiscreteDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    
+    Eigen::VectorXd next_state(STATE_DIM);
+    evalDiscreteDynamicsInto(state, control, time, next_state);
+    return next_state;
+}
+
+void Forklift::evalDiscreteDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> next_state) const {
+
     // Extract states
     const double x = state(STATE_X);         // x position
     const double y = state(STATE_Y);         // y position
@@ -41,16 +49,12 @@ Eigen::VectorXd Forklift::getDiscreteDynamics(
     const double sin_theta = std::sin(theta);
     const double tan_delta = std::tan(effective_delta);
     
-    // State derivatives
-    Eigen::VectorXd dy = Eigen::VectorXd::Zero(STATE_DIM);
-    dy(STATE_X) = h * v * cos_theta;
-    dy(STATE_Y) = h * v * sin_theta;
-    dy(STATE_THETA) = h * v * tan_delta / L; 
-    dy(STATE_V) = h * a;
-    dy(STATE_DELTA) = h * ddelta; 
-
-    // Return next state
-    return state + dy;
+    // Euler step of the state derivatives
+    next_state(STATE_X) = x + h * v * cos_theta;
+    next_state(STATE_Y) = y + h * v * sin_theta;
+    next_state(STATE_THETA) = theta + h * v * tan_delta / L;
+    next_state(STATE_V) = v + h * a;
+    next_state(STATE_DELTA) = delta + h * ddelta;
 }
 
 Eigen::MatrixXd Forklift::getStateJacobian(
@@ -59,18 +63,12 @@ Eigen::MatrixXd Forklift::getStateJacobian(
     // Convert inputs to autodiff types
     VectorXdual2nd state_dual = state.cast<autodiff::dual2nd>();
     VectorXdual2nd control_dual = control.cast<autodiff::dual2nd>();
-    
-    // Initialize Jacobian
-    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(STATE_DIM, STATE_DIM);
 
-    // Calculate Jacobian using autodiff
-    for (int i = 0; i < STATE_DIM; ++i) {
-        auto dynamics_i = [this, i, &control_dual, time](const VectorXdual2nd& x) -> autodiff::dual2nd {
-            VectorXdual2nd dynamics = this->getDiscreteDynamicsAutodiff(x, control_dual, time);
-            return dynamics(i);
-        };
-        J.row(i) = autodiff::gradient(dynamics_i, autodiff::wrt(state_dual), at(state_dual));
-    }
+    // Full discrete Jacobian from one jacobian() call
+    auto dynamics_x = [this, &control_dual, time](const VectorXdual2nd& x) -> VectorXdual2nd {
+        return this->getDiscreteDynamicsAutodiff(x, control_dual, time);
+    };
+    Eigen::MatrixXd J = autodiff::jacobian(dynamics_x, autodiff::wrt(state_dual), at(state_dual));
 
     // Convert discrete Jacobian to continuous time Jacobian
     J.diagonal().array() -= 1.0;
@@ -85,24 +83,59 @@ Eigen::MatrixXd Forklift::getControlJacobian(
     // Convert inputs to autodiff types
     VectorXdual2nd state_dual = state.cast<autodiff::dual2nd>();
     VectorXdual2nd control_dual = control.cast<autodiff::dual2nd>();
-    
-    // Initialize Jacobian
-    Eigen::MatrixXd J = Eigen::MatrixXd::Zero(STATE_DIM, CONTROL_DIM);
 
-    // Calculate Jacobian using autodiff
-    for (int i = 0; i < STATE_DIM; ++i) {
-        auto dynamics_i = [this, i, &state_dual, time](const VectorXdual2nd& u) -> autodiff::dual2nd {
-            VectorXdual2nd dynamics = this->getDiscreteDynamicsAutodiff(state_dual, u, time);
-            return dynamics(i);
-        };
+    // Full discrete Jacobian from one jacobian() call
+    auto dynamics_u = [this, &state_dual, time](const VectorXdual2nd& u) -> VectorXdual2nd {
+        return this->getDiscreteDynamicsAutodiff(state_dual, u, time);
+    };
+    Eigen::MatrixXd J = autodiff::jacobian(dynamics_u, autodiff::wrt(control_dual), at(control_dual));
 
-        J.row(i) = autodiff::gradient(dynamics_i, autodiff::wrt(control_dual), at(control_dual));
-    }
+    // Convert discrete Jacobian to continuous time Jacobian
     J /= timestep_;
     
     return J;
 }
 
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> Forklift::getJacobians(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+
+    auto [A, B] = getDiscreteJacobians(state, control, time);
+
+    // Convert discrete Jacobians to continuous time Jacobians
+    A.diagonal().array() -= 1.0;
+    A /= timestep_;
+    B /= timestep_;
+
+    return {A, B};
+}
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd> Forklift::getDiscreteJacobians(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::MatrixXd A(STATE_DIM, STATE_DIM);
+    Eigen::MatrixXd B(STATE_DIM, CONTROL_DIM);
+    evalDiscreteJacobiansInto(state, control, time, A, B);
+    return {A, B};
+}
+
+void Forklift::evalDiscreteJacobiansInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::MatrixXd> A, Eigen::Ref<Eigen::MatrixXd> B) const {
+
+    // Differentiate once w.r.t. z = [x, u] to get [df/dx, df/du] together
+    VectorXdual2nd z(STATE_DIM + CONTROL_DIM);
+    z.head(STATE_DIM) = state.cast<autodiff::dual2nd>();
+    z.tail(CONTROL_DIM) = control.cast<autodiff::dual2nd>();
+
+    auto dynamics_z = [this, time](const VectorXdual2nd& z_ad) -> VectorXdual2nd {
+        VectorXdual2nd x = z_ad.head(STATE_DIM);
+        VectorXdual2nd u = z_ad.tail(CONTROL_DIM);
+        return this->getDiscreteDynamicsAutodiff(x, u, time);
+    };
+    const Eigen::MatrixXd J = autodiff::jacobian(dynamics_z, autodiff::wrt(z), at(z));
+    A = J.leftCols(STATE_DIM);
+    B = J.rightCols(CONTROL_DIM);
+}
+
 std::vector<Eigen::MatrixXd> Forklift::getStateHessian(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
     
@@ -75,6 +75,37 @@ Eigen::VectorXd LTISystem::getDiscreteDynamics(
     return A_ * state + B_ * control;
 }
 
+void LTISystem::evalDiscreteDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> next_state) const {
+
+    next_state.noalias() = A_ * state;
+    next_state.noalias() += B_ * control;
+}
+
+void LTISystem::getDiscreteDynamicsBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& states,
+    const Eigen::Ref<const Eigen::MatrixXd>& controls,
+    const Eigen::Ref<const Eigen::VectorXd>& times,
+    Eigen::Ref<Eigen::MatrixXd> next_states) const {
+
+    // All knots at once as two matrix products
+    next_states.noalias() = A_ * states;
+    next_states.noalias() += B_ * controls;
+}
+
+void LTISystem::getDiscreteJacobiansBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& states,
+    const Eigen::Ref<const Eigen::MatrixXd>& controls,
+    const Eigen::Ref<const Eigen::VectorXd>& times,
+    Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+    Eigen::Ref<Eigen::MatrixXd> control_jacobians) const {
+
+    const Eigen::Index N = states.cols();
+    state_jacobians = A_.replicate(1, N);
+    control_jacobians = B_.replicate(1, N);
+}
+
 Eigen::MatrixXd LTISystem::getStateJacobian(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
     
@@ -28,8 +28,16 @@ Manipulator::Manipulator(double timestep, std::string integration_type)
 
 Eigen::VectorXd Manipulator::getContinuousDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void Manipulator::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
     
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    state_dot.setZero();
     
     // Extract joint positions and velocities
     Eigen::VectorXd q = state.segment(0, NUM_JOINTS);
@@ -46,8 +54,6 @@ Eigen::VectorXd Manipulator::getContinuousDynamics(
     // State derivative
     state_dot.segment(0, NUM_JOINTS) = dq;
     state_dot.segment(NUM_JOINTS, NUM_JOINTS) = ddq;
-    
-    return state_dot;
 }
 
 Eigen::MatrixXd Manipulator::getStateJacobian(
@@ -28,23 +28,28 @@ namespace cddp
           inertia_(inertia_matrix),
           inertia_inv_(inertia_matrix.inverse()) {}
 
-    Eigen::VectorXd MrpAttitude::getContinuousDynamics(const Eigen::VectorXd &state,
-                                                       const Eigen::VectorXd &control, double time) const
+    Eigen::VectorXd MrpAttitude::getContinuousDynamics(
+        const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time) const
+    {
+        Eigen::VectorXd state_dot(STATE_DIM);
+        evalContinuousDynamicsInto(state, control, time, state_dot);
+        return state_dot;
+    }
+
+    void MrpAttitude::evalContinuousDynamicsInto(
+        const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time,
+        Eigen::Ref<Eigen::VectorXd> state_dot) const
     {
         Eigen::Vector3d mrp = state.segment<3>(STATE_MRP_X);
         Eigen::Vector3d omega = state.segment<3>(STATE_OMEGA_X);
         Eigen::Vector3d tau = control.segment<3>(CONTROL_TAU_X);
 
-        Eigen::VectorXd state_dot(STATE_DIM);
-
         // Correct MRP Kinematics: dmrp/dt = 0.25 * B(mrp) * omega
         // Use the *current* mrp state for the kinematics matrix B.
         state_dot.segment<3>(STATE_MRP_X) = 0.25 * this->mrpKinematicsMatrix<double>(mrp) * omega;
 
         // Euler's Rotational Dynamics: I * d(omega)/dt = -omega x (I * omega) + tau
         state_dot.segment<3>(STATE_OMEGA_X) = this->inertia_inv_ * (-this->skew<double>(omega) * (this->inertia_ * omega) + tau);
-
-        return state_dot;
     }
 
     Eigen::MatrixXd MrpAttitude::getStateJacobian(const Eigen::VectorXd &state,
@@ -77,6 +82,23 @@ namespace cddp
         return DynamicalSystem::getCrossHessian(state, control, dt); // Use autodiff
     }
 
+    std::tuple<std::vector<Eigen::MatrixXd>, std::vector<Eigen::MatrixXd>,
+               std::vector<Eigen::MatrixXd>>
+    MrpAttitude::getHessians(const Eigen::VectorXd &state,
+                             const Eigen::VectorXd &control, double dt) const
+    {
+        return getHessiansAutodiff(state, control, dt);
+    }
+
+    std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+    MrpAttitude::getHessianContraction(const Eigen::VectorXd &state,
+                                       const Eigen::VectorXd &control,
+                                       const Eigen::VectorXd &lambda,
+                                       double dt) const
+    {
+        return getHessianContractionAutodiff(state, control, lambda, dt);
+    }
+
     VectorXdual2nd MrpAttitude::getContinuousDynamicsAutodiff(const VectorXdual2nd &state,
                                                               const VectorXdual2nd &control, double time) const
     {
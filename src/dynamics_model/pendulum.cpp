@@ -28,8 +28,16 @@ Pendulum::Pendulum(double timestep, double length, double mass, double damping,
 
 Eigen::VectorXd Pendulum::getContinuousDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void Pendulum::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
     
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    state_dot.setZero();
     
     // Extract state variables
     const double theta = state(STATE_THETA);
@@ -44,40 +52,45 @@ Eigen::VectorXd Pendulum::getContinuousDynamics(
     // Pendulum dynamics equations
     state_dot(STATE_THETA) = theta_dot;
     state_dot(STATE_THETA_DOT) = (torque - damping_ * theta_dot + mass_ * gravity_ * length_ * std::sin(theta)) / inertia;
-
-    return state_dot;
 }
 
 Eigen::MatrixXd Pendulum::getStateJacobian(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    
-    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(STATE_DIM, STATE_DIM);
-    
+    Eigen::MatrixXd A(STATE_DIM, STATE_DIM);
+    Eigen::MatrixXd B(STATE_DIM, CONTROL_DIM);
+    evalJacobiansInto(state, control, time, A, B);
+    return A;
+}
+
+Eigen::MatrixXd Pendulum::getControlJacobian(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::MatrixXd A(STATE_DIM, STATE_DIM);
+    Eigen::MatrixXd B(STATE_DIM, CONTROL_DIM);
+    evalJacobiansInto(state, control, time, A, B);
+    return B;
+}
+
+void Pendulum::evalJacobiansInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::MatrixXd> A, Eigen::Ref<Eigen::MatrixXd> B) const {
+
     // Extract state variables
     const double theta = state(STATE_THETA);
-    
+
     // Compute partial derivatives with respect to state variables
+    A.setZero();
     A(STATE_THETA, STATE_THETA_DOT) = 1.0;
-    
+
     // d(dtheta_dot/dt)/dtheta
     A(STATE_THETA_DOT, STATE_THETA) = (gravity_ / length_) * std::cos(theta);
-    
+
     // d(dtheta_dot/dt)/dtheta_dot
     A(STATE_THETA_DOT, STATE_THETA_DOT) = -damping_ / (mass_ * length_ * length_);
-    
-    return A;
-}
 
-Eigen::MatrixXd Pendulum::getControlJacobian(
-    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    
-    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(STATE_DIM, CONTROL_DIM);
-    
     // Compute partial derivatives with respect to control variable
     // d(dtheta_dot/dt)/dtorque
+    B.setZero();
     B(STATE_THETA_DOT, CONTROL_TORQUE) = 1.0 / (mass_ * length_ * length_);
-    
-    return B;
 }
 
 std::vector<Eigen::MatrixXd> Pendulum::getStateHessian(
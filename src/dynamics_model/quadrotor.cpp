@@ -32,8 +32,16 @@ Quadrotor::Quadrotor(double timestep, double mass, const Eigen::Matrix3d& inerti
 
 Eigen::VectorXd Quadrotor::getContinuousDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void Quadrotor::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
     
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    state_dot.setZero();
 
     // --- Position Derivative ---
     // The derivative of the position is the linear velocity.
@@ -100,8 +108,6 @@ Eigen::VectorXd Quadrotor::getContinuousDynamics(
     Eigen::Vector3d tau(tau_x, tau_y, tau_z);
     Eigen::Vector3d angular_acc = inertia_.inverse() * (tau - omega.cross(inertia_ * omega));
     state_dot.segment<3>(STATE_OMEGA_X) = angular_acc;
-
-    return state_dot;
 }
 
 Eigen::Matrix3d Quadrotor::getRotationMatrix(double qw, double qx, double qy, double qz) const {
@@ -311,11 +317,27 @@ std::vector<Eigen::MatrixXd> Quadrotor::getCrossHessian(
             return autodiff::gradient(fi_x, wrt(x), at(x));
         };
         
-        // Compute Jacobian of gradient w.r.t. control (this is the cross Hessian)
-        cross_hessians[i] = autodiff::jacobian(gradient_i, wrt(u), at(u));
+        // Jacobian of the gradient w.r.t. control is (state_dim x control_dim);
+        // the cross Hessian d^2f_i/dudx is its transpose
+        cross_hessians[i] = autodiff::jacobian(gradient_i, wrt(u), at(u)).transpose();
     }
     
     return cross_hessians;
 }
 
+std::tuple<std::vector<Eigen::MatrixXd>, std::vector<Eigen::MatrixXd>,
+           std::vector<Eigen::MatrixXd>>
+Quadrotor::getHessians(const Eigen::VectorXd& state,
+                       const Eigen::VectorXd& control, double time) const {
+    return getHessiansAutodiff(state, control, time);
+}
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+Quadrotor::getHessianContraction(const Eigen::VectorXd& state,
+                                 const Eigen::VectorXd& control,
+                                 const Eigen::VectorXd& lambda,
+                                 double time) const {
+    return getHessianContractionAutodiff(state, control, lambda, time);
+}
+
 } // namespace cddp
@@ -36,9 +36,16 @@ QuadrotorRate::QuadrotorRate(double timestep, double mass, double max_thrust, do
     }
 }
 
-Eigen::VectorXd QuadrotorRate::getContinuousDynamics(const Eigen::VectorXd& state, 
-                                                     const Eigen::VectorXd& control, 
-                                                     double /*time*/) const {
+Eigen::VectorXd QuadrotorRate::getContinuousDynamics(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void QuadrotorRate::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double /*time*/,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
     // Validate input dimensions
     if (state.size() != STATE_DIM) {
         throw std::invalid_argument("State dimension mismatch. Expected " + 
@@ -73,7 +80,7 @@ Eigen::VectorXd QuadrotorRate::getContinuousDynamics(const Eigen::VectorXd& stat
     const double wz = control(CONTROL_WZ);
 
     // Initialize state derivative
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    state_dot.setZero();
 
     // Position derivatives (velocity)
     state_dot.segment<3>(STATE_PX) = velocity;
@@ -100,8 +107,6 @@ Eigen::VectorXd QuadrotorRate::getContinuousDynamics(const Eigen::VectorXd& stat
     state_dot(STATE_QX) = q_dot(1);
     state_dot(STATE_QY) = q_dot(2);
     state_dot(STATE_QZ) = q_dot(3);
-
-    return state_dot;
 }
 
 Eigen::MatrixXd QuadrotorRate::getStateJacobian(const Eigen::VectorXd& state, 
@@ -139,6 +144,21 @@ std::vector<Eigen::MatrixXd> QuadrotorRate::getCrossHessian(const Eigen::VectorX
     return DynamicalSystem::getCrossHessian(state, control, time);
 }
 
+std::tuple<std::vector<Eigen::MatrixXd>, std::vector<Eigen::MatrixXd>,
+           std::vector<Eigen::MatrixXd>>
+QuadrotorRate::getHessians(const Eigen::VectorXd& state,
+                           const Eigen::VectorXd& control, double time) const {
+    return getHessiansAutodiff(state, control, time);
+}
+
+std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+QuadrotorRate::getHessianContraction(const Eigen::VectorXd& state,
+                                     const Eigen::VectorXd& control,
+                                     const Eigen::VectorXd& lambda,
+                                     double time) const {
+    return getHessianContractionAutodiff(state, control, lambda, time);
+}
+
 VectorXdual2nd QuadrotorRate::getContinuousDynamicsAutodiff(const VectorXdual2nd& state, 
                                                            const VectorXdual2nd& control, 
                                                            double /*time*/) const {
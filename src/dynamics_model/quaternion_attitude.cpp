@@ -30,11 +30,18 @@ namespace cddp
           inertia_(inertia_matrix),
           inertia_inv_(inertia_matrix.inverse()) {}
 
-    Eigen::VectorXd QuaternionAttitude::getContinuousDynamics(const Eigen::VectorXd &state,
-                                                              const Eigen::VectorXd &control, double time) const
+    Eigen::VectorXd QuaternionAttitude::getContinuousDynamics(
+        const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time) const
     {
         Eigen::VectorXd state_dot(STATE_DIM);
+        evalContinuousDynamicsInto(state, control, time, state_dot);
+        return state_dot;
+    }
 
+    void QuaternionAttitude::evalContinuousDynamicsInto(
+        const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time,
+        Eigen::Ref<Eigen::VectorXd> state_dot) const
+    {
         // Extract states
         Eigen::Vector4d quat = state.segment<4>(STATE_QUAT_W);
         Eigen::Vector3d omega = state.segment<3>(STATE_OMEGA_X);
@@ -59,8 +66,6 @@ namespace cddp
 
         // Euler's Rotational Dynamics: I * d(omega)/dt = -omega x (I * omega) + tau
         state_dot.segment<3>(STATE_OMEGA_X) = this->inertia_inv_ * (-this->skew<double>(omega) * (this->inertia_ * omega) + tau);
-
-        return state_dot;
     }
 
     Eigen::MatrixXd QuaternionAttitude::getStateJacobian(const Eigen::VectorXd &state,
@@ -43,8 +43,16 @@ SpacecraftLanding2D::SpacecraftLanding2D(double timestep,
 
 Eigen::VectorXd SpacecraftLanding2D::getContinuousDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void SpacecraftLanding2D::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
     
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    state_dot.setZero();
 
     // Extract state variables
     const double theta = state(STATE_THETA);
@@ -74,8 +82,6 @@ Eigen::VectorXd SpacecraftLanding2D::getContinuousDynamics(
     state_dot(STATE_X_DOT) = F_x / mass_;
     state_dot(STATE_Y_DOT) = F_y / mass_ - gravity_;
     state_dot(STATE_THETA_DOT) = T / inertia_;
-
-    return state_dot;
 }
 
 Eigen::MatrixXd SpacecraftLanding2D::getStateJacobian(
@@ -30,8 +30,16 @@ HCW::HCW(double timestep, double mean_motion, double mass,
 
 Eigen::VectorXd HCW::getContinuousDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void HCW::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
     
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    state_dot.setZero();
     
     // Extract state variables
     const double x = state(STATE_X);
@@ -62,47 +70,79 @@ Eigen::VectorXd HCW::getContinuousDynamics(
     state_dot(STATE_VX) = 2.0 * n * vy + 3.0 * n2 * x + Fx/mass_;
     state_dot(STATE_VY) = -2.0 * n * vx + Fy/mass_;
     state_dot(STATE_VZ) = -n2 * z + Fz/mass_;
-    
-    return state_dot;
+}
+
+void HCW::getContinuousDynamicsBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& states,
+    const Eigen::Ref<const Eigen::MatrixXd>& controls,
+    const Eigen::Ref<const Eigen::VectorXd>& times,
+    Eigen::Ref<Eigen::MatrixXd> state_dots) const {
+
+    // The HCW equations are linear: xdot = A x + B u for every knot
+    Eigen::Matrix<double, STATE_DIM, STATE_DIM> A;
+    Eigen::Matrix<double, STATE_DIM, CONTROL_DIM> B;
+    evalJacobiansInto(Eigen::VectorXd(), Eigen::VectorXd(), 0.0, A, B);
+
+    state_dots.noalias() = A * states;
+    state_dots.noalias() += B * controls;
+}
+
+void HCW::getJacobiansBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& states,
+    const Eigen::Ref<const Eigen::MatrixXd>& controls,
+    const Eigen::Ref<const Eigen::VectorXd>& times,
+    Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+    Eigen::Ref<Eigen::MatrixXd> control_jacobians) const {
+
+    const Eigen::Index N = states.cols();
+    state_jacobians = getStateJacobian(Eigen::VectorXd(), Eigen::VectorXd(), 0.0).replicate(1, N);
+    control_jacobians = getControlJacobian(Eigen::VectorXd(), Eigen::VectorXd(), 0.0).replicate(1, N);
 }
 
 Eigen::MatrixXd HCW::getStateJacobian(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    
-    // For HCW equations, we can compute the analytical Jacobian
+    Eigen::MatrixXd A(STATE_DIM, STATE_DIM);
+    Eigen::MatrixXd B(STATE_DIM, CONTROL_DIM);
+    evalJacobiansInto(state, control, time, A, B);
+    return A;
+}
+
+Eigen::MatrixXd HCW::getControlJacobian(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::MatrixXd A(STATE_DIM, STATE_DIM);
+    Eigen::MatrixXd B(STATE_DIM, CONTROL_DIM);
+    evalJacobiansInto(state, control, time, A, B);
+    return B;
+}
+
+void HCW::evalJacobiansInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::MatrixXd> A, Eigen::Ref<Eigen::MatrixXd> B) const {
+
+    // For HCW equations, we can compute the analytical Jacobians
     const double n = mean_motion_;
     const double n2 = n * n;
-    
-    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(STATE_DIM, STATE_DIM);
-    
+
+    A.setZero();
+
     // Position derivatives
     A(STATE_X, STATE_VX) = 1.0;
     A(STATE_Y, STATE_VY) = 1.0;
     A(STATE_Z, STATE_VZ) = 1.0;
-    
+
     // Velocity derivatives
     A(STATE_VX, STATE_X) = 3.0 * n2;
     A(STATE_VX, STATE_VY) = 2.0 * n;
-    
+
     A(STATE_VY, STATE_VX) = -2.0 * n;
-    
+
     A(STATE_VZ, STATE_Z) = -n2;
-    
-    return A;
-}
 
-Eigen::MatrixXd HCW::getControlJacobian(
-    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    
-    // For HCW equations, we can compute the analytical control Jacobian
-    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(STATE_DIM, CONTROL_DIM);
-    
     // Control only affects velocity states
+    B.setZero();
     B(STATE_VX, CONTROL_FX) = 1.0/mass_;
     B(STATE_VY, CONTROL_FY) = 1.0/mass_;
     B(STATE_VZ, CONTROL_FZ) = 1.0/mass_;
-    
-    return B;
 }
 
 std::vector<Eigen::MatrixXd> HCW::getStateHessian(
@@ -38,8 +38,16 @@ SpacecraftLinearFuel::SpacecraftLinearFuel(double timestep, double mean_motion,
 
 Eigen::VectorXd SpacecraftLinearFuel::getContinuousDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void SpacecraftLinearFuel::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
     
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    state_dot.setZero();
     
     // Extract state variables
     const double x = state(STATE_X);
@@ -75,8 +83,6 @@ Eigen::VectorXd SpacecraftLinearFuel::getContinuousDynamics(
     const double thrust_norm = std::sqrt(thrust_squared + epsilon_);
     state_dot(STATE_MASS) = -thrust_norm / (isp_ * g0_);
     state_dot(STATE_ACCUMULATED_CONTROL_EFFORT) = 0.5 * thrust_squared;
-    
-    return state_dot;
 }
 
 VectorXdual2nd SpacecraftLinearFuel::getContinuousDynamicsAutodiff(
@@ -34,10 +34,17 @@ SpacecraftNonlinear::SpacecraftNonlinear(
 }
 
 Eigen::VectorXd SpacecraftNonlinear::getContinuousDynamics(
-    const Eigen::VectorXd& state,
-    const Eigen::VectorXd& control, double time) const {
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
 
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+void SpacecraftNonlinear::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
+
+    state_dot.setZero();
 
     // Unpack state vector
     const double px = state(STATE_PX);
@@ -77,8 +84,6 @@ Eigen::VectorXd SpacecraftNonlinear::getContinuousDynamics(
                  ddx, ddy, ddz,            // Velocity derivatives
                  dr0, dtheta,             // Orbital parameter derivatives
                  ddr0, ddtheta;           // Orbital parameter acceleration derivatives
-
-    return state_dot;
 }
 
 Eigen::MatrixXd SpacecraftNonlinear::getStateJacobian(
@@ -34,8 +34,16 @@ namespace cddp
 
     //-----------------------------------------------------------------------------
     Eigen::VectorXd SpacecraftROE::getContinuousDynamics(
-        const Eigen::VectorXd &state,
-        const Eigen::VectorXd &control, double time) const
+        const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time) const
+    {
+        Eigen::VectorXd xdot(STATE_DIM);
+        evalContinuousDynamicsInto(state, control, time, xdot);
+        return xdot;
+    }
+
+    void SpacecraftROE::evalContinuousDynamicsInto(
+        const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time,
+        Eigen::Ref<Eigen::VectorXd> xdot) const
     {
         /**
          * Based on the linear QNSROE model:
@@ -61,7 +69,7 @@ namespace cddp
          */
 
         // Create a zero derivative vector
-        Eigen::VectorXd xdot = Eigen::VectorXd::Zero(STATE_DIM);
+        xdot.setZero();
 
         // Current argument of latitude
         double nu = n_ref_ * time + u0_;
@@ -96,7 +104,7 @@ namespace cddp
         B(STATE_DIY, CONTROL_UN) = su;
         B *= factor;
 
-        return xdot + B * control;
+        xdot.noalias() += B * control;
     }
 
     VectorXdual2nd SpacecraftROE::getContinuousDynamicsAutodiff(
@@ -9,12 +9,21 @@
 
 namespace cddp {
 
-SpacecraftTwobody::SpacecraftTwobody(double timestep, double mu, double mass)
-    : DynamicalSystem(STATE_DIM, CONTROL_DIM, timestep, "euler"), mu_(mu), mass_(mass) {}
+SpacecraftTwobody::SpacecraftTwobody(double timestep, double mu, double mass,
+                                     std::string integration_type)
+    : DynamicalSystem(STATE_DIM, CONTROL_DIM, timestep, integration_type), mu_(mu), mass_(mass) {}
 
 Eigen::VectorXd SpacecraftTwobody::getContinuousDynamics(
     const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time) const {
-  Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+  Eigen::VectorXd state_dot(STATE_DIM);
+  evalContinuousDynamicsInto(state, control, time, state_dot);
+  return state_dot;
+}
+
+void SpacecraftTwobody::evalContinuousDynamicsInto(
+    const Eigen::VectorXd &state, const Eigen::VectorXd &control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
+  state_dot.setZero();
 
   const double x = state(STATE_X);
   const double y = state(STATE_Y);
@@ -39,8 +48,6 @@ Eigen::VectorXd SpacecraftTwobody::getContinuousDynamics(
   state_dot(STATE_VX) = -mu_ * x / r3 + ux / mass_;
   state_dot(STATE_VY) = -mu_ * y / r3 + uy / mass_;
   state_dot(STATE_VZ) = -mu_ * z / r3 + uz / mass_;
-
-  return state_dot;
 }
 
 Eigen::MatrixXd SpacecraftTwobody::getStateJacobian(
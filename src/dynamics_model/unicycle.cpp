@@ -27,8 +27,16 @@ Unicycle::Unicycle(double timestep, std::string integration_type)
 
 Eigen::VectorXd Unicycle::getContinuousDynamics(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void Unicycle::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const {
     
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    state_dot.setZero();
     
     // Extract state variables
     const double theta = state(STATE_THETA);  // heading angle
@@ -41,50 +49,93 @@ Eigen::VectorXd Unicycle::getContinuousDynamics(
     state_dot(STATE_X) = v * std::cos(theta);     // dx/dt
     state_dot(STATE_Y) = v * std::sin(theta);     // dy/dt
     state_dot(STATE_THETA) = omega;               // dtheta/dt
-    
-    return state_dot;
+}
+
+void Unicycle::getContinuousDynamicsBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& states,
+    const Eigen::Ref<const Eigen::MatrixXd>& controls,
+    const Eigen::Ref<const Eigen::VectorXd>& times,
+    Eigen::Ref<Eigen::MatrixXd> state_dots) const {
+
+    // Rows of the packed knots are strided; gather the heading and speed
+    // into contiguous arrays so sin/cos run on full SIMD packets
+    const Eigen::ArrayXd theta = states.row(STATE_THETA).transpose();
+    const Eigen::ArrayXd v = controls.row(CONTROL_V).transpose();
+
+    state_dots.row(STATE_X) = (v * theta.cos()).transpose();
+    state_dots.row(STATE_Y) = (v * theta.sin()).transpose();
+    state_dots.row(STATE_THETA) = controls.row(CONTROL_OMEGA);
+}
+
+void Unicycle::getJacobiansBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& states,
+    const Eigen::Ref<const Eigen::MatrixXd>& controls,
+    const Eigen::Ref<const Eigen::VectorXd>& times,
+    Eigen::Ref<Eigen::MatrixXd> state_jacobians,
+    Eigen::Ref<Eigen::MatrixXd> control_jacobians) const {
+
+    const Eigen::ArrayXd theta = states.row(STATE_THETA).transpose();
+    const Eigen::ArrayXd v = controls.row(CONTROL_V).transpose();
+    const Eigen::ArrayXd cos_theta = theta.cos();
+    const Eigen::ArrayXd sin_theta = theta.sin();
+
+    state_jacobians.setZero();
+    control_jacobians.setZero();
+    for (Eigen::Index j = 0; j < states.cols(); ++j) {
+        auto A = state_jacobians.middleCols(j * STATE_DIM, STATE_DIM);
+        A(STATE_X, STATE_THETA) = -v(j) * sin_theta(j);
+        A(STATE_Y, STATE_THETA) = v(j) * cos_theta(j);
+
+        auto B = control_jacobians.middleCols(j * CONTROL_DIM, CONTROL_DIM);
+        B(STATE_X, CONTROL_V) = cos_theta(j);
+        B(STATE_Y, CONTROL_V) = sin_theta(j);
+        B(STATE_THETA, CONTROL_OMEGA) = 1.0;
+    }
 }
 
 Eigen::MatrixXd Unicycle::getStateJacobian(
     const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    
-    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(STATE_DIM, STATE_DIM);
-    
+    Eigen::MatrixXd A(STATE_DIM, STATE_DIM);
+    Eigen::MatrixXd B(STATE_DIM, CONTROL_DIM);
+    evalJacobiansInto(state, control, time, A, B);
+    return A;
+}
+
+Eigen::MatrixXd Unicycle::getControlJacobian(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
+    Eigen::MatrixXd A(STATE_DIM, STATE_DIM);
+    Eigen::MatrixXd B(STATE_DIM, CONTROL_DIM);
+    evalJacobiansInto(state, control, time, A, B);
+    return B;
+}
+
+void Unicycle::evalJacobiansInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::MatrixXd> A, Eigen::Ref<Eigen::MatrixXd> B) const {
+
     // Extract state variables
     const double theta = state(STATE_THETA);  // heading angle
-    
+    const double cos_theta = std::cos(theta);
+    const double sin_theta = std::sin(theta);
+
     // Extract control variables
     const double v = control(CONTROL_V);  // velocity
-    
+
     // Compute partial derivatives with respect to state variables
+    A.setZero();
     // df1/dtheta = d(dx/dt)/dtheta
-    A(STATE_X, STATE_THETA) = -v * std::sin(theta);
-    
+    A(STATE_X, STATE_THETA) = -v * sin_theta;
     // df2/dtheta = d(dy/dt)/dtheta
-    A(STATE_Y, STATE_THETA) = v * std::cos(theta);
-    
-    return A;
-}
+    A(STATE_Y, STATE_THETA) = v * cos_theta;
 
-Eigen::MatrixXd Unicycle::getControlJacobian(
-    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const {
-    
-    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(STATE_DIM, CONTROL_DIM);  // Note: Using 2 for control dim as per original
-    
-    // Extract state variables
-    const double theta = state(STATE_THETA);  // heading angle
-    
     // Compute partial derivatives with respect to control variables
+    B.setZero();
     // df1/dv = d(dx/dt)/dv
-    B(STATE_X, CONTROL_V) = std::cos(theta);
-    
+    B(STATE_X, CONTROL_V) = cos_theta;
     // df2/dv = d(dy/dt)/dv
-    B(STATE_Y, CONTROL_V) = std::sin(theta);
-    
+    B(STATE_Y, CONTROL_V) = sin_theta;
     // df3/domega = d(dtheta/dt)/domega
     B(STATE_THETA, CONTROL_OMEGA) = 1.0;
-    
-    return B;
 }
 
 std::vector<Eigen::MatrixXd> Unicycle::getStateHessian(
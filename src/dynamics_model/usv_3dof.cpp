@@ -56,11 +56,18 @@ Usv3Dof::Usv3Dof(double timestep, std::string integration_type)
 }
 
 Eigen::VectorXd Usv3Dof::getContinuousDynamics(
-    const Eigen::VectorXd& state,
-    const Eigen::VectorXd& control,
-    double time) const
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time) const
 {
-    Eigen::VectorXd state_dot = Eigen::VectorXd::Zero(STATE_DIM);
+    Eigen::VectorXd state_dot(STATE_DIM);
+    evalContinuousDynamicsInto(state, control, time, state_dot);
+    return state_dot;
+}
+
+void Usv3Dof::evalContinuousDynamicsInto(
+    const Eigen::VectorXd& state, const Eigen::VectorXd& control, double time,
+    Eigen::Ref<Eigen::VectorXd> state_dot) const
+{
+    state_dot.setZero();
 
     // Extract state components
     const double psi = state(Usv3Dof::STATE_PSI);
@@ -96,8 +103,6 @@ Eigen::VectorXd Usv3Dof::getContinuousDynamics(
     state_dot(Usv3Dof::STATE_U) = nu_dot(0);
     state_dot(Usv3Dof::STATE_V) = nu_dot(1);
     state_dot(Usv3Dof::STATE_R) = nu_dot(2);
-
-    return state_dot;
 }
 
 
@@ -14,13 +14,20 @@
  limitations under the License.
 */
 #include "sqp_core/sqp_core.hpp"
-#include <casadi/casadi.hpp>
+#include "absl/status/status.h"
 #include <iostream>
 #include <chrono>
 #include <cmath>
 
 namespace cddp {
 
+namespace {
+
+// Weight of the terminal error |x_N - x_ref|^2 relative to sum_t |u_t|^2
+constexpr double kTerminalWeight = 1e6;
+
+} // namespace
+
 SCPSolver::SCPSolver(const Eigen::VectorXd& initial_state,
                                const Eigen::VectorXd& reference_state,
                                int horizon,
@@ -69,29 +76,148 @@ void SCPSolver::initializeSCP() {
 
 
 void SCPSolver::computeLinearizedDynamics(const std::vector<Eigen::VectorXd>& X,
-                                               const std::vector<Eigen::VectorXd>& U,
-                                               std::vector<Eigen::MatrixXd>& A,
-                                               std::vector<Eigen::MatrixXd>& B) const {
-    int state_dim = initial_state_.size();
-    int control_dim = U[0].size();
-    double eps = 1e-5;
-    A.resize(horizon_);
-    B.resize(horizon_);
-    for (int t = 0; t < horizon_; ++t) {
-        Eigen::VectorXd x = X[t];
-        Eigen::VectorXd u = U[t];
-        Eigen::VectorXd f0 = system_->getDiscreteDynamics(x, u, t * timestep_);
-        A[t] = Eigen::MatrixXd::Zero(state_dim, state_dim);
-        B[t] = Eigen::MatrixXd::Zero(state_dim, control_dim);
-        
-        auto [fx, fu] = system_->getJacobians(x, u, t * timestep_);
-        A[t] = Eigen::MatrixXd::Identity(state_dim, state_dim) + timestep_ * fx;
-        B[t] = timestep_ * fu;
+                                          const std::vector<Eigen::VectorXd>& U) {
+    const int state_dim = initial_state_.size();
+    const int control_dim = U[0].size();
+    const int N = horizon_;
+
+    X_bar_.resize(state_dim, N);
+    U_bar_.resize(control_dim, N);
+    for (int t = 0; t < N; ++t) {
+        X_bar_.col(t) = X[t];
+        U_bar_.col(t) = U[t];
+    }
+    times_ = Eigen::VectorXd::LinSpaced(N, 0.0, (N - 1) * timestep_);
+
+    // All knots in one call, so batched models evaluate them together
+    F_nom_.resize(state_dim, N);
+    A_.resize(state_dim, N * state_dim);
+    B_.resize(state_dim, N * control_dim);
+    system_->getDiscreteDynamicsBatch(X_bar_, U_bar_, times_, F_nom_);
+    system_->getDiscreteJacobiansBatch(X_bar_, U_bar_, times_, A_, B_);
+}
+
+void SCPSolver::setupQP(int state_dim, int control_dim) {
+    const int n = state_dim;
+    const int m = control_dim;
+    const int N = horizon_;
+    const int n_x = (N + 1) * n;
+    const int n_w = n_x + N * m;
+    const int dyn_row = n;              // First dynamics row
+    const int trust_row = n + N * n;    // First trust-region row
+
+    // Cost sum_t |u_t|^2 + w |x_N - x_ref|^2, constant over the iterations
+    qp_P_.resize(n_w, n_w);
+    qp_P_.reserve(Eigen::VectorXi::Ones(n_w));
+    qp_q_ = Eigen::VectorXd::Zero(n_w);
+    for (int i = 0; i < n; ++i) {
+        qp_P_.insert(N * n + i, N * n + i) = 2.0 * kTerminalWeight;
+        qp_q_(N * n + i) = -2.0 * kTerminalWeight * reference_state_(i);
+    }
+    for (int i = n_x; i < n_w; ++i) {
+        qp_P_.insert(i, i) = 2.0;
+    }
+    qp_P_.makeCompressed();
+
+    // Constraint rows: x_0 = x_init; x_{t+1} - A_t x_t - B_t u_t = c_t;
+    // |w - w_prev| <= Delta. The A_t and B_t blocks are stored densely so
+    // that the pattern does not depend on their values.
+    Eigen::VectorXi col_nnz(n_w);
+    for (int t = 0; t <= N; ++t) {
+        col_nnz.segment(t * n, n).setConstant(
+            (t == 0 ? 1 : 0) + (t > 0 ? 1 : 0) + (t < N ? n : 0) + 1);
+    }
+    col_nnz.tail(N * m).setConstant(n + 1);
+
+    qp_A_.resize(trust_row + n_w, n_w);
+    qp_A_.reserve(col_nnz);
+    for (int t = 0; t <= N; ++t) {
+        for (int j = 0; j < n; ++j) {
+            const int col = t * n + j;
+            if (t == 0)
+                qp_A_.insert(j, col) = 1.0;
+            if (t > 0)
+                qp_A_.insert(dyn_row + (t - 1) * n + j, col) = 1.0;
+            if (t < N) {
+                for (int i = 0; i < n; ++i)
+                    qp_A_.insert(dyn_row + t * n + i, col) = 0.0;
+            }
+            qp_A_.insert(trust_row + col, col) = 1.0;
+        }
+    }
+    for (int t = 0; t < N; ++t) {
+        for (int j = 0; j < m; ++j) {
+            const int col = n_x + t * m + j;
+            for (int i = 0; i < n; ++i)
+                qp_A_.insert(dyn_row + t * n + i, col) = 0.0;
+            qp_A_.insert(trust_row + col, col) = 1.0;
+        }
+    }
+    qp_A_.makeCompressed();
+
+    qp_lower_.resize(trust_row + n_w);
+    qp_upper_.resize(trust_row + n_w);
+
+    // A new pattern needs a new symbolic factorization
+    qp_solver_.reset();
+}
+
+void SCPSolver::updateQP(const std::vector<Eigen::VectorXd>& X,
+                         const std::vector<Eigen::VectorXd>& U,
+                         double Delta) {
+    const int n = initial_state_.size();
+    const int m = U[0].size();
+    const int N = horizon_;
+    const int n_x = (N + 1) * n;
+    const int dyn_row = n;
+    const int trust_row = n + N * n;
+
+    computeLinearizedDynamics(X, U);
+
+    // -A_t and -B_t into the dense blocks of the dynamics rows
+    for (int t = 0; t < N; ++t) {
+        const int block_row = dyn_row + t * n;
+        for (int j = 0; j < n; ++j) {
+            for (SparseMatrix::InnerIterator it(qp_A_, t * n + j); it; ++it) {
+                const int i = static_cast<int>(it.row()) - block_row;
+                if (i >= 0 && i < n)
+                    it.valueRef() = -A_(i, t * n + j);
+            }
+        }
+        for (int j = 0; j < m; ++j) {
+            for (SparseMatrix::InnerIterator it(qp_A_, n_x + t * m + j); it; ++it) {
+                const int i = static_cast<int>(it.row()) - block_row;
+                if (i >= 0 && i < n)
+                    it.valueRef() = -B_(i, t * m + j);
+            }
+        }
+    }
+
+    // x_0 = x_init
+    qp_lower_.head(n) = initial_state_;
+    qp_upper_.head(n) = initial_state_;
+
+    // c_t = f(xbar_t, ubar_t) - A_t xbar_t - B_t ubar_t
+    for (int t = 0; t < N; ++t) {
+        auto c_t = qp_lower_.segment(dyn_row + t * n, n);
+        c_t = F_nom_.col(t);
+        c_t.noalias() -= A_.middleCols(t * n, n) * X_bar_.col(t);
+        c_t.noalias() -= B_.middleCols(t * m, m) * U_bar_.col(t);
+        qp_upper_.segment(dyn_row + t * n, n) = c_t;
+    }
+
+    // Trust region about the previous iterate
+    for (int t = 0; t <= N; ++t) {
+        qp_lower_.segment(trust_row + t * n, n).array() = X[t].array() - Delta;
+        qp_upper_.segment(trust_row + t * n, n).array() = X[t].array() + Delta;
+    }
+    for (int t = 0; t < N; ++t) {
+        qp_lower_.segment(trust_row + n_x + t * m, m).array() = U[t].array() - Delta;
+        qp_upper_.segment(trust_row + n_x + t * m, m).array() = U[t].array() + Delta;
     }
 }
 
 SCPResult SCPSolver::solve() {
-    using namespace casadi;
     SCPResult result;
     
     // --- Parameters (adjust as needed) ---
@@ -103,17 +229,18 @@ SCPResult SCPSolver::solve() {
     int state_dim = initial_state_.size();
     int control_dim = U_[0].size();
     int N = horizon_;  // There are N control intervals, so the state trajectory has N+1 points
+    const int n_x = (N + 1) * state_dim;
+    const int n_w = n_x + N * control_dim;
+
+    // The subproblem structure only depends on the dimensions
+    if (qp_A_.rows() != state_dim + N * state_dim + n_w || qp_A_.cols() != n_w) {
+        setupQP(state_dim, control_dim);
+    }
 
     // Use the current trajectory estimates stored in X_ and U_
     std::vector<Eigen::VectorXd> X = X_;  // our state trajectory
     std::vector<Eigen::VectorXd> U = U_;
 
-    // If no initial trajectory is provided, you might consider initializing X by linear interpolation:
-    // for (int t = 0; t <= N; ++t) {
-    //     double alpha = static_cast<double>(t) / N;
-    //     X[t] = initial_state_ + alpha * (reference_state_ - initial_state_);
-    // }
-
     // Store previous iterate for linearization and convergence checking.
     std::vector<Eigen::VectorXd> X_prev = X;
     std::vector<Eigen::VectorXd> U_prev = U;
@@ -124,7 +251,7 @@ SCPResult SCPSolver::solve() {
     X_all.push_back(X);
     U_all.push_back(U);
 
-    bool success = false;
+    bool qp_failed = false;
     int it = 1;
 
     // Start timing.
@@ -141,7 +268,6 @@ SCPResult SCPSolver::solve() {
 
         // After at least 3 iterations, check convergence.
         if (it > 2 && conv_metric < convergence_threshold) {
-            success = true;
             break;
         }
 
@@ -149,135 +275,73 @@ SCPResult SCPSolver::solve() {
         X_prev = X;
         U_prev = U;
 
-        std::vector<MX> x_vars, u_vars;
-        for (int t = 0; t <= N; ++t)
-            x_vars.push_back(MX::sym("x_" + std::to_string(t), state_dim));
-        for (int t = 0; t < N; ++t)
-            u_vars.push_back(MX::sym("u_" + std::to_string(t), control_dim));
-
-        // --- Define the Objective ---
-        MX cost = 0;
-        for (int t = 0; t < N; ++t) {
-            cost += dot(u_vars[t], u_vars[t]);
-        }
-        DM ref_dm = DM(std::vector<double>(reference_state_.data(),
-                                             reference_state_.data() + state_dim));
-        MX terminal_error = x_vars[N] - ref_dm;
-        cost += 1e6 * dot(terminal_error, terminal_error);
-
-        // --- Define Constraints ---
-        std::vector<MX> g;
-        // (1) Initial state constraint: x₀ == initial_state.
-        DM init_dm = DM(std::vector<double>(initial_state_.data(),
-                                              initial_state_.data() + state_dim));
-        g.push_back(x_vars[0] - init_dm);
-
-        // (2) Dynamics constraints: linearize the dynamics around (X_prev, U_prev).
-        std::vector<Eigen::MatrixXd> A, B;
-        computeLinearizedDynamics(X_prev, U_prev, A, B);
-        for (int t = 0; t < N; ++t) {
-            Eigen::VectorXd f_nom = system_->getDiscreteDynamics(X_prev[t], U_prev[t], t * timestep_);
-            DM f_nom_dm = DM(std::vector<double>(f_nom.data(),
-                                                   f_nom.data() + state_dim));
-            DM xbar = DM(std::vector<double>(X_prev[t].data(),
-                                               X_prev[t].data() + state_dim));
-            DM ubar = DM(std::vector<double>(U_prev[t].data(),
-                                               U_prev[t].data() + control_dim));
-            // Convert A[t] and B[t] to CasADi DM.
-            DM A_dm = DM::zeros(state_dim, state_dim);
-            DM B_dm = DM::zeros(state_dim, control_dim);
-            for (int i = 0; i < state_dim; ++i)
-                for (int j = 0; j < state_dim; ++j)
-                    A_dm(i, j) = A[t](i, j);
-            for (int i = 0; i < state_dim; ++i)
-                for (int j = 0; j < control_dim; ++j)
-                    B_dm(i, j) = B[t](i, j);
-            // Linearized dynamics constraint: 
-            //   x_{t+1} ≈ f_nom + A*(x_t - xbar) + B*(u_t - ubar)
-            MX dyn_lin = f_nom_dm + mtimes(A_dm, (x_vars[t] - xbar))
-                                   + mtimes(B_dm, (u_vars[t] - ubar));
-            g.push_back(x_vars[t+1] - dyn_lin);
+        // --- Linearize about (X_prev, U_prev) and update the QP in place ---
+        updateQP(X_prev, U_prev, Delta);
+
+        const bool updated =
+            qp_solver_ && qp_solver_->IsInitialized() &&
+            qp_solver_->UpdateConstraintMatrix(qp_A_).ok() &&
+            qp_solver_->SetBounds(qp_lower_, qp_upper_).ok();
+
+        if (!updated) {
+            osqp::OsqpInstance instance;
+            instance.objective_matrix = qp_P_;
+            instance.objective_vector = qp_q_;
+            instance.constraint_matrix = qp_A_;
+            instance.lower_bounds = qp_lower_;
+            instance.upper_bounds = qp_upper_;
+
+            osqp::OsqpSettings osqp_settings;
+            osqp_settings.warm_start = true;
+            osqp_settings.verbose = false;
+            osqp_settings.polish = true;
+            osqp_settings.max_iter = options_.osqp_max_iter;
+            osqp_settings.eps_abs = options_.osqp_eps_abs;
+            osqp_settings.eps_rel = options_.osqp_eps_rel;
+
+            qp_solver_ = std::make_unique<osqp::OsqpSolver>();
+            absl::Status init_status = qp_solver_->Init(instance, osqp_settings);
+            if (!init_status.ok()) {
+                if (options_.verbose)
+                    std::cerr << "[SCP] QP initialization failed: "
+                              << init_status.message() << std::endl;
+                qp_solver_.reset();
+                qp_failed = true;
+                break;
+            }
         }
 
-        // (3) Trust-region constraints: force the new decision variables to stay within [-Delta, Delta] of the previous iterate.
-        for (int t = 0; t <= N; ++t) {
-            g.push_back(x_vars[t] - DM(std::vector<double>(X_prev[t].data(),
-                                                             X_prev[t].data() + state_dim)));
+        // The previous solution is the linearization point, which OSQP
+        // keeps as its warm start. A reused instance still holds the last
+        // solve()'s iterate, so the first subproblem is seeded explicitly
+        if (X_all.size() == 1) {
+            Eigen::VectorXd primal(n_w);
+            for (int t = 0; t <= N; ++t)
+                primal.segment(t * state_dim, state_dim) = X_prev[t];
+            for (int t = 0; t < N; ++t)
+                primal.segment(n_x + t * control_dim, control_dim) = U_prev[t];
+            const absl::Status warm_status =
+                qp_solver_->SetWarmStart(primal, Eigen::VectorXd::Zero(qp_A_.rows()));
+            if (!warm_status.ok() && options_.verbose)
+                std::cerr << "[SCP] QP warm start failed: "
+                          << warm_status.message() << std::endl;
         }
-        for (int t = 0; t < N; ++t) {
-            g.push_back(u_vars[t] - DM(std::vector<double>(U_prev[t].data(),
-                                                             U_prev[t].data() + control_dim)));
+        const osqp::OsqpExitCode exit_code = qp_solver_->Solve();
+        if (exit_code != osqp::OsqpExitCode::kOptimal &&
+            exit_code != osqp::OsqpExitCode::kOptimalInaccurate) {
+            if (options_.verbose)
+                std::cerr << "[SCP] QP solve failed at iteration " << it << std::endl;
+            qp_failed = true;
+            break;
         }
-        MX g_all = vertcat(g);
 
-        // --- Concatenate Decision Variables ---
-        std::vector<MX> w_list;
+        // --- Extract the New Trajectory ---
+        const auto sol = qp_solver_->primal_solution();
         for (int t = 0; t <= N; ++t)
-            w_list.push_back(x_vars[t]);
+            X[t] = sol.segment(t * state_dim, state_dim);
         for (int t = 0; t < N; ++t)
-            w_list.push_back(u_vars[t]);
-        MX w = vertcat(w_list);
-        int n_w = w.size1();
-
-        // --- Set Variable and Constraint Bounds ---
-        std::vector<double> lbw(n_w, -1e20), ubw(n_w, 1e20);
-        // For constraints:
-        int num_eq = state_dim + N * state_dim;
-        int num_trust = (N + 1) * state_dim + N * control_dim;
-        std::vector<double> lbg, ubg;
-        for (int i = 0; i < num_eq; ++i) {
-            lbg.push_back(0.0);
-            ubg.push_back(0.0);
-        }
-        for (int i = 0; i < num_trust; ++i) {
-            lbg.push_back(-Delta);
-            ubg.push_back(Delta);
-        }
-
-        // --- Formulate and Solve the NLP or QP ---
-        MXDict nlp = {{"x", w}, {"f", cost}, {"g", g_all}};
-        // Dict solver_opts;
-        // solver_opts["ipopt.max_iter"] = options_.ipopt_max_iter;
-        // solver_opts["ipopt.tol"] = options_.ipopt_tol;
-        Function solver_fun = qpsol("solver", "qrqp", nlp);
-
-        // Use the previous iterate as the initial guess.
-        std::vector<double> w0(n_w, 0.0);
-        int offset = 0;
-        for (int t = 0; t <= N; ++t) {
-            for (int i = 0; i < state_dim; ++i)
-                w0[offset++] = X_prev[t](i);
-        }
-        for (int t = 0; t < N; ++t) {
-            for (int i = 0; i < control_dim; ++i)
-                w0[offset++] = U_prev[t](i);
-        }
-
-        DMDict solver_args = {{"x0", w0}, {"lbx", lbw}, {"ubx", ubw},
-                              {"lbg", lbg}, {"ubg", ubg}};
-        DMDict solver_res = solver_fun(solver_args);
-        std::vector<double> sol = std::vector<double>(solver_res.at("x"));
+            U[t] = sol.segment(n_x + t * control_dim, control_dim);
 
-        // --- Extract the New Trajectory ---
-        std::vector<Eigen::VectorXd> X_new(N + 1, Eigen::VectorXd(state_dim));
-        std::vector<Eigen::VectorXd> U_new(N, Eigen::VectorXd(control_dim));
-        offset = 0;
-        for (int t = 0; t <= N; ++t) {
-            Eigen::VectorXd x_new(state_dim);
-            for (int i = 0; i < state_dim; ++i)
-                x_new(i) = sol[offset++];
-            X_new[t] = x_new;
-        }
-        for (int t = 0; t < N; ++t) {
-            Eigen::VectorXd u_new(control_dim);
-            for (int i = 0; i < control_dim; ++i)
-                u_new(i) = sol[offset++];
-            U_new[t] = u_new;
-        }
-
-        // --- Update the Current Trajectory ---
-        X = X_new;
-        U = U_new;
         X_all.push_back(X);
         U_all.push_back(U);
 
@@ -301,16 +365,18 @@ SCPResult SCPSolver::solve() {
     auto end = std::chrono::high_resolution_clock::now();
     result.solve_time = std::chrono::duration<double>(end - start).count();
     result.iterations = it;
-    result.success = (it < max_it);
+    result.success = !qp_failed && (it < max_it);
     result.X = X;
     result.U = U;
     result.objective_value = 0.0;         // (Not computed in this simplified version)
     result.constraint_violation = 0.0;      // (Not computed in this simplified version)
 
     // Optionally, check trust-region satisfaction.
-    bool B_trust_satisfied = satisfies_trust_region_constraints(X, X_all[X_all.size()-2], Delta);
-    if (options_.verbose)
-        std::cout << "[SCP] Trust region satisfied: " << (B_trust_satisfied ? "true" : "false") << std::endl;
+    if (X_all.size() >= 2) {
+        bool B_trust_satisfied = satisfies_trust_region_constraints(X, X_all[X_all.size()-2], Delta);
+        if (options_.verbose)
+            std::cout << "[SCP] Trust region satisfied: " << (B_trust_satisfied ? "true" : "false") << std::endl;
+    }
 
     return result;
 }
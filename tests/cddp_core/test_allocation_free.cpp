@@ -0,0 +1,525 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+// Checks that CLDDP and IPDDP iterations do not touch the heap once the first
+// iteration has sized the solver workspaces.
+//
+// Built only with -DCDDP_CPP_ALLOCATION_TEST=ON: the test replaces the global
+// allocator of its executable. Eigen allocates with std::malloc rather than
+// operator new, so the hook sits on the glibc malloc family, which operator
+// new also ends up in.
+//
+// Model, objective and constraint callbacks may allocate (autodiff models,
+// user-defined costs), so they are wrapped in decorators that pause counting
+// while user code runs. The decorators leave the eval*Into variants to the
+// base-class defaults, which reach the paused get* methods. What is counted
+// is the solver's own work between callbacks.
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "cddp.hpp"
+
+namespace
+{
+    thread_local bool counting = false;
+    thread_local int paused = 0;
+    thread_local long long allocation_count = 0;
+
+    inline void recordAllocation()
+    {
+        if (counting && paused == 0)
+        {
+            ++allocation_count;
+        }
+    }
+
+    struct PauseCounting
+    {
+        PauseCounting() { ++paused; }
+        ~PauseCounting() { --paused; }
+    };
+} // namespace
+
+#if defined(__GLIBC__)
+extern "C"
+{
+    void *__libc_malloc(std::size_t size);
+    void *__libc_calloc(std::size_t count, std::size_t size);
+    void *__libc_realloc(void *ptr, std::size_t size);
+    void __libc_free(void *ptr);
+
+    void *malloc(std::size_t size)
+    {
+        recordAllocation();
+        return __libc_malloc(size);
+    }
+
+    void *calloc(std::size_t count, std::size_t size)
+    {
+        recordAllocation();
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *ptr, std::size_t size)
+    {
+        recordAllocation();
+        return __libc_realloc(ptr, size);
+    }
+
+    void free(void *ptr) { __libc_free(ptr); }
+}
+#define CDDP_ALLOCATION_HOOK_ACTIVE 1
+#endif
+
+namespace
+{
+    // Forwards every call to the wrapped system with counting paused
+    class UncountedSystem : public cddp::DynamicalSystem
+    {
+    public:
+        explicit UncountedSystem(std::unique_ptr<cddp::DynamicalSystem> system)
+            : DynamicalSystem(system->getStateDim(), system->getControlDim(),
+                              system->getTimestep(), system->getIntegrationType()),
+              system_(std::move(system)) {}
+
+        Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd &state,
+                                              const Eigen::VectorXd &control,
+                                              double time) const override
+        {
+            PauseCounting pause;
+            return system_->getContinuousDynamics(state, control, time);
+        }
+
+        Eigen::VectorXd getDiscreteDynamics(const Eigen::VectorXd &state,
+                                            const Eigen::VectorXd &control,
+                                            double time) const override
+        {
+            PauseCounting pause;
+            return system_->getDiscreteDynamics(state, control, time);
+        }
+
+        Eigen::MatrixXd getStateJacobian(const Eigen::VectorXd &state,
+                                         const Eigen::VectorXd &control,
+                                         double time) const override
+        {
+            PauseCounting pause;
+            return system_->getStateJacobian(state, control, time);
+        }
+
+        Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd &state,
+                                           const Eigen::VectorXd &control,
+                                           double time) const override
+        {
+            PauseCounting pause;
+            return system_->getControlJacobian(state, control, time);
+        }
+
+        std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+        getJacobians(const Eigen::VectorXd &state, const Eigen::VectorXd &control,
+                     double time) const override
+        {
+            PauseCounting pause;
+            return system_->getJacobians(state, control, time);
+        }
+
+        std::tuple<Eigen::MatrixXd, Eigen::MatrixXd>
+        getDiscreteJacobians(const Eigen::VectorXd &state, const Eigen::VectorXd &control,
+                             double time) const override
+        {
+            PauseCounting pause;
+            return system_->getDiscreteJacobians(state, control, time);
+        }
+
+        std::vector<Eigen::MatrixXd>
+        getStateHessian(const Eigen::VectorXd &state, const Eigen::VectorXd &control,
+                        double time) const override
+        {
+            PauseCounting pause;
+            return system_->getStateHessian(state, control, time);
+        }
+
+        std::vector<Eigen::MatrixXd>
+        getControlHessian(const Eigen::VectorXd &state, const Eigen::VectorXd &control,
+                          double time) const override
+        {
+            PauseCounting pause;
+            return system_->getControlHessian(state, control, time);
+        }
+
+        std::vector<Eigen::MatrixXd>
+        getCrossHessian(const Eigen::VectorXd &state, const Eigen::VectorXd &control,
+                        double time) const override
+        {
+            PauseCounting pause;
+            return system_->getCrossHessian(state, control, time);
+        }
+
+        std::tuple<std::vector<Eigen::MatrixXd>, std::vector<Eigen::MatrixXd>,
+                   std::vector<Eigen::MatrixXd>>
+        getHessians(const Eigen::VectorXd &state, const Eigen::VectorXd &control,
+                    double time) const override
+        {
+            PauseCounting pause;
+            return system_->getHessians(state, control, time);
+        }
+
+    private:
+        std::unique_ptr<cddp::DynamicalSystem> system_;
+    };
+
+    // Forwards every call to the wrapped objective with counting paused
+    class UncountedObjective : public cddp::Objective
+    {
+    public:
+        explicit UncountedObjective(std::unique_ptr<cddp::Objective> objective)
+            : objective_(std::move(objective)) {}
+
+        double evaluate(const std::vector<Eigen::VectorXd> &states,
+                        const std::vector<Eigen::VectorXd> &controls) const override
+        {
+            PauseCounting pause;
+            return objective_->evaluate(states, controls);
+        }
+
+        double running_cost(const Eigen::VectorXd &state,
+                            const Eigen::VectorXd &control, int index) const override
+        {
+            PauseCounting pause;
+            return objective_->running_cost(state, control, index);
+        }
+
+        double terminal_cost(const Eigen::VectorXd &final_state) const override
+        {
+            PauseCounting pause;
+            return objective_->terminal_cost(final_state);
+        }
+
+        Eigen::VectorXd getRunningCostStateGradient(const Eigen::VectorXd &state,
+                                                    const Eigen::VectorXd &control,
+                                                    int index) const override
+        {
+            PauseCounting pause;
+            return objective_->getRunningCostStateGradient(state, control, index);
+        }
+
+        Eigen::VectorXd getRunningCostControlGradient(const Eigen::VectorXd &state,
+                                                      const Eigen::VectorXd &control,
+                                                      int index) const override
+        {
+            PauseCounting pause;
+            return objective_->getRunningCostControlGradient(state, control, index);
+        }
+
+        std::tuple<Eigen::VectorXd, Eigen::VectorXd>
+        getRunningCostGradients(const Eigen::VectorXd &state,
+                                const Eigen::VectorXd &control, int index) const override
+        {
+            PauseCounting pause;
+            return objective_->getRunningCostGradients(state, control, index);
+        }
+
+        Eigen::VectorXd getFinalCostGradient(const Eigen::VectorXd &final_state) const override
+        {
+            PauseCounting pause;
+            return objective_->getFinalCostGradient(final_state);
+        }
+
+        Eigen::MatrixXd getRunningCostStateHessian(const Eigen::VectorXd &state,
+                                                   const Eigen::VectorXd &control,
+                                                   int index) const override
+        {
+            PauseCounting pause;
+            return objective_->getRunningCostStateHessian(state, control, index);
+        }
+
+        Eigen::MatrixXd getRunningCostControlHessian(const Eigen::VectorXd &state,
+                                                     const Eigen::VectorXd &control,
+                                                     int index) const override
+        {
+            PauseCounting pause;
+            return objective_->getRunningCostControlHessian(state, control, index);
+        }
+
+        Eigen::MatrixXd getRunningCostCrossHessian(const Eigen::VectorXd &state,
+                                                   const Eigen::VectorXd &control,
+                                                   int index) const override
+        {
+            PauseCounting pause;
+            return objective_->getRunningCostCrossHessian(state, control, index);
+        }
+
+        std::tuple<Eigen::MatrixXd, Eigen::MatrixXd, Eigen::MatrixXd>
+        getRunningCostHessians(const Eigen::VectorXd &state,
+                               const Eigen::VectorXd &control, int index) const override
+        {
+            PauseCounting pause;
+            return objective_->getRunningCostHessians(state, control, index);
+        }
+
+        Eigen::MatrixXd getFinalCostHessian(const Eigen::VectorXd &final_state) const override
+        {
+            PauseCounting pause;
+            return objective_->getFinalCostHessian(final_state);
+        }
+
+        Eigen::VectorXd getReferenceState() const override
+        {
+            PauseCounting pause;
+            return objective_->getReferenceState();
+        }
+
+        std::vector<Eigen::VectorXd> getReferenceStates() const override
+        {
+            PauseCounting pause;
+            return objective_->getReferenceStates();
+        }
+
+        void setReferenceState(const Eigen::VectorXd &reference_state) override
+        {
+            objective_->setReferenceState(reference_state);
+        }
+
+        void setReferenceStates(const std::vector<Eigen::VectorXd> &reference_states) override
+        {
+            objective_->setReferenceStates(reference_states);
+        }
+
+    private:
+        std::unique_ptr<cddp::Objective> objective_;
+    };
+
+    // Forwards every call to the wrapped constraint with counting paused
+    class UncountedConstraint : public cddp::Constraint
+    {
+    public:
+        explicit UncountedConstraint(std::unique_ptr<cddp::Constraint> constraint)
+            : Constraint(constraint->getName()), constraint_(std::move(constraint)) {}
+
+        int getDualDim() const override { return constraint_->getDualDim(); }
+
+        Eigen::VectorXd evaluate(const Eigen::VectorXd &state,
+                                 const Eigen::VectorXd &control) const override
+        {
+            PauseCounting pause;
+            return constraint_->evaluate(state, control);
+        }
+
+        Eigen::VectorXd getLowerBound() const override
+        {
+            PauseCounting pause;
+            return constraint_->getLowerBound();
+        }
+
+        Eigen::VectorXd getUpperBound() const override
+        {
+            PauseCounting pause;
+            return constraint_->getUpperBound();
+        }
+
+        Eigen::MatrixXd getStateJacobian(const Eigen::VectorXd &state,
+                                         const Eigen::VectorXd &control) const override
+        {
+            PauseCounting pause;
+            return constraint_->getStateJacobian(state, control);
+        }
+
+        Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd &state,
+                                           const Eigen::VectorXd &control) const override
+        {
+            PauseCounting pause;
+            return constraint_->getControlJacobian(state, control);
+        }
+
+        double computeViolation(const Eigen::VectorXd &state,
+                                const Eigen::VectorXd &control) const override
+        {
+            PauseCounting pause;
+            return constraint_->computeViolation(state, control);
+        }
+
+        double computeViolationFromValue(const Eigen::VectorXd &g) const override
+        {
+            PauseCounting pause;
+            return constraint_->computeViolationFromValue(g);
+        }
+
+    private:
+        std::unique_ptr<cddp::Constraint> constraint_;
+    };
+
+    struct TestProblem
+    {
+        std::unique_ptr<cddp::DynamicalSystem> system;
+        std::unique_ptr<cddp::Objective> objective;
+        Eigen::VectorXd initial_state;
+        Eigen::VectorXd goal_state;
+        Eigen::VectorXd control_upper_bound;
+        Eigen::VectorXd hover_control;
+        int horizon;
+        double timestep;
+    };
+
+    TestProblem makeUnicycle()
+    {
+        TestProblem problem;
+        problem.horizon = 50;
+        problem.timestep = 0.05;
+        problem.system = std::make_unique<cddp::Unicycle>(problem.timestep, "euler");
+
+        problem.initial_state = Eigen::VectorXd::Zero(3);
+        problem.goal_state = Eigen::Vector3d(2.0, 2.0, M_PI / 2.0);
+        problem.control_upper_bound = Eigen::Vector2d(1.1, M_PI);
+        problem.hover_control = Eigen::VectorXd::Zero(2);
+
+        Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(3, 3);
+        Eigen::MatrixXd R = 0.05 * Eigen::MatrixXd::Identity(2, 2);
+        Eigen::MatrixXd Qf = 100.0 * Eigen::MatrixXd::Identity(3, 3);
+        problem.objective = std::make_unique<cddp::QuadraticObjective>(
+            Q, R, Qf, problem.goal_state, std::vector<Eigen::VectorXd>(),
+            problem.timestep);
+        return problem;
+    }
+
+    TestProblem makeQuadrotor()
+    {
+        TestProblem problem;
+        problem.horizon = 50;
+        problem.timestep = 0.02;
+
+        const double mass = 1.2;
+        Eigen::Matrix3d inertia = Eigen::Matrix3d::Zero();
+        inertia(0, 0) = 7.782e-3;
+        inertia(1, 1) = 7.782e-3;
+        inertia(2, 2) = 1.439e-2;
+        problem.system = std::make_unique<cddp::Quadrotor>(
+            problem.timestep, mass, inertia, 0.165, "rk4");
+
+        problem.initial_state = Eigen::VectorXd::Zero(13);
+        problem.initial_state(2) = 1.0;
+        problem.initial_state(3) = 1.0;
+        problem.goal_state = problem.initial_state;
+        problem.goal_state(0) = 0.5;
+        problem.goal_state(2) = 1.5;
+        problem.control_upper_bound = 4.0 * Eigen::VectorXd::Ones(4);
+        problem.hover_control = (mass * 9.81 / 4.0) * Eigen::VectorXd::Ones(4);
+
+        Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(13, 13);
+        Q.diagonal().head(7).setOnes();
+        Eigen::MatrixXd R = 0.01 * Eigen::MatrixXd::Identity(4, 4);
+        Eigen::MatrixXd Qf = 10.0 * Q;
+        problem.objective = std::make_unique<cddp::QuadraticObjective>(
+            Q, R, Qf, problem.goal_state, std::vector<Eigen::VectorXd>(),
+            problem.timestep);
+        return problem;
+    }
+
+    // Allocations made by the calling thread during one solve with a fixed
+    // number of iterations, excluding those inside user callbacks
+    long long countSolveAllocations(TestProblem (*make_problem)(),
+                                    const std::string &solver_name,
+                                    bool constrained, int iterations)
+    {
+        TestProblem problem = make_problem();
+
+        cddp::CDDPOptions options;
+        options.max_iterations = iterations;
+        options.tolerance = 0.0;              // Never converge early...
+        options.acceptable_tolerance = -1.0;  // ...on any criterion
+        options.enable_parallel = false;
+        options.verbose = false;
+        options.print_solver_header = false;
+
+        auto system = std::make_unique<UncountedSystem>(std::move(problem.system));
+        auto objective = std::make_unique<UncountedObjective>(std::move(problem.objective));
+
+        cddp::CDDP solver(problem.initial_state, problem.goal_state, problem.horizon,
+                          problem.timestep, std::move(system), std::move(objective),
+                          options);
+        if (constrained)
+        {
+            solver.addPathConstraint(
+                "ControlConstraint",
+                std::make_unique<UncountedConstraint>(
+                    std::make_unique<cddp::ControlConstraint>(problem.control_upper_bound)));
+        }
+
+        std::vector<Eigen::VectorXd> X(problem.horizon + 1, problem.initial_state);
+        std::vector<Eigen::VectorXd> U(problem.horizon, problem.hover_control);
+        for (int t = 0; t < problem.horizon; ++t)
+        {
+            X[t + 1] = solver.getSystem().getDiscreteDynamics(X[t], U[t], t * problem.timestep);
+        }
+        solver.setInitialTrajectory(X, U);
+
+        allocation_count = 0;
+        counting = true;
+        cddp::CDDPSolution solution = solver.solve(solver_name);
+        counting = false;
+
+        EXPECT_EQ(std::any_cast<std::string>(solution.at("status_message")),
+                  "MaxIterationsReached");
+        EXPECT_EQ(std::any_cast<int>(solution.at("iterations_completed")), iterations);
+        return allocation_count;
+    }
+
+    // Solves of one and of several iterations allocate the same amount when
+    // no iteration after the first allocates
+    void expectAllocationFreeIterations(TestProblem (*make_problem)(),
+                                        const std::string &solver_name,
+                                        bool constrained)
+    {
+#ifndef CDDP_ALLOCATION_HOOK_ACTIVE
+        GTEST_SKIP() << "Allocation counting requires glibc";
+#else
+        const long long single = countSolveAllocations(make_problem, solver_name,
+                                                       constrained, 1);
+        const long long several = countSolveAllocations(make_problem, solver_name,
+                                                        constrained, 5);
+        EXPECT_GT(single, 0) << "Allocation hook is not active";
+        EXPECT_EQ(several, single)
+            << solver_name << " allocated " << (several - single)
+            << " times over 4 steady-state iterations";
+#endif
+    }
+} // namespace
+
+TEST(AllocationFreeTest, CLDDPUnicycle)
+{
+    expectAllocationFreeIterations(&makeUnicycle, "CLDDP", false);
+}
+
+TEST(AllocationFreeTest, CLDDPQuadrotor)
+{
+    expectAllocationFreeIterations(&makeQuadrotor, "CLDDP", false);
+}
+
+TEST(AllocationFreeTest, IPDDPUnicycle)
+{
+    expectAllocationFreeIterations(&makeUnicycle, "IPDDP", true);
+}
+
+TEST(AllocationFreeTest, IPDDPQuadrotor)
+{
+    expectAllocationFreeIterations(&makeQuadrotor, "IPDDP", true);
+}
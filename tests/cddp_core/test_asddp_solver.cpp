@@ -303,3 +303,78 @@ TEST(ASDDPTest, SolveUnicycle) {
     auto U_sol = std::any_cast<std::vector<Eigen::VectorXd>>(solution.at("control_trajectory")); // size: horizon
     auto t_sol = std::any_cast<std::vector<double>>(solution.at("time_points")); // size: horizon + 1
 }
+
+TEST(ASDDPTest, ParallelLineSearchIsDeterministic) {
+    // Each line-search alpha owns its per-knot OSQP solvers, so running the
+    // alphas on several workers must give the same result as on one
+    int state_dim = 3;
+    int control_dim = 2;
+    int horizon = 60;
+    double timestep = 0.05;
+
+    Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(state_dim, state_dim);
+    Eigen::MatrixXd R = 0.5 * Eigen::MatrixXd::Identity(control_dim, control_dim);
+    Eigen::MatrixXd Qf = 25.0 * Eigen::MatrixXd::Identity(state_dim, state_dim);
+    Eigen::VectorXd goal_state(state_dim);
+    goal_state << 2.0, 2.0, M_PI / 2.0;
+    Eigen::VectorXd initial_state(state_dim);
+    initial_state << 0.0, 0.0, M_PI / 4.0;
+
+    // y <= 1.8 keeps the state rows of the forward-pass QPs active
+    Eigen::MatrixXd A_lin = Eigen::MatrixXd::Zero(1, state_dim);
+    A_lin(0, 1) = 1.0;
+    Eigen::VectorXd b_lin(1);
+    b_lin << 1.8;
+
+    auto solve = [&](int num_threads) {
+        cddp::CDDPOptions options;
+        options.max_iterations = 15;
+        options.tolerance = 1e-3;
+        options.enable_parallel = true;
+        options.num_threads = num_threads;
+        options.verbose = false;
+        options.regularization.initial_value = 1e-2;
+
+        cddp::CDDP cddp_solver(initial_state, goal_state, horizon, timestep);
+        cddp_solver.setDynamicalSystem(std::make_unique<cddp::Unicycle>(timestep, "euler"));
+        cddp_solver.setObjective(std::make_unique<cddp::QuadraticObjective>(
+            Q, R, Qf, goal_state, std::vector<Eigen::VectorXd>(), timestep));
+        cddp_solver.addPathConstraint("ControlBoxConstraint",
+            std::make_unique<cddp::ControlBoxConstraint>(
+                Eigen::Vector2d(-1.0, -M_PI), Eigen::Vector2d(1.0, M_PI)));
+        cddp_solver.addPathConstraint("LinearConstraint",
+            std::make_unique<cddp::LinearConstraint>(A_lin, b_lin));
+        cddp_solver.setOptions(options);
+        cddp_solver.setInitialTrajectory(
+            std::vector<Eigen::VectorXd>(horizon + 1, initial_state),
+            std::vector<Eigen::VectorXd>(horizon, Eigen::VectorXd::Zero(control_dim)));
+        return cddp_solver.solve("ASDDP");
+    };
+
+    cddp::CDDPSolution sequential = solve(1);
+    cddp::CDDPSolution parallel = solve(4);
+
+    auto X_seq = std::any_cast<std::vector<Eigen::VectorXd>>(sequential.at("state_trajectory"));
+    auto X_par = std::any_cast<std::vector<Eigen::VectorXd>>(parallel.at("state_trajectory"));
+    auto U_seq = std::any_cast<std::vector<Eigen::VectorXd>>(sequential.at("control_trajectory"));
+    auto U_par = std::any_cast<std::vector<Eigen::VectorXd>>(parallel.at("control_trajectory"));
+
+    EXPECT_EQ(std::any_cast<int>(parallel.at("iterations_completed")),
+              std::any_cast<int>(sequential.at("iterations_completed")));
+    EXPECT_NEAR(std::any_cast<double>(parallel.at("final_objective")),
+                std::any_cast<double>(sequential.at("final_objective")), 1e-9);
+    ASSERT_EQ(X_par.size(), X_seq.size());
+    for (size_t t = 0; t < X_seq.size(); ++t) {
+        EXPECT_TRUE(X_par[t].isApprox(X_seq[t], 1e-9)) << "t = " << t;
+    }
+    for (size_t t = 0; t < U_seq.size(); ++t) {
+        EXPECT_TRUE(U_par[t].isApprox(U_seq[t], 1e-9)) << "t = " << t;
+    }
+
+    // The solve made progress and the QPs kept the constraint; the last
+    // knot's QP has no state rows, so the terminal state is left out
+    EXPECT_GT(std::any_cast<int>(parallel.at("iterations_completed")), 1);
+    for (int t = 0; t < horizon; ++t) {
+        EXPECT_LE(X_par[t](1), 1.8 + 1e-2) << "t = " << t;
+    }
+}
@@ -0,0 +1,151 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "cddp.hpp"
+
+namespace
+{
+    const int kHorizon = 40;
+    const double kTimestep = 0.05;
+
+    std::unique_ptr<cddp::CDDP> makeUnicycleProblem()
+    {
+        const int state_dim = 3;
+        const int control_dim = 2;
+
+        Eigen::VectorXd initial_state = Eigen::VectorXd::Zero(state_dim);
+        Eigen::VectorXd goal_state(state_dim);
+        goal_state << 2.0, 2.0, M_PI / 2.0;
+
+        Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(state_dim, state_dim);
+        Eigen::MatrixXd R = 0.05 * Eigen::MatrixXd::Identity(control_dim, control_dim);
+        Eigen::MatrixXd Qf = Eigen::MatrixXd::Identity(state_dim, state_dim);
+        Qf.diagonal() << 50.0, 50.0, 10.0;
+
+        std::vector<Eigen::VectorXd> empty_reference_states;
+        auto objective = std::make_unique<cddp::QuadraticObjective>(
+            Q, R, Qf, goal_state, empty_reference_states, kTimestep);
+        auto system = std::make_unique<cddp::Unicycle>(kTimestep, "euler");
+
+        cddp::CDDPOptions options;
+        options.max_iterations = 30;
+        options.verbose = false;
+        options.print_solver_header = false;
+        options.enable_parallel = false;
+
+        auto problem = std::make_unique<cddp::CDDP>(initial_state, goal_state, kHorizon, kTimestep,
+                                                    std::move(system), std::move(objective), options);
+
+        Eigen::VectorXd control_upper_bound(control_dim);
+        control_upper_bound << 1.0, M_PI;
+        problem->addPathConstraint("ControlConstraint",
+                                   std::make_unique<cddp::ControlConstraint>(control_upper_bound));
+        return problem;
+    }
+
+    std::vector<cddp::BatchProblem> makeInstances(int count)
+    {
+        std::mt19937 gen(7);
+        std::normal_distribution<> perturbation(0.0, 0.2);
+
+        std::vector<cddp::BatchProblem> instances(count);
+        for (int i = 0; i < count; ++i)
+        {
+            instances[i].initial_state = Eigen::Vector3d(perturbation(gen), perturbation(gen), 0.0);
+            if (i % 3 == 0)
+            {
+                // Every third instance tracks a different goal
+                instances[i].reference_state = Eigen::Vector3d(1.0, 2.5, 0.0);
+            }
+        }
+        return instances;
+    }
+} // namespace
+
+TEST(BatchSolverTest, MatchesSequentialSolvesInOrder)
+{
+    const std::vector<cddp::BatchProblem> instances = makeInstances(9);
+
+    for (const std::string solver : {"CLDDP", "IPDDP"})
+    {
+        std::atomic<int> factory_calls{0};
+        cddp::BatchSolver batch([&factory_calls]()
+                                {
+                                    ++factory_calls;
+                                    return makeUnicycleProblem();
+                                },
+                                solver, 3);
+        ASSERT_EQ(batch.getNumWorkers(), 3);
+
+        std::vector<cddp::SolveResult> results = batch.solve(instances);
+        ASSERT_EQ(results.size(), instances.size());
+        // Models are built once per worker, not once per instance
+        EXPECT_EQ(factory_calls.load(), 3);
+
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            auto problem = makeUnicycleProblem();
+            problem->setInitialState(instances[i].initial_state);
+            if (instances[i].reference_state.size() > 0)
+            {
+                problem->setReferenceState(instances[i].reference_state);
+            }
+            cddp::SolveResult expected;
+            problem->solve(solver, expected);
+
+            EXPECT_EQ(results[i].solver_name, solver);
+            EXPECT_EQ(results[i].status_message, expected.status_message) << i;
+            EXPECT_EQ(results[i].iterations_completed, expected.iterations_completed) << i;
+            EXPECT_DOUBLE_EQ(results[i].final_objective, expected.final_objective) << i;
+            EXPECT_TRUE(results[i].state_trajectory.front().isApprox(instances[i].initial_state));
+            EXPECT_TRUE(results[i].state_trajectory.matrix().isApprox(
+                expected.state_trajectory.matrix()))
+                << i;
+        }
+
+        // A second batch reuses the workers
+        batch.solve(instances, results);
+        EXPECT_EQ(factory_calls.load(), 3);
+    }
+}
+
+TEST(BatchSolverTest, WarmStartAndErrors)
+{
+    cddp::BatchSolver batch(makeUnicycleProblem, "CLDDP", 2);
+    std::vector<cddp::BatchProblem> instances = makeInstances(2);
+
+    std::vector<cddp::SolveResult> cold = batch.solve(instances);
+
+    // Starting from the converged solution needs fewer iterations
+    instances[0].initial_state_trajectory = cold[0].state_trajectory;
+    instances[0].initial_control_trajectory = cold[0].control_trajectory;
+    std::vector<cddp::SolveResult> warm = batch.solve(instances);
+    EXPECT_LT(warm[0].iterations_completed, cold[0].iterations_completed);
+    EXPECT_EQ(warm[1].iterations_completed, cold[1].iterations_completed);
+
+    instances[1].initial_state = Eigen::VectorXd::Zero(2);
+    EXPECT_THROW(batch.solve(instances), std::invalid_argument);
+
+    EXPECT_TRUE(batch.solve(std::vector<cddp::BatchProblem>()).empty());
+}
@@ -20,6 +20,7 @@
 
 #include "cddp_core/qp_solver.hpp"
 #include "cddp_core/boxqp.hpp"
+#include "cddp_core/thread_pool.hpp"
 
 using namespace std;
 using namespace Eigen;
@@ -232,6 +233,171 @@ TEST(BoxQPSolver, LargeDimensionTest) {
                     elapsed.count(), static_cast<int>(result.status));
 }
 
+TEST(BoxQPSolver, WorkspaceWarmStart) {
+    const int n = 4;
+    MatrixXd M = MatrixXd::Random(n, n);
+    MatrixXd H = M * M.transpose() + n * MatrixXd::Identity(n, n);
+    VectorXd g(n);
+    g << -30.0, 25.0, 1.0, -0.5;
+    VectorXd lb = VectorXd::Constant(n, -1.0);
+    VectorXd ub = VectorXd::Constant(n, 1.0);
+
+    BoxQPSolver solver;
+    BoxQPResult reference = solver.solve(H, g, lb, ub);
+
+    // Same solution through a workspace
+    BoxQPWorkspace ws;
+    BoxQPStatus status = solver.solve(H, g, lb, ub, VectorXd(), ws);
+    ASSERT_NE(status, BoxQPStatus::HESSIAN_NOT_PD);
+    EXPECT_TRUE(ws.x.isApprox(reference.x, 1e-8));
+    EXPECT_EQ(ws.free, reference.free);
+    EXPECT_EQ(ws.active_set.cwiseAbs(), VectorXi::Ones(n) - ws.free);
+
+    // Free-subspace solves through ws.Hfree match the reduced factor
+    VectorXd rhs = VectorXd::Zero(n);
+    VectorXd rhs_free(reference.free.sum());
+    for (int i = 0, j = 0; i < n; ++i) {
+        if (reference.free(i)) {
+            rhs(i) = i + 1.0;
+            rhs_free(j++) = i + 1.0;
+        }
+    }
+    VectorXd sol = ws.Hfree.solve(rhs);
+    VectorXd sol_free = reference.Hfree.solve(rhs_free);
+    for (int i = 0, j = 0; i < n; ++i) {
+        if (reference.free(i)) {
+            EXPECT_NEAR(sol(i), sol_free(j++), 1e-10);
+        } else {
+            EXPECT_EQ(sol(i), 0.0);
+        }
+    }
+
+    // Shifted bounds, as after a DDP iteration moves the nominal control:
+    // the stored active set is found by the first factorization
+    lb.array() -= 0.01;
+    ub.array() -= 0.01;
+    VectorXd x0 = ws.x;
+    solver.solve(H, g, lb, ub, x0, ws);
+    BoxQPResult cold = solver.solve(H, g, lb, ub, x0);
+    EXPECT_TRUE(ws.x.isApprox(cold.x, 1e-8));
+    EXPECT_EQ(ws.factorizations, 1);
+    EXPECT_GT(cold.factorizations, 1);
+}
+
+TEST(BoxQPSolver, FixedSizeMatchesDynamic) {
+    constexpr int n = 4;
+    using Fixed = BoxQPSolverFixed<n>;
+    MatrixXd M = MatrixXd::Random(n, n);
+    MatrixXd H = M * M.transpose() + n * MatrixXd::Identity(n, n);
+    VectorXd g(n);
+    g << -30.0, 25.0, 1.0, -0.5;
+    VectorXd lb = VectorXd::Constant(n, -1.0);
+    VectorXd ub = VectorXd::Constant(n, 1.0);
+
+    BoxQPSolver solver;
+    BoxQPResult reference = solver.solve(H, g, lb, ub);
+
+    Fixed fixed_solver;
+    Fixed::Workspace ws;
+    BoxQPStatus status = fixed_solver.solve(H, g, lb, ub, Fixed::Vector::Zero(), ws);
+    EXPECT_EQ(status, reference.status);
+    EXPECT_TRUE(ws.x.isApprox(reference.x, 1e-8));
+    EXPECT_EQ(VectorXi(ws.free), reference.free);
+    EXPECT_NEAR(ws.final_value, reference.final_value, 1e-10);
+
+    // Free-subspace solve against the reduced factor
+    Fixed::Vector rhs = Fixed::Vector::Zero();
+    VectorXd rhs_free(reference.free.sum());
+    for (int i = 0, j = 0; i < n; ++i) {
+        if (reference.free(i)) {
+            rhs(i) = i + 1.0;
+            rhs_free(j++) = i + 1.0;
+        }
+    }
+    ws.solveFree(rhs);
+    VectorXd sol_free = reference.Hfree.solve(rhs_free);
+    for (int i = 0, j = 0; i < n; ++i) {
+        if (reference.free(i)) {
+            EXPECT_NEAR(rhs(i), sol_free(j++), 1e-10);
+        } else {
+            EXPECT_EQ(rhs(i), 0.0);
+        }
+    }
+
+    // Warm start from the stored active set after the bounds shift
+    lb.array() -= 0.01;
+    ub.array() -= 0.01;
+    Fixed::Vector x0 = ws.x;
+    fixed_solver.solve(H, g, lb, ub, x0, ws);
+    BoxQPResult cold = solver.solve(H, g, lb, ub, x0);
+    EXPECT_TRUE(ws.x.isApprox(cold.x, 1e-8));
+    EXPECT_EQ(ws.factorizations, 1);
+
+    // Not positive definite
+    Fixed::Matrix H_indef = Fixed::Matrix::Identity();
+    H_indef(1, 1) = -1.0;
+    Fixed::Workspace ws_indef;
+    EXPECT_EQ(fixed_solver.solve(H_indef, Fixed::Vector::Ones(),
+                                 Fixed::Vector::Constant(-1.0),
+                                 Fixed::Vector::Constant(1.0),
+                                 Fixed::Vector::Zero(), ws_indef),
+              BoxQPStatus::HESSIAN_NOT_PD);
+}
+
+TEST(QPSolver, BatchMatchesBoxQP) {
+    // Box-constrained problems, so BoxQP provides the reference
+    const int n = 3;
+    const int m = 2 * n;
+    const int N = 40;
+    MatrixXd Q(n, N * n), A(m, N * n), c(n, N), b(m, N);
+    for (int k = 0; k < N; ++k) {
+        MatrixXd M = MatrixXd::Random(n, n);
+        Q.middleCols(k * n, n) = M * M.transpose() + MatrixXd::Identity(n, n);
+        A.middleCols(k * n, n) << MatrixXd::Identity(n, n), -MatrixXd::Identity(n, n);
+        c.col(k) = 5.0 * VectorXd::Random(n);
+        b.col(k).setOnes();
+    }
+
+    QPSolverOptions options;
+    options.warm_start = true;
+    BatchQPSolver batch(options);
+    batch.setDimensions(n, m);
+    MatrixXd X(n, N);
+    std::vector<QPStatus> status;
+    batch.solve(Q, c, A, b, X, status);
+
+    BoxQPSolver box_solver;
+    for (int k = 0; k < N; ++k) {
+        ASSERT_EQ(status[k], QPStatus::OPTIMAL);
+        BoxQPResult reference = box_solver.solve(Q.middleCols(k * n, n), c.col(k),
+                                                 -VectorXd::Ones(n), VectorXd::Ones(n));
+        EXPECT_TRUE(X.col(k).isApprox(reference.x, 1e-6)) << "problem " << k;
+
+        // Active constraints are the clamped variables
+        int num_active = (batch.getBases().col(k).array() >= 0).count();
+        EXPECT_EQ(num_active, n - reference.free.sum());
+    }
+
+    // Same batch on a thread pool, warm-started from the stored bases
+    ThreadPool pool(4);
+    MatrixXd X_warm(n, N);
+    batch.solve(Q, c, A, b, X_warm, status, &pool);
+    for (int k = 0; k < N; ++k) {
+        EXPECT_EQ(status[k], QPStatus::OPTIMAL);
+    }
+    EXPECT_TRUE(X_warm.isApprox(X, 1e-9));
+
+    // With the basis processed first, only its constraints are ever violated
+    QPSolver single(options);
+    single.setDimensions(n, m);
+    VectorXi basis = batch.getBases().col(0);
+    const int num_active = (basis.array() >= 0).count();
+    VectorXd x(n);
+    single.solve(Q.leftCols(n), c.col(0), A.leftCols(n), b.col(0), x, basis);
+    EXPECT_TRUE(x.isApprox(X.col(0), 1e-9));
+    EXPECT_EQ(single.getIterations(), num_active);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
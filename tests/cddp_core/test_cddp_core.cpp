@@ -395,4 +395,74 @@ TEST_F(CDDPCoreTest, IntegrationWithTrajectoryAndOptions) {
     ASSERT_TRUE(solution.count("control_trajectory"));
     auto control_traj = std::any_cast<std::vector<Eigen::VectorXd>>(solution["control_trajectory"]);
     EXPECT_EQ(control_traj.size(), horizon);
-} 
\ No newline at end of file
+} 
+TEST_F(CDDPCoreTest, PathConstraintBlocksAreStacked) {
+    cddp::CDDP cddp_solver(initial_state, goal_state, horizon, timestep,
+                          std::make_unique<cddp::Unicycle>(timestep, "euler"),
+                          std::make_unique<cddp::QuadraticObjective>(
+                              Eigen::MatrixXd::Identity(state_dim, state_dim),
+                              Eigen::MatrixXd::Identity(control_dim, control_dim),
+                              10.0 * Eigen::MatrixXd::Identity(state_dim, state_dim),
+                              goal_state, std::vector<Eigen::VectorXd>(), timestep),
+                          options);
+
+    Eigen::VectorXd control_bound = Eigen::VectorXd::Ones(control_dim);
+    Eigen::VectorXd state_bound = 5.0 * Eigen::VectorXd::Ones(state_dim);
+    cddp_solver.addPathConstraint("StateBoxConstraint",
+        std::make_unique<cddp::StateBoxConstraint>(-state_bound, state_bound));
+    cddp_solver.addPathConstraint("ControlConstraint",
+        std::make_unique<cddp::ControlConstraint>(control_bound));
+
+    // Blocks follow the constraint set order and are packed back to back
+    const auto &blocks = cddp_solver.getPathConstraintBlocks();
+    ASSERT_EQ(blocks.size(), 2u);
+    EXPECT_EQ(blocks[0].name, "ControlConstraint");
+    EXPECT_EQ(blocks[0].offset, 0);
+    EXPECT_EQ(blocks[0].dim, 2 * control_dim);
+    EXPECT_EQ(blocks[1].name, "StateBoxConstraint");
+    EXPECT_EQ(blocks[1].offset, 2 * control_dim);
+    EXPECT_EQ(blocks[1].dim, 2 * state_dim);
+    EXPECT_EQ(cddp_solver.getPathDualDim(), 2 * control_dim + 2 * state_dim);
+
+    // Stacked evaluation matches per-constraint evaluation
+    Eigen::VectorXd x = Eigen::VectorXd::Constant(state_dim, 0.5);
+    Eigen::VectorXd u = Eigen::VectorXd::Constant(control_dim, 0.25);
+    Eigen::VectorXd g;
+    cddp_solver.evaluatePathConstraints(x, u, g);
+    ASSERT_EQ(g.size(), cddp_solver.getPathDualDim());
+    for (const auto &block : blocks) {
+        Eigen::VectorXd value = block.constraint->evaluate(x, u);
+        Eigen::VectorXd expected = value - block.constraint->getUpperBound();
+        if (block.value_dim != block.dim) {
+            // Box constraints are stacked as [lb - g; g - ub]
+            expected.conservativeResize(block.dim);
+            expected << block.constraint->getLowerBound() - value,
+                        value - block.constraint->getUpperBound();
+        }
+        ASSERT_EQ(expected.size(), block.dim);
+        EXPECT_TRUE(g.segment(block.offset, block.dim).isApprox(expected));
+    }
+    EXPECT_EQ(blocks[1].value_dim, state_dim);
+
+    // Jacobians follow the same layout
+    Eigen::MatrixXd G_x(cddp_solver.getPathDualDim(), state_dim);
+    Eigen::MatrixXd G_u(cddp_solver.getPathDualDim(), control_dim);
+    for (const auto &block : blocks) {
+        cddp_solver.evaluatePathConstraintJacobians(
+            block, x, u, G_x.middleRows(block.offset, block.dim),
+            G_u.middleRows(block.offset, block.dim));
+    }
+    Eigen::MatrixXd box_x(2 * state_dim, state_dim);
+    box_x << -Eigen::MatrixXd::Identity(state_dim, state_dim),
+             Eigen::MatrixXd::Identity(state_dim, state_dim);
+    EXPECT_TRUE(G_x.middleRows(blocks[1].offset, blocks[1].dim).isApprox(box_x));
+    EXPECT_TRUE(G_u.middleRows(blocks[1].offset, blocks[1].dim).isZero());
+    EXPECT_TRUE(G_u.middleRows(blocks[0].offset, blocks[0].dim).isApprox(
+        blocks[0].constraint->getControlJacobian(x, u)));
+
+    // Removing a constraint recompiles the table
+    EXPECT_TRUE(cddp_solver.removePathConstraint("ControlConstraint"));
+    ASSERT_EQ(cddp_solver.getPathConstraintBlocks().size(), 1u);
+    EXPECT_EQ(cddp_solver.getPathConstraintBlocks()[0].offset, 0);
+    EXPECT_EQ(cddp_solver.getPathDualDim(), 2 * state_dim);
+}
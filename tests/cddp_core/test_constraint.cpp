@@ -19,6 +19,8 @@
 #include "cddp-cpp/cddp_core/constraint.hpp"
 #include <matplot/matplot.h>
 #include <sys/stat.h>
+#include <memory>
+#include <vector>
 
 TEST(ControlBoxConstraintTest, Evaluate) {
     // Create a constraint with lower and upper bounds
@@ -568,6 +570,43 @@ TEST(BallConstraintTest, Hessians) {
     ASSERT_TRUE(Hxx_list_scaled[0].isApprox(expected_Hxx_scaled));
 }
 
+TEST(ConstraintTest, InPlaceVariantsMatch) {
+    Eigen::VectorXd state(6);
+    state << 0.4, -0.3, 1.2, 0.1, 0.2, -0.1;
+    Eigen::VectorXd control(3);
+    control << 0.5, -0.2, 0.8;
+    Eigen::MatrixXd A(2, 6);
+    A << 1.0, 0.0, 2.0, 0.0, 0.0, 1.0,
+         0.0, -1.0, 0.0, 3.0, 0.0, 0.0;
+
+    std::vector<std::unique_ptr<cddp::Constraint>> constraints;
+    constraints.push_back(std::make_unique<cddp::ControlConstraint>(
+        Eigen::VectorXd::Constant(3, 1.0), Eigen::VectorXd::Constant(3, -0.5), 2.0));
+    constraints.push_back(std::make_unique<cddp::StateConstraint>(
+        Eigen::VectorXd::Constant(6, 2.0), Eigen::VectorXd(), 0.5));
+    constraints.push_back(std::make_unique<cddp::LinearConstraint>(A, Eigen::Vector2d(1.0, 2.0)));
+    constraints.push_back(std::make_unique<cddp::BallConstraint>(0.5, Eigen::Vector2d(0.1, 0.1), 2.0));
+    constraints.push_back(std::make_unique<cddp::PoleConstraint>(Eigen::Vector3d(0.0, 0.0, 0.0), 'z', 0.3, 2.0));
+    constraints.push_back(std::make_unique<cddp::SecondOrderConeConstraint>(
+        Eigen::Vector3d(0.0, 0.0, -1.0), Eigen::Vector3d(0.0, 0.0, 1.0), M_PI / 6.0));
+    constraints.push_back(std::make_unique<cddp::ThrustMagnitudeConstraint>(0.2, 1.0));
+    constraints.push_back(std::make_unique<cddp::MaxThrustMagnitudeConstraint>(1.0));
+
+    for (const auto &constraint : constraints) {
+        const int dim = constraint->getDualDim();
+        Eigen::VectorXd g(dim), upper(dim);
+        Eigen::MatrixXd g_x(dim, state.size()), g_u(dim, control.size());
+        constraint->evalInto(state, control, g);
+        constraint->evalUpperBoundInto(upper);
+        constraint->evalJacobiansInto(state, control, g_x, g_u);
+
+        EXPECT_TRUE(g.isApprox(constraint->evaluate(state, control))) << constraint->getName();
+        EXPECT_TRUE(upper.isApprox(constraint->getUpperBound())) << constraint->getName();
+        EXPECT_TRUE(g_x.isApprox(constraint->getStateJacobian(state, control))) << constraint->getName();
+        EXPECT_TRUE(g_u.isApprox(constraint->getControlJacobian(state, control))) << constraint->getName();
+    }
+}
+
 // TEST(LinearConstraintTest, Hessians) {
 //     Eigen::MatrixXd A(2, 2);
 //     A <<  1.0,  1.0,
@@ -0,0 +1,119 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "cddp.hpp"
+
+namespace
+{
+    std::unique_ptr<cddp::CDDP> makeUnicycleProblem(bool box_constrained)
+    {
+        const int state_dim = 3;
+        const int control_dim = 2;
+        const int horizon = 100;
+        const double timestep = 0.03;
+
+        Eigen::MatrixXd Q = 0.01 * Eigen::MatrixXd::Identity(state_dim, state_dim);
+        Q(2, 2) = 0.0;
+        Eigen::MatrixXd R = 0.05 * Eigen::MatrixXd::Identity(control_dim, control_dim);
+        Eigen::MatrixXd Qf = 100.0 * Eigen::MatrixXd::Identity(state_dim, state_dim);
+
+        Eigen::VectorXd initial_state(state_dim);
+        initial_state << 0.0, 0.0, M_PI / 4.0;
+        Eigen::VectorXd goal_state(state_dim);
+        goal_state << 2.0, 2.0, M_PI / 2.0;
+
+        std::vector<Eigen::VectorXd> empty_reference_states;
+        auto objective = std::make_unique<cddp::QuadraticObjective>(
+            Q, R, Qf, goal_state, empty_reference_states, timestep);
+        auto system = std::make_unique<cddp::Unicycle>(timestep, "euler");
+
+        cddp::CDDPOptions options;
+        options.max_iterations = 50;
+        options.tolerance = 1e-5;
+        options.acceptable_tolerance = 1e-6;
+        options.verbose = false;
+        options.print_solver_header = false;
+        options.enable_parallel = false;
+        options.regularization.initial_value = 1e-4;
+
+        auto problem = std::make_unique<cddp::CDDP>(initial_state, goal_state, horizon, timestep,
+                                                    std::move(system), std::move(objective), options);
+
+        std::vector<Eigen::VectorXd> X(horizon + 1, initial_state);
+        std::vector<Eigen::VectorXd> U(horizon, Eigen::VectorXd::Zero(control_dim));
+        problem->setInitialTrajectory(X, U);
+
+        if (box_constrained)
+        {
+            Eigen::VectorXd upper(control_dim);
+            upper << 1.0, M_PI / 2.0;
+            problem->addPathConstraint("ControlBoxConstraint",
+                                       std::make_unique<cddp::ControlBoxConstraint>(-upper, upper));
+        }
+        return problem;
+    }
+} // namespace
+
+TEST(FixedSizeCLDDPSolverTest, MatchesDynamicCLDDP)
+{
+    const std::string name = cddp::FixedSizeCLDDPSolver<3, 2>::registerSolver();
+    EXPECT_EQ(name, "FixedSizeCLDDP<3,2>");
+    EXPECT_TRUE(cddp::CDDP::isSolverRegistered(name));
+
+    for (bool box_constrained : {false, true})
+    {
+        auto reference = makeUnicycleProblem(box_constrained);
+        cddp::CDDPSolution sol_ref = reference->solve(cddp::SolverType::CLDDP);
+
+        auto fixed = makeUnicycleProblem(box_constrained);
+        cddp::CDDPSolution sol_fixed = fixed->solve(name);
+
+        EXPECT_EQ(std::any_cast<std::string>(sol_fixed.at("solver_name")), name);
+
+        const double cost_ref = std::any_cast<double>(sol_ref.at("final_objective"));
+        const double cost_fixed = std::any_cast<double>(sol_fixed.at("final_objective"));
+        EXPECT_NEAR(cost_fixed, cost_ref, 1e-3 * std::abs(cost_ref) + 1e-6);
+
+        auto X_fixed = std::any_cast<std::vector<Eigen::VectorXd>>(sol_fixed.at("state_trajectory"));
+        auto U_fixed = std::any_cast<std::vector<Eigen::VectorXd>>(sol_fixed.at("control_trajectory"));
+        ASSERT_EQ(X_fixed.size(), 101u);
+        ASSERT_EQ(U_fixed.size(), 100u);
+        EXPECT_NEAR(X_fixed.back()(0), 2.0, 0.1);
+        EXPECT_NEAR(X_fixed.back()(1), 2.0, 0.1);
+
+        if (box_constrained)
+        {
+            for (const auto &u : U_fixed)
+            {
+                EXPECT_LE(u.cwiseAbs()(0), 1.0 + 1e-8);
+                EXPECT_LE(u.cwiseAbs()(1), M_PI / 2.0 + 1e-8);
+            }
+        }
+    }
+}
+
+TEST(FixedSizeCLDDPSolverTest, RejectsMismatchedDimensions)
+{
+    const std::string name = cddp::FixedSizeCLDDPSolver<4, 2>::registerSolver();
+    auto problem = makeUnicycleProblem(false);
+    EXPECT_THROW(problem->solve(name), std::invalid_argument);
+}
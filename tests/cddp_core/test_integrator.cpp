@@ -0,0 +1,269 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "cddp.hpp"
+#include "dynamics_model/spacecraft_twobody.hpp"
+
+namespace
+{
+    // x' = -lambda * x + u on every component, with analytic Jacobians
+    class StiffDecay : public cddp::DynamicalSystem
+    {
+    public:
+        StiffDecay(double lambda, double timestep, const std::string &integration_type)
+            : DynamicalSystem(2, 2, timestep, integration_type), lambda_(lambda) {}
+
+        Eigen::VectorXd getContinuousDynamics(const Eigen::VectorXd &state,
+                                              const Eigen::VectorXd &control,
+                                              double time) const override
+        {
+            return -lambda_ * state + control;
+        }
+
+        Eigen::MatrixXd getStateJacobian(const Eigen::VectorXd &state,
+                                         const Eigen::VectorXd &control,
+                                         double time) const override
+        {
+            return -lambda_ * Eigen::MatrixXd::Identity(2, 2);
+        }
+
+        Eigen::MatrixXd getControlJacobian(const Eigen::VectorXd &state,
+                                           const Eigen::VectorXd &control,
+                                           double time) const override
+        {
+            return Eigen::MatrixXd::Identity(2, 2);
+        }
+
+    private:
+        double lambda_;
+    };
+
+    // Central differences of getDiscreteDynamics
+    std::pair<Eigen::MatrixXd, Eigen::MatrixXd>
+    finiteDifferenceJacobians(const cddp::DynamicalSystem &system,
+                              const Eigen::VectorXd &x, const Eigen::VectorXd &u)
+    {
+        const double h = 1e-6;
+        Eigen::MatrixXd A(x.size(), x.size());
+        Eigen::MatrixXd B(x.size(), u.size());
+        for (int j = 0; j < x.size(); ++j)
+        {
+            Eigen::VectorXd dx = Eigen::VectorXd::Zero(x.size());
+            dx(j) = h;
+            A.col(j) = (system.getDiscreteDynamics(x + dx, u, 0.0) -
+                        system.getDiscreteDynamics(x - dx, u, 0.0)) / (2 * h);
+        }
+        for (int j = 0; j < u.size(); ++j)
+        {
+            Eigen::VectorXd du = Eigen::VectorXd::Zero(u.size());
+            du(j) = h;
+            B.col(j) = (system.getDiscreteDynamics(x, u + du, 0.0) -
+                        system.getDiscreteDynamics(x, u - du, 0.0)) / (2 * h);
+        }
+        return {A, B};
+    }
+} // namespace
+
+TEST(IntegratorTest, SelectsSchemeByName)
+{
+    const std::pair<std::string, cddp::IntegrationType> schemes[] = {
+        {"euler", cddp::IntegrationType::Euler},
+        {"heun", cddp::IntegrationType::Heun},
+        {"rk3", cddp::IntegrationType::RK3},
+        {"rk4", cddp::IntegrationType::RK4},
+        {"rk45", cddp::IntegrationType::RK45},
+        {"implicit_midpoint", cddp::IntegrationType::ImplicitMidpoint}};
+    for (const auto &[name, type] : schemes)
+    {
+        auto integrator = cddp::makeIntegrator(name);
+        ASSERT_NE(integrator, nullptr) << name;
+        EXPECT_EQ(integrator->getType(), type);
+        EXPECT_EQ(integrator->getName(), name);
+    }
+    EXPECT_EQ(cddp::makeIntegrator("RK4"), nullptr);
+
+    cddp::Pendulum pendulum(0.05, 1.0, 1.0, 0.0, "rk4");
+    ASSERT_NE(pendulum.getIntegrator(), nullptr);
+    EXPECT_EQ(pendulum.getIntegrator()->getType(), cddp::IntegrationType::RK4);
+
+    pendulum.setIntegrator(std::make_shared<cddp::RK45Integrator>(1e-10, 1e-10));
+    EXPECT_EQ(pendulum.getIntegrationType(), "rk45");
+}
+
+TEST(IntegratorTest, RK4MatchesClassicalFormula)
+{
+    const double dt = 0.1;
+    cddp::Pendulum pendulum(dt, 1.0, 1.0, 0.1, "rk4");
+    Eigen::VectorXd x(2);
+    x << 0.8, -0.3;
+    Eigen::VectorXd u(1);
+    u << 0.4;
+
+    Eigen::VectorXd k1 = pendulum.getContinuousDynamics(x, u, 0.0);
+    Eigen::VectorXd k2 = pendulum.getContinuousDynamics(x + 0.5 * dt * k1, u, 0.5 * dt);
+    Eigen::VectorXd k3 = pendulum.getContinuousDynamics(x + 0.5 * dt * k2, u, 0.5 * dt);
+    Eigen::VectorXd k4 = pendulum.getContinuousDynamics(x + dt * k3, u, dt);
+    Eigen::VectorXd expected = x + (dt / 6) * (k1 + 2 * k2 + 2 * k3 + k4);
+
+    EXPECT_TRUE(pendulum.getDiscreteDynamics(x, u, 0.0).isApprox(expected, 1e-14));
+}
+
+TEST(IntegratorTest, RK45KeepsCircularOrbitAtCoarseTimestep)
+{
+    // Unit circular orbit, period 2*pi, covered in 12 steps
+    const double mu = 1.0;
+    const int steps = 12;
+    const double dt = 2.0 * M_PI / steps;
+    cddp::SpacecraftTwobody rk45(dt, mu, 1.0, "rk45");
+    cddp::SpacecraftTwobody rk4(dt, mu, 1.0, "rk4");
+
+    Eigen::VectorXd x0(6);
+    x0 << 1.0, 0.0, 0.0, 0.0, 1.0, 0.0;
+    Eigen::VectorXd u = Eigen::VectorXd::Zero(3);
+    Eigen::VectorXd x_rk45 = x0;
+    Eigen::VectorXd x_rk4 = x0;
+    for (int t = 0; t < steps; ++t)
+    {
+        x_rk45 = rk45.getDiscreteDynamics(x_rk45, u, t * dt);
+        x_rk4 = rk4.getDiscreteDynamics(x_rk4, u, t * dt);
+    }
+
+    EXPECT_LT((x_rk45 - x0).norm(), 1e-4);
+    EXPECT_GT((x_rk4 - x0).norm(), 10 * (x_rk45 - x0).norm());
+}
+
+TEST(IntegratorTest, ImplicitMidpointStableForStiffSystem)
+{
+    // dt * lambda = 10: explicit schemes blow up, implicit midpoint decays
+    StiffDecay implicit_system(1000.0, 0.01, "implicit_midpoint");
+    StiffDecay explicit_system(1000.0, 0.01, "rk4");
+
+    Eigen::VectorXd x0(2);
+    x0 << 1.0, -2.0;
+    Eigen::VectorXd u = Eigen::VectorXd::Zero(2);
+    Eigen::VectorXd x_implicit = x0;
+    Eigen::VectorXd x_explicit = x0;
+    for (int t = 0; t < 20; ++t)
+    {
+        x_implicit = implicit_system.getDiscreteDynamics(x_implicit, u, 0.0);
+        x_explicit = explicit_system.getDiscreteDynamics(x_explicit, u, 0.0);
+    }
+
+    EXPECT_LT(x_implicit.norm(), x0.norm());
+    EXPECT_GT(x_explicit.norm(), 1e6 * x0.norm());
+
+    // One step matches the closed form (1 - dt*lambda/2) / (1 + dt*lambda/2)
+    Eigen::VectorXd x1 = implicit_system.getDiscreteDynamics(x0, u, 0.0);
+    EXPECT_TRUE(x1.isApprox((1.0 - 5.0) / (1.0 + 5.0) * x0, 1e-8));
+}
+
+TEST(IntegratorTest, DiscreteJacobiansMatchFiniteDifferences)
+{
+    Eigen::VectorXd x(6);
+    x << 1.0, 0.2, -0.1, 0.05, 0.9, 0.1;
+    Eigen::VectorXd u(3);
+    u << 0.01, -0.02, 0.03;
+
+    for (const std::string integration_type : {"rk45", "implicit_midpoint"})
+    {
+        cddp::SpacecraftTwobody system(0.5, 1.0, 1.0, integration_type);
+        auto [A, B] = system.getDiscreteJacobians(x, u, 0.0);
+        auto [A_fd, B_fd] = finiteDifferenceJacobians(system, x, u);
+        EXPECT_TRUE(A.isApprox(A_fd, 1e-5)) << integration_type << "\nA:\n" << A << "\nFD:\n" << A_fd;
+        EXPECT_TRUE(B.isApprox(B_fd, 1e-5)) << integration_type << "\nB:\n" << B << "\nFD:\n" << B_fd;
+    }
+}
+
+TEST(IntegratorTest, InPlaceEvaluationMatchesReturningVersions)
+{
+    Eigen::VectorXd x(6);
+    x << 1.0, 0.2, -0.1, 0.05, 0.9, 0.1;
+    Eigen::VectorXd u(3);
+    u << 0.01, -0.02, 0.03;
+
+    for (const std::string integration_type : {"euler", "rk4", "rk45", "implicit_midpoint"})
+    {
+        cddp::SpacecraftTwobody system(0.5, 1.0, 1.0, integration_type);
+
+        Eigen::VectorXd x_next(6);
+        system.evalDiscreteDynamicsInto(x, u, 0.2, x_next);
+        EXPECT_TRUE(x_next.isApprox(system.getDiscreteDynamics(x, u, 0.2), 1e-14)) << integration_type;
+
+        Eigen::MatrixXd A(6, 6), B(6, 3);
+        system.evalDiscreteJacobiansInto(x, u, 0.2, A, B);
+        auto [A_ref, B_ref] = system.getDiscreteJacobians(x, u, 0.2);
+        EXPECT_TRUE(A.isApprox(A_ref, 1e-14)) << integration_type;
+        EXPECT_TRUE(B.isApprox(B_ref, 1e-14)) << integration_type;
+    }
+
+    // Analytic Jacobians written straight into blocks of a larger matrix
+    cddp::Pendulum pendulum(0.05, 1.0, 1.0, 0.1, "rk4");
+    Eigen::VectorXd xp(2);
+    xp << 0.8, -0.3;
+    Eigen::VectorXd up(1);
+    up << 0.4;
+    Eigen::MatrixXd AB = Eigen::MatrixXd::Zero(4, 3);
+    pendulum.evalJacobiansInto(xp, up, 0.0, AB.block(1, 0, 2, 2), AB.block(1, 2, 2, 1));
+    EXPECT_TRUE(AB.block(1, 0, 2, 2).isApprox(pendulum.getStateJacobian(xp, up, 0.0)));
+    EXPECT_TRUE(AB.block(1, 2, 2, 1).isApprox(pendulum.getControlJacobian(xp, up, 0.0)));
+    EXPECT_TRUE(AB.row(0).isZero());
+    EXPECT_TRUE(AB.row(3).isZero());
+
+    Eigen::VectorXd xdot(2);
+    pendulum.evalContinuousDynamicsInto(xp, up, 0.0, xdot);
+    EXPECT_TRUE(xdot.isApprox(pendulum.getContinuousDynamics(xp, up, 0.0)));
+}
+
+TEST(IntegratorTest, CountsStepsWithoutErrorControl)
+{
+    const double dt = 0.5;
+    StiffDecay system(50.0, dt, "rk4");
+    Eigen::VectorXd x(2);
+    x << 1.0, -2.0;
+    Eigen::VectorXd u(2);
+    u << 0.5, 0.0;
+
+    // With one substep allowed, the rejected first try is followed by the
+    // whole interval in one step, as if the tolerances were never violated
+    cddp::RK45Integrator limited(1e-12, 1e-12, 1);
+    cddp::RK45Integrator loose(1e30, 1e30);
+    Eigen::VectorXd expected = loose.step(system, x, u, dt, 0.0);
+    EXPECT_TRUE(limited.step(system, x, u, dt, 0.0).isApprox(expected, 1e-14));
+    EXPECT_EQ(limited.getSubstepLimitCount(), 1u);
+    EXPECT_EQ(loose.getSubstepLimitCount(), 0u);
+
+    Eigen::MatrixXd A(2, 2), B(2, 2);
+    limited.stepJacobiansInto(system, x, u, dt, 0.0, A, B);
+    EXPECT_EQ(limited.getSubstepLimitCount(), 2u);
+
+    cddp::Pendulum pendulum(0.1, 1.0, 1.0, 0.0, "rk4");
+    Eigen::VectorXd xp(2);
+    xp << 2.5, 1.0;
+    Eigen::VectorXd up(1);
+    up << 0.0;
+    cddp::ImplicitMidpointIntegrator one_iteration(1e-14, 1);
+    cddp::ImplicitMidpointIntegrator converging;
+    one_iteration.step(pendulum, xp, up, 0.1, 0.0);
+    converging.step(pendulum, xp, up, 0.1, 0.0);
+    EXPECT_EQ(one_iteration.getNewtonFailureCount(), 1u);
+    EXPECT_EQ(converging.getNewtonFailureCount(), 0u);
+}
@@ -20,6 +20,7 @@
 #include <sys/stat.h>
 #include <random>
 #include <cmath>
+#include <limits>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -823,3 +824,71 @@ TEST(IPDDPTest, SolveQuadrotor)
     EXPECT_LE(warm_iterations, iterations_completed + 20) << "Warm start should not take significantly more iterations";
 }
 
+
+namespace
+{
+    // Unicycle that counts Jacobian evaluations and reports a NaN control
+    // Jacobian, so that no amount of regularization makes Q_uu factorizable
+    class NaNJacobianUnicycle : public cddp::Unicycle
+    {
+    public:
+        using cddp::Unicycle::Unicycle;
+
+        void evalJacobiansInto(const Eigen::VectorXd &state, const Eigen::VectorXd &control,
+                               double time, Eigen::Ref<Eigen::MatrixXd> A,
+                               Eigen::Ref<Eigen::MatrixXd> B) const override
+        {
+            ++jacobian_calls;
+            cddp::Unicycle::evalJacobiansInto(state, control, time, A, B);
+            B.setConstant(std::numeric_limits<double>::quiet_NaN());
+        }
+
+        mutable int jacobian_calls = 0;
+    };
+} // namespace
+
+TEST(IPDDPTest, RegularizationRetriesReuseDerivatives)
+{
+    const int state_dim = 3;
+    const int control_dim = 2;
+    const int horizon = 50;
+    const double timestep = 0.05;
+
+    Eigen::VectorXd initial_state = Eigen::VectorXd::Zero(state_dim);
+    Eigen::VectorXd goal_state(state_dim);
+    goal_state << 2.0, 2.0, M_PI / 2.0;
+
+    Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(state_dim, state_dim);
+    Eigen::MatrixXd R = 0.05 * Eigen::MatrixXd::Identity(control_dim, control_dim);
+    Eigen::MatrixXd Qf = 10.0 * Eigen::MatrixXd::Identity(state_dim, state_dim);
+
+    for (const std::string solver : {"IPDDP", "ALDDP"})
+    {
+        std::vector<Eigen::VectorXd> empty_reference_states;
+        auto objective = std::make_unique<cddp::QuadraticObjective>(
+            Q, R, Qf, goal_state, empty_reference_states, timestep);
+        auto system = std::make_unique<NaNJacobianUnicycle>(timestep, "euler");
+        const NaNJacobianUnicycle &counter = *system;
+
+        cddp::CDDPOptions options;
+        options.max_iterations = 10;
+        options.verbose = false;
+        options.print_solver_header = false;
+        options.enable_parallel = false;
+
+        cddp::CDDP problem(initial_state, goal_state, horizon, timestep,
+                           std::move(system), std::move(objective), options);
+        Eigen::VectorXd control_upper_bound(control_dim);
+        control_upper_bound << 1.0, M_PI;
+        problem.addPathConstraint("ControlConstraint",
+                                  std::make_unique<cddp::ControlConstraint>(control_upper_bound));
+
+        cddp::SolveResult result;
+        problem.solve(solver, result);
+
+        // Every backward pass fails until the regularization limit, but the
+        // nominal trajectory never changes, so derivatives are evaluated once
+        EXPECT_FALSE(result.converged()) << solver;
+        EXPECT_EQ(counter.jacobian_calls, horizon) << solver;
+    }
+}
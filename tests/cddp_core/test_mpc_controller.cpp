@@ -0,0 +1,312 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "cddp.hpp"
+
+namespace
+{
+    std::unique_ptr<cddp::CDDP> makeUnicycleProblem(const Eigen::VectorXd &initial_state,
+                                                    const Eigen::VectorXd &goal_state,
+                                                    int horizon, double timestep)
+    {
+        const int state_dim = 3;
+        const int control_dim = 2;
+
+        Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(state_dim, state_dim);
+        Q.diagonal() << 10.0, 10.0, 0.1;
+        Eigen::MatrixXd R = 0.1 * Eigen::MatrixXd::Identity(control_dim, control_dim);
+        Eigen::MatrixXd Qf = 10.0 * Q;
+
+        std::vector<Eigen::VectorXd> empty_reference_states;
+        auto objective = std::make_unique<cddp::QuadraticObjective>(
+            Q, R, Qf, goal_state, empty_reference_states, timestep);
+        auto system = std::make_unique<cddp::Unicycle>(timestep, "euler");
+
+        cddp::CDDPOptions options;
+        options.max_iterations = 30;
+        options.tolerance = 1e-4;
+        options.verbose = false;
+        options.print_solver_header = false;
+        options.enable_parallel = false;
+        options.regularization.initial_value = 1e-4;
+
+        auto problem = std::make_unique<cddp::CDDP>(initial_state, goal_state, horizon, timestep,
+                                                    std::move(system), std::move(objective), options);
+
+        Eigen::VectorXd control_upper_bound(control_dim);
+        control_upper_bound << 1.0, M_PI;
+        problem->addPathConstraint("ControlConstraint",
+                                   std::make_unique<cddp::ControlConstraint>(control_upper_bound));
+        return problem;
+    }
+} // namespace
+
+TEST(MPCControllerTest, ShiftTrajectoryHelper)
+{
+    std::vector<Eigen::VectorXd> traj;
+    for (int i = 0; i < 5; ++i)
+    {
+        traj.push_back(Eigen::VectorXd::Constant(2, i));
+    }
+    const double *data_before = traj[0].data();
+
+    cddp::shiftTrajectory(traj, 2);
+
+    ASSERT_EQ(traj.size(), 5u);
+    EXPECT_DOUBLE_EQ(traj[0](0), 2.0);
+    EXPECT_DOUBLE_EQ(traj[1](0), 3.0);
+    EXPECT_DOUBLE_EQ(traj[2](0), 4.0);
+    EXPECT_DOUBLE_EQ(traj[3](0), 4.0);
+    EXPECT_DOUBLE_EQ(traj[4](0), 4.0);
+
+    // Buffers are rotated, not reallocated
+    bool reused = false;
+    for (const auto &x : traj)
+    {
+        reused = reused || x.data() == data_before;
+    }
+    EXPECT_TRUE(reused);
+}
+
+TEST(MPCControllerTest, ClosedLoopUnicycle)
+{
+    const int horizon = 30;
+    const double timestep = 0.1;
+
+    Eigen::VectorXd initial_state(3);
+    initial_state << 0.0, 0.0, 0.0;
+    Eigen::VectorXd goal_state(3);
+    goal_state << 2.0, 1.0, 0.0;
+
+    auto problem = makeUnicycleProblem(initial_state, goal_state, horizon, timestep);
+    cddp::MPCController mpc(std::move(problem), "IPDDP");
+
+    cddp::Unicycle plant(timestep, "euler");
+    Eigen::VectorXd state = initial_state;
+    const double initial_error = (state.head(2) - goal_state.head(2)).norm();
+
+    double time = 0.0;
+    for (int k = 0; k < 40; ++k)
+    {
+        const cddp::SolveResult &solution = mpc.step(state, time);
+        ASSERT_EQ(solution.control_trajectory.size(), static_cast<size_t>(horizon));
+        EXPECT_EQ(&solution, &mpc.getLastSolution());
+
+        const Eigen::VectorXd &u = mpc.getControl();
+        ASSERT_EQ(u.size(), 2);
+        EXPECT_LE(u(0), 1.0 + 1e-6);
+
+        // The problem always starts from the measured state
+        EXPECT_TRUE(mpc.getProblem().X_[0].isApprox(state));
+
+        state = plant.getDiscreteDynamics(state, u, time);
+        time += timestep;
+    }
+
+    // Warm starting is switched on after the first tick
+    EXPECT_TRUE(mpc.getProblem().getOptions().warm_start);
+
+    const double final_error = (state.head(2) - goal_state.head(2)).norm();
+    EXPECT_LT(final_error, 0.5 * initial_error);
+
+    mpc.reset();
+    EXPECT_FALSE(mpc.getProblem().getOptions().warm_start);
+    EXPECT_FALSE(mpc.getProblem().initialized_);
+
+    // The next tick starts cold from the measured state
+    const cddp::SolveResult &restarted = mpc.step(state, time);
+    ASSERT_EQ(restarted.control_trajectory.size(), static_cast<size_t>(horizon));
+    EXPECT_TRUE(mpc.getProblem().X_[0].isApprox(state));
+}
+
+TEST(MPCControllerTest, ShiftKeepsTailDynamicallyConsistent)
+{
+    const int horizon = 20;
+    const double timestep = 0.1;
+
+    Eigen::VectorXd initial_state(3);
+    initial_state << 0.0, 0.0, 0.0;
+    Eigen::VectorXd goal_state(3);
+    goal_state << 1.0, 1.0, 0.0;
+
+    auto problem = makeUnicycleProblem(initial_state, goal_state, horizon, timestep);
+    problem->solve("IPDDP");
+
+    const std::vector<Eigen::VectorXd> X_prev = problem->X_;
+    const std::vector<Eigen::VectorXd> U_prev = problem->U_;
+
+    problem->shiftTrajectory(3);
+
+    ASSERT_EQ(problem->X_.size(), static_cast<size_t>(horizon + 1));
+    ASSERT_EQ(problem->U_.size(), static_cast<size_t>(horizon));
+    for (int t = 0; t < horizon - 3; ++t)
+    {
+        EXPECT_TRUE(problem->U_[t].isApprox(U_prev[t + 3]));
+        EXPECT_TRUE(problem->X_[t].isApprox(X_prev[t + 3]));
+    }
+    for (int t = horizon - 3; t < horizon; ++t)
+    {
+        EXPECT_TRUE(problem->U_[t].isApprox(U_prev[horizon - 1]));
+        Eigen::VectorXd x_next = problem->getSystem().getDiscreteDynamics(
+            problem->X_[t], problem->U_[t], t * timestep);
+        EXPECT_TRUE(problem->X_[t + 1].isApprox(x_next));
+    }
+}
+
+TEST(MPCControllerTest, RealTimeIterationClosedLoop)
+{
+    const int horizon = 30;
+    const double timestep = 0.1;
+
+    Eigen::VectorXd initial_state(3);
+    initial_state << 0.0, 0.0, 0.0;
+    Eigen::VectorXd goal_state(3);
+    goal_state << 2.0, 1.0, 0.0;
+
+    for (const std::string solver : {"CLDDP", "IPDDP"})
+    {
+        auto problem = makeUnicycleProblem(initial_state, goal_state, horizon, timestep);
+        cddp::MPCController mpc(std::move(problem), solver);
+
+        cddp::Unicycle plant(timestep, "euler");
+        Eigen::VectorXd state = initial_state;
+        const double initial_error = (state.head(2) - goal_state.head(2)).norm();
+
+        // Full solve on the first tick, one iteration per tick afterwards
+        double time = 0.0;
+        mpc.step(state, time);
+        for (int k = 0; k < 40; ++k)
+        {
+            state = plant.getDiscreteDynamics(state, mpc.getControl(), time);
+            time += timestep;
+
+            mpc.prepare(time);
+            const cddp::SolveResult &solution = mpc.feedback(state);
+            EXPECT_EQ(solution.status_message, "RealTimeIterationCompleted") << solver;
+            EXPECT_EQ(solution.iterations_completed, 1);
+            ASSERT_EQ(solution.control_trajectory.size(), static_cast<size_t>(horizon));
+
+            // The rollout starts from the measured state
+            EXPECT_TRUE(mpc.getProblem().X_[0].isApprox(state));
+            EXPECT_TRUE(solution.state_trajectory.front().isApprox(state));
+            if (solver == "IPDDP")
+            {
+                // CLDDP only enforces ControlBoxConstraint
+                EXPECT_LE(mpc.getControl()(0), 1.0 + 1e-6) << solver;
+            }
+        }
+
+        const double final_error = (state.head(2) - goal_state.head(2)).norm();
+        EXPECT_LT(final_error, 0.5 * initial_error) << solver;
+    }
+}
+
+TEST(MPCControllerTest, RealTimeIterationRejectsDivergedRollout)
+{
+    const int horizon = 20;
+    const double timestep = 0.1;
+
+    Eigen::VectorXd initial_state = Eigen::VectorXd::Zero(3);
+    Eigen::VectorXd goal_state(3);
+    goal_state << 1.0, 1.0, 0.0;
+
+    for (const std::string solver : {"CLDDP", "IPDDP"})
+    {
+        auto problem = makeUnicycleProblem(initial_state, goal_state, horizon, timestep);
+        cddp::SolveResult result;
+        problem->solve(solver, result);
+        problem->prepare(solver);
+
+        const cddp::Trajectory X_nominal = problem->X_;
+        const cddp::Trajectory U_nominal = problem->U_;
+        const double regularization = problem->regularization_;
+
+        // A non-finite measurement propagates through the whole rollout
+        Eigen::VectorXd bad_state(3);
+        bad_state << std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0;
+        problem->feedback(bad_state, result);
+
+        EXPECT_EQ(result.status_message, "ForwardPassFailed_NotConverged") << solver;
+        EXPECT_GT(problem->regularization_, regularization) << solver;
+        for (int t = 0; t <= horizon; ++t)
+        {
+            EXPECT_TRUE(problem->X_[t].isApprox(X_nominal[t])) << solver;
+        }
+        for (int t = 0; t < horizon; ++t)
+        {
+            EXPECT_TRUE(problem->U_[t].isApprox(U_nominal[t])) << solver;
+        }
+    }
+}
+
+TEST(MPCControllerTest, RealTimeIterationAppliesFeedbackAfterLargeJump)
+{
+    const int horizon = 20;
+    const double timestep = 0.1;
+
+    Eigen::VectorXd initial_state = Eigen::VectorXd::Zero(3);
+    Eigen::VectorXd goal_state(3);
+    goal_state << 1.0, 1.0, 0.0;
+
+    auto problem = makeUnicycleProblem(initial_state, goal_state, horizon, timestep);
+    cddp::SolveResult result;
+    problem->solve(cddp::SolverType::CLDDP, result);
+    problem->prepare(cddp::SolverType::CLDDP);
+    const cddp::Trajectory U_nominal = problem->U_;
+
+    // The rollout from a distant measurement costs far more than the nominal
+    // trajectory, but it is still the feedback-corrected plan
+    Eigen::VectorXd far_state(3);
+    far_state << -20.0, 20.0, M_PI;
+    problem->feedback(far_state, result);
+
+    EXPECT_EQ(result.status_message, "RealTimeIterationCompleted");
+    EXPECT_TRUE(problem->X_[0].isApprox(far_state));
+    EXPECT_FALSE(problem->U_.matrix().isApprox(U_nominal.matrix()));
+    EXPECT_TRUE(std::isfinite(result.final_objective));
+}
+
+TEST(MPCControllerTest, RealTimeIterationRequiresPrepare)
+{
+    Eigen::VectorXd initial_state = Eigen::VectorXd::Zero(3);
+    Eigen::VectorXd goal_state(3);
+    goal_state << 1.0, 1.0, 0.0;
+
+    auto problem = makeUnicycleProblem(initial_state, goal_state, 20, 0.1);
+    cddp::SolveResult result;
+    EXPECT_THROW(problem->feedback(initial_state, result), std::runtime_error);
+
+    problem->prepare(cddp::SolverType::CLDDP);
+    EXPECT_THROW(problem->feedback(Eigen::VectorXd::Zero(2), result), std::runtime_error);
+    problem->feedback(initial_state, result);
+    EXPECT_EQ(result.solver_name, "CLDDP");
+    EXPECT_THROW(problem->feedback(initial_state, result), std::runtime_error);
+
+    // A full solve invalidates a pending preparation
+    problem->prepare(cddp::SolverType::CLDDP);
+    problem->solve(cddp::SolverType::CLDDP, result);
+    EXPECT_THROW(problem->feedback(initial_state, result), std::runtime_error);
+
+    // Solvers without real-time iteration support are rejected
+    EXPECT_THROW(problem->prepare(cddp::SolverType::LogDDP), std::runtime_error);
+    EXPECT_THROW(problem->prepare("NoSuchSolver"), std::runtime_error);
+}
@@ -123,6 +123,52 @@ TEST(ObjectiveFunctionTests, QuadraticObjective) {
     ASSERT_TRUE(compareMatrices(final_cost_hess, 2.0 * Qf));
 }
 
+TEST(ObjectiveFunctionTests, QuadraticObjectiveInPlaceDerivatives) {
+    const int state_dim = 3;
+    const int control_dim = 2;
+    const double timestep = 0.1;
+    Eigen::MatrixXd Q(state_dim, state_dim);
+    Q << 2.0, 0.3, 0.0,
+         0.3, 1.0, 0.1,
+         0.0, 0.1, 0.5;
+    Eigen::MatrixXd R = Eigen::MatrixXd::Identity(control_dim, control_dim) * 0.1;
+    Eigen::MatrixXd Qf = Eigen::MatrixXd::Identity(state_dim, state_dim) * 2.0;
+    Eigen::VectorXd goal_state(state_dim);
+    goal_state << 1.1, 0.6, 0.3;
+    std::vector<Eigen::VectorXd> X_ref(3, goal_state);
+    X_ref[1] << 0.2, -0.4, 1.0;
+
+    Eigen::VectorXd state(state_dim);
+    state << 1.0, 0.5, 0.2;
+    Eigen::VectorXd control(control_dim);
+    control << 0.8, -0.5;
+
+    // With and without a reference trajectory
+    for (const auto &reference : {std::vector<Eigen::VectorXd>(), X_ref}) {
+        cddp::QuadraticObjective objective(Q, R, Qf, goal_state, reference, timestep);
+
+        Eigen::VectorXd l_x(state_dim), l_u(control_dim);
+        objective.evalRunningCostGradientsInto(state, control, 1, l_x, l_u);
+        auto [state_grad, control_grad] = objective.getRunningCostGradients(state, control, 1);
+        ASSERT_TRUE(compareVectors(l_x, state_grad, 1e-12));
+        ASSERT_TRUE(compareVectors(l_u, control_grad, 1e-12));
+
+        Eigen::MatrixXd l_xx(state_dim, state_dim), l_uu(control_dim, control_dim),
+            l_ux = Eigen::MatrixXd::Ones(control_dim, state_dim);
+        objective.evalRunningCostHessiansInto(state, control, 1, l_xx, l_uu, l_ux);
+        auto [state_hess, control_hess, cross_hess] = objective.getRunningCostHessians(state, control, 1);
+        ASSERT_TRUE(compareMatrices(l_xx, state_hess, 1e-12));
+        ASSERT_TRUE(compareMatrices(l_uu, control_hess, 1e-12));
+        ASSERT_TRUE(compareMatrices(l_ux, cross_hess, 1e-12));
+
+        Eigen::VectorXd lf_x(state_dim);
+        Eigen::MatrixXd lf_xx(state_dim, state_dim);
+        objective.evalFinalCostGradientInto(state, lf_x);
+        objective.evalFinalCostHessianInto(state, lf_xx);
+        ASSERT_TRUE(compareVectors(lf_x, objective.getFinalCostGradient(state), 1e-12));
+        ASSERT_TRUE(compareMatrices(lf_xx, objective.getFinalCostHessian(state), 1e-12));
+    }
+}
 
 class TestNonlinearObjective : public cddp::NonlinearObjective {
 public:
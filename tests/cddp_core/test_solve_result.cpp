@@ -0,0 +1,261 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <cmath>
+#include <memory>
+#include <future>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "cddp.hpp"
+
+namespace
+{
+    std::unique_ptr<cddp::CDDP> makeUnicycleProblem(bool return_iteration_info)
+    {
+        const int state_dim = 3;
+        const int control_dim = 2;
+        const int horizon = 50;
+        const double timestep = 0.05;
+
+        Eigen::VectorXd initial_state = Eigen::VectorXd::Zero(state_dim);
+        Eigen::VectorXd goal_state(state_dim);
+        goal_state << 2.0, 2.0, M_PI / 2.0;
+
+        Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(state_dim, state_dim);
+        Eigen::MatrixXd R = 0.05 * Eigen::MatrixXd::Identity(control_dim, control_dim);
+        Eigen::MatrixXd Qf = Eigen::MatrixXd::Identity(state_dim, state_dim);
+        Qf.diagonal() << 50.0, 50.0, 10.0;
+
+        std::vector<Eigen::VectorXd> empty_reference_states;
+        auto objective = std::make_unique<cddp::QuadraticObjective>(
+            Q, R, Qf, goal_state, empty_reference_states, timestep);
+        auto system = std::make_unique<cddp::Unicycle>(timestep, "euler");
+
+        cddp::CDDPOptions options;
+        options.max_iterations = 20;
+        options.verbose = false;
+        options.print_solver_header = false;
+        options.enable_parallel = false;
+        options.return_iteration_info = return_iteration_info;
+
+        auto problem = std::make_unique<cddp::CDDP>(initial_state, goal_state, horizon, timestep,
+                                                    std::move(system), std::move(objective), options);
+
+        Eigen::VectorXd control_upper_bound(control_dim);
+        control_upper_bound << 1.0, M_PI;
+        problem->addPathConstraint("ControlConstraint",
+                                   std::make_unique<cddp::ControlConstraint>(control_upper_bound));
+        return problem;
+    }
+
+    // External solver that only implements the map-based interface
+    class MapOnlySolver : public cddp::ISolverAlgorithm
+    {
+    public:
+        void initialize(cddp::CDDP &context) override {}
+
+        cddp::CDDPSolution solve(cddp::CDDP &context) override
+        {
+            cddp::CDDPSolution solution;
+            solution["solver_name"] = getSolverName();
+            solution["status_message"] = std::string("OptimalSolutionFound");
+            solution["iterations_completed"] = 3;
+            solution["final_objective"] = 4.5;
+            solution["final_barrier_parameter_mu"] = 1e-6;
+            solution["state_trajectory"] = context.X_.toVector();
+            solution["control_trajectory"] = context.U_.toVector();
+            solution["history_objective"] = std::vector<double>{6.0, 5.0, 4.5};
+            return solution;
+        }
+
+        std::string getSolverName() const override { return "MapOnlySolver"; }
+    };
+} // namespace
+
+TEST(SolveResultTest, TypedResultMatchesSolutionMap)
+{
+    for (const std::string solver : {"CLDDP", "IPDDP"})
+    {
+        auto typed_problem = makeUnicycleProblem(true);
+        cddp::SolveResult result;
+        typed_problem->solve(solver, result);
+
+        auto map_problem = makeUnicycleProblem(true);
+        cddp::CDDPSolution solution = map_problem->solve(solver);
+
+        EXPECT_EQ(result.solver_name, solver);
+        EXPECT_EQ(result.status_message,
+                  std::any_cast<std::string>(solution.at("status_message")));
+        EXPECT_EQ(result.iterations_completed,
+                  std::any_cast<int>(solution.at("iterations_completed")));
+        EXPECT_DOUBLE_EQ(result.final_objective,
+                         std::any_cast<double>(solution.at("final_objective")));
+
+        auto X = std::any_cast<std::vector<Eigen::VectorXd>>(solution.at("state_trajectory"));
+        auto U = std::any_cast<std::vector<Eigen::VectorXd>>(solution.at("control_trajectory"));
+        auto K = std::any_cast<std::vector<Eigen::MatrixXd>>(solution.at("control_feedback_gains_K"));
+        auto time_points = std::any_cast<std::vector<double>>(solution.at("time_points"));
+        ASSERT_EQ(result.state_trajectory.size(), X.size());
+        ASSERT_EQ(result.control_trajectory.size(), U.size());
+        ASSERT_EQ(result.control_feedback_gains_K.size(), K.size());
+        EXPECT_EQ(result.time_points, time_points);
+        EXPECT_TRUE(result.state_trajectory.back().isApprox(X.back()));
+        EXPECT_TRUE(result.control_trajectory.front().isApprox(U.front()));
+        EXPECT_TRUE(result.control_feedback_gains_K.front().isApprox(K.front()));
+
+        // History is carried over series by series
+        ASSERT_TRUE(result.history.has_value());
+        auto history_objective =
+            std::any_cast<std::vector<double>>(solution.at("history_objective"));
+        EXPECT_EQ(result.history->objective.size(), history_objective.size());
+        EXPECT_EQ(solution.count("history_lagrangian"), 0u);
+
+        // Solver-specific metrics are only present when the solver sets them
+        EXPECT_EQ(result.final_barrier_parameter_mu.has_value(), solver == "IPDDP");
+        EXPECT_EQ(solution.count("final_barrier_parameter_mu"),
+                  result.final_barrier_parameter_mu ? 1u : 0u);
+
+        // Converting the typed result reproduces the same keys
+        cddp::CDDPSolution converted = cddp::toSolution(result);
+        for (const auto &entry : solution)
+        {
+            EXPECT_EQ(converted.count(entry.first), 1u) << entry.first;
+        }
+        EXPECT_EQ(converted.size(), solution.size());
+    }
+}
+
+TEST(SolveResultTest, ReSolveReusesStorage)
+{
+    auto problem = makeUnicycleProblem(false);
+    cddp::CDDPOptions options = problem->getOptions();
+    options.warm_start = true;
+    problem->setOptions(options);
+
+    cddp::SolveResult result;
+    problem->solve(cddp::SolverType::CLDDP, result);
+    EXPECT_FALSE(result.history.has_value());
+    ASSERT_FALSE(result.control_feedback_gains_K.empty());
+
+    const double *X_data = result.state_trajectory.matrix().data();
+    const double *U_data = result.control_trajectory.matrix().data();
+    const double *K_data = result.control_feedback_gains_K.front().data();
+    const double *t_data = result.time_points.data();
+
+    problem->solve(cddp::SolverType::CLDDP, result);
+    EXPECT_EQ(result.state_trajectory.matrix().data(), X_data);
+    EXPECT_EQ(result.control_trajectory.matrix().data(), U_data);
+    EXPECT_EQ(result.control_feedback_gains_K.front().data(), K_data);
+    EXPECT_EQ(result.time_points.data(), t_data);
+    EXPECT_TRUE(result.state_trajectory.matrix().isApprox(problem->X_.matrix()));
+}
+
+TEST(SolveResultTest, MapOnlySolverThroughTypedInterface)
+{
+    cddp::CDDP::registerSolver("MapOnlySolver",
+                               []() { return std::make_unique<MapOnlySolver>(); });
+
+    auto problem = makeUnicycleProblem(false);
+    cddp::SolveResult result;
+    result.final_penalty_parameter = 1.0; // stale value from a previous solve
+    problem->solve("MapOnlySolver", result);
+
+    EXPECT_EQ(result.solver_name, "MapOnlySolver");
+    EXPECT_TRUE(result.converged());
+    EXPECT_EQ(result.iterations_completed, 3);
+    EXPECT_DOUBLE_EQ(result.final_objective, 4.5);
+    ASSERT_TRUE(result.final_barrier_parameter_mu.has_value());
+    EXPECT_DOUBLE_EQ(*result.final_barrier_parameter_mu, 1e-6);
+    EXPECT_FALSE(result.final_penalty_parameter.has_value());
+    EXPECT_EQ(result.state_trajectory.size(), 51u);
+    EXPECT_EQ(result.control_trajectory.size(), 50u);
+    ASSERT_TRUE(result.history.has_value());
+    EXPECT_EQ(result.history->objective.size(), 3u);
+
+    problem->solve("NoSuchSolver", result);
+    EXPECT_FALSE(result.converged());
+    EXPECT_EQ(result.status_message.rfind("UnknownSolver", 0), 0u);
+    EXPECT_TRUE(result.state_trajectory.empty());
+}
+
+TEST(SolveResultTest, SolveAsyncReportsIterations)
+{
+    auto async_problem = makeUnicycleProblem(true);
+    int callbacks = 0;
+    double last_cost = 0.0;
+    async_problem->setIterationCallback(
+        [&](const cddp::CDDP &context, int iteration)
+        {
+            ++callbacks;
+            EXPECT_EQ(context.X_.size(), 51u);
+            last_cost = context.cost_;
+        });
+
+    std::future<cddp::SolveResult> future = async_problem->solveAsync(cddp::SolverType::IPDDP);
+    cddp::SolveResult result = future.get();
+
+    auto problem = makeUnicycleProblem(true);
+    cddp::SolveResult expected;
+    problem->solve(cddp::SolverType::IPDDP, expected);
+
+    EXPECT_EQ(result.status_message, expected.status_message);
+    EXPECT_EQ(result.iterations_completed, expected.iterations_completed);
+    EXPECT_DOUBLE_EQ(result.final_objective, expected.final_objective);
+
+    // One call per accepted step, i.e. per history entry after the first
+    ASSERT_TRUE(result.history.has_value());
+    EXPECT_EQ(callbacks, static_cast<int>(result.history->objective.size()) - 1);
+    EXPECT_GT(callbacks, 0);
+    EXPECT_DOUBLE_EQ(last_cost, result.final_objective);
+}
+
+TEST(SolveResultTest, CancellationStopsSolve)
+{
+    for (const std::string solver : {"CLDDP", "IPDDP", "MSIPDDP", "LogDDP"})
+    {
+        auto problem = makeUnicycleProblem(false);
+        cddp::CancellationToken token;
+        problem->setIterationCallback(
+            [&](const cddp::CDDP &, int iteration)
+            {
+                if (iteration == 2)
+                {
+                    token.cancel();
+                }
+            });
+
+        cddp::SolveResult result = problem->solveAsync(solver, token).get();
+        EXPECT_EQ(result.status_message, "Cancelled") << solver;
+        EXPECT_LE(result.iterations_completed, 3) << solver;
+        EXPECT_TRUE(result.state_trajectory.front().isApprox(problem->X_.front()));
+
+        // The token only applied to that solve
+        problem->setIterationCallback(nullptr);
+        cddp::SolveResult rerun;
+        problem->solve(solver, rerun);
+        EXPECT_NE(rerun.status_message, "Cancelled") << solver;
+
+        // A token cancelled up front stops the solve before the first step
+        cddp::CancellationToken cancelled;
+        cancelled.cancel();
+        problem->setCancellationToken(cancelled);
+        problem->solve(solver, rerun);
+        EXPECT_EQ(rerun.status_message, "Cancelled") << solver;
+        EXPECT_EQ(rerun.iterations_completed, 1) << solver;
+    }
+}
@@ -0,0 +1,199 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "cddp.hpp"
+
+TEST(ThreadPoolTest, RunsAllTasks)
+{
+    cddp::ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+
+    std::atomic<int> counter{0};
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 1000; ++i)
+    {
+        futures.push_back(pool.submit([&counter, i]() {
+            ++counter;
+            return i * i;
+        }));
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(futures[i].get(), i * i);
+    }
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPoolTest, ReusesWorkerThreads)
+{
+    cddp::ThreadPool pool(2);
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+
+    for (int round = 0; round < 50; ++round)
+    {
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < 4; ++i)
+        {
+            futures.push_back(pool.submit([&]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                ids.insert(std::this_thread::get_id());
+            }));
+        }
+        for (auto &f : futures)
+        {
+            f.get();
+        }
+    }
+    EXPECT_LE(ids.size(), 2u);
+}
+
+TEST(ThreadPoolTest, PropagatesExceptions)
+{
+    cddp::ThreadPool pool(1);
+    auto future = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+
+    // Pool keeps working after a task threw
+    EXPECT_EQ(pool.submit([]() { return 7; }).get(), 7);
+}
+
+TEST(ThreadPoolTest, SharedByCDDPInstance)
+{
+    cddp::CDDPOptions options;
+    options.num_threads = 3;
+    Eigen::VectorXd x0 = Eigen::VectorXd::Zero(3);
+    cddp::CDDP problem(x0, x0, 10, 0.1, nullptr, nullptr, options);
+
+    cddp::ThreadPool &pool = problem.getThreadPool();
+    EXPECT_EQ(pool.size(), 3);
+    EXPECT_EQ(&pool, &problem.getThreadPool());
+
+    options.num_threads = 2;
+    problem.setOptions(options);
+    EXPECT_EQ(problem.getThreadPool().size(), 2);
+}
+
+TEST(ThreadPoolTest, ParallelSolversUsePool)
+{
+    const int state_dim = 3;
+    const int control_dim = 2;
+    const int horizon = 100;
+    const double timestep = 0.05;
+
+    Eigen::VectorXd initial_state = Eigen::VectorXd::Zero(state_dim);
+    Eigen::VectorXd goal_state(state_dim);
+    goal_state << 2.0, 2.0, M_PI / 2.0;
+
+    Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(state_dim, state_dim);
+    Eigen::MatrixXd R = 0.05 * Eigen::MatrixXd::Identity(control_dim, control_dim);
+    Eigen::MatrixXd Qf = 100.0 * Eigen::MatrixXd::Identity(state_dim, state_dim);
+
+    for (const std::string solver_type : {"CLDDP", "LogDDP", "IPDDP", "MSIPDDP", "ALDDP"})
+    {
+        cddp::CDDPOptions options;
+        options.max_iterations = 100;
+        options.verbose = false;
+        options.print_solver_header = false;
+        options.enable_parallel = true;
+        options.num_threads = 4;
+
+        std::vector<Eigen::VectorXd> empty_reference_states;
+        cddp::CDDP problem(initial_state, goal_state, horizon, timestep,
+                           std::make_unique<cddp::Unicycle>(timestep, "euler"),
+                           std::make_unique<cddp::QuadraticObjective>(
+                               Q, R, Qf, goal_state, empty_reference_states, timestep),
+                           options);
+
+        Eigen::VectorXd control_upper_bound(control_dim);
+        control_upper_bound << 2.0, M_PI;
+        problem.addPathConstraint("ControlConstraint",
+                                  std::make_unique<cddp::ControlConstraint>(control_upper_bound));
+
+        cddp::CDDPSolution solution = problem.solve(solver_type);
+        auto X_sol = std::any_cast<std::vector<Eigen::VectorXd>>(solution.at("state_trajectory"));
+        ASSERT_EQ(X_sol.size(), static_cast<size_t>(horizon + 1)) << solver_type;
+        EXPECT_LT((X_sol.back().head(2) - goal_state.head(2)).norm(), 0.5) << solver_type;
+        EXPECT_EQ(problem.getThreadPool().size(), 4);
+    }
+}
+
+TEST(ThreadPoolTest, ALDDPParallelLineSearchMatchesSerial)
+{
+    const int state_dim = 3;
+    const int control_dim = 2;
+    const int horizon = 100;
+    const double timestep = 0.05;
+
+    Eigen::VectorXd initial_state = Eigen::VectorXd::Zero(state_dim);
+    Eigen::VectorXd goal_state(state_dim);
+    goal_state << 2.0, 2.0, M_PI / 2.0;
+
+    Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(state_dim, state_dim);
+    Eigen::MatrixXd R = 0.05 * Eigen::MatrixXd::Identity(control_dim, control_dim);
+    Eigen::MatrixXd Qf = 100.0 * Eigen::MatrixXd::Identity(state_dim, state_dim);
+
+    std::vector<cddp::CDDPSolution> solutions;
+    for (bool parallel : {false, true})
+    {
+        cddp::CDDPOptions options;
+        options.max_iterations = 100;
+        options.verbose = false;
+        options.print_solver_header = false;
+        options.enable_parallel = parallel;
+        options.num_threads = 4;
+
+        std::vector<Eigen::VectorXd> empty_reference_states;
+        cddp::CDDP problem(initial_state, goal_state, horizon, timestep,
+                           std::make_unique<cddp::Unicycle>(timestep, "euler"),
+                           std::make_unique<cddp::QuadraticObjective>(
+                               Q, R, Qf, goal_state, empty_reference_states, timestep),
+                           options);
+
+        Eigen::VectorXd control_upper_bound(control_dim);
+        control_upper_bound << 2.0, M_PI;
+        problem.addPathConstraint("ControlConstraint",
+                                  std::make_unique<cddp::ControlConstraint>(control_upper_bound));
+
+        solutions.push_back(problem.solve("ALDDP"));
+    }
+
+    // The parallel search accepts the same step size as the serial one
+    const auto &serial = solutions[0];
+    const auto &parallel = solutions[1];
+    EXPECT_EQ(std::any_cast<std::string>(parallel.at("status_message")),
+              std::any_cast<std::string>(serial.at("status_message")));
+    EXPECT_EQ(std::any_cast<int>(parallel.at("iterations_completed")),
+              std::any_cast<int>(serial.at("iterations_completed")));
+    EXPECT_NEAR(std::any_cast<double>(parallel.at("final_objective")),
+                std::any_cast<double>(serial.at("final_objective")), 1e-9);
+
+    auto X_serial = std::any_cast<std::vector<Eigen::VectorXd>>(serial.at("state_trajectory"));
+    auto X_parallel = std::any_cast<std::vector<Eigen::VectorXd>>(parallel.at("state_trajectory"));
+    ASSERT_EQ(X_parallel.size(), X_serial.size());
+    for (size_t t = 0; t < X_serial.size(); ++t)
+    {
+        EXPECT_TRUE(X_parallel[t].isApprox(X_serial[t], 1e-9)) << "t = " << t;
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ Copyright 2025 Tomo Sasaki
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      https://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "cddp.hpp"
+
+TEST(TrajectoryTest, ContiguousColumnViews)
+{
+    cddp::Trajectory traj(3, 4);
+    ASSERT_EQ(traj.size(), 4u);
+    ASSERT_EQ(traj.dim(), 3);
+    EXPECT_TRUE(traj.matrix().isZero());
+
+    traj[2] << 1.0, 2.0, 3.0;
+    traj.back() = Eigen::Vector3d(4.0, 5.0, 6.0);
+
+    // Writes go straight to the underlying column-major storage
+    EXPECT_DOUBLE_EQ(traj.matrix()(1, 2), 2.0);
+    EXPECT_DOUBLE_EQ(traj.matrix().data()[3 * 3 + 2], 6.0);
+    EXPECT_EQ(traj[1].data(), traj.matrix().data() + 3);
+
+    EXPECT_THROW(traj.at(4), std::out_of_range);
+}
+
+TEST(TrajectoryTest, ConvertsToAndFromVectors)
+{
+    std::vector<Eigen::VectorXd> knots;
+    for (int i = 0; i < 5; ++i)
+    {
+        knots.push_back(Eigen::VectorXd::Constant(2, i));
+    }
+
+    cddp::Trajectory traj = knots;
+    ASSERT_EQ(traj.size(), 5u);
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_TRUE(traj[i].isApprox(knots[i]));
+    }
+
+    std::vector<Eigen::VectorXd> round_trip = traj;
+    ASSERT_EQ(round_trip.size(), knots.size());
+    EXPECT_TRUE(round_trip.back().isApprox(knots.back()));
+
+    knots[3] = Eigen::VectorXd::Zero(3);
+    EXPECT_THROW(traj.assign(knots), std::invalid_argument);
+}
+
+TEST(TrajectoryTest, SwapAndShiftKeepStorage)
+{
+    cddp::Trajectory a(5, Eigen::Vector2d(1.0, 1.0));
+    cddp::Trajectory b(2, 5);
+    for (int k = 0; k < 5; ++k)
+    {
+        b[k].setConstant(k);
+    }
+    const double *a_data = a.matrix().data();
+    const double *b_data = b.matrix().data();
+
+    a.swap(b);
+    EXPECT_EQ(a.matrix().data(), b_data);
+    EXPECT_EQ(b.matrix().data(), a_data);
+
+    a.shift(2);
+    EXPECT_EQ(a.matrix().data(), b_data);
+    EXPECT_DOUBLE_EQ(a[0](0), 2.0);
+    EXPECT_DOUBLE_EQ(a[2](0), 4.0);
+    EXPECT_DOUBLE_EQ(a[3](0), 4.0);
+    EXPECT_DOUBLE_EQ(a[4](0), 4.0);
+
+    // Same shape: resize keeps the buffer; longer: old knots preserved
+    a.resize(2, 5);
+    EXPECT_EQ(a.matrix().data(), b_data);
+    a.resize(2, 7);
+    EXPECT_DOUBLE_EQ(a[2](1), 4.0);
+    EXPECT_TRUE(a[6].isZero());
+}
@@ -164,6 +164,35 @@ TEST(CarTest, JacobianTest) {
     }
 }
 
+TEST(CarTest, CombinedJacobiansMatchSeparate) {
+    cddp::Car car(0.03, 2.0, "euler");
+
+    Eigen::VectorXd state(4);
+    state << 1.0, 1.0, 3*M_PI/2, 1.0;
+    Eigen::VectorXd control(2);
+    control << 0.3, 0.1;
+
+    // One pass over [x, u] must agree with the per-block Jacobians
+    auto [A, B] = car.getJacobians(state, control, 0.0);
+    EXPECT_TRUE(A.isApprox(car.getStateJacobian(state, control, 0.0), 1e-8));
+    EXPECT_TRUE(B.isApprox(car.getControlJacobian(state, control, 0.0), 1e-8));
+}
+
+TEST(CarTest, BatchDynamicsMatchesPerKnot) {
+    cddp::Car car(0.03, 2.0, "euler");
+    const int N = 9;
+    Eigen::MatrixXd states = Eigen::MatrixXd::Random(4, N);
+    Eigen::MatrixXd controls = 0.5 * Eigen::MatrixXd::Random(2, N);
+    Eigen::VectorXd times = Eigen::VectorXd::Zero(N);
+
+    Eigen::MatrixXd next_states(4, N);
+    car.getDiscreteDynamicsBatch(states, controls, times, next_states);
+    for (int j = 0; j < N; ++j) {
+        EXPECT_TRUE(next_states.col(j).isApprox(
+            car.getDiscreteDynamics(states.col(j), controls.col(j), 0.0), 1e-12));
+    }
+}
+
 TEST(CarTest, HessianTest) {
     // Create a car instance
     double timestep = 0.03;
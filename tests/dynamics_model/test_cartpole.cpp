@@ -99,6 +99,84 @@ TEST(CartPoleJacobianTest, Jacobians) {
         << "\nAutodiff B:\n" << autodiff_B;
 }
 
+TEST(CartPoleJacobianTest, ScalarInstantiationsAgree) {
+    // Nonzero damping, which the double and autodiff paths used to disagree on
+    cddp::CartPole cartpole(0.01, "rk4", 1.0, 0.2, 0.5, 9.81, 0.3);
+
+    Eigen::VectorXd state(4);
+    state << 0.2, M_PI / 4.0, -0.3, 0.5;
+    Eigen::VectorXd control(1);
+    control << -2.0;
+
+    // double and dual2nd instantiations of the same dynamics
+    Eigen::VectorXd f = cartpole.getContinuousDynamics(state, control, 0.0);
+    VectorXdual2nd state_ad = state.cast<autodiff::dual2nd>();
+    VectorXdual2nd control_ad = control.cast<autodiff::dual2nd>();
+    VectorXdual2nd f_ad = cartpole.getContinuousDynamicsAutodiff(state_ad, control_ad, 0.0);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_NEAR(f(i), autodiff::val(f_ad(i)), 1e-12);
+    }
+
+    // First-order Jacobians against central differences of the double path
+    auto [A, B] = cartpole.getJacobians(state, control, 0.0);
+    const double h = 1e-6;
+    Eigen::MatrixXd A_fd(4, 4);
+    for (int j = 0; j < 4; ++j) {
+        Eigen::VectorXd dx = Eigen::VectorXd::Zero(4);
+        dx(j) = h;
+        A_fd.col(j) = (cartpole.getContinuousDynamics(state + dx, control, 0.0) -
+                       cartpole.getContinuousDynamics(state - dx, control, 0.0)) / (2 * h);
+    }
+    Eigen::VectorXd du(1);
+    du << h;
+    Eigen::VectorXd B_fd = (cartpole.getContinuousDynamics(state, control + du, 0.0) -
+                            cartpole.getContinuousDynamics(state, control - du, 0.0)) / (2 * h);
+    EXPECT_TRUE(A.isApprox(A_fd, 1e-6)) << "A:\n" << A << "\nFD:\n" << A_fd;
+    EXPECT_TRUE(B.isApprox(B_fd, 1e-6)) << "B:\n" << B << "\nFD:\n" << B_fd;
+    EXPECT_TRUE(A.isApprox(cartpole.getStateJacobian(state, control, 0.0)));
+    EXPECT_TRUE(B.isApprox(cartpole.getControlJacobian(state, control, 0.0)));
+}
+
+TEST(CartPoleJacobianTest, DiscreteJacobiansMatchIntegrator) {
+    Eigen::VectorXd state(4);
+    state << 0.2, M_PI / 4.0, -0.3, 0.5;
+    Eigen::VectorXd control(1);
+    control << -2.0;
+
+    // Coarse step, where I + dt * df/dx is visibly off for the RK schemes
+    const double timestep = 0.1;
+    for (const std::string integration_type : {"euler", "heun", "rk3", "rk4"}) {
+        cddp::CartPole cartpole(timestep, integration_type, 1.0, 0.2, 0.5, 9.81, 0.3);
+        auto [A, B] = cartpole.getDiscreteJacobians(state, control, 0.0);
+
+        // Central differences of the discrete map the rollout uses
+        const double h = 1e-6;
+        Eigen::MatrixXd A_fd(4, 4);
+        for (int j = 0; j < 4; ++j) {
+            Eigen::VectorXd dx = Eigen::VectorXd::Zero(4);
+            dx(j) = h;
+            A_fd.col(j) = (cartpole.getDiscreteDynamics(state + dx, control, 0.0) -
+                           cartpole.getDiscreteDynamics(state - dx, control, 0.0)) / (2 * h);
+        }
+        Eigen::VectorXd du(1);
+        du << h;
+        Eigen::VectorXd B_fd = (cartpole.getDiscreteDynamics(state, control + du, 0.0) -
+                                cartpole.getDiscreteDynamics(state, control - du, 0.0)) / (2 * h);
+        EXPECT_TRUE(A.isApprox(A_fd, 1e-5)) << integration_type << "\nA:\n" << A << "\nFD:\n" << A_fd;
+        EXPECT_TRUE(B.isApprox(B_fd, 1e-5)) << integration_type << "\nB:\n" << B << "\nFD:\n" << B_fd;
+
+        // Euler is exactly the first-order conversion
+        auto [Fx, Fu] = cartpole.getJacobians(state, control, 0.0);
+        Eigen::MatrixXd A_euler = Eigen::MatrixXd::Identity(4, 4) + timestep * Fx;
+        if (integration_type == "euler") {
+            EXPECT_TRUE(A.isApprox(A_euler));
+            EXPECT_TRUE(B.isApprox(timestep * Fu));
+        } else {
+            EXPECT_FALSE(A.isApprox(A_euler, 1e-3)) << integration_type;
+        }
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
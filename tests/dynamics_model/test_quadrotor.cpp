@@ -490,6 +490,91 @@ TEST(QuadrotorTest, ControlJacobianAutodiff) {
     EXPECT_NEAR((B_autodiff - B_numerical).norm(), 0.0, tolerance);
 }
 
+TEST(QuadrotorTest, FusedHessiansMatchBlockHessians) {
+    double timestep = 0.01;
+    double mass = 1.0;
+    double arm_length = 0.2;
+    Eigen::Matrix3d inertia;
+    inertia << 0.01, 0, 0,
+               0, 0.01, 0,
+               0, 0, 0.02;
+    Quadrotor quadrotor(timestep, mass, inertia, arm_length, "euler");
+
+    Eigen::VectorXd state(13);
+    state << 0.1, -0.2, 1.0, 0.0, 0.0, 0.0, 0.0, 0.2, 0.2, 0.2, 0.1, 0.1, 0.1;
+    state.segment(3, 4) << 0.9, 0.1, 0.2, 0.3;
+    state.segment(3, 4).normalize();
+    Eigen::VectorXd control(4);
+    control << 2.7, 2.2, 2.7, 2.2;
+
+    // getHessians evaluates each output's Hessian once and splits it
+    auto [Fxx, Fuu, Fux] = quadrotor.getHessians(state, control, 0.0);
+    auto Fxx_ref = quadrotor.getStateHessian(state, control, 0.0);
+    auto Fuu_ref = quadrotor.getControlHessian(state, control, 0.0);
+    auto Fux_ref = quadrotor.getCrossHessian(state, control, 0.0);
+
+    ASSERT_EQ(Fxx.size(), 13u);
+    ASSERT_EQ(Fuu.size(), 13u);
+    ASSERT_EQ(Fux.size(), 13u);
+    double tolerance = 1e-2;
+    for (int i = 0; i < 13; ++i) {
+        ASSERT_EQ(Fxx[i].rows(), 13);
+        ASSERT_EQ(Fuu[i].rows(), 4);
+        ASSERT_EQ(Fux[i].rows(), 4);
+        ASSERT_EQ(Fux[i].cols(), 13);
+        EXPECT_NEAR((Fxx[i] - Fxx_ref[i]).norm(), 0.0, tolerance) << "output " << i;
+        EXPECT_NEAR((Fuu[i] - Fuu_ref[i]).norm(), 0.0, tolerance) << "output " << i;
+        ASSERT_EQ(Fux_ref[i].rows(), 4);
+        EXPECT_NEAR((Fux[i] - Fux_ref[i]).norm(), 0.0, tolerance) << "output " << i;
+    }
+}
+
+TEST(QuadrotorTest, HessianContractionMatchesTensors) {
+    double timestep = 0.01;
+    double mass = 1.0;
+    double arm_length = 0.2;
+    Eigen::Matrix3d inertia;
+    inertia << 0.01, 0, 0,
+               0, 0.01, 0,
+               0, 0, 0.02;
+    Quadrotor quadrotor(timestep, mass, inertia, arm_length, "euler");
+
+    Eigen::VectorXd state(13);
+    state << 0.1, -0.2, 1.0, 0.9, 0.1, 0.2, 0.3, 0.2, 0.2, 0.2, 0.1, 0.1, 0.1;
+    state.segment(3, 4).normalize();
+    Eigen::VectorXd control(4);
+    control << 2.7, 2.2, 2.7, 2.2;
+    Eigen::VectorXd lambda = Eigen::VectorXd::LinSpaced(13, -1.0, 2.0);
+
+    // Reference: contract the full tensors by hand
+    auto [Fxx, Fuu, Fux] = quadrotor.getHessians(state, control, 0.0);
+    Eigen::MatrixXd Fxx_ref = Eigen::MatrixXd::Zero(13, 13);
+    Eigen::MatrixXd Fuu_ref = Eigen::MatrixXd::Zero(4, 4);
+    Eigen::MatrixXd Fux_ref = Eigen::MatrixXd::Zero(4, 13);
+    for (int i = 0; i < 13; ++i) {
+        Fxx_ref += lambda(i) * Fxx[i];
+        Fuu_ref += lambda(i) * Fuu[i];
+        Fux_ref += lambda(i) * Fux[i];
+    }
+
+    // Autodiff Hessian of lambda^T f (Quadrotor override)
+    auto [lambda_Fxx, lambda_Fuu, lambda_Fux] =
+        quadrotor.getHessianContraction(state, control, lambda, 0.0);
+    // Base class default, which contracts getHessians()
+    auto [base_Fxx, base_Fuu, base_Fux] =
+        quadrotor.DynamicalSystem::getHessianContraction(state, control, lambda, 0.0);
+
+    double tolerance = 1e-2;
+    ASSERT_EQ(lambda_Fux.rows(), 4);
+    ASSERT_EQ(lambda_Fux.cols(), 13);
+    EXPECT_NEAR((lambda_Fxx - Fxx_ref).norm(), 0.0, tolerance);
+    EXPECT_NEAR((lambda_Fuu - Fuu_ref).norm(), 0.0, tolerance);
+    EXPECT_NEAR((lambda_Fux - Fux_ref).norm(), 0.0, tolerance);
+    EXPECT_NEAR((base_Fxx - Fxx_ref).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((base_Fuu - Fuu_ref).norm(), 0.0, 1e-12);
+    EXPECT_NEAR((base_Fux - Fux_ref).norm(), 0.0, 1e-12);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -64,4 +64,27 @@ TEST(UnicycleTest, DiscreteDynamics) {
 
     // Assert true if the unicycle has the correct integration type
     ASSERT_EQ(unicycle.getIntegrationType(), "euler"); 
-}
\ No newline at end of file
+}
+TEST(UnicycleTest, BatchMatchesPerKnot) {
+    cddp::Unicycle unicycle(0.1, "rk4");
+    const int N = 7;
+    Eigen::MatrixXd states = Eigen::MatrixXd::Random(3, N);
+    Eigen::MatrixXd controls = Eigen::MatrixXd::Random(2, N);
+    Eigen::VectorXd times = Eigen::VectorXd::LinSpaced(N, 0.0, 0.6);
+
+    Eigen::MatrixXd next_states(3, N);
+    Eigen::MatrixXd A_batch(3, 3 * N), B_batch(3, 2 * N);
+    unicycle.getDiscreteDynamicsBatch(states, controls, times, next_states);
+    unicycle.getJacobiansBatch(states, controls, times, A_batch, B_batch);
+
+    for (int j = 0; j < N; ++j) {
+        const Eigen::VectorXd x = states.col(j);
+        const Eigen::VectorXd u = controls.col(j);
+        EXPECT_TRUE(next_states.col(j).isApprox(
+            unicycle.getDiscreteDynamics(x, u, times(j)), 1e-12));
+        EXPECT_TRUE(A_batch.middleCols(3 * j, 3).isApprox(
+            unicycle.getStateJacobian(x, u, times(j)), 1e-12));
+        EXPECT_TRUE(B_batch.middleCols(2 * j, 2).isApprox(
+            unicycle.getControlJacobian(x, u, times(j)), 1e-12));
+    }
+}
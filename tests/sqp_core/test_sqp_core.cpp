@@ -176,6 +176,70 @@ TEST(SQPIPOPTTest, SolveUnicycle) {
     // EXPECT_NEAR((solution.X.back() - goal_state).norm(), 0.0, 0.1);
 }
 
+TEST(SQPIPOPTTest, ReusedQPMatchesFreshSolver) {
+    // Problem parameters.
+    int state_dim = 3;
+    int control_dim = 2;
+    int horizon = 50;
+    double timestep = 0.05;
+
+    Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(state_dim, state_dim);
+    Eigen::MatrixXd R = 0.5 * Eigen::MatrixXd::Identity(control_dim, control_dim);
+    Eigen::MatrixXd Qf(state_dim, state_dim);
+    Qf << 100.0, 0.0, 0.0,
+          0.0, 100.0, 0.0,
+          0.0, 0.0, 50.0;
+    Eigen::VectorXd goal_state(state_dim);
+    goal_state << 2.0, 2.0, M_PI / 2.0;
+
+    cddp::SCPOptions options;
+    options.max_iterations = 10;
+    options.verbose = false;
+    options.trust_region_radius = 100.0;
+
+    auto make_solver = [&](const Eigen::VectorXd &initial_state) {
+        auto solver = std::make_unique<cddp::SCPSolver>(initial_state, goal_state, horizon, timestep);
+        solver->setDynamicalSystem(std::make_unique<cddp::Unicycle>(timestep, "euler"));
+        solver->setObjective(std::make_unique<cddp::QuadraticObjective>(
+            Q, R, Qf, goal_state, std::vector<Eigen::VectorXd>(), timestep));
+        solver->setOptions(options);
+        solver->setInitialTrajectory(
+            std::vector<Eigen::VectorXd>(horizon + 1, Eigen::VectorXd::Zero(state_dim)),
+            std::vector<Eigen::VectorXd>(horizon, Eigen::VectorXd::Zero(control_dim)));
+        return solver;
+    };
+
+    Eigen::VectorXd initial_state(state_dim);
+    initial_state << 0.0, 0.0, M_PI / 4.0;
+    auto reused = make_solver(initial_state);
+    cddp::SCPResult first = reused->solve();
+    ASSERT_GT(first.iterations, 1);
+
+    // A second solve keeps the OSQP instance and only changes its bounds:
+    // the initial-state rows and the trust region
+    Eigen::VectorXd moved_state(state_dim);
+    moved_state << 0.2, -0.1, M_PI / 3.0;
+    options.trust_region_radius = 50.0;
+    reused->setInitialState(moved_state);
+    reused->setOptions(options);
+    cddp::SCPResult second = reused->solve();
+
+    auto fresh = make_solver(moved_state);
+    cddp::SCPResult reference = fresh->solve();
+
+    EXPECT_EQ(second.success, reference.success);
+    EXPECT_EQ(second.iterations, reference.iterations);
+    ASSERT_EQ(second.X.size(), reference.X.size());
+    ASSERT_EQ(second.U.size(), reference.U.size());
+    EXPECT_NEAR((second.X.front() - moved_state).norm(), 0.0, 1e-3);
+    for (size_t t = 0; t < reference.X.size(); ++t) {
+        EXPECT_TRUE(second.X[t].isApprox(reference.X[t], 1e-3)) << "t = " << t;
+    }
+    for (size_t t = 0; t < reference.U.size(); ++t) {
+        EXPECT_LT((second.U[t] - reference.U[t]).norm(), 1e-3) << "t = " << t;
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();